@@ -205,6 +205,28 @@ void ssp_rx(ssp_rx_id_t ssp_id, ssp_buf_t *buf)
 
         break;
 
+#if NUFR_CS_TRACE == 1
+    case SSP_DAPP_CLEAR_TRACE_DUMP_REQUEST:
+    {
+        unsigned   channel_number = buf->header.channel_number;
+        unsigned   offset = 0;
+
+        ssp_free_buffer_from_task(buf);
+
+        // Stream kernel trace ring back, one piece per packet
+        while (NULL != (buf = ssp_trace_dump_next(channel_number, &offset)))
+        {
+            nsvc_msg_send_argsW(NSVC_MSG_SSP_TX,
+                                ID_TX_SSP_PACKET_SEND,
+                                NUFR_MSG_PRI_MID,
+                                NUFR_TID_null,
+                                (uint32_t)buf);
+        }
+
+        break;
+    }
+#endif  // NUFR_CS_TRACE
+
     // Bad packet, discard
     default:
         
@@ -46,10 +46,12 @@ typedef enum
     NSVC_MSRT_ERROR,
     NSVC_MSRT_ABORTED,
     NSVC_MSRT_AWOKE_RECEIVER,
+    NSVC_MSRT_QUEUE_FULL,
     // END SECTION OVERLAY OF 'nufr_msg_send_rtn_t'
 
     // Non-'nufr_msg_send_rtn_t' value(s)
     NSVC_MSRT_DEST_NOT_FOUND,
+    NSVC_MSRT_PARTIAL,          // multi-send reached only some tasks
 } nsvc_msg_send_return_t;
 
 
@@ -163,6 +165,24 @@ typedef enum
     NSVC_TMODE_CONTINUOUS,
 } nsvc_timer_mode_t;
 
+#if NUFR_CS_TIMER_CALLBACK == 1
+//!
+//! @enum      nsvc_timer_delivery_t
+//!
+//! @details   What happens when a timer expires
+//! @details   'NSVC_TDELIVERY_MSG'-- message sent (default)
+//! @details   'NSVC_TDELIVERY_CALLBACK'-- 'callback' called, no message
+//! @details   'NSVC_TDELIVERY_HYBRID'-- 'callback' called, message
+//! @details        sent if it returns 'true'
+//!
+typedef enum
+{
+    NSVC_TDELIVERY_MSG = 0,       //must be zero
+    NSVC_TDELIVERY_CALLBACK,
+    NSVC_TDELIVERY_HYBRID,
+} nsvc_timer_delivery_t;
+#endif
+
 //!
 //! @enum      nsvc_timer_callin_return_t
 //!
@@ -187,21 +207,73 @@ typedef enum
 //! @brief     SL timer block
 //!
 //! @details   Timer control block fields
-//! @details   
+//! @details   While active, a timer is a node in the active timer
+//! @details   pairing heap: 'child' is its leftmost child, 'flink'
+//! @details   its next sibling, and 'blink' its previous sibling, or
+//! @details   its parent if it's the leftmost child. Otherwise, only
+//! @details   'flink' is used, to link the free and expired lists.
+//! @details   'slack' is how many millisecs after 'duration' the timer
+//! @details   may fire, so it can expire along with other timers.
+//! @details   0 (the default) fires on time. Must not exceed 'duration'.
+//! @details   'delivery' and 'callback' select direct-callback expiry.
+//! @details   'coalesce' drops an expiry message if one with the same
+//! @details   fields and parameter is still queued to the receiver
+//! @details   (see nufr_msg_send_coalesce()). Defaults to 'false'.
 //!
 typedef struct nsvc_timer_t_
 {
     struct nsvc_timer_t_ *flink;
     struct nsvc_timer_t_ *blink;
+    struct nsvc_timer_t_ *child;
     uint32_t              duration;
     uint32_t              expiration_time;
+#if NUFR_CS_TIMER_SLACK == 1
+    uint32_t              slack;
+#endif
     uint32_t              msg_fields;
     uint32_t              msg_parameter;
+#if NUFR_CS_TIMER_CALLBACK == 1
+    bool                (*callback)(struct nsvc_timer_t_ *);
+#endif
     uint8_t               dest_task_id;   //type 'nufr_tid_t'
     uint8_t               mode;           //type 'nsvc_timer_mode_t'
+#if NUFR_CS_TIMER_CALLBACK == 1
+    uint8_t               delivery;       //type 'nsvc_timer_delivery_t'
+#endif
+#if NUFR_CS_MSG_INDEX == 1
+    bool                  coalesce;
+#endif
     bool                  is_active;
 } nsvc_timer_t;
 
+#if NUFR_CS_TIMER_CALLBACK == 1
+//!
+//! @name      nsvc_timer_callback_fcn_ptr_t
+//!
+//! @brief     Timer 'callback': runs in the expiry context
+//!
+//! @details   Called from wherever nsvc_timer_expire_timer_callin()
+//! @details   is: the OS tick or quantum timer ISR, or a high priority
+//! @details   task. It's also called from inside nsvc_timer_start()
+//! @details   and nsvc_timer_kill(), when they catch a pending expiry.
+//! @details   Timer lists are mid-update and other expiries wait
+//! @details   behind it, so a callback:
+//! @details     - must be short, and must not block
+//! @details     - may only call APIs which are callable from an ISR:
+//! @details       message sends, bop sends, nufr_event_set(),
+//! @details       nsvc_work_defer()
+//! @details     - must not call nsvc_timer_start()/kill()/alloc()/free()
+//! @details     - may change 'msg_parameter' (or 'msg_fields'), for
+//! @details       the message a hybrid timer sends
+//! @details   A continuous timer is rearmed after its callback.
+//!
+//! @param[in] 'nsvc_timer_t *'-- the expiring timer
+//!
+//! @return    'NSVC_TDELIVERY_HYBRID' timers: 'true' sends message
+//!
+typedef bool (*nsvc_timer_callback_fcn_ptr_t)(nsvc_timer_t *);
+#endif
+
 //!
 //! @name      nsvc_timer_get_current_time_fcn_ptr_t
 //!
@@ -219,6 +291,91 @@ typedef uint32_t (*nsvc_timer_get_current_time_fcn_ptr_t)(void);
 //!
 typedef void (*nsvc_timer_quantum_device_reconfigure_fcn_ptr_t)(uint32_t);
 
+#if NUFR_CS_TIMER_SLACK == 1
+//!
+//! @struct    nsvc_timer_stats_t
+//!
+//! @details   'wakeups_saved' counts expiration times which, due to
+//! @details   slack, were folded into an expiry at a later time.
+//! @details   'reprograms_saved' counts task-level timer changes which
+//! @details   didn't move the next expiry, so the quantum timer wasn't
+//! @details   reconfigured. Each saved wakeup also saves the quantum
+//! @details   timer reprogram that follows it.
+//!
+typedef struct
+{
+    uint32_t     expiries;           // expiry passes which expired timers
+    uint32_t     timers_expired;
+    uint32_t     wakeups_saved;
+    uint32_t     reprograms;         // quantum timer reconfigures
+    uint32_t     reprograms_saved;
+} nsvc_timer_stats_t;
+#endif  //NUFR_CS_TIMER_SLACK
+
+#if NUFR_CS_DEFERRED_WORK == 1
+//!
+//! @name      NSVC_WORK_PRIORITIES
+//!
+//! @details   Number of deferred work rings. Ring 0 runs first.
+//! @details   May be overridden in nsvc-app.h.
+//!
+#ifndef NSVC_WORK_PRIORITIES
+    #define NSVC_WORK_PRIORITIES              2
+#endif
+
+//!
+//! @name      NSVC_WORK_RING_SIZE
+//!
+//! @details   Items per ring. Must be a power of 2.
+//! @details   May be overridden in nsvc-app.h.
+//!
+#ifndef NSVC_WORK_RING_SIZE
+    #define NSVC_WORK_RING_SIZE               16
+#endif
+
+//!
+//! @name      NSVC_WORK_LATENCY_BUCKETS
+//!
+//! @details   Latency histogram, bucketed as NUFR_LOCK_PROFILE_BUCKETS
+//!
+#define NSVC_WORK_LATENCY_BUCKETS             16
+
+//!
+//! @name      nsvc_work_fcn_ptr_t
+//!
+//! @details   Deferred work item. Runs on the worker task.
+//!
+//! @param[in] 'uint32_t'-- argument given to 'nsvc_work_defer()'
+//!
+typedef void (*nsvc_work_fcn_ptr_t)(uint32_t);
+
+//!
+//! @struct    nsvc_work_ring_stats_t
+//!
+//! @details   Per ring. Latency is from 'nsvc_work_defer()' to the
+//! @details   item starting, in NUFR_TASK_STATS_TIMESTAMP() units.
+//!
+typedef struct
+{
+    uint32_t    deferred;
+    uint32_t    dropped;             // ring full
+    uint32_t    executed;
+    uint32_t    latency_max;
+    uint32_t    latency_histogram[NSVC_WORK_LATENCY_BUCKETS];
+} nsvc_work_ring_stats_t;
+
+//!
+//! @struct    nsvc_work_stats_t
+//!
+typedef struct
+{
+    uint32_t               batches;      // worker wakeups which ran items
+    uint32_t               batch_max;    // most items run in one wakeup
+    uint32_t               wake_fails;   // wake message not sent
+    nsvc_work_ring_stats_t ring[NSVC_WORK_PRIORITIES];
+} nsvc_work_stats_t;
+#endif  //NUFR_CS_DEFERRED_WORK
+
 //!
 //! @name      NSVC_TIMER_SET_ID
 //! @name      NSVC_TIMER_SET_PREFIX_ID
@@ -263,6 +420,10 @@ typedef void (*nsvc_timer_quantum_device_reconfigure_fcn_ptr_t)(uint32_t);
 //! @details   'tail_ptr'-- free list tail
 //! @details   'sema', 'sema_block'-- semaphore dedicated to pool
 //! @details             Count of sema is equal to free count
+//! @details   'zero_size'-- (NUFR_CS_POOL_BULK only) leading bytes of an
+//! @details             element cleared by a task-level alloc. Set before
+//! @details             init: 0 for whole element, NSVC_POOL_ZERO_NONE
+//! @details             for none. The flink is always cleared.
 //!
 typedef struct
 {
@@ -276,9 +437,21 @@ typedef struct
     uint16_t           element_size;
     uint16_t           element_index_size;
     uint16_t           flink_offset;
+#if NUFR_CS_POOL_BULK == 1
+    uint16_t           zero_size;
+#endif
     nufr_sema_t        sema;
 } nsvc_pool_t;
 
+#if NUFR_CS_POOL_BULK == 1
+//!
+//! @name      NSVC_POOL_ZERO_NONE
+//!
+//! @brief     'zero_size' setting: don't clear elements on alloc
+//!
+#define NSVC_POOL_ZERO_NONE         0xFFFF
+#endif  //NUFR_CS_POOL_BULK
+
 //!
 //! @name      NSVC_PCL_SIZE_AT_HEAD
 //!
@@ -381,6 +554,35 @@ nufr_sema_get_rtn_t nsvc_mutex_getT(nsvc_mutex_t   mutex,
                                     unsigned       timeout_ticks);
 bool nsvc_mutex_release(nsvc_mutex_t mutex);
 
+//! deferred work
+#if NUFR_CS_DEFERRED_WORK == 1
+void nsvc_work_init(nufr_tid_t worker_tid);
+bool nsvc_work_defer(unsigned            priority,
+                     nsvc_work_fcn_ptr_t fcn_ptr,
+                     uint32_t            argument);
+unsigned nsvc_work_run(void);
+void nsvc_work_task_entry(unsigned parm);
+void nsvc_work_stats_get(nsvc_work_stats_t *stats_ptr);
+void nsvc_work_stats_reset(void);
+#endif  //NUFR_CS_DEFERRED_WORK
+
+//! reader-writer locks, for apps which define them
+#ifdef NSVC_NUM_RWLOCK
+void nsvc_rwlock_init(void);
+nufr_sema_get_rtn_t nsvc_rwlock_read_getW(nsvc_rwlock_t  rwlock,
+                                          nufr_msg_pri_t abort_priority_of_rx_msg);
+nufr_sema_get_rtn_t nsvc_rwlock_read_getT(nsvc_rwlock_t  rwlock,
+                                          nufr_msg_pri_t abort_priority_of_rx_msg,
+                                          unsigned       timeout_ticks);
+bool nsvc_rwlock_read_release(nsvc_rwlock_t rwlock);
+nufr_sema_get_rtn_t nsvc_rwlock_write_getW(nsvc_rwlock_t  rwlock,
+                                           nufr_msg_pri_t abort_priority_of_rx_msg);
+nufr_sema_get_rtn_t nsvc_rwlock_write_getT(nsvc_rwlock_t  rwlock,
+                                           nufr_msg_pri_t abort_priority_of_rx_msg,
+                                           unsigned       timeout_ticks);
+bool nsvc_rwlock_write_release(nsvc_rwlock_t rwlock);
+#endif  //NSVC_NUM_RWLOCK
+
 //! generic pool
 void nsvc_pool_init(nsvc_pool_t *pool_ptr);
 bool nsvc_pool_is_element(nsvc_pool_t *pool_ptr, void *element_ptr);
@@ -391,6 +593,15 @@ nufr_sema_get_rtn_t nsvc_pool_allocateW(nsvc_pool_t  *pool_ptr,
 nufr_sema_get_rtn_t nsvc_pool_allocateT(nsvc_pool_t  *pool_ptr,
                                         void        **element_ptr,
                                         unsigned      timeout_ticks);
+#if NUFR_CS_POOL_BULK == 1
+unsigned nsvc_pool_allocate_bulk(nsvc_pool_t  *pool_ptr,
+                                 void        **element_ptrs,
+                                 unsigned      count,
+                                 bool          called_from_ISR);
+void nsvc_pool_free_bulk(nsvc_pool_t  *pool_ptr,
+                         void        **element_ptrs,
+                         unsigned      count);
+#endif  //NUFR_CS_POOL_BULK
 
 //! messaging
 uint32_t nsvc_msg_struct_to_fields(const nsvc_msg_fields_unary_t *parms);
@@ -505,6 +716,10 @@ uint32_t nsvc_timer_next_expiration_callin(void);
 uint8_t nsvc_timer_expire_timer_callin(
                                     uint32_t      current_time,
                                     uint32_t     *reconfigured_time_ptr);
+#if NUFR_CS_TIMER_SLACK == 1
+void nsvc_timer_stats_get(nsvc_timer_stats_t *stats_ptr);
+void nsvc_timer_stats_reset(void);
+#endif
 
 RAGING_EXTERN_C_END
 
@@ -56,7 +56,11 @@ typedef enum
     NUFR_BKD_MSG,              // blocked on msg receive with no timeout
     NUFR_BKD_MSG_TOUT,         // blocked on msg receive with timeout
     NUFR_BKD_SEMA,             // blocked on sema with no timeout
-    NUFR_BKD_SEMA_TOUT         // blocked on sema with timeout
+    NUFR_BKD_SEMA_TOUT,        // blocked on sema with timeout
+    NUFR_BKD_EVENT,            // blocked on event flags with no timeout
+    NUFR_BKD_EVENT_TOUT,       // blocked on event flags with timeout
+    NUFR_BKD_MSG_SPACE,        // blocked on msg send queue room, no timeout
+    NUFR_BKD_MSG_SPACE_TOUT    // blocked on msg send queue room with timeout
 } nufr_bkd_t;
 
 typedef enum
@@ -188,9 +192,21 @@ typedef enum
     NUFR_MSG_SEND_OK = 1,
     NUFR_MSG_SEND_ERROR,
     NUFR_MSG_SEND_ABORTED_RECEIVER,
-    NUFR_MSG_SEND_AWOKE_RECEIVER
+    NUFR_MSG_SEND_AWOKE_RECEIVER,
+    NUFR_MSG_SEND_QUEUE_FULL         // only with NUFR_CS_MSG_QUEUE_LIMIT
 } nufr_msg_send_rtn_t;
 
+//!
+//! @struct    nufr_msg_batch_entry_t
+//!
+//! @details   One message for nufr_msg_send_batch()
+//!
+typedef struct
+{
+    uint32_t fields;
+    uint32_t parameter;
+} nufr_msg_batch_entry_t;
+
 typedef enum
 {
     NUFR_SEMA_GET_OK_NO_BLOCK = 1,  //got sema without having to block
@@ -199,6 +215,80 @@ typedef enum
     NUFR_SEMA_GET_TIMEOUT,
 } nufr_sema_get_rtn_t;
 
+#if NUFR_CS_EVENT == 1
+typedef enum
+{
+    NUFR_EVENT_WAIT_OK_NO_BLOCK = 1, //flags already set, didn't block
+    NUFR_EVENT_WAIT_OK_BLOCK,        //had to block waiting for flags
+    NUFR_EVENT_WAIT_MSG_ABORT, //message send causes blocking task to abort wait
+    NUFR_EVENT_WAIT_TIMEOUT,
+} nufr_event_wait_rtn_t;
+
+//!
+//! @name      Event wait options
+//!
+//! @details   NUFR_EVENT_WAIT_ANY: wait satisfied by any flag set
+//! @details   NUFR_EVENT_WAIT_ALL: wait satisfied when all flags set
+//! @details   NUFR_EVENT_CONSUME: flags which satisfy wait are cleared
+//!
+#define NUFR_EVENT_WAIT_ANY             0x00
+#define NUFR_EVENT_WAIT_ALL             0x01
+#define NUFR_EVENT_CONSUME              0x02
+#endif  //NUFR_CS_EVENT
+
+#if NUFR_CS_TASK_PERIOD == 1
+typedef enum
+{
+    NUFR_PERIOD_OK = 1,                // woke on deadline
+    NUFR_PERIOD_OVERRUN,               // deadline already passed, no sleep
+    NUFR_PERIOD_ABORTED_BY_MESSAGE     // deadline not consumed
+} nufr_period_rtn_t;
+
+//!
+//! @struct    nufr_period_t
+//!
+//! @details   Periodic task state, owned by the task. 'next_deadline'
+//! @details   is an absolute tick count, advanced by 'period_ticks' from
+//! @details   the previous deadline, never from the current time.
+//! @details   'overruns' counts late releases, 'missed_periods' counts
+//! @details   whole periods skipped to get back on the grid.
+//!
+typedef struct
+{
+    uint32_t    next_deadline;
+    uint32_t    period_ticks;
+    uint32_t    overruns;
+    uint32_t    missed_periods;
+} nufr_period_t;
+#endif  //NUFR_CS_TASK_PERIOD
+
+#if NUFR_CS_LOCK_PROFILE == 1
+//!
+//! @name      NUFR_LOCK_PROFILE_BUCKETS
+//!
+//! @details   Histogram bucket 0 counts zero-length holds. Bucket 'n'
+//! @details   counts holds of 2^(n-1) to 2^n - 1 timestamp units. Last
+//! @details   bucket also counts everything longer.
+//!
+#define NUFR_LOCK_PROFILE_BUCKETS          16
+
+//!
+//! @struct    nufr_lock_profile_site_t
+//!
+//! @details   Interrupt lock hold times for one call site: the
+//! @details   NUFR_LOCK_INTERRUPTS() which took the outermost lock.
+//! @details   Times are in platform timestamp units.
+//!
+typedef struct
+{
+    const char *file;
+    uint32_t    line;
+    uint32_t    count;
+    uint32_t    max;
+    uint32_t    histogram[NUFR_LOCK_PROFILE_BUCKETS];
+} nufr_lock_profile_site_t;
+#endif  //NUFR_CS_LOCK_PROFILE
+
 //!
 //! @brief   Task API's
 //!
@@ -211,6 +301,13 @@ nufr_tid_t nufr_self_tid(void);
 nufr_bkd_t nufr_task_running_state(nufr_tid_t task_id);
 bool nufr_sleep(unsigned sleep_delay_in_ticks,
                 nufr_msg_pri_t abort_priority_of_rx_msg);
+#if NUFR_CS_TASK_PERIOD == 1
+bool nufr_sleep_until(uint32_t wake_tick,
+                      nufr_msg_pri_t abort_priority_of_rx_msg);
+void nufr_period_init(nufr_period_t *period, uint32_t period_ticks);
+nufr_period_rtn_t nufr_period_waitW(nufr_period_t *period,
+                            nufr_msg_pri_t abort_priority_of_rx_msg);
+#endif  //NUFR_CS_TASK_PERIOD
 bool nufr_yield(void);
 void nufr_prioritize(void);
 void nufr_unprioritize(void);
@@ -240,6 +337,29 @@ void nufr_local_struct_set(void *local_struct_ptr);
 void *nufr_local_struct_get(nufr_tid_t task_id);
 #endif  //NUFR_CS_LOCAL_STRUCT
 
+//!
+//! @brief   Task Stats API's
+//!
+#if NUFR_CS_TASK_STATS == 1
+bool nufr_task_stats_get(nufr_tid_t task_id, nufr_task_stats_t *stats_ptr);
+#endif  //NUFR_CS_TASK_STATS
+
+//!
+//! @brief   Time Slice API's
+//!
+#if NUFR_CS_TIME_SLICE == 1
+void nufr_time_slice_set(unsigned priority, unsigned quantum_ticks);
+#endif  //NUFR_CS_TIME_SLICE
+
+//!
+//! @brief   Interrupt Lock Profile API's
+//!
+#if NUFR_CS_LOCK_PROFILE == 1
+unsigned nufr_lock_profile_get(nufr_lock_profile_site_t *sites_ptr,
+                               unsigned                  max_sites);
+void nufr_lock_profile_reset(void);
+#endif  //NUFR_CS_LOCK_PROFILE
+
 //!
 //! @brief   Messaging API's
 //!
@@ -250,9 +370,50 @@ nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task
 nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
                                   uint32_t   optional_parameter,
                                   nufr_tid_t dest_task_id);
+unsigned nufr_msg_send_batch(const nufr_msg_batch_entry_t *entries,
+                             unsigned                      count,
+                             nufr_tid_t                    dest_task_id);
 void nufr_msg_getW(uint32_t *msg_fields_ptr, uint32_t *parameter_ptr);
 bool nufr_msg_getT(unsigned timeout_ticks, uint32_t *msg_fields_ptr, uint32_t *parameter_ptr);
 nufr_msg_t *nufr_msg_peek(void);
+#if NUFR_CS_MSG_PAYLOAD == 1
+nufr_msg_send_rtn_t nufr_msg_send_payload(uint32_t    msg_fields,
+                                          const void *payload_ptr,
+                                          unsigned    length,
+                                          nufr_tid_t  dest_task_id);
+void nufr_msg_payload_getW(uint32_t *msg_fields_ptr,
+                           uint32_t *length_ptr,
+                           void     *payload_ptr,
+                           unsigned  payload_size);
+bool nufr_msg_payload_getT(unsigned  timeout_ticks,
+                           uint32_t *msg_fields_ptr,
+                           uint32_t *length_ptr,
+                           void     *payload_ptr,
+                           unsigned  payload_size);
+#endif  //NUFR_CS_MSG_PAYLOAD
+#if NUFR_CS_MSG_INDEX == 1
+bool nufr_msg_is_pending(nufr_tid_t task_id, uint32_t msg_fields);
+nufr_msg_send_rtn_t nufr_msg_send_coalesce(uint32_t   msg_fields,
+                                           uint32_t   optional_parameter,
+                                           nufr_tid_t dest_task_id);
+#endif  //NUFR_CS_MSG_INDEX
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+nufr_msg_send_rtn_t nufr_msg_sendW(uint32_t   msg_fields,
+                                   uint32_t   optional_parameter,
+                                   nufr_tid_t dest_task_id);
+nufr_msg_send_rtn_t nufr_msg_sendT(uint32_t   msg_fields,
+                                   uint32_t   optional_parameter,
+                                   nufr_tid_t dest_task_id,
+                                   unsigned   timeout_ticks);
+#endif  //NUFR_CS_MSG_QUEUE_LIMIT
+#if NUFR_CS_MSG_BROADCAST == 1
+unsigned nufr_msg_broadcast(uint32_t          msg_fields,
+                            uint32_t          parameter,
+                            const void       *payload_ptr,
+                            unsigned          length,
+                            const nufr_tid_t *tid_list,
+                            unsigned          tid_count);
+#endif  //NUFR_CS_MSG_BROADCAST
 #endif  //NUFR_CS_MESSAGING
 
 //!
@@ -266,8 +427,29 @@ nufr_sema_get_rtn_t nufr_sema_getT(nufr_sema_t    sema,
                                    nufr_msg_pri_t abort_priority_of_rx_msg,
                                    unsigned       timeout_ticks);
 bool nufr_sema_release(nufr_sema_t sema);
+unsigned nufr_sema_release_count(nufr_sema_t sema, unsigned count);
 #endif  //NUFR_CS_SEMAPHORE
 
+//!
+//! @brief   Event Flag Group API's
+//!
+#if NUFR_CS_EVENT == 1
+uint32_t nufr_event_get(nufr_event_t event);
+bool nufr_event_set(nufr_event_t event, uint32_t flags);
+void nufr_event_clear(nufr_event_t event, uint32_t flags);
+nufr_event_wait_rtn_t nufr_event_waitW(nufr_event_t    event,
+                                       uint32_t        wait_flags,
+                                       unsigned        options,
+                                       uint32_t       *flags_ptr,
+                                       nufr_msg_pri_t  abort_priority_of_rx_msg);
+nufr_event_wait_rtn_t nufr_event_waitT(nufr_event_t    event,
+                                       uint32_t        wait_flags,
+                                       unsigned        options,
+                                       uint32_t       *flags_ptr,
+                                       nufr_msg_pri_t  abort_priority_of_rx_msg,
+                                       unsigned        timeout_ticks);
+#endif  //NUFR_CS_EVENT
+
 RAGING_EXTERN_C_END
 
 #endif  //NUFR_API_H
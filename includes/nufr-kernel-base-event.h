@@ -0,0 +1,57 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     nufr-kernel-base-event.h
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief   Event flag group definitions that fit either of:
+//! @brief     (1) Non-customizable platform layer constructs
+//! @brief     (2) Defined in kernel but needed in platform layer
+//!
+//! @details 
+
+#ifndef NUFR_KERNEL_BASE_EVENT_H
+#define NUFR_KERNEL_BASE_EVENT_H
+
+#include "nufr-global.h"
+
+//!
+//! @struct   nufr_event_block_t
+//!
+//! @brief    kernel event flag group data block, one per group
+//!
+//! @details  Wait list is singly linked through tcb->flink, and
+//! @details  sorted by task priority, highest first.
+//!
+struct nufr_tcb_t_;
+
+typedef struct
+{
+    struct nufr_tcb_t_ *task_list_head;
+    uint32_t            flags;
+} nufr_event_block_t;
+
+#endif  // NUFR_KERNEL_BASE_EVENT_H
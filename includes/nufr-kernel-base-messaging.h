@@ -54,6 +54,105 @@ typedef struct nufr_msg_t_
     uint32_t            parameter;
 } nufr_msg_t;
 
+//!
+//! @name      NUFR_BCAST_LINKS_PER_TASK
+//!
+//! @details   Broadcast link entries embedded in each tcb. Bounds how many
+//! @details   broadcasts a task can have queued by link at once; more
+//! @details   than that fall back to a block each.
+//!
+#if NUFR_CS_MSG_BROADCAST == 1
+    #ifndef NUFR_BCAST_LINKS_PER_TASK
+        #define NUFR_BCAST_LINKS_PER_TASK    2
+    #endif
+#endif  //NUFR_CS_MSG_BROADCAST
+
+// Shared descriptors come from the inline-payload pool
+#if (NUFR_CS_MSG_BROADCAST == 1) && (NUFR_CS_MSG_PAYLOAD == 0)
+    #error "NUFR_CS_MSG_BROADCAST requires NUFR_CS_MSG_PAYLOAD"
+#endif
+
+//!
+//! @name      NUFR_MSG_INDEX_BUCKETS
+//! @name      NUFR_MSG_INDEX_HASH
+//!
+//! @details   Per-task message index: a count, per message priority, of
+//! @details   queued messages whose prefix/ID hashes to a bucket.
+//! @details   Hash folds prefix onto ID, so consecutive IDs of one
+//! @details   prefix land in different buckets. IDs of a prefix which
+//! @details   differ by a multiple of NUFR_MSG_INDEX_BUCKETS do collide;
+//! @details   a collision costs a longer queue walk, not a wrong answer.
+//! @details   Buckets must be a power of 2.
+//!
+//! @name      NUFR_MSG_INDEX_INC
+//! @name      NUFR_MSG_INDEX_DEC
+//!
+//! @details   Kept with interrupts locked, wherever a message is put on
+//! @details   or taken off a tcb's queue.
+//!
+#if NUFR_CS_MSG_INDEX == 1
+    #ifndef NUFR_MSG_INDEX_BUCKETS
+        #define NUFR_MSG_INDEX_BUCKETS       8
+    #endif
+
+    typedef uint16_t nufr_msg_index_count_t;
+
+    #define NUFR_MSG_INDEX_HASH(fields)                                    \
+        ( (((fields) >> 12) ^ ((fields) >> 22)) & (NUFR_MSG_INDEX_BUCKETS - 1) )
+    #define NUFR_MSG_INDEX_SLOT(tcb, fields)                               \
+        ( (tcb)->msg_index[NUFR_GET_MSG_PRIORITY(fields)]                  \
+                          [NUFR_MSG_INDEX_HASH(fields)] )
+    #define NUFR_MSG_INDEX_INC(tcb, fields)  ( NUFR_MSG_INDEX_SLOT(tcb, fields)++ )
+    #define NUFR_MSG_INDEX_DEC(tcb, fields)  ( NUFR_MSG_INDEX_SLOT(tcb, fields)-- )
+#else
+    #define NUFR_MSG_INDEX_INC(tcb, fields)  ((void)0)
+    #define NUFR_MSG_INDEX_DEC(tcb, fields)  ((void)0)
+#endif  //NUFR_CS_MSG_INDEX
+
+//!
+//! @name      NUFR_MSG_QUEUE_HAS_ROOM
+//!
+//! @details   Can a message of priority 'pri' be queued to 'tcb' without
+//! @details   exceeding its queue limits? Interrupts locked.
+//!
+//! @name      NUFR_MSG_DEPTH_INC
+//! @name      NUFR_MSG_DEPTH_DEC
+//!
+//! @details   Queue depth and high-water mark upkeep. Done next to
+//! @details   NUFR_MSG_INDEX_INC()/NUFR_MSG_INDEX_DEC().
+//!
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    #define NUFR_MSG_QUEUE_HAS_ROOM(tcb, pri)                              \
+        ( ((0 == (tcb)->msg_queue_limit) ||                                \
+           ((tcb)->msg_queue_depth < (tcb)->msg_queue_limit)) &&           \
+          ((0 == (tcb)->msg_queue_pri_limit[pri]) ||                       \
+           ((tcb)->msg_queue_pri_depth[pri] < (tcb)->msg_queue_pri_limit[pri])) )
+    #define NUFR_MSG_DEPTH_INC(tcb, fields)                                \
+    {                                                                      \
+        unsigned m_pri = NUFR_GET_MSG_PRIORITY(fields);                    \
+                                                                           \
+        if (++(tcb)->msg_queue_depth > (tcb)->msg_queue_hwm)               \
+        {                                                                  \
+            (tcb)->msg_queue_hwm = (tcb)->msg_queue_depth;                 \
+        }                                                                  \
+        if (++(tcb)->msg_queue_pri_depth[m_pri] >                          \
+                                      (tcb)->msg_queue_pri_hwm[m_pri])     \
+        {                                                                  \
+            (tcb)->msg_queue_pri_hwm[m_pri] =                              \
+                                      (tcb)->msg_queue_pri_depth[m_pri];   \
+        }                                                                  \
+    }
+    #define NUFR_MSG_DEPTH_DEC(tcb, fields)                                \
+    {                                                                      \
+        (tcb)->msg_queue_depth--;                                          \
+        (tcb)->msg_queue_pri_depth[NUFR_GET_MSG_PRIORITY(fields)]--;       \
+    }
+#else
+    #define NUFR_MSG_QUEUE_HAS_ROOM(tcb, pri)  (true)
+    #define NUFR_MSG_DEPTH_INC(tcb, fields)
+    #define NUFR_MSG_DEPTH_DEC(tcb, fields)
+#endif  //NUFR_CS_MSG_QUEUE_LIMIT
+
 // See 'nufr-api.h' for helper macros for nufr_msg_t->fields value
 
 #endif  //NUFR_KERNEL_BASE_MESSAGING_H
\ No newline at end of file
@@ -48,6 +48,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     #include "nufr-kernel-base-semaphore.h"
 #endif  //NUFR_CS_SEMAPHORE
 
+#if NUFR_CS_EVENT == 1
+    #include "nufr-kernel-base-event.h"
+#endif  //NUFR_CS_EVENT
+
 //!
 //! @struct  Task descriptor
 //!
@@ -59,8 +63,35 @@ typedef struct
     unsigned     stack_size;
     uint8_t      start_priority;    //of 'nufr_tpr_t'
     uint8_t      instance;
+#if NUFR_CS_TIME_SLICE == 1
+    bool         time_slice_opt_out;
+#endif
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    // Max queued messages, in total and per message priority.
+    //   0 is no limit.
+    uint8_t      msg_queue_limit;
+    uint8_t      msg_queue_pri_limit[NUFR_CS_MSG_PRIORITIES];
+#endif
 } nufr_task_desc_t;
 
+#if NUFR_CS_TASK_STATS == 1
+//!
+//! @struct  Per-task CPU time and context switch stats
+//!
+//! @details 'run_time' is in NUFR_TASK_STATS_TIMESTAMP() units. Every unit
+//! @details is charged to some task, BG included, so run times of all
+//! @details tasks sum to elapsed time. ISR time is charged to the task
+//! @details it interrupted.
+//!
+typedef struct
+{
+    uint64_t    run_time;         // cumulative time switched in
+    uint32_t    switch_ins;       // times switched in
+    uint32_t    preemptions;      // times switched out while still ready
+    uint32_t    blocks;           // times switched out while blocked
+} nufr_task_stats_t;
+#endif  //NUFR_CS_TASK_STATS
+
 //!
 //! @struct  Task Control Block (TCB)
 //!
@@ -82,6 +113,12 @@ typedef struct nufr_tcb_t_
         // 'stack_ptr' must be offset NUFR_SP_OFFSET_IN_TCB bytes 'nufr_tcb_t'
     unsigned           *stack_ptr;       // 'unsigned' will be 32-bits by default, 16-bits/20-bits on MSP430/X
 
+#if NUFR_CS_READY_LIST_BITMAP == 1
+    // Back link for ready list. NULL when task is ready list head
+    // or when task isn't ready.
+    struct nufr_tcb_t_ *blink_ready;
+#endif
+
 #if NUFR_CS_LOCAL_STRUCT == 1
     void               *local_struct_ptr;
 #endif
@@ -102,6 +139,18 @@ typedef struct nufr_tcb_t_
     nufr_sema_block_t  *sema_block;
 #endif  //NUFR_CS_SEMAPHORE
 
+#if NUFR_CS_EVENT == 1
+    // The event group this task is blocked on. NULL if none.
+    nufr_event_block_t *event_block;
+
+    // While blocked, the flags being waited on. When the wait is
+    //   satisfied, the flags which satisfied it.
+    uint32_t            event_flags;
+
+    // While blocked, the wait options (NUFR_EVENT_WAIT_ALL, etc.)
+    uint8_t             event_options;
+#endif  //NUFR_CS_EVENT
+
     uint32_t            timer;
 
     // Flags indicating why task isn't ready.
@@ -156,7 +205,41 @@ typedef struct nufr_tcb_t_
     #if NUFR_CS_MSG_PRIORITIES == 4
         nufr_msg_t     *msg_tail3;
     #endif
+    #if NUFR_CS_MSG_BROADCAST == 1
+        // Queue entries for nufr_msg_broadcast(). Free when 'parameter'
+        //   is 0; otherwise, 'parameter' - 1 is the descriptor's
+        //   index into inline-payload pool.
+        nufr_msg_t      bcast_links[NUFR_BCAST_LINKS_PER_TASK];
+    #endif
+    #if NUFR_CS_MSG_INDEX == 1
+        // Queued message counts, see NUFR_MSG_INDEX_HASH()
+        nufr_msg_index_count_t
+                        msg_index[NUFR_CS_MSG_PRIORITIES][NUFR_MSG_INDEX_BUCKETS];
+    #endif
+    #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+        // Limits, copied from task descriptor at launch
+        uint8_t         msg_queue_limit;
+        uint8_t         msg_queue_pri_limit[NUFR_CS_MSG_PRIORITIES];
+        // Queued message counts and their high-water marks
+        uint16_t        msg_queue_depth;
+        uint16_t        msg_queue_hwm;
+        uint16_t        msg_queue_pri_depth[NUFR_CS_MSG_PRIORITIES];
+        uint16_t        msg_queue_pri_hwm[NUFR_CS_MSG_PRIORITIES];
+        // Sends refused for lack of room
+        uint16_t        msg_queue_full_count;
+        // Senders blocked in nufr_msg_sendW()/nufr_msg_sendT() on this
+        //   task's queue, priority sorted, linked by 'flink'.
+        struct nufr_tcb_t_ *msg_space_waiters;
+        // When this task is such a sender: receiver, and priority
+        //   it needs room at
+        struct nufr_tcb_t_ *msg_space_dest;
+        uint8_t         msg_space_priority;
+    #endif
 #endif  //NUFR_CS_MESSAGING
+
+#if NUFR_CS_TASK_STATS == 1
+    nufr_task_stats_t   stats;
+#endif
 } nufr_tcb_t;
 
 // values for tcb->block_flags field
@@ -165,12 +248,16 @@ typedef struct nufr_tcb_t_
 #define NUFR_TASK_BLOCKED_BOP            0x04
 #define NUFR_TASK_BLOCKED_MSG            0x08
 #define NUFR_TASK_BLOCKED_SEMA           0x10
+#define NUFR_TASK_BLOCKED_EVENT          0x20
+#define NUFR_TASK_BLOCKED_MSG_SPACE      0x40
 #define NUFR_TASK_BLOCKED_ALL                       \
         (NUFR_TASK_NOT_LAUNCHED   |                 \
          NUFR_TASK_BLOCKED_ASLEEP |                 \
          NUFR_TASK_BLOCKED_BOP    |                 \
          NUFR_TASK_BLOCKED_MSG    |                 \
-         NUFR_TASK_BLOCKED_SEMA)
+         NUFR_TASK_BLOCKED_SEMA   |                 \
+         NUFR_TASK_BLOCKED_EVENT  |                 \
+         NUFR_TASK_BLOCKED_MSG_SPACE)
 
 // values for tcb->statuses field
           // task on OS timer list
@@ -181,6 +268,8 @@ typedef struct nufr_tcb_t_
 #define NUFR_TASK_BOP_LOCKED             0x04
           // priority raised to prevent inversion/'priority_restore_inversion'
 #define NUFR_TASK_INVERSION_PRIORITIZED  0x08
+          // task exempt from time slicing
+#define NUFR_TASK_NO_TIME_SLICE          0x10
 
 
 // values for tcb->notifications
@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     nufr-kernel-event.h
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief   Event flag group definitions that are only exported
+//! @brief   to nufr platform and nufr kernel, but not to app layers
+//!
+//! @details 
+
+#ifndef NUFR_KERNEL_EVENT_H
+#define NUFR_KERNEL_EVENT_H
+
+#include "nufr-global.h"
+#include "nufr-kernel-base-event.h"
+#include "nufr-kernel-base-task.h"
+#include "nufr-platform-app.h"
+
+
+#define NUFR_EVENT_ID_TO_BLOCK(x)   ( &nufr_event_block[(x) - 1] )
+#define NUFR_EVENT_BLOCK_TO_ID(y)   ( (nufr_event_t) ((unsigned)((y) - &nufr_event_block[0]) + 1) )
+
+#define NUFR_IS_EVENT_BLOCK(x)      ( ((x) >= nufr_event_block) &&             \
+                              ((x) <= &nufr_event_block[NUFR_NUM_EVENTS - 1]) )
+
+
+#ifndef NUFR_EVENT_GLOBAL_DEFS
+    extern nufr_event_block_t nufr_event_block[NUFR_NUM_EVENTS];
+#endif  //NUFR_EVENT_GLOBAL_DEFS
+
+
+//  APIs
+RAGING_EXTERN_C_START
+void nufrkernel_event_link_task(nufr_event_block_t *event_block,
+                                nufr_tcb_t         *add_tcb);
+void nufrkernel_event_unlink_task(nufr_event_block_t *event_block,
+                                  nufr_tcb_t         *delete_tcb);
+RAGING_EXTERN_C_END
+
+#endif  //NUFR_KERNEL_EVENT_H
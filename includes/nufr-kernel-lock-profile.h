@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     nufr-kernel-lock-profile.h
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief   Interrupt lock hold time profiler. Only exported to nufr
+//! @brief   platform and nufr kernel, but not to app layers
+//!
+//! @details The platform's NUFR_LOCK_INTERRUPTS()/NUFR_UNLOCK_INTERRUPTS()
+//! @details call nufrkernel_lock_profile_enter()/_exit(), declared in
+//! @details nufr-platform.h, which time the outermost lock. Apps read
+//! @details results with nufr_lock_profile_get().
+//!
+
+#ifndef NUFR_KERNEL_LOCK_PROFILE_H
+#define NUFR_KERNEL_LOCK_PROFILE_H
+
+#include "nufr-global.h"
+#include "nufr-platform.h"
+#include "nufr-api.h"
+
+#if NUFR_CS_LOCK_PROFILE == 1
+
+//!
+//! @name      NUFR_LOCK_PROFILE_SITES
+//!
+//! @details   Max call sites tracked. Must be a power of 2.
+//!
+#ifndef NUFR_LOCK_PROFILE_SITES
+    #define NUFR_LOCK_PROFILE_SITES       64
+#endif
+
+#ifndef NUFR_LOCK_PROFILE_GLOBAL_DEFS
+extern nufr_lock_profile_site_t nufr_lock_profile_sites[NUFR_LOCK_PROFILE_SITES];
+extern uint32_t nufr_lock_profile_overflows;
+#endif
+
+#endif  //NUFR_CS_LOCK_PROFILE
+
+#endif  //NUFR_KERNEL_LOCK_PROFILE_H
@@ -35,14 +35,158 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "nufr-global.h"
 #include "nufr-kernel-base-messaging.h"
+#include "nufr-platform-app.h"
+#if NUFR_CS_MSG_BROADCAST == 1
+    #include "nufr-kernel-task.h"
+#endif
 
 #if NUFR_CS_MESSAGING == 1
 
+#if NUFR_CS_MSG_PAYLOAD == 1
+//!
+//! @struct   nufr_msg_payload_t
+//!
+//! @details  Inline-payload message block. Queued and freed as a
+//! @details  nufr_msg_t, so 'header' must be first. 'header.parameter'
+//! @details  holds the payload length, unless block is a broadcast
+//! @details  descriptor.
+//! @details
+//! @details  A broadcast descriptor is never queued itself: tcb link
+//! @details  entries refer to it. 'header' holds the fields and
+//! @details  parameter receivers get, 'refcount' the number of link
+//! @details  entries still queued.
+//!
+typedef struct
+{
+    nufr_msg_t  header;
+    uint16_t    length;
+#if NUFR_CS_MSG_BROADCAST == 1
+    uint16_t    refcount;
+#endif
+    uint8_t     payload[NUFR_MSG_PAYLOAD_SIZE];
+} nufr_msg_payload_t;
+
+//! @name      NUFR_IS_MSG_PAYLOAD_BLOCK
+//!
+//! @brief     Is msg block pointer from inline-payload pool?
+#define NUFR_IS_MSG_PAYLOAD_BLOCK(x)                                           \
+    ( ((nufr_msg_payload_t *)(x) >= nufr_msg_payload_bpool) &&                 \
+      ((nufr_msg_payload_t *)(x) <=                                            \
+                             &nufr_msg_payload_bpool[NUFR_MAX_PAYLOAD_MSGS - 1]) )
+#endif  //NUFR_CS_MSG_PAYLOAD
+
+#if NUFR_CS_MSG_BROADCAST == 1
+//! @name      NUFR_IS_MSG_BCAST_LINK
+//!
+//! @brief     Is msg block pointer a broadcast link entry in a tcb?
+#define NUFR_IS_MSG_BCAST_LINK(x)                                              \
+    ( ((const uint8_t *)(x) >= (const uint8_t *)nufr_tcb_block) &&           \
+      ((const uint8_t *)(x) < (const uint8_t *)&nufr_tcb_block[NUFR_NUM_TASKS]) )
+
+//! @name      NUFR_BCAST_LINK_TO_DESC
+//!
+//! @brief     Broadcast link entry to its descriptor
+#define NUFR_BCAST_LINK_TO_DESC(x)                                             \
+    ( &nufr_msg_payload_bpool[(x)->parameter - 1] )
+#endif  //NUFR_CS_MSG_BROADCAST
+
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+//!
+//! @name      NUFR_MSG_POOL_ISR_RESERVE
+//!
+//! @details   Free message blocks which only ISRs and senders of
+//! @details   NUFR_MSG_PRI_CONTROL messages may take. Override in
+//! @details   nufr-platform-app.h.
+//!
+#ifndef NUFR_MSG_POOL_ISR_RESERVE
+    #define NUFR_MSG_POOL_ISR_RESERVE    2
+#endif
+
+#if NUFR_MSG_POOL_ISR_RESERVE >= NUFR_MAX_MSGS
+    #error "NUFR_MSG_POOL_ISR_RESERVE must be less than NUFR_MAX_MSGS"
+#endif
+
+//!
+//! @enum      nufr_msg_caller_t
+//!
+//! @details   Who is allocating a message block
+//!
+typedef enum
+{
+    NUFR_MSG_CALLER_TASK = 0,    // task level, priority 1 and up
+    NUFR_MSG_CALLER_CONTROL,     // task level, NUFR_MSG_PRI_CONTROL
+    NUFR_MSG_CALLER_ISR,
+    NUFR_MSG_CALLER_max
+} nufr_msg_caller_t;
+
+//!
+//! @struct    nufr_msg_pool_stats_t
+//!
+//! @details   Message block pool statistics. Inline-payload pool isn't
+//! @details   included.
+//!
+typedef struct
+{
+    unsigned    free;                     // blocks free now
+    unsigned    in_use;                   // blocks allocated now
+    unsigned    low_water;                // fewest ever free
+    unsigned    alloc_fails[NUFR_MSG_CALLER_max];
+} nufr_msg_pool_stats_t;
+
+//! @name      NUFR_MSG_CALLER
+//!
+//! @brief     Caller class for a block to carry 'fields'
+#define NUFR_MSG_CALLER(fields)                                                \
+    ( NUFR_IS_ISR() ? NUFR_MSG_CALLER_ISR :                                    \
+      (0 == NUFR_GET_MSG_PRIORITY(fields)) ?                                   \
+           NUFR_MSG_CALLER_CONTROL : NUFR_MSG_CALLER_TASK )
+
+//! @name      NUFR_MSG_POOL_MAY_TAKE
+//!
+//! @brief     Can 'caller' take 'count' blocks? Interrupts locked.
+#define NUFR_MSG_POOL_MAY_TAKE(caller, count)                                  \
+    ( (NUFR_MSG_CALLER_TASK != (caller)) ?                                     \
+           (nufr_msg_pool_free >= (count)) :                                   \
+           (nufr_msg_pool_free >= (count) + NUFR_MSG_POOL_ISR_RESERVE) )
+
+//! @name      NUFR_MSG_POOL_TAKEN
+//!
+//! @brief     Accounts for 'count' blocks taken. Interrupts locked.
+#define NUFR_MSG_POOL_TAKEN(count)                                             \
+{                                                                              \
+    nufr_msg_pool_free -= (count);                                             \
+    if (nufr_msg_pool_free < nufr_msg_pool_low_water)                          \
+    {                                                                          \
+        nufr_msg_pool_low_water = nufr_msg_pool_free;                          \
+    }                                                                          \
+}
+
+//! @name      NUFR_MSG_POOL_RETURNED
+//!
+//! @brief     Accounts for a block freed. Interrupts locked.
+#define NUFR_MSG_POOL_RETURNED()         nufr_msg_pool_free++
+#else
+#define NUFR_MSG_POOL_TAKEN(count)
+#define NUFR_MSG_POOL_RETURNED()
+#endif  //NUFR_CS_MSG_POOL_RESERVE
+
 
 #ifndef NUFR_MESSAGE_BLOCKS_GLOBAL_DEFS
     extern nufr_msg_t *nufr_msg_free_head;
     extern nufr_msg_t *nufr_msg_free_tail;
     extern unsigned nufr_msg_pool_empty_count;
+  #if NUFR_CS_MSG_PAYLOAD == 1
+    extern nufr_msg_payload_t nufr_msg_payload_bpool[NUFR_MAX_PAYLOAD_MSGS];
+    extern nufr_msg_t *nufr_msg_payload_free_head;
+  #endif  //NUFR_CS_MSG_PAYLOAD
+  #if NUFR_CS_MSG_BROADCAST == 1
+    extern unsigned nufr_msg_bcast_overflow_count;
+  #endif  //NUFR_CS_MSG_BROADCAST
+  #if NUFR_CS_MSG_POOL_RESERVE == 1
+    extern unsigned nufr_msg_pool_free;
+    extern unsigned nufr_msg_pool_low_water;
+    extern unsigned nufr_msg_pool_alloc_fails[NUFR_MSG_CALLER_max];
+  #endif  //NUFR_CS_MSG_POOL_RESERVE
 #endif  //NUFR_MESSAGE_BLOCKS_GLOBAL_DEFS
 
 
@@ -52,6 +196,17 @@ void nufr_msg_bpool_init(void);
 nufr_msg_t *nufr_msg_get_block(void);
 void nufr_msg_free_block(nufr_msg_t *msg_ptr);
 unsigned nufr_msg_free_count(void);
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+void nufr_msg_pool_stats_get(nufr_msg_pool_stats_t *stats_ptr);
+void nufr_msg_pool_stats_reset(void);
+#endif  //NUFR_CS_MSG_POOL_RESERVE
+#if NUFR_CS_MSG_PAYLOAD == 1
+nufr_msg_t *nufr_msg_payload_get_block(void);
+unsigned nufr_msg_payload_free_count(void);
+#endif  //NUFR_CS_MSG_PAYLOAD
+#if NUFR_CS_MSG_BROADCAST == 1
+void nufrkernel_msg_bcast_release(nufr_msg_t *link);
+#endif  //NUFR_CS_MSG_BROADCAST
 
 RAGING_EXTERN_C_END
 
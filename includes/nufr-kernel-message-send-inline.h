@@ -60,6 +60,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! @details    1) Secondary context switches (NUFR_SECONDARY_CONTEXT_SWITCH())
 //! @details        This macro won't work on MSP430.
 //! @details    2) Abort messages (Task kill/'NUFR_CS_TASK_KILL', bop lock)
+//! @details    3) 'msg_queue_full_count'. A message to a queue at its
+//! @details        NUFR_CS_MSG_QUEUE_LIMIT limit is dropped, uncounted.
+//! @details    4) NUFR_CS_MSG_POOL_RESERVE. Macro may take reserved
+//! @details        blocks, and its fails aren't counted.
 //! @details   
 //! @details   To run faster, all input parameters should be constants or enums.
 //! @details   
@@ -97,8 +101,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     {                                                                          \
         KERNEL_REQUIRE_IL(NULL != nufr_msg_free_head);                         \
                                                                                \
-        /* Check that a message block is available */                          \
-        if (NULL != nufr_msg_free_head)                                        \
+        /* Check that a message block is available and queue has room */       \
+        if ((NULL != nufr_msg_free_head) &&                                    \
+            NUFR_MSG_QUEUE_HAS_ROOM(dest_tcb, msg_priority))                   \
         {                                                                      \
             /* Allocate block from pool. */                                    \
             msg_ptr = nufr_msg_free_head;                                      \
@@ -110,6 +115,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                 nufr_msg_pool_empty_count++;                                   \
                 KERNEL_REQUIRE_IL(false);                                      \
             }                                                                  \
+            NUFR_MSG_POOL_TAKEN(1);                                            \
                                                                                \
             /*** Populate msg_ptr block members */                             \
             msg_ptr->flink = NULL;                                             \
@@ -137,6 +143,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                                                                                \
             /* Finish stitching links */                                       \
             *tail_ptr = msg_ptr;                                               \
+            NUFR_MSG_INDEX_INC(dest_tcb, msg_ptr->fields);                     \
+            NUFR_MSG_DEPTH_INC(dest_tcb, msg_ptr->fields);                     \
                                                                                \
             /*** Unblock task if this warrants it */                           \
                                                                                \
@@ -195,8 +203,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     {                                                                          \
         KERNEL_REQUIRE_IL(NULL != nufr_msg_free_head);                         \
                                                                                \
-        /* Check that a message block is available */                          \
-        if (NULL != nufr_msg_free_head)                                        \
+        /* Check that a message block is available and queue has room */       \
+        if ((NULL != nufr_msg_free_head) &&                                    \
+            NUFR_MSG_QUEUE_HAS_ROOM(dest_tcb, msg_priority))                   \
         {                                                                      \
             /* Allocate block from pool. */                                    \
             msg_ptr = nufr_msg_free_head;                                      \
@@ -208,6 +217,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                 nufr_msg_pool_empty_count++;                                   \
                 KERNEL_REQUIRE_IL(false);                                      \
             }                                                                  \
+            NUFR_MSG_POOL_TAKEN(1);                                            \
                                                                                \
             /*** Populate msg_ptr block members */                             \
             msg_ptr->flink = NULL;                                             \
@@ -235,6 +245,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                                                                                \
             /* Finish stitching links */                                       \
             *tail_ptr = msg_ptr;                                               \
+            NUFR_MSG_INDEX_INC(dest_tcb, msg_ptr->fields);                     \
+            NUFR_MSG_DEPTH_INC(dest_tcb, msg_ptr->fields);                     \
                                                                                \
             /*** Unblock task if this warrants it */                           \
                                                                                \
@@ -41,9 +41,31 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-platform.h"
 #include "nufr-kernel-base-task.h"
 #include "nufr-kernel-task.h"
+#include "nufr-kernel-trace.h"
 
 #include "raging-contract.h"
 
+#if NUFR_CS_READY_LIST_BITMAP == 1
+
+// Bitmap ready list operations have no list walks, so there's
+// nothing to gain by inlining them: macros call the fcns.
+#define NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS                         \
+    bool      macro_do_switch
+
+#define NUFRKERNEL_ADD_TASK_TO_READY_LIST(m_tcb)                               \
+    macro_do_switch = nufrkernel_add_task_to_ready_list(m_tcb)
+
+#define NUFRKERNEL_BLOCK_RUNNING_TASK(m_block_flag)                            \
+    nufrkernel_block_running_task(m_block_flag)
+
+#define NUFRKERNEL_REMOVE_HEAD_TASK_FROM_READY_LIST()                          \
+    nufrkernel_remove_head_task_from_ready_list()
+
+#define NUFRKERNEL_DELETE_TASK_FROM_READY_LIST(m_tcb)                          \
+    nufrkernel_delete_task_from_ready_list(m_tcb)
+
+#else
+
 //! @name      NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS
 //
 //! @brief     Declarations for NUFRKERNEL_ADD_TASK_TO_READY_LIST
@@ -65,6 +87,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                                                                                \
     macro_priority = (m_tcb)->priority;                                        \
                                                                                \
+    NUFR_TRACE(NUFR_TRACE_READY_INSERT, NUFR_TRACE_TID(m_tcb),                 \
+               macro_priority, 0);                                             \
+                                                                               \
     if (NULL == nufr_ready_list)                                               \
     {                                                                          \
         if (NUFR_TPR_NOMINAL == macro_priority)                                \
@@ -195,7 +220,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                                      NUFR_TASK_BLOCKED_ASLEEP |                \
                                      NUFR_TASK_BLOCKED_BOP    |                \
                                      NUFR_TASK_BLOCKED_MSG    |                \
-                                     NUFR_TASK_BLOCKED_SEMA));                 \
+                                     NUFR_TASK_BLOCKED_SEMA   |                \
+                                     NUFR_TASK_BLOCKED_EVENT  |                \
+                                     NUFR_TASK_BLOCKED_MSG_SPACE));            \
     KERNEL_REQUIRE_IL(ANY_BITS_SET((m_block_flag), NUFR_TASK_NOT_LAUNCHED)?    \
             ARE_BITS_CLR((m_block_flag), NUFR_TASK_BLOCKED_ASLEEP |            \
                                      NUFR_TASK_BLOCKED_BOP    |                \
@@ -220,6 +247,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                                                                                \
     nufr_ready_list->block_flags = (m_block_flag);                             \
                                                                                \
+    NUFR_TRACE(NUFR_TRACE_BLOCK, NUFR_TRACE_TID(nufr_ready_list), 0,           \
+               (m_block_flag));                                                \
+                                                                               \
     next_tcb = nufr_ready_list->flink;                                         \
     nufr_ready_list->flink = NULL;                                             \
                                                                                \
@@ -261,6 +291,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     KERNEL_ENSURE_IL(NULL != nufr_ready_list);                                 \
     KERNEL_ENSURE_IL(NULL != nufr_ready_list_tail);                            \
                                                                                \
+    NUFR_TRACE(NUFR_TRACE_READY_REMOVE, NUFR_TRACE_TID(nufr_ready_list),       \
+               nufr_ready_list->priority, 0);                                  \
+                                                                               \
     next_tcb = nufr_ready_list->flink;                                         \
     nufr_ready_list->flink = NULL;                                             \
                                                                                \
@@ -345,6 +378,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     if (found_it && (NULL != this_tcb))                                        \
     {                                                                          \
                                                                                \
+    NUFR_TRACE(NUFR_TRACE_READY_REMOVE, NUFR_TRACE_TID(m_tcb),                 \
+               (m_tcb)->priority, 0);                                          \
+                                                                               \
     next_tcb = this_tcb->flink;                                                \
                                                                                \
     if ((m_tcb) == nufr_ready_list)                                            \
@@ -390,4 +426,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                nufr_ready_list->flink != NULL : true);                         \
 }
 
+#endif  // NUFR_CS_READY_LIST_BITMAP
+
 #endif  // NUFR_KERNEL_TASK_INLINES_H_
\ No newline at end of file
@@ -45,6 +45,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NUFR_IS_TCB(x)       ( ((x) >= nufr_tcb_block) &&                  \
                                ((x) <= &nufr_tcb_block[NUFR_NUM_TASKS - 1]) )
 
+#if NUFR_CS_READY_LIST_BITMAP == 1
+    // One bitmap bit and one head/tail pair per priority level
+    #define NUFR_READY_LIST_LEVELS       BITS_PER_WORD32
+    // Priority 0 is MSB, so CLZ yields highest priority populated
+    #define NUFR_READY_LIST_BIT(x)       ((uint32_t)0x80000000 >> (x))
+    #define NUFR_TPR_MAX_VALUE           (NUFR_READY_LIST_LEVELS - 1)
+#else
+    #define NUFR_TPR_MAX_VALUE           BIT_MASK8
+#endif
+
 #ifndef NUFR_TASK_GLOBAL_DEFS
 extern nufr_tcb_t nufr_tcb_block[NUFR_NUM_TASKS];
 
@@ -54,6 +64,20 @@ extern nufr_tcb_t *nufr_ready_list_tail_nominal;
 extern nufr_tcb_t *nufr_ready_list_tail;
 extern unsigned *nufr_bg_sp[NUFR_SP_INDEX_IN_TCB + 1];
 extern uint16_t nufr_bop_key;
+#if NUFR_CS_READY_LIST_BITMAP == 1
+extern uint32_t nufr_ready_list_bitmap;
+extern nufr_tcb_t *nufr_ready_list_heads[NUFR_READY_LIST_LEVELS];
+extern nufr_tcb_t *nufr_ready_list_tails[NUFR_READY_LIST_LEVELS];
+#endif
+#if NUFR_CS_TASK_STATS == 1
+extern nufr_task_stats_t nufr_bg_stats;
+extern uint32_t nufr_task_stats_timestamp;
+#endif
+#if NUFR_CS_TIME_SLICE == 1
+extern uint8_t nufr_time_slice_quantum[NUFR_TPR_MAX_VALUE + 1];
+extern nufr_tcb_t *nufr_time_slice_tcb;
+extern uint8_t nufr_time_slice_ticks;
+#endif
 
 // fixme (if possible): put here to prevent instead of in nufr-platform-import.h
 //  to prevent circular include problem
@@ -70,6 +94,19 @@ void nufrkernel_block_running_task(unsigned block_flag);
 void nufrkernel_remove_head_task_from_ready_list(void);
 void nufrkernel_delete_task_from_ready_list(nufr_tcb_t *tcb);
 void nufrkernel_exit_running_task(void);
+bool nufrkernel_change_task_priority(nufr_tcb_t *tcb, unsigned new_priority);
+#if NUFR_CS_READY_LIST_BITMAP == 1
+void nufrkernel_reprioritize_head_task(unsigned new_priority);
+#endif
+#if NUFR_CS_TASK_STATS == 1
+void nufrkernel_task_stats_switch(nufr_tcb_t *out_tcb, nufr_tcb_t *in_tcb);
+#endif
+#if NUFR_CS_TIME_SLICE == 1
+void nufrkernel_time_slice_tick(void);
+#endif
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+void nufrkernel_msg_space_unlink_task(nufr_tcb_t *delete_tcb);
+#endif
 RAGING_EXTERN_C_END
 
 #endif  //NUFR_KERNEL_TASK_H
\ No newline at end of file
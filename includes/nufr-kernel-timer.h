@@ -36,6 +36,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef NUFR_TIMER_GLOBAL_DEFS
 extern nufr_tcb_t *nufr_timer_list;
 extern nufr_tcb_t *nufr_timer_list_tail;
+extern uint32_t nufr_os_tick_count;
 #endif  //NUFR_TIMER_GLOBAL_DEFS
 
 RAGING_EXTERN_C_START
@@ -43,6 +44,10 @@ void nufrkernel_update_task_timers(void);
 void nufrkernel_add_to_timer_list(nufr_tcb_t *task,
                                   uint32_t    initial_timer_value);
 bool nufrkernel_purge_from_timer_list(nufr_tcb_t *task);
+#if NUFR_CS_TICKLESS_IDLE == 1
+void nufrkernel_update_task_timers_elapsed(uint32_t elapsed_ticks);
+uint32_t nufrkernel_ticks_to_next_timeout(void);
+#endif
 RAGING_EXTERN_C_END
 
 #endif  //NUFR_KERNEL_TIMER_H
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     nufr-kernel-trace.h
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief   Kernel event trace ring. Only exported to nufr platform
+//! @brief   and nufr kernel, but not to app layers
+//!
+//! @details Kernel hot paths write fixed-size binary records into a
+//! @details RAM ring. A writer claims its slot with an atomic increment
+//! @details of 'write_index', so no interrupt lock is held while the
+//! @details record is filled in, and ISRs can trace.
+//! @details
+//! @details A slot's 'sequence' is zeroed before the record is filled
+//! @details in, then set to the claimed index + 1 when it's complete.
+//! @details A reader only trusts slots whose 'sequence' matches the slot
+//! @details position, which discards torn records.
+//! @details
+//! @details The ring is dumped as a raw memory image (little-endian,
+//! @details as laid out below) and decoded off-target by
+//! @details tools/linux/nufr-trace-decode.
+//!
+
+#ifndef NUFR_KERNEL_TRACE_H
+#define NUFR_KERNEL_TRACE_H
+
+#include "nufr-global.h"
+#include "nufr-platform.h"
+#include "nufr-kernel-task.h"
+
+//!
+//! @name      NUFR_TRACE_MAGIC
+//!
+//! @details   "NTRC", first word of a ring image
+//!
+#define NUFR_TRACE_MAGIC              0x4E545243
+
+//!
+//! @name      NUFR_TRACE_RECORDS
+//!
+//! @details   Ring size, in records. Must be a power of 2.
+//!
+#ifndef NUFR_TRACE_RECORDS
+    #define NUFR_TRACE_RECORDS        256
+#endif
+
+//!
+//! @enum      nufr_trace_event_t
+//!
+//! @details   What 'tid', 'object_id' and 'param' hold, per event
+//!
+typedef enum
+{
+    NUFR_TRACE_NONE = 0,
+    NUFR_TRACE_READY_INSERT,    // task made ready, obj=priority
+    NUFR_TRACE_READY_REMOVE,    // task taken off ready list, obj=priority
+    NUFR_TRACE_BLOCK,           // running task blocked, param=block flag
+    NUFR_TRACE_TIMER_EXPIRE,    // task's timer expired, param=block flags
+    NUFR_TRACE_MSG_SEND,        // tid=dest, obj=msg id, param=msg fields
+    NUFR_TRACE_MSG_RECEIVE,     // tid=receiver, obj=msg id, param=fields
+    NUFR_TRACE_SEMA_GET,        // obj=sema, param=nufr_sema_get_rtn_t
+    NUFR_TRACE_SEMA_RELEASE,    // obj=sema, param=tasks woken
+    NUFR_TRACE_BOP_SEND,        // tid=dest, obj=key, param=nufr_bop_rtn_t
+    NUFR_TRACE_BOP_WAIT,        // obj=key, param=nufr_bop_wait_rtn_t
+    NUFR_TRACE_EVENT_SET,       // obj=event, param=flags after set
+    NUFR_TRACE_EVENT_WAIT,      // obj=event, param=nufr_event_wait_rtn_t
+    NUFR_TRACE_max
+} nufr_trace_event_t;
+
+//!
+//! @struct    nufr_trace_record_t
+//!
+//! @details   16 bytes. 'sequence' of 0 means slot empty or being written.
+//! @details   'timestamp' is in NUFR_TASK_STATS_TIMESTAMP() units.
+//! @details   A 'tid' of 0 is the BG task or an ISR.
+//!
+typedef struct
+{
+    uint32_t    timestamp;
+    uint32_t    sequence;
+    uint8_t     event;            // of 'nufr_trace_event_t'
+    uint8_t     tid;
+    uint16_t    object_id;
+    uint32_t    param;
+} nufr_trace_record_t;
+
+//!
+//! @struct    nufr_trace_ring_t
+//!
+//! @details   'write_index' is free-running. Slot = index modulo capacity.
+//!
+typedef struct
+{
+    uint32_t             magic;
+    uint16_t             capacity;
+    uint16_t             record_size;
+    volatile uint32_t    write_index;
+    nufr_trace_record_t  records[NUFR_TRACE_RECORDS];
+} nufr_trace_ring_t;
+
+//!
+//! @name      NUFR_TRACE_TID
+//!
+//! @details   TCB ptr to a record 'tid'. BG task and NULL map to 0.
+//!
+#define NUFR_TRACE_TID(tcb)                                            \
+    (NUFR_IS_TCB(tcb) ? (uint8_t)NUFR_TCB_TO_TID(tcb) : 0)
+
+//!
+//! @name      NUFR_TRACE
+//!
+//! @details   Trace point. Compiles out when NUFR_CS_TRACE is off.
+//!
+#if NUFR_CS_TRACE == 1
+    #define NUFR_TRACE(event, tid, object_id, param)                   \
+        nufr_trace_write((event), (tid), (object_id), (param))
+#else
+    #define NUFR_TRACE(event, tid, object_id, param)   ((void)0)
+#endif
+
+#if NUFR_CS_TRACE == 1
+
+#ifndef NUFR_TRACE_GLOBAL_DEFS
+extern nufr_trace_ring_t nufr_trace_ring;
+#endif
+
+//  APIs
+RAGING_EXTERN_C_START
+void nufr_trace_init(void);
+void nufr_trace_write(nufr_trace_event_t event,
+                      uint8_t            tid,
+                      uint16_t           object_id,
+                      uint32_t           param);
+RAGING_EXTERN_C_END
+
+#endif  //NUFR_CS_TRACE
+
+#endif  //NUFR_KERNEL_TRACE_H
@@ -31,6 +31,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! @brief     pthread layer which allows the nufr kernel+platform
 //! @brief     to run in a PC environment
 //!
+//! @details   With NUFR_CS_SIM_COROUTINE, the single-threaded
+//! @details   coroutine layer in nufr-simulation-coroutine.c is used
+//! @details   instead.
+//!
 
 #ifndef NUFR_SIMULATION_H_
 #define NUFR_SIMULATION_H_
@@ -39,6 +43,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 typedef void *(nufr_sim_generic_fcn_ptr)(void *);
 
+#if NUFR_CS_SIM_COROUTINE == 1
+#include "nufr-platform-import.h"
+
+extern unsigned nufr_sim_in_isr;
+extern uint64_t nufr_sim_virtual_ns;
+extern uint32_t nufr_sim_ticks;
+extern uint32_t nufr_sim_switch_count;
+extern uint32_t nufr_sim_stop_ticks;
+
+void nufr_sim_prepare_task(_IMPORT_stack_specifier_t *ptr);
+void nufr_sim_tick(void);
+void nufr_sim_unlocked(void);
+void nufr_sim_idle(void);
+#if NUFR_CS_TICKLESS_IDLE == 1
+void nufr_sim_fast_forward(void);
+#endif
+uint32_t nufr_sim_timestamp_us(void);
+#endif  //NUFR_CS_SIM_COROUTINE
+
 
 void *nufr_sim_launch_wrapper(void *arg_ptr);
 void nufr_sim_context_switch(void);
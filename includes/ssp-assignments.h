@@ -55,9 +55,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 typedef enum
 {
     SSP_DAPP_CLEAR_ECHO_REQUEST = 1,    // Clear-text loopback
-    SSP_DAPP_last = SSP_DAPP_CLEAR_ECHO_REQUEST,  // Last used
+    SSP_DAPP_CLEAR_TRACE_DUMP_REQUEST = 2,  // Send NUFR trace ring
+    SSP_DAPP_last = SSP_DAPP_CLEAR_TRACE_DUMP_REQUEST,  // Last used
 
     SSP_DAPP_CLEAR_ECHO_RESPONSE = SSP_DAPP_CLEAR_ECHO_REQUEST + SSP_DAPP_RESPONSE_OFFSET,
+      // Trace ring image, in pieces. See ssp_trace_dump_next().
+    SSP_DAPP_CLEAR_TRACE_DUMP_RESPONSE = SSP_DAPP_CLEAR_TRACE_DUMP_REQUEST + SSP_DAPP_RESPONSE_OFFSET,
 
 } ssp_dapp_wellknowns_t;
 
@@ -164,6 +164,10 @@ void ssp_tx_obtain_next_bytes(unsigned  channel_number,
                               uint8_t  *tx_holder,
                               unsigned  max_length,
                               unsigned *length_ptr);
+#if NUFR_CS_TRACE == 1
+ssp_buf_t *ssp_trace_dump_next(unsigned  channel_number,
+                               unsigned *offset_ptr);
+#endif
 
 RAGING_EXTERN_C_END
 
@@ -64,4 +64,194 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //!
 #define NUFR_CS_OPTIMIZATION_INLINES     0
 
+//!
+//! @brief    Compile switch: Ready List indexed by a priority bitmap
+//!
+//! @details  Adds per-priority head/tail pointers and a bitmap of
+//! @details  populated priorities, so that ready list inserts and
+//! @details  deletes never have to walk the list.
+//! @details  Task priorities are limited to 0-31 when enabled.
+//!
+#define NUFR_CS_READY_LIST_BITMAP        0
+
+//!
+//! @brief    Compile switch: Tickless idle
+//!
+//! @details  When the BG task idles, the OS tick is reprogrammed as a
+//! @details  one-shot which expires at the earliest kernel or SL timer
+//! @details  deadline. Ticks skipped over are accounted for on wakeup.
+//! @details  Not supported on MSP430, which has no OS tick.
+//!
+#define NUFR_CS_TICKLESS_IDLE            0
+
+//!
+//! @brief    Compile switch: Per-task CPU time and context switch stats
+//!
+//! @details  Context switch charges elapsed platform timestamp units
+//! @details  to the task switched out, counts switch-ins, and counts
+//! @details  whether the task was preempted or blocked. The BG task
+//! @details  is accounted for too, giving idle time.
+//! @details  Not supported on MSP430.
+//!
+#define NUFR_CS_TASK_STATS               0
+
+//!
+//! @brief    Compile switch: Kernel event trace ring
+//!
+//! @details  Kernel hot paths write fixed-size binary records into a
+//! @details  RAM ring (see nufr-kernel-trace.h). Decode a dump of the
+//! @details  ring with tools/linux/nufr-trace-decode.
+//! @details  Not supported on MSP430.
+//!
+#define NUFR_CS_TRACE                    0
+
+//!
+//! @brief    Compile switch: Interrupt lock hold time profiler
+//!
+//! @details  NUFR_LOCK_INTERRUPTS()/NUFR_UNLOCK_INTERRUPTS() note the
+//! @details  call site and time of the outermost lock. Hold time is
+//! @details  kept per site, as a max and a log2 histogram.
+//! @details  See nufr_lock_profile_get().
+//! @details  Not supported on MSP430.
+//!
+#define NUFR_CS_LOCK_PROFILE             0
+
+//!
+//! @brief    Compile switch: Round-robin time slicing
+//!
+//! @details  OS tick rotates the running task behind ready tasks of
+//! @details  its own priority once it has run for that priority's
+//! @details  quantum. See nufr_time_slice_set().
+//! @details  Not supported on MSP430, which has no periodic OS tick.
+//!
+#define NUFR_CS_TIME_SLICE               0
+
+//!
+//! @brief    Compile switch: Event flag groups
+//!
+//! @details  32 event flags per group. Flags can be set and cleared
+//! @details  from ISRs. Tasks wait for any or all of a set of flags.
+//!
+#define NUFR_CS_EVENT                    0
+
+//!
+//! @brief    Compile switch: Inline-payload messages
+//!
+//! @details  Second message block pool whose blocks carry up to
+//! @details  NUFR_MSG_PAYLOAD_SIZE bytes of data, copied in on send and
+//! @details  out on receive. Requires NUFR_CS_MESSAGING.
+//!
+#define NUFR_CS_MSG_PAYLOAD              0
+
+//!
+//! @brief    Compile switch: Reference-counted message broadcast
+//!
+//! @details  nufr_msg_broadcast() puts one shared descriptor, from the
+//! @details  inline-payload pool, on many tasks' queues through link
+//! @details  entries embedded in each tcb. Requires NUFR_CS_MSG_PAYLOAD.
+//!
+#define NUFR_CS_MSG_BROADCAST            0
+
+//!
+//! @brief    Compile switch: Per-task message index
+//!
+//! @details  Each tcb keeps counts of queued messages per priority and
+//! @details  per hash bucket of message prefix/ID. Lets nufr_msg_purge()
+//! @details  stop early, and nufr_msg_is_pending()/nufr_msg_send_coalesce()
+//! @details  answer without a queue walk in the common case.
+//!
+#define NUFR_CS_MSG_INDEX                0
+
+//!
+//! @brief    Compile switch: Message queue depth limits
+//!
+//! @details  Task descriptors can cap a task's queued message count,
+//! @details  in total and per priority. A send to a full queue fails
+//! @details  with NUFR_MSG_SEND_QUEUE_FULL, or waits for room with
+//! @details  nufr_msg_sendW()/nufr_msg_sendT(). Queue high-water marks
+//! @details  are kept in the tcb.
+//!
+#define NUFR_CS_MSG_QUEUE_LIMIT          0
+
+//!
+//! @brief    Compile switch: Message pool ISR reserve and statistics
+//!
+//! @details  The last NUFR_MSG_POOL_ISR_RESERVE free message blocks can
+//! @details  only be taken by ISRs and by senders of priority 0
+//! @details  messages. Pool usage, low-water mark and allocation
+//! @details  failures per caller class are kept. Platform must supply
+//! @details  NUFR_IS_ISR().
+//! @details  Not supported: no NUFR_IS_ISR() for msp430.
+//!
+#define NUFR_CS_MSG_POOL_RESERVE         0
+
+//!
+//! @brief    Compile switch: Atomic fast path for SL mutexes
+//!
+//! @details  An uncontended nsvc_mutex_getW()/getT()/release() takes
+//! @details  and drops ownership with a single compare-and-swap,
+//! @details  leaving the kernel semaphore alone. Only on contention is
+//! @details  the mutex handed over to its semaphore, for the wait list
+//! @details  and priority inheritance. Platform must supply
+//! @details  NUFR_ATOMIC_CAS32().
+//! @details  Off: no NUFR_ATOMIC_CAS32 on this platform.
+//!
+#define NUFR_CS_MUTEX_FAST_PATH          0
+
+//!
+//! @brief    Compile switch: SL deferred work queue
+//!
+//! @details  ISRs hand (function, argument) items to a worker task
+//! @details  through per-priority rings (nsvc-work.c), instead of
+//! @details  sending one message per interrupt. The worker runs items
+//! @details  in batches and keeps per-item latency statistics.
+//! @details  Platform must supply NUFR_ATOMIC_CAS32(),
+//! @details  NUFR_ATOMIC_FETCH_INC32() and NUFR_TASK_STATS_TIMESTAMP().
+//! @details  Off: no NUFR_ATOMIC_CAS32 or timestamp on this platform.
+//!
+#define NUFR_CS_DEFERRED_WORK            0
+
+//!
+//! @brief    Compile switch: SL timer slack
+//!
+//! @details  Adds an optional 'slack' to nsvc_timer_t: how late the
+//! @details  timer may fire. Timers whose windows overlap expire
+//! @details  together, at the earliest of their latest fire times,
+//! @details  saving quantum timer reprograms and wakeups.
+//! @details  Counters are kept (nsvc_timer_stats_get()).
+//! @details  Off here to keep nsvc_timer_t small.
+//!
+#define NUFR_CS_TIMER_SLACK              0
+
+//!
+//! @brief    Compile switch: SL timer callback delivery
+//!
+//! @details  An nsvc timer can call a function directly from the
+//! @details  expiry context instead of sending a message, or call it
+//! @details  and send the message only if it asks for one. See
+//! @details  'nsvc_timer_callback_fcn_ptr_t' for what the function
+//! @details  may do.
+//!
+#define NUFR_CS_TIMER_CALLBACK           1
+
+//!
+//! @brief    Compile switch: absolute sleeps and periodic tasks
+//!
+//! @details  Adds nufr_sleep_until() and the nufr_period_t helpers,
+//! @details  which wake a task on a fixed tick grid, so its execution
+//! @details  time and preemption delays don't accumulate as drift.
+//! @details  Off: overrun recovery needs a 32-bit divide.
+//!
+#define NUFR_CS_TASK_PERIOD              0
+
+//!
+//! @brief    Compile switch: SL pool bulk ops and lazy zeroing
+//!
+//! @details  Adds nsvc_pool_allocate_bulk()/nsvc_pool_free_bulk(),
+//! @details  which move many elements per interrupt lock, and the
+//! @details  'zero_size' pool member, which limits how much of an
+//! @details  element a task-level allocation clears.
+//!
+#define NUFR_CS_POOL_BULK                0
+
 #endif  //NUFR_COMPILE_SWITCHES_H
\ No newline at end of file
@@ -152,6 +152,11 @@ __attribute__((always_inline)) inline void int_disable(msp430_sr_reg_t status)
 
 #define _IMPORT_INTERRUPT_LOCK         int_lock
 #define _IMPORT_INTERRUPT_UNLOCK(y)    int_unlock(y)
+
+//!
+//! @brief   Count leading zeroes of 32-bit word. MSP430 has no CLZ instruction.
+//!
+#define _IMPORT_CLZ32(x)               ((unsigned)__builtin_clzl(x))
 #define _IMPORT_INTERRUPT_ENABLE       int_enable
 #define _IMPORT_INTERRUPT_DISABLE(y)   int_disable(y)
 
@@ -44,6 +44,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-kernel-message-blocks.h"
 #include "nufr-kernel-timer.h"
 #include "nufr-kernel-semaphore.h"
+#if NUFR_CS_EVENT == 1
+    #include "nufr-kernel-event.h"
+#endif
 #include "nufr-api.h"
 
 #include "raging-contract.h"
@@ -51,6 +54,26 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+    #error "NUFR_CS_TICKLESS_IDLE not supported on MSP430"
+#endif
+
+#if NUFR_CS_TASK_STATS == 1
+    #error "NUFR_CS_TASK_STATS not supported on MSP430"
+#endif
+
+#if NUFR_CS_TRACE == 1
+    #error "NUFR_CS_TRACE not supported on MSP430"
+#endif
+
+#if NUFR_CS_LOCK_PROFILE == 1
+    #error "NUFR_CS_LOCK_PROFILE not supported on MSP430"
+#endif
+
+#if NUFR_CS_TIME_SLICE == 1
+    #error "NUFR_CS_TIME_SLICE not supported on MSP430"
+#endif
+
 
 //  Implementing the onContractFailure method with a print statement
 //  to allow local debugging under commandline workflow
@@ -111,6 +134,11 @@ void nufr_init(void)
     nufr_ready_list = NULL;
     nufr_ready_list_tail = NULL;
     nufr_ready_list_tail_nominal = NULL;
+#if NUFR_CS_READY_LIST_BITMAP == 1
+    nufr_ready_list_bitmap = 0;
+    rutils_memset(nufr_ready_list_heads, 0, sizeof(nufr_ready_list_heads));
+    rutils_memset(nufr_ready_list_tails, 0, sizeof(nufr_ready_list_tails));
+#endif
     nufr_bop_key = 0;
     nufr_timer_list = NULL;
     nufr_timer_list_tail = NULL;
@@ -131,6 +159,11 @@ void nufr_init(void)
     }
 #endif  // NUFR_CS_SEMAPHORE
 
+#if NUFR_CS_EVENT == 1
+    // Event flag group inits
+    rutils_memset(nufr_event_block, 0, sizeof(nufr_event_block));
+#endif  // NUFR_CS_EVENT
+
 #if NUFR_CS_MESSAGING == 1
     // Init message bpool
     nufr_msg_bpool_init();
@@ -108,6 +108,13 @@ typedef _IMPORT_STATUS_REG_TYPE nufr_sr_reg_t;
   
 #define NUFR_LOCK_INTERRUPTS            _IMPORT_INTERRUPT_LOCK
 #define NUFR_UNLOCK_INTERRUPTS(x)       _IMPORT_INTERRUPT_UNLOCK(x)
+
+//!
+//! @def      NUFR_CLZ32
+//!
+//! @brief    Count leading zeroes of a 32-bit word. 'x' must be non-zero.
+//!
+#define NUFR_CLZ32(x)                   _IMPORT_CLZ32(x)
 
 // APIs
 void nufr_init(void);
@@ -1,5 +1,9 @@
+#include "nufr-global.h"
 #include "nufr-platform-import.h"
 #include "raging-global.h"
+#if NUFR_CS_SIM_COROUTINE == 1
+    #include "nufr-simulation.h"
+#endif
 
 #include "raging-utils-mem.h"
 
@@ -90,4 +94,9 @@ void Prepare_Stack(_IMPORT_stack_specifier_t *ptr)
     auto_save_regs_ptr->LR = 0xDEADBEEF;   // not used!
     auto_save_regs_ptr->PC = 0xDEADBEEF;
     auto_save_regs_ptr->PSR = 1 << 24;     // MUST set thumb bit==1 or will fault!
+
+#if NUFR_CS_SIM_COROUTINE == 1
+    // Stack above is never run from. Task runs as a coroutine.
+    nufr_sim_prepare_task(ptr);
+#endif
 }
\ No newline at end of file
@@ -39,17 +39,26 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-platform.h"
 #include "nufr-platform-app.h"
 #include "nufr-kernel-task.h"
+#include "nufr-kernel-trace.h"
 #include "nufr-kernel-base-semaphore.h"
 #include "nufr-kernel-base-messaging.h"
 #include "nufr-kernel-message-blocks.h"
 #include "nufr-kernel-timer.h"
 #include "nufr-kernel-semaphore.h"
+#if NUFR_CS_EVENT == 1
+    #include "nufr-kernel-event.h"
+#endif
 #include "nufr-api.h"
 
 #include "raging-contract.h"
 #include "raging-utils-mem.h"
 
 #include <stdio.h>
+#if (NUFR_CS_TICKLESS_IDLE == 1) || (NUFR_CS_TASK_STATS == 1) || \
+    (NUFR_CS_TRACE == 1) || (NUFR_CS_LOCK_PROFILE == 1) ||       \
+    (NUFR_CS_DEFERRED_WORK == 1)
+#include <time.h>
+#endif
 
 //  Implementing the onContractFailure method with a print statement
 //  to allow local debugging under commandline workflow
@@ -71,6 +80,29 @@ static uint8_t (*nufr_sl_timer_callback_fcn_ptr)(uint32_t, uint32_t *);
 //! @brief     For app timers
 uint32_t nufrplat_simulated_time;
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+//! @name      TICKLESS_MAX_TICKS
+//!
+//! @brief     Longest one-shot the simulated OS tick timer can be programmed for
+#define TICKLESS_MAX_TICKS            BIT_MASK16
+
+//! @name      nufr_sl_timer_deadline_fcn_ptr
+//!
+//! @brief     Service Layer callback reporting millisecs to next app timer
+static uint32_t (*nufr_sl_timer_deadline_fcn_ptr)(void);
+
+//! @name      nufrplat_oneshot_ticks
+//!
+//! @brief     Simulated OS tick timer: ticks it's programmed to expire in.
+//! @brief     A value of 1 means the timer is ticking periodically.
+uint32_t nufrplat_oneshot_ticks = 1;
+
+//! @name      nufrplat_oneshot_count
+//!
+//! @brief     Simulated OS tick timer: ticks elapsed since it was programmed
+uint32_t nufrplat_oneshot_count;
+#endif  // NUFR_CS_TICKLESS_IDLE
+
 //! @name      nufr_init
 //!
 //! @brief     Initializes the OS.
@@ -115,9 +147,25 @@ void nufr_init(void)
     nufr_ready_list = NULL;
     nufr_ready_list_tail = NULL;
     nufr_ready_list_tail_nominal = NULL;
+#if NUFR_CS_READY_LIST_BITMAP == 1
+    nufr_ready_list_bitmap = 0;
+    rutils_memset(nufr_ready_list_heads, 0, sizeof(nufr_ready_list_heads));
+    rutils_memset(nufr_ready_list_tails, 0, sizeof(nufr_ready_list_tails));
+#endif
     nufr_bop_key = 0;
     nufr_timer_list = NULL;
     nufr_timer_list_tail = NULL;
+#if NUFR_CS_TICKLESS_IDLE == 1
+    nufrplat_oneshot_ticks = 1;
+    nufrplat_oneshot_count = 0;
+#endif
+#if NUFR_CS_TASK_STATS == 1
+    rutils_memset(&nufr_bg_stats, 0, sizeof(nufr_bg_stats));
+    nufr_task_stats_timestamp = NUFR_TASK_STATS_TIMESTAMP();
+#endif
+#if NUFR_CS_TRACE == 1
+    nufr_trace_init();
+#endif
 
 #if NUFR_CS_SEMAPHORE == 1
     // Semaphore inits
@@ -135,12 +183,43 @@ void nufr_init(void)
     }
 #endif  // NUFR_CS_SEMAPHORE
 
+#if NUFR_CS_EVENT == 1
+    // Event flag group inits
+    rutils_memset(nufr_event_block, 0, sizeof(nufr_event_block));
+#endif  // NUFR_CS_EVENT
+
 #if NUFR_CS_MESSAGING == 1
     // Init message bpool
     nufr_msg_bpool_init();
 #endif  // NUFR_CS_MESSAGING
 }
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+//! @name      tickless_update_timers
+//
+//! @brief     Advances kernel and SL timers by one or more ticks
+//
+//! @param[in] elapsed_ticks-- OS ticks which have passed
+static void tickless_update_timers(uint32_t elapsed_ticks)
+{
+    uint32_t         next_timeout;
+    uint8_t          rc;
+
+#if NUFR_CS_EXCLUDING_OS_INTERNAL_TICKS == 0
+    nufrkernel_update_task_timers_elapsed(elapsed_ticks);
+#endif
+
+    if (NULL != nufr_sl_timer_callback_fcn_ptr)
+    {
+        nufrplat_simulated_time += NUFR_TICK_PERIOD * elapsed_ticks;
+
+        rc = (*nufr_sl_timer_callback_fcn_ptr)(nufrplat_simulated_time,
+                                               &next_timeout);
+        UNUSED(rc);          // suppress warning
+    }
+}
+#endif  // NUFR_CS_TICKLESS_IDLE
+
 //! @name      nufr_plat_systick_handler
 //
 //! @brief     Entry point for timer which is dedicated to OS clock
@@ -150,13 +229,26 @@ void nufr_init(void)
 //! @details   to it. It MUST call 'nufrkernel_update_task_timers()'.
 void nufrplat_systick_handler(void)
 {
+#if NUFR_CS_TICKLESS_IDLE == 1
+    uint32_t         elapsed_ticks;
+#else
     uint32_t         next_timeout;
     uint8_t          rc;
+#endif
 
     NUFR_SYSTICK_PREPROCESSING();
 
     // user-defined code (if any)
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+    // Account for every tick the timer was programmed for,
+    // then resume periodic ticking.
+    elapsed_ticks = nufrplat_oneshot_ticks;
+    nufrplat_oneshot_ticks = 1;
+    nufrplat_oneshot_count = 0;
+
+    tickless_update_timers(elapsed_ticks);
+#else
 #if NUFR_CS_EXCLUDING_OS_INTERNAL_TICKS == 0
     nufrkernel_update_task_timers();
 #endif
@@ -165,9 +257,15 @@ void nufrplat_systick_handler(void)
     {
         nufrplat_simulated_time += NUFR_TICK_PERIOD;
 
-        rc = (*nufr_sl_timer_callback_fcn_ptr)(NUFR_TICK_PERIOD, &next_timeout);
+        rc = (*nufr_sl_timer_callback_fcn_ptr)(nufrplat_simulated_time,
+                                               &next_timeout);
         UNUSED(rc);          // suppress warning
     }
+#endif  // NUFR_CS_TICKLESS_IDLE
+
+#if NUFR_CS_TIME_SLICE == 1
+    nufrkernel_time_slice_tick();
+#endif
 
     // user-defined code (if any)
 
@@ -195,6 +293,182 @@ void nufrplat_systick_sl_add_callback(uint8_t (*fcn_ptr)(uint32_t, uint32_t *))
     nufr_sl_timer_callback_fcn_ptr = fcn_ptr;
 }
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+//! @name      nufrplat_systick_sl_add_deadline_callback
+//
+//! @brief     Means for Service Layer timer to report its next expiration
+//
+//! @details   Callback returns millisecs until next app timer expires,
+//! @details   or 0 if no app timers are running.
+void nufrplat_systick_sl_add_deadline_callback(uint32_t (*fcn_ptr)(void))
+{
+    nufr_sl_timer_deadline_fcn_ptr = fcn_ptr;
+}
+
+//! @name      tickless_ticks_to_deadline
+//
+//! @brief     OS ticks until the earliest kernel or SL timer deadline
+//
+//! @details   Must be called with interrupts locked.
+//
+//! @return    0 if a task is ready to run, otherwise ticks (1 or more)
+//! @return    to program the one-shot for
+static uint32_t tickless_ticks_to_deadline(void)
+{
+    uint32_t ticks = 0;
+    uint32_t sl_ticks;
+
+    if (NULL != nufr_ready_list)
+    {
+        return 0;
+    }
+
+#if NUFR_CS_EXCLUDING_OS_INTERNAL_TICKS == 0
+    ticks = nufrkernel_ticks_to_next_timeout();
+#endif
+
+    if (NULL != nufr_sl_timer_deadline_fcn_ptr)
+    {
+        // Round up, so app timers are never checked early
+        sl_ticks = ((*nufr_sl_timer_deadline_fcn_ptr)() +
+                    NUFR_TICK_PERIOD - 1) / NUFR_TICK_PERIOD;
+
+        if ((0 != sl_ticks) && ((0 == ticks) || (sl_ticks < ticks)))
+        {
+            ticks = sl_ticks;
+        }
+    }
+
+    // No deadlines, or deadline beyond what timer can be programmed for
+    if ((0 == ticks) || (ticks > TICKLESS_MAX_TICKS))
+    {
+        ticks = TICKLESS_MAX_TICKS;
+    }
+
+    return ticks;
+}
+
+//! @name      nufrplat_sim_oneshot_clock
+//
+//! @brief     Simulated OS tick timer H/W: called once per tick period
+//
+//! @details   Invokes the OS tick handler when the one-shot expires.
+//! @details   When ticking periodically, that's every call.
+void nufrplat_sim_oneshot_clock(void)
+{
+    nufrplat_oneshot_count++;
+
+    if (nufrplat_oneshot_count >= nufrplat_oneshot_ticks)
+    {
+        nufrplat_systick_handler();
+    }
+}
+
+//! @name      nufrplat_tickless_idle
+//
+//! @brief     Called by the BG task when it has nothing to do
+//
+//! @details   If no task is ready, the OS tick timer is programmed as a
+//! @details   one-shot expiring at the earliest kernel task timeout or
+//! @details   SL app timer expiration, then the CPU waits for an interrupt.
+//! @details   If the one-shot expires, the OS tick handler accounts for
+//! @details   all ticks skipped. If some other interrupt wakes the CPU
+//! @details   first, ticks that elapsed are accounted for here and
+//! @details   periodic ticking resumes.
+//! @details   Simulated: the CPU waits by polling until the one-shot
+//! @details   expires or a task is made ready. Coroutine simulation:
+//! @details   virtual time jumps straight to the one-shot expiration.
+void nufrplat_tickless_idle(void)
+{
+    nufr_sr_reg_t          saved_psr;
+    uint32_t               ticks;
+#if NUFR_CS_SIM_COROUTINE == 0
+    const struct timespec  poll_interval = {0, NUFR_TICK_PERIOD * 100000};
+#endif
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    ticks = tickless_ticks_to_deadline();
+
+    // Nothing gained unless at least one tick gets skipped
+    if (ticks > 1)
+    {
+        nufrplat_oneshot_ticks = ticks;
+        nufrplat_oneshot_count = 0;
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    #if NUFR_CS_SIM_COROUTINE == 1
+        // Nothing else runs while BG idles: skip to the expiration
+        if ((nufrplat_oneshot_ticks > 1) && (NULL == nufr_ready_list))
+        {
+            nufr_sim_fast_forward();
+        }
+    #else
+        // Simulated wait-for-interrupt. The OS tick thread clocks
+        // the one-shot. Wake when it expires or a task is made ready.
+        while ((nufrplat_oneshot_ticks > 1) && (NULL == nufr_ready_list))
+        {
+            nanosleep(&poll_interval, NULL);
+        }
+    #endif
+
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        // Woken before one-shot expired? Account for ticks
+        // that elapsed and resume periodic ticking.
+        if (nufrplat_oneshot_ticks > 1)
+        {
+            ticks = nufrplat_oneshot_count;
+            nufrplat_oneshot_ticks = 1;
+            nufrplat_oneshot_count = 0;
+
+            if (ticks > 0)
+            {
+                tickless_update_timers(ticks);
+            }
+        }
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+}
+#endif  // NUFR_CS_TICKLESS_IDLE
+
+#if (NUFR_CS_TASK_STATS == 1) || (NUFR_CS_TRACE == 1) ||               \
+    (NUFR_CS_DEFERRED_WORK == 1)
+//! @name      nufrplat_timestamp_get
+//
+//! @brief     Timestamp for task stats: monotonic microsecs, wraps
+//
+//! @details   Coroutine simulation: virtual time, so runs repeat exactly
+uint32_t nufrplat_timestamp_get(void)
+{
+#if NUFR_CS_SIM_COROUTINE == 1
+    return nufr_sim_timestamp_us();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+#endif  // NUFR_CS_SIM_COROUTINE
+}
+#endif  // NUFR_CS_TASK_STATS || NUFR_CS_TRACE || NUFR_CS_DEFERRED_WORK
+
+#if NUFR_CS_LOCK_PROFILE == 1
+//! @name      nufrplat_timestamp_ns_get
+//
+//! @brief     Timestamp for lock profiling: monotonic nanosecs, wraps
+uint32_t nufrplat_timestamp_ns_get(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
+#endif  // NUFR_CS_LOCK_PROFILE
+
 // Needed?
 void nufrplat_task_exit_point(void)
 {
@@ -89,19 +89,126 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! @brief    For UT, just monitor counts, to detect a mismatch in
 //! @brief    lock/unlock pairs.
 //!
+//! @brief    With NUFR_CS_LOCK_PROFILE, 'saved_psr' holds lock depth,
+//! @brief    so the outermost lock can be timed.
+//!
+//! @brief    With NUFR_CS_SIM_COROUTINE, an unlock is where a pended
+//! @brief    context switch or a due OS tick is taken.
+//!
 typedef uint32_t nufr_register_t;       //!!! TBD
 typedef uint32_t nufr_sr_reg_t;
+#if NUFR_CS_LOCK_PROFILE == 1
+#define NUFR_LOCK_INTERRUPTS()                                         \
+    nufrkernel_lock_profile_enter(ut_interrupt_count++, __FILE__, __LINE__)
+#if NUFR_CS_SIM_COROUTINE == 1
+#define NUFR_UNLOCK_INTERRUPTS(x)                                      \
+    UNUSED(saved_psr), nufrkernel_lock_profile_exit(x),                \
+    ut_interrupt_count--, nufr_sim_unlocked()
+#else
+#define NUFR_UNLOCK_INTERRUPTS(x)                                      \
+    UNUSED(saved_psr), nufrkernel_lock_profile_exit(x), ut_interrupt_count--
+#endif
+#else
 #define NUFR_LOCK_INTERRUPTS()          ut_interrupt_count++
+#if NUFR_CS_SIM_COROUTINE == 1
+#define NUFR_UNLOCK_INTERRUPTS(x)                                      \
+    UNUSED(saved_psr), ut_interrupt_count--, nufr_sim_unlocked()
+#else
 #define NUFR_UNLOCK_INTERRUPTS(x)       UNUSED(saved_psr), ut_interrupt_count--
+#endif
+#endif
+
+//!
+//! @def      NUFR_CLZ32
+//!
+//! @brief    Count leading zeroes of a 32-bit word. 'x' must be non-zero.
+//!
+#define NUFR_CLZ32(x)                   ((unsigned)__builtin_clz(x))
+
+//!
+//! @def      NUFR_ATOMIC_FETCH_INC32
+//!
+//! @brief    Atomically increment a uint32_t, returning its prior value.
+//! @brief    Must be safe against ISRs without an interrupt lock.
+//!
+#define NUFR_ATOMIC_FETCH_INC32(ptr)                                   \
+    __atomic_fetch_add((ptr), 1, __ATOMIC_RELAXED)
+
+//!
+//! @def      NUFR_ATOMIC_CAS32
+//!
+//! @brief    Atomically replace a uint32_t holding 'expected' with
+//! @brief    'desired'. 'true' if swapped. No interrupt lock.
+//!
+#define NUFR_ATOMIC_CAS32(ptr, expected, desired)                      \
+    nufrplat_atomic_cas32((ptr), (expected), (desired))
+
+static inline bool nufrplat_atomic_cas32(volatile uint32_t *ptr,
+                                         uint32_t           expected,
+                                         uint32_t           desired)
+{
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+//!
+//! @def      NUFR_IS_ISR
+//!
+//! @brief    'true' if called from an ISR. pthread simulation has no
+//! @brief    ISRs: OS tick and other threads stand in at task level.
+//! @brief    Coroutine simulation runs the OS tick handler as an ISR.
+//!
+#if NUFR_CS_SIM_COROUTINE == 1
+    #define NUFR_IS_ISR()               (0 != nufr_sim_in_isr)
+#else
+    #define NUFR_IS_ISR()               (false)
+#endif
+
+//!
+//! @def      NUFR_TASK_STATS_TIMESTAMP
+//!
+//! @brief    Free-running 32-bit timestamp for task stats, in microsecs
+//!
+#define NUFR_TASK_STATS_TIMESTAMP()     nufrplat_timestamp_get()
+
+//!
+//! @def      NUFR_LOCK_PROFILE_TIMESTAMP
+//!
+//! @brief    Free-running 32-bit timestamp for lock profiling, in nanosecs.
+//! @brief    Most holds are well under a microsec.
+//!
+#define NUFR_LOCK_PROFILE_TIMESTAMP()   nufrplat_timestamp_ns_get()
 
 // For ut/sim only
 extern int ut_interrupt_count;
+#if NUFR_CS_TICKLESS_IDLE == 1
+extern uint32_t nufrplat_oneshot_ticks;
+extern uint32_t nufrplat_oneshot_count;
+#endif
 
 // APIs
 RAGING_EXTERN_C_START
 void nufr_init(void);
+#if NUFR_CS_LOCK_PROFILE == 1
+nufr_sr_reg_t nufrkernel_lock_profile_enter(nufr_sr_reg_t saved_psr,
+                                            const char   *file,
+                                            unsigned      line);
+void nufrkernel_lock_profile_exit(nufr_sr_reg_t saved_psr);
+#endif
 uint32_t nufrplat_systick_get_reference_time(void);
 void nufrplat_systick_sl_add_callback(uint8_t (*fcn_ptr)(uint32_t, uint32_t *));
+#if NUFR_CS_TICKLESS_IDLE == 1
+void nufrplat_systick_sl_add_deadline_callback(uint32_t (*fcn_ptr)(void));
+void nufrplat_tickless_idle(void);
+void nufrplat_sim_oneshot_clock(void);
+#endif
+#if (NUFR_CS_TASK_STATS == 1) || (NUFR_CS_TRACE == 1) ||               \
+    (NUFR_CS_DEFERRED_WORK == 1)
+uint32_t nufrplat_timestamp_get(void);
+#endif
+#if NUFR_CS_LOCK_PROFILE == 1
+uint32_t nufrplat_timestamp_ns_get(void);
+#endif
 const nufr_task_desc_t *nufrplat_task_get_desc(nufr_tcb_t *tcb,
                                                nufr_tid_t tid);
 void nufrplat_task_exit_point(void);
@@ -58,7 +58,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //!
 //! @brief    For UT, it just changes running task
 //!
+#if NUFR_CS_TASK_STATS == 1
+#define NUFR_INVOKE_CONTEXT_SWITCH()                                   \
+    nufrkernel_task_stats_switch(nufr_running, nufr_ready_list),       \
+    nufr_running = nufr_ready_list
+#else
 #define NUFR_INVOKE_CONTEXT_SWITCH()     nufr_running = nufr_ready_list
+#endif
 
 //!
 //! @def      NUFR_SECONDARY_CONTEXT_SWITCH
@@ -89,19 +95,107 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! @brief    For UT, just monitor counts, to detect a mismatch in
 //! @brief    lock/unlock pairs.
 //!
+//! @brief    With NUFR_CS_LOCK_PROFILE, 'saved_psr' holds lock depth,
+//! @brief    so the outermost lock can be timed.
+//!
 typedef uint32_t nufr_register_t;       //!!! TBD
 typedef uint32_t nufr_sr_reg_t;
+#if NUFR_CS_LOCK_PROFILE == 1
+#define NUFR_LOCK_INTERRUPTS()                                         \
+    nufrkernel_lock_profile_enter(ut_interrupt_count++,                \
+                                  __FILE__, __LINE__); UNUSED(saved_psr)
+#define NUFR_UNLOCK_INTERRUPTS(x)                                      \
+    nufrkernel_lock_profile_exit(x), ut_interrupt_count--
+#else
 #define NUFR_LOCK_INTERRUPTS()          ut_interrupt_count++; UNUSED(saved_psr)
 #define NUFR_UNLOCK_INTERRUPTS(x)       ut_interrupt_count--
+#endif
+
+//!
+//! @def      NUFR_CLZ32
+//!
+//! @brief    Count leading zeroes of a 32-bit word. 'x' must be non-zero.
+//!
+#define NUFR_CLZ32(x)                   ((unsigned)__builtin_clz(x))
+
+//!
+//! @def      NUFR_ATOMIC_FETCH_INC32
+//!
+//! @brief    Atomically increment a uint32_t, returning its prior value.
+//! @brief    Must be safe against ISRs without an interrupt lock.
+//!
+#define NUFR_ATOMIC_FETCH_INC32(ptr)                                   \
+    __atomic_fetch_add((ptr), 1, __ATOMIC_RELAXED)
+
+//!
+//! @def      NUFR_ATOMIC_CAS32
+//!
+//! @brief    Atomically replace a uint32_t holding 'expected' with
+//! @brief    'desired'. 'true' if swapped. No interrupt lock.
+//!
+#define NUFR_ATOMIC_CAS32(ptr, expected, desired)                      \
+    nufrplat_atomic_cas32((ptr), (expected), (desired))
+
+static inline bool nufrplat_atomic_cas32(volatile uint32_t *ptr,
+                                         uint32_t           expected,
+                                         uint32_t           desired)
+{
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+//!
+//! @def      NUFR_IS_ISR
+//!
+//! @brief    'true' if called from an ISR.
+//! @brief    For UT, a variable the test sets.
+//!
+#define NUFR_IS_ISR()                   (0 != nufrplat_sim_in_isr)
+
+//!
+//! @def      NUFR_TASK_STATS_TIMESTAMP
+//!
+//! @brief    Free-running 32-bit timestamp for task stats.
+//! @brief    For UT, a variable the test advances.
+//!
+#define NUFR_TASK_STATS_TIMESTAMP()     nufrplat_sim_timestamp
+
+//!
+//! @def      NUFR_LOCK_PROFILE_TIMESTAMP
+//!
+//! @brief    Free-running 32-bit timestamp for lock profiling
+//!
+#define NUFR_LOCK_PROFILE_TIMESTAMP()   nufrplat_sim_timestamp
 
 // For ut/sim only
 extern int ut_interrupt_count;
+extern unsigned nufrplat_sim_in_isr;
+#if NUFR_CS_TICKLESS_IDLE == 1
+extern uint32_t nufrplat_oneshot_ticks;
+extern uint32_t nufrplat_oneshot_count;
+extern uint32_t nufrplat_sim_wake_after_ticks;
+#endif
+#if (NUFR_CS_TASK_STATS == 1) || (NUFR_CS_TRACE == 1) || \
+    (NUFR_CS_LOCK_PROFILE == 1)
+extern uint32_t nufrplat_sim_timestamp;
+#endif
 
 // APIs
 RAGING_EXTERN_C_START
 void nufr_init(void);
+#if NUFR_CS_LOCK_PROFILE == 1
+nufr_sr_reg_t nufrkernel_lock_profile_enter(nufr_sr_reg_t saved_psr,
+                                            const char   *file,
+                                            unsigned      line);
+void nufrkernel_lock_profile_exit(nufr_sr_reg_t saved_psr);
+#endif
 uint32_t nufrplat_systick_get_reference_time(void);
 void nufrplat_systick_sl_add_callback(uint8_t (*fcn_ptr)(uint32_t, uint32_t *));
+#if NUFR_CS_TICKLESS_IDLE == 1
+void nufrplat_systick_sl_add_deadline_callback(uint32_t (*fcn_ptr)(void));
+void nufrplat_tickless_idle(void);
+void nufrplat_sim_oneshot_clock(void);
+#endif
 const nufr_task_desc_t *nufrplat_task_get_desc(nufr_tcb_t *tcb,
                                                nufr_tid_t tid);
 void nufrplat_task_exit_point(void);
@@ -96,14 +96,77 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 typedef _IMPORT_REGISTER_TYPE   nufr_register_t;     
 typedef _IMPORT_STATUS_REG_TYPE nufr_sr_reg_t;     
   
+#if NUFR_CS_LOCK_PROFILE == 1
+#define NUFR_LOCK_INTERRUPTS()                                         \
+    nufrkernel_lock_profile_enter(_IMPORT_INTERRUPT_LOCK(),            \
+                                  __FILE__, __LINE__)
+#define NUFR_UNLOCK_INTERRUPTS(x)                                      \
+    nufrkernel_lock_profile_exit(x), _IMPORT_INTERRUPT_UNLOCK(x)
+#else
 #define NUFR_LOCK_INTERRUPTS            _IMPORT_INTERRUPT_LOCK
 #define NUFR_UNLOCK_INTERRUPTS(x)       _IMPORT_INTERRUPT_UNLOCK(x)
+#endif
+
+//!
+//! @def      NUFR_CLZ32
+//!
+//! @brief    Count leading zeroes of a 32-bit word. 'x' must be non-zero.
+//!
+#define NUFR_CLZ32(x)                   _IMPORT_CLZ32(x)
+
+//!
+//! @def      NUFR_ATOMIC_FETCH_INC32
+//!
+//! @brief    Atomically increment a uint32_t, returning its prior value.
+//! @brief    Must be safe against ISRs without an interrupt lock.
+//!
+#define NUFR_ATOMIC_FETCH_INC32(ptr)    _IMPORT_ATOMIC_FETCH_INC32(ptr)
+
+//!
+//! @def      NUFR_ATOMIC_CAS32
+//!
+//! @brief    Atomically replace a uint32_t holding 'expected' with
+//! @brief    'desired'. 'true' if swapped. No interrupt lock.
+//!
+#define NUFR_ATOMIC_CAS32(ptr, expected, desired)                      \
+    _IMPORT_ATOMIC_CAS32((ptr), (expected), (desired))
+
+//!
+//! @def      NUFR_IS_ISR
+//!
+//! @brief    'true' if called from an ISR (exception handler)
+//!
+#define NUFR_IS_ISR()                   _IMPORT_IS_ISR()
+
+//!
+//! @def      NUFR_TASK_STATS_TIMESTAMP
+//!
+//! @brief    Free-running 32-bit timestamp for task stats
+//!
+#define NUFR_TASK_STATS_TIMESTAMP()     _IMPORT_TIMESTAMP()
+
+//!
+//! @def      NUFR_LOCK_PROFILE_TIMESTAMP
+//!
+//! @brief    Free-running 32-bit timestamp for lock profiling
+//!
+#define NUFR_LOCK_PROFILE_TIMESTAMP()   _IMPORT_TIMESTAMP()
 
 // APIs
 RAGING_EXTERN_C_START
 void nufr_init(void);
+#if NUFR_CS_LOCK_PROFILE == 1
+nufr_sr_reg_t nufrkernel_lock_profile_enter(nufr_sr_reg_t saved_psr,
+                                            const char   *file,
+                                            unsigned      line);
+void nufrkernel_lock_profile_exit(nufr_sr_reg_t saved_psr);
+#endif
 uint32_t nufrplat_systick_get_reference_time(void);
 void nufrplat_systick_sl_add_callback(uint8_t (*fcn_ptr)(uint32_t, uint32_t *));
+#if NUFR_CS_TICKLESS_IDLE == 1
+void nufrplat_systick_sl_add_deadline_callback(uint32_t (*fcn_ptr)(void));
+void nufrplat_tickless_idle(void);
+#endif
 const nufr_task_desc_t *nufrplat_task_get_desc(nufr_tcb_t *tcb,
                                                nufr_tid_t tid);
 void nufrplat_task_exit_point(void);
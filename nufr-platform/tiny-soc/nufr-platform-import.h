@@ -38,6 +38,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NUFR_PLATFORM_IMPORT_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // fixme: where does this get set??
 #define   ARM_CORTEX_M
@@ -184,6 +185,83 @@ __attribute__((always_inline)) inline void int_unlock(_IMPORT_REGISTER_TYPE stat
 #define _IMPORT_INTERRUPT_LOCK         int_lock
 #define _IMPORT_INTERRUPT_UNLOCK(y)    int_unlock(y)
 
+//!
+//! @brief   Atomic fetch-and-increment of a 32-bit word
+//!
+//! @details M0 has no LDREX/STREX, so PRIMASK is held across the
+//! @details read-modify-write. Unlike int_lock(), PRIMASK is saved and
+//! @details restored, so this nests inside a locked region. Compiler
+//! @details picks the register, which keeps clear of M0 high registers.
+//!
+__attribute__((always_inline)) inline uint32_t atomic_fetch_inc32(volatile uint32_t *ptr)
+{
+    uint32_t primask;
+    uint32_t old_value;
+
+    __asm volatile ("MRS %[pm], PRIMASK\n\t"
+                    "CPSID I"
+                    : [pm] "=r" (primask) :: "memory");
+    old_value = *ptr;
+    *ptr = old_value + 1;
+    __asm volatile ("MSR PRIMASK, %[pm]" :: [pm] "r" (primask) : "memory");
+
+    return old_value;
+}
+
+#define _IMPORT_ATOMIC_FETCH_INC32(ptr)  atomic_fetch_inc32(ptr)
+
+//!
+//! @brief   Atomic compare-and-swap of a 32-bit word
+//!
+//! @details PRIMASK held across the compare and store, as
+//! @details atomic_fetch_inc32().
+//!
+__attribute__((always_inline)) inline bool atomic_cas32(volatile uint32_t *ptr,
+                                                        uint32_t           expected,
+                                                        uint32_t           desired)
+{
+    uint32_t primask;
+    bool     swapped;
+
+    __asm volatile ("MRS %[pm], PRIMASK\n\t"
+                    "CPSID I"
+                    : [pm] "=r" (primask) :: "memory");
+    swapped = (*ptr == expected);
+    if (swapped)
+    {
+        *ptr = desired;
+    }
+    __asm volatile ("MSR PRIMASK, %[pm]" :: [pm] "r" (primask) : "memory");
+
+    return swapped;
+}
+
+#define _IMPORT_ATOMIC_CAS32(ptr, expected, desired)                  \
+    atomic_cas32((ptr), (expected), (desired))
+
+//!
+//! @brief   Count leading zeroes of 32-bit word
+//!
+//! @details Cortex M0 has no CLZ instruction, so on M0 this is a call
+//! @details to libgcc's __clzsi2(). M3/M4 get a single CLZ.
+//!
+#define _IMPORT_CLZ32(x)               ((unsigned)__builtin_clz(x))
+
+//!
+//! @brief   In exception context? IPSR holds the active exception
+//! @brief   number, 0 in thread mode.
+//!
+__attribute__((always_inline)) inline uint32_t get_ipsr(void)
+{
+    uint32_t ipsr;
+
+    __asm volatile ("MRS %[ipsr], IPSR" : [ipsr] "=r" (ipsr));
+
+    return ipsr;
+}
+
+#define _IMPORT_IS_ISR()               (0 != get_ipsr())
+
 
 //  Clock rate (Hz)
 //  For convenience only. This is the value used on QEMU.
@@ -196,6 +274,70 @@ __attribute__((always_inline)) inline void int_unlock(_IMPORT_REGISTER_TYPE stat
 //!
 #define _IMPORT_PENDSV_ACTIVATE  *(volatile uint32_t *)(0xE000ED04) = 0x10000000
 
+//!
+//! @brief   SysTick registers and one-shot support, for tickless idle
+//!
+//! @details SysTick counts CVR down to 0, pends its exception, then reloads
+//! @details from RVR. A one-shot is made by loading RVR with a count
+//! @details spanning several OS ticks. Reload is 24 bits wide, which
+//! @details limits how many ticks a one-shot can span.
+//!
+#define _IMPORT_SYSTICK_CSR          (*(volatile uint32_t *)(0xE000E010))
+#define _IMPORT_SYSTICK_RVR          (*(volatile uint32_t *)(0xE000E014))
+#define _IMPORT_SYSTICK_CVR          (*(volatile uint32_t *)(0xE000E018))
+#define _IMPORT_SYSTICK_ENABLE_BIT   0x00000001
+#define _IMPORT_SYSTICK_RELOAD_MAX   0x00FFFFFF
+#define _IMPORT_SYSTICK_PENDST_BIT   0x04000000   // in ICSR
+
+#define _IMPORT_SYSTICK_CYCLES_PER_TICK                                  \
+    ((uint32_t)(((uint64_t)_IMPORT_CPU_CLOCK_SPEED * NUFR_TICK_PERIOD)    \
+                / 1000))
+#define _IMPORT_SYSTICK_MAX_TICKS                                        \
+    (_IMPORT_SYSTICK_RELOAD_MAX / _IMPORT_SYSTICK_CYCLES_PER_TICK)
+
+#define _IMPORT_SYSTICK_STOP()                                           \
+    _IMPORT_SYSTICK_CSR &= ~_IMPORT_SYSTICK_ENABLE_BIT
+#define _IMPORT_SYSTICK_START()                                          \
+    _IMPORT_SYSTICK_CSR |= _IMPORT_SYSTICK_ENABLE_BIT
+#define _IMPORT_SYSTICK_IS_PENDING()                                     \
+    (0 != (*(volatile uint32_t *)(0xE000ED04) & _IMPORT_SYSTICK_PENDST_BIT))
+
+//!
+//! @brief   Wait for interrupt, with interrupts locked
+//!
+//! @details Any interrupt wakes the CPU, but isn't taken until interrupts
+//! @details are unlocked. Interrupts masked by BASEPRI can't wake the CPU,
+//! @details so all are masked with PRIMASK instead, across the WFI.
+//!
+#ifdef USE_PRIMASK
+#define _IMPORT_WAIT_FOR_INTERRUPT()                                     \
+    __asm volatile ("DSB\n\t"                                            \
+                    "WFI\n\t"                                            \
+                    "ISB" ::: "memory")
+#else
+#define _IMPORT_WAIT_FOR_INTERRUPT()                                     \
+    __asm volatile ("MRS r12, BASEPRI\n\t"                               \
+                    "CPSID I\n\t"                                        \
+                    "MSR BASEPRI, %[zero]\n\t"                           \
+                    "DSB\n\t"                                            \
+                    "WFI\n\t"                                            \
+                    "MSR BASEPRI, r12\n\t"                               \
+                    "CPSIE I\n\t"                                        \
+                    "ISB"                                                \
+                    :: [zero] "r" (0) : "r12", "memory")
+#endif
+
+//!
+//! @brief   Free-running 32-bit timestamp, for task stats
+//!
+//! @details Cortex M0 has no cycle counter. OS tick count is scaled to
+//! @details SysTick cycles, plus cycles into the current tick.
+//!
+#define _IMPORT_TIMESTAMP_INIT()
+#define _IMPORT_TIMESTAMP()                                              \
+    (nufr_tick_count_get() * _IMPORT_SYSTICK_CYCLES_PER_TICK +           \
+     (_IMPORT_SYSTICK_RVR - _IMPORT_SYSTICK_CVR))
+
 //!
 //! @brief   Alternative Context Switching
 //!
@@ -39,11 +39,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-platform.h"
 #include "nufr-platform-app.h"
 #include "nufr-kernel-task.h"
+#include "nufr-kernel-trace.h"
 #include "nufr-kernel-base-semaphore.h"
 #include "nufr-kernel-base-messaging.h"
 #include "nufr-kernel-message-blocks.h"
 #include "nufr-kernel-timer.h"
 #include "nufr-kernel-semaphore.h"
+#if NUFR_CS_EVENT == 1
+    #include "nufr-kernel-event.h"
+#endif
 #include "nufr-api.h"
 
 #include "raging-contract.h"
@@ -74,6 +78,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //    //fflush(stdout);
 //}
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+//! @name      nufrplat_oneshot_ticks
+//!
+//! @brief     OS ticks SysTick is programmed to expire in.
+//! @brief     A value of 1 means SysTick is ticking periodically.
+uint32_t nufrplat_oneshot_ticks = 1;
+#endif  // NUFR_CS_TICKLESS_IDLE
+
 //! @name      nufr_init
 //!
 //! @brief     Initializes the OS.
@@ -117,9 +129,28 @@ void nufr_init(void)
     nufr_ready_list = NULL;
     nufr_ready_list_tail = NULL;
     nufr_ready_list_tail_nominal = NULL;
+#if NUFR_CS_READY_LIST_BITMAP == 1
+    nufr_ready_list_bitmap = 0;
+    rutils_memset(nufr_ready_list_heads, 0, sizeof(nufr_ready_list_heads));
+    rutils_memset(nufr_ready_list_tails, 0, sizeof(nufr_ready_list_tails));
+#endif
     nufr_bop_key = 0;
     nufr_timer_list = NULL;
     nufr_timer_list_tail = NULL;
+#if NUFR_CS_TICKLESS_IDLE == 1
+    nufrplat_oneshot_ticks = 1;
+#endif
+#if (NUFR_CS_TASK_STATS == 1) || (NUFR_CS_TRACE == 1) || \
+    (NUFR_CS_LOCK_PROFILE == 1)
+    _IMPORT_TIMESTAMP_INIT();
+#endif
+#if NUFR_CS_TASK_STATS == 1
+    rutils_memset(&nufr_bg_stats, 0, sizeof(nufr_bg_stats));
+    nufr_task_stats_timestamp = NUFR_TASK_STATS_TIMESTAMP();
+#endif
+#if NUFR_CS_TRACE == 1
+    nufr_trace_init();
+#endif
 
 #if NUFR_CS_SEMAPHORE == 1
     // Semaphore inits
@@ -137,12 +168,33 @@ void nufr_init(void)
     }
 #endif  // NUFR_CS_SEMAPHORE
 
+#if NUFR_CS_EVENT == 1
+    // Event flag group inits
+    rutils_memset(nufr_event_block, 0, sizeof(nufr_event_block));
+#endif  // NUFR_CS_EVENT
+
 #if NUFR_CS_MESSAGING == 1
     // Init message bpool
     nufr_msg_bpool_init();
 #endif  // NUFR_CS_MESSAGING
 }
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+//! @name      tickless_update_timers
+//
+//! @brief     Advances kernel timers by one or more ticks
+//
+//! @param[in] elapsed_ticks-- OS ticks which have passed
+static void tickless_update_timers(uint32_t elapsed_ticks)
+{
+#if NUFR_CS_EXCLUDING_OS_INTERNAL_TICKS == 0
+    nufrkernel_update_task_timers_elapsed(elapsed_ticks);
+#else
+    UNUSED(elapsed_ticks);
+#endif
+}
+#endif  // NUFR_CS_TICKLESS_IDLE
+
 //! @name      nufr_plat_systick_handler
 //
 //! @brief     Entry point for timer which is dedicated to OS clock
@@ -154,12 +206,33 @@ void nufrplat_systick_handler(void)
 {
 //    uint32_t         next_timeout;
 //    uint8_t          rc;
+#if NUFR_CS_TICKLESS_IDLE == 1
+    uint32_t         elapsed_ticks;
+#endif
     NUFR_SYSTICK_PREPROCESSING();
 
-#if NUFR_CS_EXCLUDING_OS_INTERNAL_TICKS == 0
+#if NUFR_CS_TICKLESS_IDLE == 1
+    // One-shot expired: resume periodic ticking. Cycles spent
+    // getting here since expiration are lost, so OS time drifts
+    // slightly across each idle period.
+    if (nufrplat_oneshot_ticks > 1)
+    {
+        _IMPORT_SYSTICK_RVR = _IMPORT_SYSTICK_CYCLES_PER_TICK - 1;
+        _IMPORT_SYSTICK_CVR = 0;
+    }
+
+    elapsed_ticks = nufrplat_oneshot_ticks;
+    nufrplat_oneshot_ticks = 1;
+
+    tickless_update_timers(elapsed_ticks);
+#elif NUFR_CS_EXCLUDING_OS_INTERNAL_TICKS == 0
     nufrkernel_update_task_timers();
 #endif
 
+#if NUFR_CS_TIME_SLICE == 1
+    nufrkernel_time_slice_tick();
+#endif
+
     // user-defined code (if any)
 #if NUFR_CS_USING_OS_TICK_CALLIN == 1
     systick_callin();
@@ -171,6 +244,106 @@ void nufrplat_systick_handler(void)
 }
 
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+//! @name      tickless_ticks_to_deadline
+//
+//! @brief     OS ticks until the earliest kernel timer deadline
+//
+//! @details   Must be called with interrupts locked.
+//
+//! @return    0 if a task is ready to run, otherwise ticks (1 or more)
+//! @return    to program the one-shot for
+static uint32_t tickless_ticks_to_deadline(void)
+{
+    uint32_t ticks = 0;
+
+    if (NULL != nufr_ready_list)
+    {
+        return 0;
+    }
+
+#if NUFR_CS_EXCLUDING_OS_INTERNAL_TICKS == 0
+    ticks = nufrkernel_ticks_to_next_timeout();
+#endif
+
+    // No deadlines, or deadline beyond what SysTick can be programmed for
+    if ((0 == ticks) || (ticks > _IMPORT_SYSTICK_MAX_TICKS))
+    {
+        ticks = _IMPORT_SYSTICK_MAX_TICKS;
+    }
+
+    return ticks;
+}
+
+//! @name      nufrplat_tickless_idle
+//
+//! @brief     Called by the BG task when it has nothing to do
+//
+//! @details   If no task is ready, SysTick is programmed as a one-shot
+//! @details   expiring at the earliest kernel task timeout, then the CPU
+//! @details   waits for an interrupt.
+//! @details   If the one-shot expires, the SysTick handler accounts for
+//! @details   all ticks skipped. If some other interrupt wakes the CPU
+//! @details   first, whole ticks that elapsed are accounted for here and
+//! @details   periodic ticking resumes, keeping the partial tick.
+void nufrplat_tickless_idle(void)
+{
+    nufr_sr_reg_t    saved_psr;
+    uint32_t         ticks;
+    uint32_t         ticks_left;
+    uint32_t         cycles_left;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    ticks = tickless_ticks_to_deadline();
+
+    // Nothing gained unless at least one tick gets skipped.
+    // If a tick is already pending, let it be handled first.
+    if ((ticks > 1) && !_IMPORT_SYSTICK_IS_PENDING())
+    {
+        // One-shot spans the rest of the current tick
+        // plus 'ticks - 1' whole ticks.
+        _IMPORT_SYSTICK_STOP();
+        _IMPORT_SYSTICK_RVR = _IMPORT_SYSTICK_CVR +
+                    (ticks - 1) * _IMPORT_SYSTICK_CYCLES_PER_TICK - 1;
+        _IMPORT_SYSTICK_CVR = 0;
+        _IMPORT_SYSTICK_START();
+        nufrplat_oneshot_ticks = ticks;
+
+        _IMPORT_WAIT_FOR_INTERRUPT();
+
+        // Woken before one-shot expired?
+        if (!_IMPORT_SYSTICK_IS_PENDING())
+        {
+            _IMPORT_SYSTICK_STOP();
+
+            // Whole ticks still to go, after the one in progress
+            cycles_left = _IMPORT_SYSTICK_CVR;
+            ticks_left = (cycles_left - 1) / _IMPORT_SYSTICK_CYCLES_PER_TICK;
+
+            // Finish the tick in progress, then resume periodic ticking
+            _IMPORT_SYSTICK_RVR = cycles_left -
+                        ticks_left * _IMPORT_SYSTICK_CYCLES_PER_TICK - 1;
+            _IMPORT_SYSTICK_CVR = 0;
+            _IMPORT_SYSTICK_START();
+            _IMPORT_SYSTICK_RVR = _IMPORT_SYSTICK_CYCLES_PER_TICK - 1;
+
+            nufrplat_oneshot_ticks = 1;
+
+            ticks = ticks - 1 - ticks_left;
+            if (ticks > 0)
+            {
+                tickless_update_timers(ticks);
+            }
+        }
+
+        // else: SysTick handler runs once interrupts are unlocked
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+}
+#endif  // NUFR_CS_TICKLESS_IDLE
+
 // Needed?
 void nufrplat_task_exit_point(void)
 {
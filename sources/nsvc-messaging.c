@@ -345,17 +345,66 @@ nsvc_msg_send_argsW(nsvc_msg_prefix_t              prefix,
 //! @brief     Send a message to multiple tasks
 //!
 //! @details   Cannot be called from an ISR or from BG task
+//! @details   With NUFR_CS_MSG_BROADCAST, one reference-counted
+//! @details   descriptor is shared by all receivers (see
+//! @details   nufr_msg_broadcast()), so the bpool isn't drained by a
+//! @details   long destination list, and the fan-out is done under
+//! @details   one interrupt lock instead of with 'nufr_prioritize()'.
+//! @details   A receiver out of links gets a bpool block, as without
+//! @details   NUFR_CS_MSG_BROADCAST. A receiver not launched, with a
+//! @details   full queue, or not sent to for lack of blocks is skipped.
+//! @details   That's reported as NSVC_MSRT_PARTIAL.
 //!
 //! @param[in]  'fields'-- completely prepared nufr_msg_t->fields value
 //! @param[in]  'destination_list'-- List of tasks to send to
 //!
-//! @return      send status
+//! @return      send status. With NUFR_CS_MSG_BROADCAST,
+//! @return      NSVC_MSRT_PARTIAL if some, but not all, tasks were
+//! @return      sent to, NSVC_MSRT_ERROR if none were.
 //!
 nsvc_msg_send_return_t
 nsvc_msg_send_multi(uint32_t           fields,
                     uint32_t           optional_parameter,
                     nsvc_msg_lookup_t *destination_list)
 {
+#if NUFR_CS_MSG_BROADCAST == 1
+    nufr_tid_t          source_task;
+    unsigned            num_receivers;
+
+    SL_REQUIRE_API(destination_list->tid_list_length > 0);
+    SL_REQUIRE_API(NUFR_TID_null == destination_list->single_tid);
+
+    // BG Task?
+    if (NUFR_IS_TCB(nufr_running))
+    {
+        source_task = NUFR_TCB_TO_TID(nufr_running);
+    }
+    else
+    {
+        source_task = NUFR_TID_null;
+    }
+    // Poke source task into 'fields', keeping all other bits the same.
+    fields = NUFR_SET_MSG_SENDING_TASK(fields, source_task);
+
+    num_receivers = nufr_msg_broadcast(fields,
+                                       optional_parameter,
+                                       NULL,
+                                       0,
+                                       destination_list->tid_list_ptr,
+                                       destination_list->tid_list_length);
+
+    // No receiver was launched/had room, or blocks ran out
+    if (0 == num_receivers)
+    {
+        return NSVC_MSRT_ERROR;
+    }
+    else if (num_receivers < destination_list->tid_list_length)
+    {
+        return NSVC_MSRT_PARTIAL;
+    }
+
+    return NSVC_MSRT_OK;
+#else
     nufr_msg_t         *msg_holder_head_ptr = NULL;
     nufr_msg_t         *msg_holder_tail_ptr;
     nufr_msg_t         *msg;
@@ -373,11 +422,11 @@ nsvc_msg_send_multi(uint32_t           fields,
     // BG Task?
     if (NUFR_IS_TCB(nufr_running))
     {
-        source_task = NUFR_TID_null;
+        source_task = NUFR_TCB_TO_TID(nufr_running);
     }
     else
     {
-        source_task = NUFR_TCB_TO_TID(nufr_running);
+        source_task = NUFR_TID_null;
     }
     // Poke source task into 'fields', keeping all other bits the same.
     fields = NUFR_SET_MSG_SENDING_TASK(fields, source_task);
@@ -444,7 +493,8 @@ nsvc_msg_send_multi(uint32_t           fields,
 
         // This will occur is a destination task hasn't been launched,
         // which is a strong possibility.
-        if (NUFR_MSG_SEND_ERROR == send_status)
+        if ((NUFR_MSG_SEND_ERROR == send_status) ||
+            (NUFR_MSG_SEND_QUEUE_FULL == send_status))
         {
             // If send failed, must return block to pool to prevent memory leak
             nufr_msg_free_block(msg);
@@ -459,6 +509,7 @@ nsvc_msg_send_multi(uint32_t           fields,
     return_value = (nsvc_msg_send_return_t)send_status;
 
     return return_value;
+#endif  //NUFR_CS_MSG_BROADCAST
 }
 
 //!
@@ -525,6 +576,7 @@ nufr_bop_wait_rtn_t nsvc_msg_send_and_bop_waitW(
 
     // Make sure msg send was successful before bop wait    
     if ((NSVC_MSRT_ERROR != msg_send_rc) &&
+        (NSVC_MSRT_QUEUE_FULL != msg_send_rc) &&
         (NSVC_MSRT_DEST_NOT_FOUND != msg_send_rc))
     {
         bop_wait_rc = nufr_bop_waitW(abort_priority_of_rx_msg);
@@ -595,6 +647,7 @@ nufr_bop_wait_rtn_t nsvc_msg_send_and_bop_waitT(
 
     // Make sure msg send was successful before bop wait    
     if ((NSVC_MSRT_ERROR != msg_send_rc) &&
+        (NSVC_MSRT_QUEUE_FULL != msg_send_rc) &&
         (NSVC_MSRT_DEST_NOT_FOUND != msg_send_rc))
     {
         bop_wait_rc = nufr_bop_waitT(abort_priority_of_rx_msg, timeout_ticks);
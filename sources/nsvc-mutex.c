@@ -26,6 +26,24 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! @file    nsvc-mutex.c
 //! @authors Bernie Woodland
 //! @date    17Sep17
+//!
+//! @details With NUFR_CS_MUTEX_FAST_PATH, 'owner' of a mutex block
+//! @details is the single word uncontended gets/releases swap with
+//! @details NUFR_ATOMIC_CAS32():
+//! @details     0                     free
+//! @details     tid                   held by 'tid', sema not involved
+//! @details     NSVC_MUTEX_INFLATED   contended: sema is authoritative
+//! @details A task which finds the mutex held inflates it: the sema's
+//! @details count and owner are set as if the holder had taken the sema,
+//! @details and the task waits on the sema, with priority inheritance.
+//! @details A release which leaves the sema free, with no task on its
+//! @details wait list, deflates it back to free. So a waiter which is
+//! @details killed, or times out, leaves nothing behind.
+//! @details A task preempted between inflating and getting the sema can
+//! @details find the mutex deflated, and maybe taken by CAS, by the time
+//! @details it gets the sema. It checks, once it has the sema, that the
+//! @details sema still stands for the mutex, and if not, hands the sema
+//! @details to the CAS holder and waits again.
 
 
 #include "nufr-global.h"
@@ -34,6 +52,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nsvc.h"
 #include "nufr-api.h"
 #include "nufr-kernel-semaphore.h"
+#include "nufr-kernel-task.h"
 #include "nufr-platform-app.h"
 
 #include "raging-contract.h"
@@ -46,8 +65,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 typedef struct
 {
     nufr_sema_t        sema;
+#if NUFR_CS_MUTEX_FAST_PATH == 1
+    volatile uint32_t  owner;
+#endif  //NUFR_CS_MUTEX_FAST_PATH
 } nsvc_mutex_block_t;
 
+//!
+//!  @name        NSVC_MUTEX_INFLATED
+//!
+//!  @brief       'owner' value: sema holds mutex state
+//!
+#define NSVC_MUTEX_INFLATED         0xFFFFFFFF
+
 //!
 //!  @name        NSVC_MUTEX_ID_TO_BLOCK
 //!  @name        NSVC_MUTEX_BLOCK_TO_ID
@@ -99,10 +128,124 @@ static void nsvc_mutex_init_single_sema(nsvc_mutex_t mutex)
     UNUSED_BY_ASSERT(alloc_rv);
 
     mutex_block->sema = sema;
+#if NUFR_CS_MUTEX_FAST_PATH == 1
+    mutex_block->owner = 0;
+#endif  //NUFR_CS_MUTEX_FAST_PATH
 
     nufrkernel_sema_reset(NUFR_SEMA_ID_TO_BLOCK(sema), 1, true);
 }
 
+#if NUFR_CS_MUTEX_FAST_PATH == 1
+//! @name      nsvc_mutex_enter_wait
+//!
+//! @brief     Slow path of a get, after the CAS failed.
+//!
+//! @details   If the mutex was freed in the meantime, takes it.
+//! @details   Otherwise, inflates it if the holder got it by CAS.
+//! @details   Caller must then get the sema and call
+//! @details   'nsvc_mutex_exit_wait()'.
+//!
+//! @param[in] 'mutex_block'
+//!
+//! @return    'true' if mutex was taken, no sema wait needed
+//!
+static bool nsvc_mutex_enter_wait(nsvc_mutex_block_t *mutex_block)
+{
+    nufr_sr_reg_t      saved_psr;
+    nufr_sema_block_t *sema_block;
+    uint32_t           owner;
+    bool               taken = false;
+
+    sema_block = NUFR_SEMA_ID_TO_BLOCK(mutex_block->sema);
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    owner = mutex_block->owner;
+    if (0 == owner)
+    {
+        mutex_block->owner = NUFR_TCB_TO_TID(nufr_running);
+        taken = true;
+    }
+    else
+    {
+        if (NSVC_MUTEX_INFLATED != owner)
+        {
+            // Recursive get would deadlock
+            SL_REQUIRE_IL(NUFR_TID_TO_TCB(owner) != nufr_running);
+
+            // Hand holder's ownership to the sema. Sema may already be
+            //   taken by a task which waited across a deflate: it'll see
+            //   it's no longer the owner.
+            sema_block->count = 0;
+            sema_block->owner_tcb = NUFR_TID_TO_TCB(owner);
+            mutex_block->owner = NSVC_MUTEX_INFLATED;
+        }
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    return taken;
+}
+
+//! @name      nsvc_mutex_exit_wait
+//!
+//! @brief     Once the sema get returns, checks the sema still stands
+//! @brief     for the mutex.
+//!
+//! @details   Mutex may have been deflated between
+//! @details   'nsvc_mutex_enter_wait()' and the sema get. If no one
+//! @details   took it since, caller's sema makes it the owner again.
+//! @details   If a task took it by CAS, the sema is handed to that
+//! @details   task, as an inflate would. If a task re-inflated it,
+//! @details   caller no longer owns the sema.
+//!
+//! @param[in] 'mutex_block'
+//! @param[in] 'get_rv'-- sema get's return value
+//!
+//! @return    'false' if caller must retry the get
+//!
+static bool nsvc_mutex_exit_wait(nsvc_mutex_block_t *mutex_block,
+                                 nufr_sema_get_rtn_t get_rv)
+{
+    nufr_sr_reg_t      saved_psr;
+    nufr_sema_block_t *sema_block;
+    uint32_t           owner;
+    bool               is_owner;
+
+    // Timeout or abort: nothing was taken
+    if ((NUFR_SEMA_GET_OK_NO_BLOCK != get_rv) &&
+        (NUFR_SEMA_GET_OK_BLOCK != get_rv))
+    {
+        return true;
+    }
+
+    sema_block = NUFR_SEMA_ID_TO_BLOCK(mutex_block->sema);
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    owner = mutex_block->owner;
+    is_owner = (sema_block->owner_tcb == nufr_running);
+
+    if (is_owner && (NSVC_MUTEX_INFLATED != owner))
+    {
+        if (0 == owner)
+        {
+            mutex_block->owner = NSVC_MUTEX_INFLATED;
+        }
+        else
+        {
+            sema_block->owner_tcb = NUFR_TID_TO_TCB(owner);
+            mutex_block->owner = NSVC_MUTEX_INFLATED;
+            is_owner = false;
+        }
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    return is_owner;
+}
+#endif  //NUFR_CS_MUTEX_FAST_PATH
+
 //! @name      nsvc_mutex_init
 //!
 //! @brief     Initialize all mutexes. Called by common SL init fcn.
@@ -147,7 +290,27 @@ nufr_sema_get_rtn_t nsvc_mutex_getW(nsvc_mutex_t   mutex,
     SL_REQUIRE_API(NSVC_IS_MUTEX_BLOCK(mutex_block));
     SL_REQUIRE_API(NUFR_IS_SEMA_BLOCK(NUFR_SEMA_ID_TO_BLOCK(mutex_block->sema)));
 
+#if NUFR_CS_MUTEX_FAST_PATH == 1
+    SL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+
+    do
+    {
+        if (NUFR_ATOMIC_CAS32(&mutex_block->owner, 0,
+                              NUFR_TCB_TO_TID(nufr_running)))
+        {
+            return NUFR_SEMA_GET_OK_NO_BLOCK;
+        }
+
+        if (nsvc_mutex_enter_wait(mutex_block))
+        {
+            return NUFR_SEMA_GET_OK_NO_BLOCK;
+        }
+
+        rv = nufr_sema_getW(mutex_block->sema, abort_priority_of_rx_msg);
+    } while (!nsvc_mutex_exit_wait(mutex_block, rv));
+#else
     rv = nufr_sema_getW(mutex_block->sema, abort_priority_of_rx_msg);
+#endif  //NUFR_CS_MUTEX_FAST_PATH
 
     return rv;
 }
@@ -177,8 +340,30 @@ nufr_sema_get_rtn_t nsvc_mutex_getT(nsvc_mutex_t   mutex,
     SL_REQUIRE_API(NSVC_IS_MUTEX_BLOCK(mutex_block));
     SL_REQUIRE_API(NUFR_IS_SEMA_BLOCK(NUFR_SEMA_ID_TO_BLOCK(mutex_block->sema)));
 
+#if NUFR_CS_MUTEX_FAST_PATH == 1
+    SL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+
+    // A retry waits 'timeout_ticks' again
+    do
+    {
+        if (NUFR_ATOMIC_CAS32(&mutex_block->owner, 0,
+                              NUFR_TCB_TO_TID(nufr_running)))
+        {
+            return NUFR_SEMA_GET_OK_NO_BLOCK;
+        }
+
+        if (nsvc_mutex_enter_wait(mutex_block))
+        {
+            return NUFR_SEMA_GET_OK_NO_BLOCK;
+        }
+
+        rv = nufr_sema_getT(mutex_block->sema, abort_priority_of_rx_msg,
+                            timeout_ticks);
+    } while (!nsvc_mutex_exit_wait(mutex_block, rv));
+#else
     rv = nufr_sema_getT(mutex_block->sema, abort_priority_of_rx_msg,
                         timeout_ticks);
+#endif  //NUFR_CS_MUTEX_FAST_PATH
 
     return rv;
 }
@@ -199,12 +384,48 @@ bool nsvc_mutex_release(nsvc_mutex_t mutex)
 {
     nsvc_mutex_block_t  *mutex_block;
     bool                 rv;
+#if NUFR_CS_MUTEX_FAST_PATH == 1
+    nufr_sr_reg_t        saved_psr;
+    nufr_sema_block_t   *sema_block;
+#endif  //NUFR_CS_MUTEX_FAST_PATH
 
     mutex_block = NSVC_MUTEX_ID_TO_BLOCK(mutex);
     SL_REQUIRE_API(NSVC_IS_MUTEX_BLOCK(mutex_block));
     SL_REQUIRE_API(NUFR_IS_SEMA_BLOCK(NUFR_SEMA_ID_TO_BLOCK(mutex_block->sema)));
 
+#if NUFR_CS_MUTEX_FAST_PATH == 1
+    if (NUFR_ATOMIC_CAS32(&mutex_block->owner,
+                          NUFR_TCB_TO_TID(nufr_running), 0))
+    {
+        return false;
+    }
+
+    SL_REQUIRE_API(NSVC_MUTEX_INFLATED == mutex_block->owner);
+
+    rv = nufr_sema_release(mutex_block->sema);
+
+    // Deflate if sema is free and no one is waiting.
+    // If the sema was handed to a waiter, it can't be free.
+    // A woken waiter may already have run and taken the sema.
+    // One about to wait sorts itself out in 'nsvc_mutex_exit_wait()'.
+    if (!rv)
+    {
+        sema_block = NUFR_SEMA_ID_TO_BLOCK(mutex_block->sema);
+
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        if ((NSVC_MUTEX_INFLATED == mutex_block->owner) &&
+            (NULL == sema_block->task_list_head) &&
+            (sema_block->count == 1))
+        {
+            mutex_block->owner = 0;
+        }
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+    }
+#else
     rv = nufr_sema_release(mutex_block->sema);
+#endif  //NUFR_CS_MUTEX_FAST_PATH
 
     return rv;
 }
\ No newline at end of file
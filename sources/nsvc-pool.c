@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-platform.h"
 #include "nufr-platform-app.h"
 #include "nufr-kernel-semaphore.h"
+#include "nufr-kernel-task.h"
 
 #include "raging-contract.h"
 #include "raging-utils-mem.h"
@@ -52,6 +53,24 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SUCCESS_ALLOC(rv)     ( (NUFR_SEMA_GET_OK_NO_BLOCK == (rv)) ||       \
                                 (NUFR_SEMA_GET_OK_BLOCK == (rv)) )
 
+//!
+//! @name      pool_element_clear
+//!
+//! @brief     Task-level clearing of a newly allocated element
+//!
+//! @details   With NUFR_CS_POOL_BULK, only the pool's 'zero_size'
+//! @details   leading bytes are cleared, plus the flink.
+//!
+static void pool_element_clear(nsvc_pool_t *pool_ptr, void *element_ptr)
+{
+#if NUFR_CS_POOL_BULK == 1
+    *NSVC_POOL_FLINK_PTR(pool_ptr, element_ptr) = NULL;
+    rutils_memset(element_ptr, 0, pool_ptr->zero_size);
+#else
+    rutils_memset(element_ptr, 0, pool_ptr->element_size);
+#endif
+}
+
 //!
 //! @name      nsvc_pool_init
 //!
@@ -64,6 +83,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! @param[in]       ->element_index_size
 //! @param[in]       ->base_ptr
 //! @param[in]       ->flink_offset
+//! @param[in]       ->zero_size (optional, NUFR_CS_POOL_BULK only)
 //! @param[in]    Caller must clear all other members
 //!
 void nsvc_pool_init(nsvc_pool_t *pool_ptr)
@@ -81,14 +101,29 @@ void nsvc_pool_init(nsvc_pool_t *pool_ptr)
     SL_REQUIRE_API(pool_ptr->element_index_size - pool_ptr->element_size < BYTES_PER_WORD32);
     SL_REQUIRE_API(pool_ptr->flink_offset <= (pool_ptr->element_size - BYTES_PER_WORD32));
     SL_REQUIRE_API(ALIGN32(pool_ptr->flink_offset) == pool_ptr->flink_offset);
+#if NUFR_CS_POOL_BULK == 1
+    SL_REQUIRE_API((NSVC_POOL_ZERO_NONE == pool_ptr->zero_size) ||
+                   (pool_ptr->zero_size <= pool_ptr->element_size));
+
+    // From caller's setting to bytes to clear
+    if (0 == pool_ptr->zero_size)
+    {
+        pool_ptr->zero_size = pool_ptr->element_size;
+    }
+    else if (NSVC_POOL_ZERO_NONE == pool_ptr->zero_size)
+    {
+        pool_ptr->zero_size = 0;
+    }
+#endif  //NUFR_CS_POOL_BULK
 
     rv = nsvc_sema_pool_alloc(&pool_ptr->sema);
     SL_REQUIRE_API(rv);
     UNUSED_BY_ASSERT(rv);
     pool_ptr->sema_block = NUFR_SEMA_ID_TO_BLOCK(pool_ptr->sema);
 
-    // One sema count per block in pool. No mutual exclusion possible.
-    nufrkernel_sema_reset(pool_ptr->sema_block, NUFR_MAX_MSGS, false);
+    // One sema count per block in pool, added as each is freed below.
+    // No mutual exclusion possible.
+    nufrkernel_sema_reset(pool_ptr->sema_block, 0, false);
 
     // Clear entire element array
     rutils_memset(pool_ptr->base_ptr, 0,
@@ -284,9 +319,9 @@ void *nsvc_pool_allocate(nsvc_pool_t *pool_ptr, bool called_from_ISR)
         }
         else
         {
-            rutils_memset(element_ptr, 0, pool_ptr->element_size);
+            pool_element_clear(pool_ptr, element_ptr);
 
-            // above memset will have cleared element's flink
+            // above clear will have cleared element's flink
             SL_REQUIRE(NULL == *NSVC_POOL_FLINK_PTR(pool_ptr, element_ptr));
         }
     }
@@ -380,4 +415,152 @@ nufr_sema_get_rtn_t nsvc_pool_allocateT(nsvc_pool_t   *pool_ptr,
     }
 
     return return_value;
-}
\ No newline at end of file
+}
+
+#if NUFR_CS_POOL_BULK == 1
+//!
+//! @name      nsvc_pool_allocate_bulk
+//!
+//! @brief     Allocate up to 'count' elements with one interrupt lock
+//!
+//! @details   Callable from ISR. No blocking.
+//! @details   The pool sema is decremented here, once, so don't
+//! @details   get the sema first.
+//!
+//! @param[in]  'pool_ptr'--
+//! @param[out] 'element_ptrs'-- array of 'count' entries, filled
+//! @param[out]       in with elements allocated
+//! @param[in]  'count'--
+//! @param[in]  'called_from_ISR'-- as with 'nsvc_pool_allocate()',
+//! @param[in]       skips clearing elements, except for their flinks.
+//! @param[in]       Otherwise they're cleared per the pool's 'zero_size'.
+//!
+//! @return    Number of elements allocated. Fewer than 'count' if
+//! @return    pool ran short.
+//!
+unsigned nsvc_pool_allocate_bulk(nsvc_pool_t  *pool_ptr,
+                                 void        **element_ptrs,
+                                 unsigned      count,
+                                 bool          called_from_ISR)
+{
+    nufr_sr_reg_t     saved_psr;
+    void             *element_ptr;
+    unsigned          taken;
+    unsigned          i;
+
+    SL_REQUIRE_API(NULL != pool_ptr);
+    SL_REQUIRE_API(NULL != element_ptrs);
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    SL_ENSURE_IL((NULL == pool_ptr->head_ptr) == (NULL == pool_ptr->tail_ptr));
+
+    // Sema count, not free count: a task which got the sema
+    //  may not have taken its element yet.
+    taken = pool_ptr->sema_block->count;
+    if (count < taken)
+    {
+        taken = count;
+    }
+    SL_ENSURE_IL(taken <= pool_ptr->free_count);
+
+    // Cut 'taken' elements off the head
+    element_ptr = pool_ptr->head_ptr;
+    for (i = 0; i < taken; i++)
+    {
+        element_ptrs[i] = element_ptr;
+        element_ptr = *NSVC_POOL_FLINK_PTR(pool_ptr, element_ptr);
+    }
+
+    pool_ptr->head_ptr = element_ptr;
+    if (NULL == element_ptr)
+    {
+        pool_ptr->tail_ptr = NULL;
+    }
+
+    pool_ptr->free_count -= taken;
+
+    // Bypass nufr API calls, as with an ISR alloc
+    pool_ptr->sema_block->count -= taken;
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    for (i = 0; i < taken; i++)
+    {
+        // Skip memory clearing at ISR level, as with a single alloc
+        if (called_from_ISR)
+        {
+            *NSVC_POOL_FLINK_PTR(pool_ptr, element_ptrs[i]) = NULL;
+        }
+        else
+        {
+            pool_element_clear(pool_ptr, element_ptrs[i]);
+        }
+    }
+
+    return taken;
+}
+
+//!
+//! @name      nsvc_pool_free_bulk
+//!
+//! @brief     Return 'count' elements to the pool with one interrupt lock
+//!
+//! @details   Elements are chained before the lock is taken, then
+//! @details   spliced onto the free list tail. The pool's sema is then
+//! @details   released 'count' times by one nufr_sema_release_count().
+//! @details   Unlike 'nsvc_pool_free()', not callable from ISR:
+//! @details   'nufr_sema_release_count()' can't be called from ISR.
+//!
+//! @param[in] 'pool_ptr'--
+//! @param[in] 'element_ptrs'-- elements to return
+//! @param[in] 'count'-- number of 'element_ptrs'
+//!
+void nsvc_pool_free_bulk(nsvc_pool_t  *pool_ptr,
+                         void        **element_ptrs,
+                         unsigned      count)
+{
+    nufr_sr_reg_t   saved_psr;
+    void          **tail_flink_ptr;
+    unsigned        i;
+
+    SL_REQUIRE_API(NULL != pool_ptr);
+    SL_REQUIRE_API(NULL != element_ptrs);
+
+    if (0 == count)
+    {
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        SL_REQUIRE_API(nsvc_pool_is_element(pool_ptr, element_ptrs[i]));
+
+        *NSVC_POOL_FLINK_PTR(pool_ptr, element_ptrs[i]) =
+                            (i + 1 < count)? element_ptrs[i + 1] : NULL;
+    }
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    SL_ENSURE_IL((NULL == pool_ptr->head_ptr) == (NULL == pool_ptr->tail_ptr));
+
+    if (NULL == pool_ptr->head_ptr)
+    {
+        pool_ptr->head_ptr = element_ptrs[0];
+    }
+    else
+    {
+        tail_flink_ptr = NSVC_POOL_FLINK_PTR(pool_ptr, pool_ptr->tail_ptr);
+        SL_ENSURE_IL(NULL == *tail_flink_ptr);
+        *tail_flink_ptr = element_ptrs[0];
+    }
+    pool_ptr->tail_ptr = element_ptrs[count - 1];
+
+    pool_ptr->free_count += count;
+    SL_ENSURE_IL(pool_ptr->free_count <= pool_ptr->pool_size);
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    (void)nufr_sema_release_count(pool_ptr->sema, count);
+}
+#endif  //NUFR_CS_POOL_BULK
\ No newline at end of file
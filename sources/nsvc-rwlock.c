@@ -0,0 +1,611 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file    nsvc-rwlock.c
+//! @authors agent
+//! @date    16Oct26
+//!
+//! @brief   SL reader-writer locks
+//!
+//! @details Built from two kernel semas per lock:
+//! @details   'gate_sema'-- binary, priority inversion protected. Held
+//! @details       by the writer for its whole write. Readers pass through
+//! @details       it when a writer holds or waits for the lock, so a
+//! @details       blocked reader or writer raises the writer's priority.
+//! @details   'drain_sema'-- count 0. The writer waits here for readers
+//! @details       already inside to leave. The last one releases it.
+//! @details
+//! @details Writer preference: while a writer holds or waits for the
+//! @details lock, new readers queue on 'gate_sema' rather than walk in.
+//! @details Waiters on 'gate_sema' are taken in priority order, so a
+//! @details reader of higher priority than a waiting writer goes first.
+//! @details
+//! @details The kernel sema has a single owner, so readers already
+//! @details inside can't be priority raised through 'drain_sema'.
+//! @details Instead, each lock tracks which tasks are reading. A
+//! @details draining writer raises any of lower priority to its own,
+//! @details and each restores its priority on leaving. Don't nest read
+//! @details gets on one lock.
+//! @details A reader's priority may also be raised by a kernel sema it
+//! @details holds ('priority_restore_inversion'). The writer's raise and
+//! @details the reader's restore both go by the priority the reader
+//! @details would have without the sema, and leave the sema's own
+//! @details raise in place.
+//! @details
+//! @details Apps using rwlocks define 'nsvc_rwlock_t' and
+//! @details NSVC_NUM_RWLOCK in nsvc-app.h, and call 'nsvc_rwlock_init()'.
+//!
+
+#include "nufr-global.h"
+
+#include "nsvc-app.h"
+
+#ifdef NSVC_NUM_RWLOCK
+
+#include "nsvc-api.h"
+#include "nsvc.h"
+#include "nufr-api.h"
+#include "nufr-kernel-semaphore.h"
+#include "nufr-kernel-task.h"
+#include "nufr-platform-app.h"
+
+#include "raging-contract.h"
+#include "raging-utils-mem.h"
+
+//!
+//!  @name        nsvc_rwlock_reader_t
+//!
+//!  @brief       One task's read state on a rwlock
+//!
+typedef struct
+{
+    bool               reading;          // inside the lock as a reader
+    bool               raised;           // priority raised by a writer
+    uint8_t            restore_priority; // of 'nufr_tpr_t', if 'raised',
+                                         //   not counting a sema's raise
+} nsvc_rwlock_reader_t;
+
+//!
+//!  @name        nsvc_rwlock_block_t
+//!
+//!  @brief       Reader-writer lock block type
+//!
+//!  @details     Counters, 'writer' and 'reader' are changed with
+//!  @details     interrupts locked
+//!
+typedef struct
+{
+    nufr_sema_t          gate_sema;
+    nufr_sema_t          drain_sema;
+    unsigned             readers;          // readers inside the lock
+    unsigned             writers_waiting;  // writers waiting on 'gate_sema'
+    nufr_tid_t           writer;           // NUFR_TID_null if none
+    bool                 draining;         // writer waiting on 'drain_sema'
+    nsvc_rwlock_reader_t reader[NUFR_NUM_TASKS];  // indexed by tid - 1
+} nsvc_rwlock_block_t;
+
+//!
+//!  @name        NSVC_RWLOCK_ID_TO_BLOCK
+//!  @name        NSVC_IS_RWLOCK_BLOCK
+//!
+//!  @brief       Rwlock block accessors. See mutex equivalents.
+//!
+#define NSVC_RWLOCK_ID_TO_BLOCK(x)  ( &nsvc_rwlock_block[(x) - 1] )
+
+#define NSVC_IS_RWLOCK_BLOCK(x)     ( ((x) >= nsvc_rwlock_block) &&           \
+                            ((x) <= &nsvc_rwlock_block[NSVC_NUM_RWLOCK - 1]) )
+
+//!
+//!  @brief       Rwlock blocks
+//!
+nsvc_rwlock_block_t nsvc_rwlock_block[NSVC_NUM_RWLOCK];
+
+//! @name      nsvc_rwlock_init
+//!
+//! @brief     Initialize all rwlocks. Call after 'nsvc_init()'.
+//!
+void nsvc_rwlock_init(void)
+{
+    nsvc_rwlock_block_t *rwlock_block;
+    unsigned             i;
+    bool                 alloc_rv;
+
+    for (i = 0; i != NSVC_NUM_RWLOCK; i++)
+    {
+        rwlock_block = &nsvc_rwlock_block[i];
+
+        alloc_rv = nsvc_sema_pool_alloc(&rwlock_block->gate_sema);
+        SL_REQUIRE(alloc_rv);
+        alloc_rv = nsvc_sema_pool_alloc(&rwlock_block->drain_sema);
+        SL_REQUIRE(alloc_rv);
+        UNUSED_BY_ASSERT(alloc_rv);
+
+        rwlock_block->readers = 0;
+        rwlock_block->writers_waiting = 0;
+        rwlock_block->writer = NUFR_TID_null;
+        rwlock_block->draining = false;
+        rutils_memset(rwlock_block->reader, 0, sizeof(rwlock_block->reader));
+
+        nufrkernel_sema_reset(NUFR_SEMA_ID_TO_BLOCK(rwlock_block->gate_sema),
+                              1, true);
+        nufrkernel_sema_reset(NUFR_SEMA_ID_TO_BLOCK(rwlock_block->drain_sema),
+                              0, false);
+    }
+}
+
+//! @name      nsvc_rwlock_sema_get
+//!
+//! @brief     'nufr_sema_getT()' if 'timed', else 'nufr_sema_getW()'
+//!
+static nufr_sema_get_rtn_t nsvc_rwlock_sema_get(nufr_sema_t    sema,
+                                         nufr_msg_pri_t abort_priority_of_rx_msg,
+                                         unsigned       timeout_ticks,
+                                         bool           timed)
+{
+    if (timed)
+    {
+        return nufr_sema_getT(sema, abort_priority_of_rx_msg, timeout_ticks);
+    }
+
+    return nufr_sema_getW(sema, abort_priority_of_rx_msg);
+}
+
+//! @name      nsvc_rwlock_read_get
+//!
+//! @brief     Common to 'nsvc_rwlock_read_getW()'/'getT()'
+//!
+static nufr_sema_get_rtn_t nsvc_rwlock_read_get(nsvc_rwlock_t  rwlock,
+                                        nufr_msg_pri_t abort_priority_of_rx_msg,
+                                        unsigned       timeout_ticks,
+                                        bool           timed)
+{
+    nsvc_rwlock_block_t  *rwlock_block;
+    nsvc_rwlock_reader_t *reader;
+    nufr_sr_reg_t         saved_psr;
+    nufr_sema_get_rtn_t   rv;
+    bool                  walk_in;
+
+    rwlock_block = NSVC_RWLOCK_ID_TO_BLOCK(rwlock);
+    SL_REQUIRE_API(NSVC_IS_RWLOCK_BLOCK(rwlock_block));
+    SL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+
+    reader = &rwlock_block->reader[NUFR_TCB_TO_TID(nufr_running) - 1];
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    // Read gets don't nest
+    SL_REQUIRE_IL(!reader->reading);
+
+    walk_in = (NUFR_TID_null == rwlock_block->writer) &&
+              (0 == rwlock_block->writers_waiting);
+    if (walk_in)
+    {
+        rwlock_block->readers++;
+        reader->reading = true;
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    if (walk_in)
+    {
+        return NUFR_SEMA_GET_OK_NO_BLOCK;
+    }
+
+    // Writer has it or is waiting: queue behind it at the gate
+    rv = nsvc_rwlock_sema_get(rwlock_block->gate_sema,
+                              abort_priority_of_rx_msg,
+                              timeout_ticks, timed);
+
+    if ((NUFR_SEMA_GET_OK_NO_BLOCK == rv) || (NUFR_SEMA_GET_OK_BLOCK == rv))
+    {
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        rwlock_block->readers++;
+        reader->reading = true;
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+        // Pass gate on to next waiter, if any
+        (void)nufr_sema_release(rwlock_block->gate_sema);
+    }
+
+    return rv;
+}
+
+//! @name      nsvc_rwlock_read_getW
+//!
+//! @brief     Get shared (read) ownership of rwlock. Blocks while a
+//! @brief     writer holds or waits for the lock, or until a message
+//! @brief     of abort priority is sent.
+//!
+//! @param[in] 'rwlock'
+//! @param[in] 'abort_priority_of_rx_msg'--priority of message send
+//! @param[in]     which will abort wait.
+//! @param[in]     NOTE: requires NUFR_CS_TASK_KILL
+//!
+//! @return    Status
+nufr_sema_get_rtn_t nsvc_rwlock_read_getW(nsvc_rwlock_t  rwlock,
+                                          nufr_msg_pri_t abort_priority_of_rx_msg)
+{
+    return nsvc_rwlock_read_get(rwlock, abort_priority_of_rx_msg, 0, false);
+}
+
+//! @name      nsvc_rwlock_read_getT
+//!
+//! @brief     As 'nsvc_rwlock_read_getW()', with a timeout
+//!
+//! @param[in] 'rwlock'
+//! @param[in] 'abort_priority_of_rx_msg'--priority of message send
+//! @param[in]     which will abort wait.
+//! @param[in] 'timeout_ticks'-- wait timeout in OS clock ticks.
+//! @param[in]     If == 0, no waiting for rwlock
+//!
+//! @return    Status. Will indicate if timeout occured.
+nufr_sema_get_rtn_t nsvc_rwlock_read_getT(nsvc_rwlock_t  rwlock,
+                                          nufr_msg_pri_t abort_priority_of_rx_msg,
+                                          unsigned       timeout_ticks)
+{
+    return nsvc_rwlock_read_get(rwlock, abort_priority_of_rx_msg,
+                                timeout_ticks, true);
+}
+
+//! @name      nsvc_rwlock_read_release
+//!
+//! @brief     Release shared ownership of rwlock
+//!
+//! @details   If a draining writer raised this task's priority, it's
+//! @details   restored, after the writer is woken. If a kernel sema
+//! @details   has raised it since, it's restored when the sema is.
+//!
+//! @param[in] 'rwlock'
+//!
+//! @return    'true' if this was the last reader and a writer was
+//! @return    waiting for it
+bool nsvc_rwlock_read_release(nsvc_rwlock_t rwlock)
+{
+    nsvc_rwlock_block_t  *rwlock_block;
+    nsvc_rwlock_reader_t *reader;
+    nufr_tcb_t           *tcb;
+    nufr_sr_reg_t         saved_psr;
+    unsigned              restore_priority;
+    bool                  wake_writer;
+    bool                  was_raised;
+
+    rwlock_block = NSVC_RWLOCK_ID_TO_BLOCK(rwlock);
+    SL_REQUIRE_API(NSVC_IS_RWLOCK_BLOCK(rwlock_block));
+    SL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+
+    tcb = nufr_running;
+    reader = &rwlock_block->reader[NUFR_TCB_TO_TID(tcb) - 1];
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    SL_REQUIRE_IL(rwlock_block->readers > 0);
+    SL_REQUIRE_IL(reader->reading);
+    rwlock_block->readers--;
+    reader->reading = false;
+
+    was_raised = reader->raised;
+    restore_priority = reader->restore_priority;
+    reader->raised = false;
+
+    wake_writer = (0 == rwlock_block->readers) && rwlock_block->draining;
+    if (wake_writer)
+    {
+        rwlock_block->draining = false;
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    if (wake_writer)
+    {
+        (void)nufr_sema_release(rwlock_block->drain_sema);
+    }
+
+    // Writer is ready by now, so it preempts as we drop back.
+    // Checked and changed in one critical section, as a sema could
+    //   raise us at any time.
+    if (was_raised)
+    {
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        if (NUFR_IS_STATUS_SET(tcb, NUFR_TASK_INVERSION_PRIORITIZED))
+        {
+            tcb->priority_restore_inversion = (uint8_t)restore_priority;
+        }
+        else if (nufrkernel_change_task_priority(tcb, restore_priority))
+        {
+            NUFR_INVOKE_CONTEXT_SWITCH();
+        }
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+        NUFR_SECONDARY_CONTEXT_SWITCH();
+    }
+
+    return wake_writer;
+}
+
+//! @name      nsvc_rwlock_raise_readers
+//!
+//! @brief     Raises readers inside the lock of lower priority than
+//! @brief     the running (draining) writer to its priority
+//!
+//! @details   Interrupts are locked per reader, not across the scan.
+//! @details   Each reader is checked and raised in one critical
+//! @details   section, so one leaving meanwhile isn't left raised.
+//! @details   A raised reader restores its own priority on leaving.
+//! @details   A reader raised by a kernel sema is compared, and
+//! @details   restored, by its 'priority_restore_inversion'.
+//!
+static void nsvc_rwlock_raise_readers(nsvc_rwlock_block_t *rwlock_block)
+{
+    nsvc_rwlock_reader_t *reader;
+    nufr_tcb_t           *tcb;
+    nufr_sr_reg_t         saved_psr;
+    unsigned              writer_priority;
+    unsigned              base_priority;
+    unsigned              i;
+    bool                  inverted;
+    bool                  invoke;
+
+    writer_priority = nufr_running->priority;
+
+    // A prioritized writer can't pass on a reserved priority
+    if (writer_priority <= NUFR_TPR_guaranteed_highest)
+    {
+        writer_priority = NUFR_TPR_guaranteed_highest + 1;
+    }
+
+    for (i = 0; i < NUFR_NUM_TASKS; i++)
+    {
+        reader = &rwlock_block->reader[i];
+        tcb = &nufr_tcb_block[i];
+
+        invoke = false;
+
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        if (reader->reading && !reader->raised)
+        {
+            // Priority it'd have without a sema's raise
+            inverted = NUFR_IS_STATUS_SET(tcb, NUFR_TASK_INVERSION_PRIORITIZED);
+            base_priority = inverted ? tcb->priority_restore_inversion :
+                                       tcb->priority;
+
+            if (base_priority > writer_priority)
+            {
+                reader->raised = true;
+                reader->restore_priority = (uint8_t)base_priority;
+
+                // Sema's restore drops it back to us, not below
+                if (inverted)
+                {
+                    tcb->priority_restore_inversion = (uint8_t)writer_priority;
+                }
+
+                if (tcb->priority > writer_priority)
+                {
+                    invoke = nufrkernel_change_task_priority(tcb,
+                                                             writer_priority);
+                }
+            }
+        }
+
+        if (invoke)
+        {
+            NUFR_INVOKE_CONTEXT_SWITCH();
+        }
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+        NUFR_SECONDARY_CONTEXT_SWITCH();
+    }
+}
+
+//! @name      nsvc_rwlock_write_get
+//!
+//! @brief     Common to 'nsvc_rwlock_write_getW()'/'getT()'
+//!
+//! @details   Takes 'gate_sema', then waits for readers inside to
+//! @details   leave, with their priorities raised to ours. The
+//! @details   timeout covers both waits.
+//!
+static nufr_sema_get_rtn_t nsvc_rwlock_write_get(nsvc_rwlock_t  rwlock,
+                                        nufr_msg_pri_t abort_priority_of_rx_msg,
+                                        unsigned       timeout_ticks,
+                                        bool           timed)
+{
+    nsvc_rwlock_block_t *rwlock_block;
+    nufr_sema_block_t   *drain_block;
+    nufr_sr_reg_t        saved_psr;
+    nufr_sema_get_rtn_t  rv;
+    nufr_sema_get_rtn_t  drain_rv;
+    uint32_t             start_ticks;
+    uint32_t             elapsed_ticks;
+    bool                 must_drain;
+    bool                 still_draining;
+
+    rwlock_block = NSVC_RWLOCK_ID_TO_BLOCK(rwlock);
+    SL_REQUIRE_API(NSVC_IS_RWLOCK_BLOCK(rwlock_block));
+    SL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+    SL_REQUIRE_API(NUFR_TCB_TO_TID(nufr_running) != rwlock_block->writer);
+
+    drain_block = NUFR_SEMA_ID_TO_BLOCK(rwlock_block->drain_sema);
+    start_ticks = nufr_tick_count_get();
+
+    // Announce ourselves, so new readers stop walking in
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+    rwlock_block->writers_waiting++;
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    rv = nsvc_rwlock_sema_get(rwlock_block->gate_sema,
+                              abort_priority_of_rx_msg,
+                              timeout_ticks, timed);
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    rwlock_block->writers_waiting--;
+
+    must_drain = false;
+    if ((NUFR_SEMA_GET_OK_NO_BLOCK == rv) || (NUFR_SEMA_GET_OK_BLOCK == rv))
+    {
+        rwlock_block->writer = NUFR_TCB_TO_TID(nufr_running);
+
+        must_drain = rwlock_block->readers > 0;
+        if (must_drain)
+        {
+            rwlock_block->draining = true;
+
+            // Kernel requires an owner for a sema being waited on.
+            // No priority inversion protection, so this is cosmetic.
+            drain_block->owner_tcb = nufr_running;
+        }
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    if (!must_drain)
+    {
+        return rv;
+    }
+
+    // Readers we wait on mustn't be held off by middle priority tasks
+    nsvc_rwlock_raise_readers(rwlock_block);
+
+    // Charge the gate wait against the timeout
+    if (timed)
+    {
+        elapsed_ticks = nufr_tick_count_delta(start_ticks);
+        timeout_ticks = (elapsed_ticks < timeout_ticks)?
+                            timeout_ticks - elapsed_ticks : 0;
+    }
+
+    drain_rv = nsvc_rwlock_sema_get(rwlock_block->drain_sema,
+                                    abort_priority_of_rx_msg,
+                                    timeout_ticks, timed);
+
+    if ((NUFR_SEMA_GET_OK_NO_BLOCK != drain_rv) &&
+        (NUFR_SEMA_GET_OK_BLOCK != drain_rv))
+    {
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        still_draining = rwlock_block->draining;
+        rwlock_block->draining = false;
+        if (still_draining)
+        {
+            rwlock_block->writer = NUFR_TID_null;
+        }
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+        // Gave up with readers still inside: back out
+        if (still_draining)
+        {
+            (void)nufr_sema_release(rwlock_block->gate_sema);
+
+            return drain_rv;
+        }
+
+        // Last reader left just as we gave up. Consume its release.
+        drain_rv = nufr_sema_getT(rwlock_block->drain_sema,
+                                  abort_priority_of_rx_msg, 0);
+        SL_ENSURE(NUFR_SEMA_GET_OK_NO_BLOCK == drain_rv);
+    }
+
+    return NUFR_SEMA_GET_OK_BLOCK;
+}
+
+//! @name      nsvc_rwlock_write_getW
+//!
+//! @brief     Get exclusive (write) ownership of rwlock. Blocks until
+//! @brief     other writers and all readers have left, or until a
+//! @brief     message of abort priority is sent.
+//!
+//! @details   Tasks blocked on the lock raise the writer's priority.
+//! @details   While the writer waits for readers inside to leave, it
+//! @details   raises their priorities to its own. If the writer gives
+//! @details   up, they stay raised until they leave.
+//!
+//! @param[in] 'rwlock'
+//! @param[in] 'abort_priority_of_rx_msg'--priority of message send
+//! @param[in]     which will abort wait.
+//! @param[in]     NOTE: requires NUFR_CS_TASK_KILL
+//!
+//! @return    Status
+nufr_sema_get_rtn_t nsvc_rwlock_write_getW(nsvc_rwlock_t  rwlock,
+                                           nufr_msg_pri_t abort_priority_of_rx_msg)
+{
+    return nsvc_rwlock_write_get(rwlock, abort_priority_of_rx_msg, 0, false);
+}
+
+//! @name      nsvc_rwlock_write_getT
+//!
+//! @brief     As 'nsvc_rwlock_write_getW()', with a timeout
+//!
+//! @param[in] 'rwlock'
+//! @param[in] 'abort_priority_of_rx_msg'--priority of message send
+//! @param[in]     which will abort wait.
+//! @param[in] 'timeout_ticks'-- wait timeout in OS clock ticks.
+//! @param[in]     If == 0, no waiting for rwlock
+//!
+//! @return    Status. Will indicate if timeout occured.
+nufr_sema_get_rtn_t nsvc_rwlock_write_getT(nsvc_rwlock_t  rwlock,
+                                           nufr_msg_pri_t abort_priority_of_rx_msg,
+                                           unsigned       timeout_ticks)
+{
+    return nsvc_rwlock_write_get(rwlock, abort_priority_of_rx_msg,
+                                 timeout_ticks, true);
+}
+
+//! @name      nsvc_rwlock_write_release
+//!
+//! @brief     Release exclusive ownership of rwlock
+//!
+//! @details   Highest priority task waiting on the gate, reader or
+//! @details   writer, goes next.
+//!
+//! @param[in] 'rwlock'
+//!
+//! @return    'true' if another task was waiting on this rwlock
+bool nsvc_rwlock_write_release(nsvc_rwlock_t rwlock)
+{
+    nsvc_rwlock_block_t *rwlock_block;
+    nufr_sr_reg_t        saved_psr;
+
+    rwlock_block = NSVC_RWLOCK_ID_TO_BLOCK(rwlock);
+    SL_REQUIRE_API(NSVC_IS_RWLOCK_BLOCK(rwlock_block));
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    SL_REQUIRE_IL(NUFR_TCB_TO_TID(nufr_running) == rwlock_block->writer);
+    rwlock_block->writer = NUFR_TID_null;
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    return nufr_sema_release(rwlock_block->gate_sema);
+}
+
+#endif  //NSVC_NUM_RWLOCK
@@ -32,8 +32,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! @details When a timer is started it's allocated from the global timer
 //! @details pool, and freed back to the pool when it expires.
 //! @details App timers send a message upon expiration. 
-//! @details App timers are queued up in the order in which they'll expire.
-//! @details This queuing allows a single timer (a "quantum timer") to be
+//! @details Active app timers are kept in a pairing heap, ordered by
+//! @details expiration, so the next to expire is always at the root.
+//! @details Start is O(1); kill and expire are O(log n) amortized.
+//! @details This allows a single timer (a "quantum timer") to be
 //! @details programmed for the next expiration, rather than polling with
 //! @details the OS tick. Both quantum timers and OS tick timers are supported.
 //! @details 
@@ -90,18 +92,52 @@ bool nsvc_timer_queue_update_in_progress;
 
 //!
 //! @name      nsvc_timer_queue_head
-//! @name      nsvc_timer_queue_tail
 //! @name      nsvc_timer_queue_length
+//! @name      nsvc_timer_queue_base_time
 //!
-//! @brief     Active timer queue ordered list
+//! @brief     Active timer queue heap
 //!
-//! @details   This list is maintained in the order of expiration,
-//! @details   with the head being the first to expire.
-//! @details   'nsvc_timer_queue_length' is the number of timers in list.
+//! @details   'nsvc_timer_queue_head' is the root of a pairing heap
+//! @details   ordered by expiration: the first timer to expire.
+//! @details   'nsvc_timer_queue_length' is the number of timers in heap.
+//! @details   'nsvc_timer_queue_base_time' is the time up to which
+//! @details   timers have been expired. Heap order is by expiration
+//! @details   time less the base time, which handles wrap.
 //!
 nsvc_timer_t    *nsvc_timer_queue_head;
-nsvc_timer_t    *nsvc_timer_queue_tail;
 unsigned         nsvc_timer_queue_length;
+static uint32_t  nsvc_timer_queue_base_time;
+
+#if NUFR_CS_TIMER_SLACK == 1
+//!
+//! @name      nsvc_timer_batch_deadline
+//! @name      nsvc_timer_batch_deadline_valid
+//!
+//! @brief     Time the next expiry is due
+//!
+//! @details   The next batch is every timer whose window opens
+//! @details   ('expiration_time') by the batch deadline. The deadline
+//! @details   is the earliest time any of them must fire
+//! @details   ('expiration_time' + 'slack'). Inserts keep it up to
+//! @details   date; removing a batch member invalidates it.
+//!
+static uint32_t  nsvc_timer_batch_deadline;
+static bool      nsvc_timer_batch_deadline_valid;
+
+//!
+//! @name      nsvc_timer_quantum_deadline
+//! @name      nsvc_timer_quantum_is_set
+//!
+//! @brief     Time the quantum timer is programmed to expire at
+//!
+static uint32_t  nsvc_timer_quantum_deadline;
+static bool      nsvc_timer_quantum_is_set;
+
+//!
+//! @name      nsvc_timer_stats
+//!
+static nsvc_timer_stats_t nsvc_timer_stats;
+#endif  //NUFR_CS_TIMER_SLACK
 
 //!
 //! @name      nsvc_timer_expired_list_head
@@ -128,81 +164,277 @@ nsvc_timer_t    *nsvc_timer_expired_list_tail;
 uint32_t         nsvc_timer_latest_time;
 
 //!
-//! @name      sl_timer_active_insert
+//! @name      sl_timer_expires_before
 //!
-//! @brief     Enqueue a timer to the timer active queue
+//! @brief     Heap ordering: does 'tm1' expire before 'tm2'?
 //!
-//! @details   Links a timer into the active timer list.
-//! @details   Timer is linked in before 'before_this_tm'. If 'before_this_tm'
-//! @details   is NULL, timer is appended to list.
-//! @details   
-//! @details   If called from task level, caller must either lock interrupts
-//! @details   or prioritize ('nufr_prioritize()') calling task.
+//! @details   Wrap-safe: expiration times are compared as deltas
+//! @details   from 'nsvc_timer_queue_base_time'. No active timer
+//! @details   expires at or before the base time, so the order
+//! @details   holds as the base time advances.
 //!
-//! @param[in] 'tm'-- timer to enqueue.
-//! @param[in] 'before_this_tm'-- Location in list to enqueue timer.
-//! @param[in]      Set to NULL to append.
+static bool sl_timer_expires_before(const nsvc_timer_t *tm1,
+                                    const nsvc_timer_t *tm2)
+{
+    return (tm1->expiration_time - nsvc_timer_queue_base_time) <
+           (tm2->expiration_time - nsvc_timer_queue_base_time);
+}
+
 //!
-//! @return    'true' if insert is new head
+//! @name      sl_timer_meld
+//!
+//! @brief     Meld two heaps into one
+//!
+//! @details   The later-expiring root becomes the leftmost child of
+//! @details   the other. On a tie, 'tm1' stays root.
 //!
-bool sl_timer_active_insert(nsvc_timer_t *tm,
-                            nsvc_timer_t *before_this_tm)
+//! @param[in] 'tm1'-- root of first heap. No siblings or parent.
+//! @param[in] 'tm2'-- root of second heap. No siblings or parent.
+//!
+//! @return    root of melded heap
+//!
+static nsvc_timer_t *sl_timer_meld(nsvc_timer_t *tm1, nsvc_timer_t *tm2)
 {
-    bool             head_change = false;
+    nsvc_timer_t *swap;
 
-    // List empty?
-    if (0 == nsvc_timer_queue_length)
+    if (sl_timer_expires_before(tm2, tm1))
     {
-        nsvc_timer_queue_head = tm;
-        nsvc_timer_queue_tail = tm;
+        swap = tm1;
+        tm1 = tm2;
+        tm2 = swap;
+    }
 
-        head_change = true;
+    tm2->blink = tm1;
+    tm2->flink = tm1->child;
+    if (NULL != tm1->child)
+    {
+        tm1->child->blink = tm2;
     }
-    // Insert before existing timer ('before_this_tm')?
-    else if (NULL != before_this_tm)
+    tm1->child = tm2;
+
+    return tm1;
+}
+
+//!
+//! @name      sl_timer_merge_pairs
+//!
+//! @brief     Two-pass merge of a sibling list into one heap
+//!
+//! @details   First pass melds siblings in pairs, left to right,
+//! @details   stacking the results (linked by 'flink'). Second pass
+//! @details   melds the stack, right to left. This is what keeps
+//! @details   a pairing heap's delete at O(log n) amortized.
+//!
+//! @param[in] 'first'-- leftmost sibling. NULL if none.
+//!
+//! @return    root of merged heap. NULL if 'first' was NULL.
+//!
+static nsvc_timer_t *sl_timer_merge_pairs(nsvc_timer_t *first)
+{
+    nsvc_timer_t *stack = NULL;
+    nsvc_timer_t *tm1;
+    nsvc_timer_t *tm2;
+    nsvc_timer_t *root;
+
+    while (NULL != first)
     {
-        if (nsvc_timer_queue_head == before_this_tm)
+        tm1 = first;
+        tm2 = tm1->flink;
+        tm1->flink = NULL;
+        tm1->blink = NULL;
+
+        if (NULL != tm2)
         {
-            nsvc_timer_queue_head = tm;
+            first = tm2->flink;
+            tm2->flink = NULL;
+            tm2->blink = NULL;
 
-            head_change = true;
+            tm1 = sl_timer_meld(tm1, tm2);
         }
         else
         {
-            tm->blink = before_this_tm->blink;
-            before_this_tm->blink->flink = tm;
+            first = NULL;
         }
 
-        before_this_tm->blink = tm;
-        tm->flink = before_this_tm;
+        tm1->flink = stack;
+        stack = tm1;
     }
-    // Otherwise, append to list
-    else
+
+    root = stack;
+    if (NULL != root)
+    {
+        stack = root->flink;
+        root->flink = NULL;
+
+        while (NULL != stack)
+        {
+            tm1 = stack;
+            stack = tm1->flink;
+            tm1->flink = NULL;
+
+            root = sl_timer_meld(tm1, root);
+        }
+    }
+
+    return root;
+}
+
+#if NUFR_CS_TIMER_SLACK == 1
+//!
+//! @name      sl_timer_in_batch
+//!
+//! @brief     Does 'tm's window open by the batch deadline?
+//!
+static bool sl_timer_in_batch(const nsvc_timer_t *tm)
+{
+    return (tm->expiration_time - nsvc_timer_queue_base_time) <=
+           (nsvc_timer_batch_deadline - nsvc_timer_queue_base_time);
+}
+
+//!
+//! @name      sl_timer_fires_before_deadline
+//!
+//! @brief     Must 'tm' fire before the batch deadline?
+//!
+static bool sl_timer_fires_before_deadline(const nsvc_timer_t *tm)
+{
+    return (tm->expiration_time + tm->slack - nsvc_timer_queue_base_time) <
+           (nsvc_timer_batch_deadline - nsvc_timer_queue_base_time);
+}
+
+//!
+//! @name      sl_timer_batch_deadline_update
+//!
+//! @brief     Recompute the batch deadline
+//!
+//! @details   Pops timers in expiration order for as long as their
+//! @details   windows open by the deadline, pulling the deadline in
+//! @details   as they go, then melds them back. O(k log n) for a
+//! @details   batch of k timers.
+//!
+static void sl_timer_batch_deadline_update(void)
+{
+    nsvc_timer_t *popped = NULL;
+    nsvc_timer_t *tm;
+
+    SL_REQUIRE_IL(NULL != nsvc_timer_queue_head);
+
+    tm = nsvc_timer_queue_head;
+    nsvc_timer_batch_deadline = tm->expiration_time + tm->slack;
+
+    while ((NULL != tm) && sl_timer_in_batch(tm))
+    {
+        if (sl_timer_fires_before_deadline(tm))
+        {
+            nsvc_timer_batch_deadline = tm->expiration_time + tm->slack;
+        }
+
+        nsvc_timer_queue_head = sl_timer_merge_pairs(tm->child);
+        tm->child = NULL;
+        tm->flink = popped;
+        popped = tm;
+
+        tm = nsvc_timer_queue_head;
+    }
+
+    // Meld back, last popped first, so ties keep their order
+    while (NULL != popped)
     {
-        nsvc_timer_queue_tail->flink = tm;
-        tm->blink = nsvc_timer_queue_tail;
+        tm = popped;
+        popped = tm->flink;
+        tm->flink = NULL;
+
+        if (NULL == nsvc_timer_queue_head)
+        {
+            nsvc_timer_queue_head = tm;
+        }
+        else
+        {
+            nsvc_timer_queue_head = sl_timer_meld(tm, nsvc_timer_queue_head);
+        }
+    }
+
+    nsvc_timer_batch_deadline_valid = true;
+}
+#endif  //NUFR_CS_TIMER_SLACK
 
-        nsvc_timer_queue_tail = tm;
+//!
+//! @name      sl_timer_next_expiry_time
+//!
+//! @brief     Time the next expiry is due
+//!
+//! @details   Head's expiration time, or with timer slack, the
+//! @details   batch deadline. Active heap must not be empty.
+//!
+static uint32_t sl_timer_next_expiry_time(void)
+{
+#if NUFR_CS_TIMER_SLACK == 1
+    if (!nsvc_timer_batch_deadline_valid)
+    {
+        sl_timer_batch_deadline_update();
+    }
+
+    return nsvc_timer_batch_deadline;
+#else
+    return nsvc_timer_queue_head->expiration_time;
+#endif
+}
+
+//!
+//! @name      sl_timer_active_insert
+//!
+//! @brief     Enqueue a timer to the timer active queue
+//!
+//! @details   Melds a timer into the active timer heap. O(1).
+//! @details   'tm->expiration_time' must be set, and must be
+//! @details   later than 'nsvc_timer_queue_base_time'.
+//! @details   A timer expiring at the same time as the head
+//! @details   doesn't displace the head.
+//! @details   
+//! @details   If called from task level, caller must either lock interrupts
+//! @details   or prioritize ('nufr_prioritize()') calling task.
+//!
+//! @param[in] 'tm'-- timer to enqueue.
+//!
+//! @return    'true' if insert is new head
+//!
+bool sl_timer_active_insert(nsvc_timer_t *tm)
+{
+    SL_REQUIRE_IL((NULL == tm->flink) && (NULL == tm->blink) &&
+                  (NULL == tm->child));
+
+#if NUFR_CS_TIMER_SLACK == 1
+    // Joining the next batch can only pull its deadline in
+    if (NULL == nsvc_timer_queue_head)
+    {
+        nsvc_timer_batch_deadline = tm->expiration_time + tm->slack;
+        nsvc_timer_batch_deadline_valid = true;
+    }
+    else if (nsvc_timer_batch_deadline_valid && sl_timer_in_batch(tm) &&
+             sl_timer_fires_before_deadline(tm))
+    {
+        nsvc_timer_batch_deadline = tm->expiration_time + tm->slack;
+    }
+#endif
+
+    if (NULL == nsvc_timer_queue_head)
+    {
+        nsvc_timer_queue_head = tm;
+    }
+    else
+    {
+        nsvc_timer_queue_head = sl_timer_meld(nsvc_timer_queue_head, tm);
     }
 
     nsvc_timer_queue_length++;
 
-    SL_REQUIRE_IL((NULL != nsvc_timer_queue_head) &&
-                  (NULL != nsvc_timer_queue_tail));
-    SL_REQUIRE_IL(nsvc_timer_queue_length > 0);
-    SL_REQUIRE_IL(NULL == nsvc_timer_queue_head->blink);
-    SL_REQUIRE_IL(NULL == nsvc_timer_queue_tail->flink);
-    SL_REQUIRE_IL((1 != nsvc_timer_queue_length) ||
-                  (nsvc_timer_queue_head == nsvc_timer_queue_tail));
+    SL_REQUIRE_IL(NULL != nsvc_timer_queue_head);
+    SL_REQUIRE_IL((NULL == nsvc_timer_queue_head->flink) &&
+                  (NULL == nsvc_timer_queue_head->blink));
     SL_REQUIRE_IL((1 != nsvc_timer_queue_length) ||
-                  ((NULL == tm->flink) && (NULL == tm->blink)));
-    SL_REQUIRE_IL((1 == nsvc_timer_queue_length) ||
-                  (NULL != nsvc_timer_queue_head->flink));
-    SL_REQUIRE_IL((nsvc_timer_queue_length > 1)?
-                  ((NULL != nsvc_timer_queue_head->flink) &&
-                  (NULL != nsvc_timer_queue_tail->blink)) : true);
+                  (NULL == nsvc_timer_queue_head->child));
 
-    return head_change;
+    return nsvc_timer_queue_head == tm;
 }
 
 //!
@@ -212,11 +444,11 @@ bool sl_timer_active_insert(nsvc_timer_t *tm,
 //!
 //! @details   Assumes timer is on active timer queue.
 //! @details   If timer is not on active timer queue, will cause crash. 
+//! @details   The timer's subtree is cut out of the heap, its children
+//! @details   merged, and the result melded back in. O(log n) amortized.
 //! @details   
 //! @details   If called from task level, caller must either lock interrupts
 //! @details   or prioritize ('nufr_prioritize()') calling task.
-//! @details   
-//! @details   
 //!
 //! @param[in] 'tm'-- timer to dequeue.
 //!
@@ -224,32 +456,51 @@ bool sl_timer_active_insert(nsvc_timer_t *tm,
 //!
 bool sl_timer_active_dequeue(nsvc_timer_t *tm)
 {
+    nsvc_timer_t    *subtree;
     bool             head_change = false;
 
     SL_REQUIRE_IL(nsvc_timer_queue_length > 0);
-    SL_REQUIRE_IL((1 != nsvc_timer_queue_length) ||
-                  ((NULL == tm->flink) && (NULL == tm->blink)));
-    SL_REQUIRE_IL((1 == nsvc_timer_queue_length) ||
-                  ((NULL != tm->flink) || (NULL != tm->blink)));
+    SL_REQUIRE_IL((nsvc_timer_queue_head == tm) || (NULL != tm->blink));
+
+#if NUFR_CS_TIMER_SLACK == 1
+    // Batch member leaving might push batch deadline out
+    if (nsvc_timer_batch_deadline_valid && sl_timer_in_batch(tm))
+    {
+        nsvc_timer_batch_deadline_valid = false;
+    }
+#endif
+
+    subtree = sl_timer_merge_pairs(tm->child);
+    tm->child = NULL;
 
     if (nsvc_timer_queue_head == tm)
     {
-        nsvc_timer_queue_head = tm->flink;
+        nsvc_timer_queue_head = subtree;
 
         head_change = true;
     }
     else
     {
-        tm->blink->flink = tm->flink;
-    }
+        // Unlink from parent, if leftmost child, or from previous sibling
+        if (tm->blink->child == tm)
+        {
+            tm->blink->child = tm->flink;
+        }
+        else
+        {
+            tm->blink->flink = tm->flink;
+        }
 
-    if (nsvc_timer_queue_tail == tm)
-    {
-        nsvc_timer_queue_tail = tm->blink;
-    }
-    else
-    {
-        tm->flink->blink = tm->blink;
+        if (NULL != tm->flink)
+        {
+            tm->flink->blink = tm->blink;
+        }
+
+        if (NULL != subtree)
+        {
+            nsvc_timer_queue_head = sl_timer_meld(nsvc_timer_queue_head,
+                                                  subtree);
+        }
     }
 
     tm->flink = NULL;
@@ -258,17 +509,10 @@ bool sl_timer_active_dequeue(nsvc_timer_t *tm)
     nsvc_timer_queue_length--;
 
     SL_REQUIRE_IL((NULL == nsvc_timer_queue_head) ==
-                  (NULL == nsvc_timer_queue_tail));
+                  (0 == nsvc_timer_queue_length));
     SL_REQUIRE_IL((NULL != nsvc_timer_queue_head)?
-                      (NULL == nsvc_timer_queue_head->blink) : true);
-    SL_REQUIRE_IL((NULL != nsvc_timer_queue_tail)?
-                      (NULL == nsvc_timer_queue_tail->flink) : true);
-    SL_REQUIRE_IL((1 != nsvc_timer_queue_length) ||
-                  (nsvc_timer_queue_head == nsvc_timer_queue_tail));
-    SL_REQUIRE_IL((nsvc_timer_queue_length > 1)?
-                  (NULL != nsvc_timer_queue_head->flink) : true);
-    SL_REQUIRE_IL((nsvc_timer_queue_length > 1)?
-                  (NULL != nsvc_timer_queue_tail->blink) : true);
+                  ((NULL == nsvc_timer_queue_head->flink) &&
+                   (NULL == nsvc_timer_queue_head->blink)) : true);
 
     return head_change;
 }
@@ -347,153 +591,109 @@ nsvc_timer_t *sl_timer_pop_expired(void)
     return tm;
 }
 
-//!
-//! @name      sl_timer_active_insert
-//!
-//! @brief     Find where in active timer list to insert a timer.
-//!
-//! @details   Walks active timer list to find the next timer which
-//! @details   which expires after this one. If listed timer expires
-//! @details   at same time, then inserted timer goes after this.
-//! @details   The next timer is returned, or NULL if insert must
-//! @details   be an append.
-//! @details   
-//! @details   If called from task level, caller must either lock interrupts
-//! @details   or prioritize ('nufr_prioritize()') calling task.
-//!
-//! @param[in] 'current_time'-- current H/W time reference value
-//! @param[in] 'duration'-- time duration to this timer's timeout
-//! @param[in]      (in milliseconds)
-//! @param[in] 'is_new_head_ptr'-- inserted timer will become new head
-//!
-//! @return    timer which will be after inserted timer. NULL if none.
-//!
-nsvc_timer_t *sl_timer_find_sorted_insert(uint32_t duration,
-                                          bool    *is_new_head_ptr)
-{
-    nsvc_timer_t  *this_tm; 
-    uint32_t       this_duration;
-    uint32_t       this_expiration_time;
-
-    this_tm = nsvc_timer_queue_head;
-
-    // No active timers?
-    if (NULL == this_tm)
-    {
-        *is_new_head_ptr = true;
-
-        return NULL;
-    }
-
-    // Walk list from head: walk list in order of expiration
-    while (NULL != this_tm)
-    {
-        this_expiration_time = this_tm->expiration_time;
-
-        // Handles wrap case ok too
-        this_duration = this_expiration_time - nsvc_timer_latest_time;
-
-        // Does 'tm' expire before this timer?
-        if (duration < this_duration)
-        {
-            // 
-            if (this_tm == nsvc_timer_queue_head)
-            {
-                *is_new_head_ptr = true;
-            }
-
-            return this_tm;
-        }
-
-        this_tm = this_tm->flink;
-    }
-
-    // Appending to end of list
-    *is_new_head_ptr = false;
-
-    return NULL;
-}
-
 //!
 //! @name      sl_timer_check_and_expire
 //!
-//! @brief     Walk active timer list, looking for expired timers.
+//! @brief     Pop expired timers off the active timer heap.
 //!
-//! @details   Walks active timer list to find the all timers which
+//! @details   Pops heap head until it finds one which hasn't expired,
+//! @details   to find all timers which
 //! @details   have expired. An expired timer is one whose expiration
 //! @details   time is either at 'nsvc_timer_latest_time' or up to
 //! @details   'previous_check_time' milliseconds before that time.
+//! @details   Comparisons are deltas from 'previous_check_time', so
+//! @details   the time wrap is handled.
+//! @details
+//! @details   With timer slack, nothing expires until the batch
+//! @details   deadline is reached. Then every timer whose window
+//! @details   has opened expires together.
 //! @details
 //! @details   All timers which are found to have expired are
-//! @details   taken off the active timer list and pushed onto the
+//! @details   taken off the active timer heap and pushed onto the
 //! @details   expired timer list.
 //! @details   
 //! @details   If called from task level, caller must either lock interrupts
 //! @details   or prioritize ('nufr_prioritize()') calling task.
 //!
 //! @param[in] 'previous_check_time'-- last reference time that expired
-//! @param[in]     timers were checked for.
+//! @param[in]     timers were checked for: 'nsvc_timer_queue_base_time'.
 //!
 //! @return    number of expired timers
 //!
 unsigned sl_timer_check_and_expire(uint32_t previous_check_time)
 {
     nsvc_timer_t   *this_tm;
-    nsvc_timer_t   *next_tm;
+    uint32_t        window;
     unsigned        expired_count = 0;
+#if NUFR_CS_TIMER_SLACK == 1
+    uint32_t        deadline = 0;
+    uint32_t        last_expiration_time = 0;
+    unsigned        expiration_times = 0;
+#endif
+
+    window = nsvc_timer_latest_time - previous_check_time;
 
     this_tm = nsvc_timer_queue_head;
 
-    // non-wrap case    
-    if (nsvc_timer_latest_time >= previous_check_time)
+#if NUFR_CS_TIMER_SLACK == 1
+    if (NULL != this_tm)
     {
-        while (NULL != this_tm)
-        {
-            next_tm = this_tm->flink;
-
-            if ((this_tm->expiration_time <= nsvc_timer_latest_time)
-                                    &&
-                (this_tm->expiration_time >= previous_check_time))
-            {
-                sl_timer_active_dequeue(this_tm);
-                sl_timer_push_expired(this_tm);
+        deadline = sl_timer_next_expiry_time();
+        this_tm = nsvc_timer_queue_head;
 
-                expired_count++;
-            }
-            else
+        // Batch not due yet? Hold its timers back. Base time
+        // can't move past a timer that's being held back.
+        if ((deadline - previous_check_time) > window)
+        {
+            if ((this_tm->expiration_time - previous_check_time) > window)
             {
-                // Since active timer list is ordered by expiration
-                // time, no timers beyond 'this_tm' can be expired.
-                break;
+                nsvc_timer_queue_base_time = nsvc_timer_latest_time;
             }
 
-            this_tm = next_tm;
+            return 0;
         }
     }
-    // wrap case    
-    else
+#endif
+
+    while ((NULL != this_tm) &&
+           ((this_tm->expiration_time - previous_check_time) <= window))
     {
-        while (NULL != this_tm)
+    #if NUFR_CS_TIMER_SLACK == 1
+        // Each distinct time in batch would have been its own expiry
+        if (((this_tm->expiration_time - previous_check_time) <=
+                                    (deadline - previous_check_time)) &&
+            ((0 == expiration_times) ||
+             (this_tm->expiration_time != last_expiration_time)))
         {
-            next_tm = this_tm->flink;
+            expiration_times++;
+            last_expiration_time = this_tm->expiration_time;
+        }
+    #endif
 
-            if ((this_tm->expiration_time <= nsvc_timer_latest_time)
-                                    ||
-                (this_tm->expiration_time >= previous_check_time))
-            {
-                sl_timer_active_dequeue(this_tm);
-                sl_timer_push_expired(this_tm);
+        sl_timer_active_dequeue(this_tm);
+        sl_timer_push_expired(this_tm);
 
-                expired_count++;
-            }
-            else
-            {
-                break;
-            }
+        expired_count++;
 
-            this_tm = next_tm;
+        // Since head is the next timer to expire, loop
+        // stops at first timer which hasn't expired.
+        this_tm = nsvc_timer_queue_head;
+    }
+
+#if NUFR_CS_TIMER_SLACK == 1
+    if (expired_count > 0)
+    {
+        nsvc_timer_stats.expiries++;
+        nsvc_timer_stats.timers_expired += expired_count;
+        if (expiration_times > 1)
+        {
+            nsvc_timer_stats.wakeups_saved += expiration_times - 1;
         }
     }
+#endif
+
+    // Nothing left in heap expires at or before current time
+    nsvc_timer_queue_base_time = nsvc_timer_latest_time;
 
     return expired_count;
 }
@@ -504,8 +704,14 @@ unsigned sl_timer_check_and_expire(uint32_t previous_check_time)
 //! @brief     Walk expired timer list. Send a message for each
 //! @brief     expired timer, then remove that timer from the list.
 //!
+//! @details   With NUFR_CS_TIMER_CALLBACK, a callback timer's function
+//! @details   is called instead; a hybrid timer's message is only sent
+//! @details   if its function returns 'true'.
 //! @details   If expired timer is a continuous timer, it
-//! @details   is put back on the active timer list.
+//! @details   is put back on the active timer heap.
+//! @details   With NUFR_CS_MSG_INDEX, a timer with 'coalesce' set
+//! @details   doesn't send while its previous message is still queued,
+//! @details   so a slow receiver doesn't build a backlog of ticks.
 //!
 //! @return    'true' is a continuous timer, when reset, then
 //! @return    became the next timer to expire (head)
@@ -513,14 +719,37 @@ unsigned sl_timer_check_and_expire(uint32_t previous_check_time)
 bool sl_timer_process_expired_timers(void)
 {
     nsvc_timer_t    *tm;
-    nsvc_timer_t    *before_this_tm;
-    bool             is_new_head;
     bool             a_new_head = false;
+    bool             send_msg;
 
     // Walk/drain expired timer list.
     while (NULL != (tm = sl_timer_pop_expired()))
     {
-        nufr_msg_send(tm->msg_fields, tm->msg_parameter, tm->dest_task_id);
+        send_msg = true;
+
+    #if NUFR_CS_TIMER_CALLBACK == 1
+        if (NSVC_TDELIVERY_MSG != tm->delivery)
+        {
+            send_msg = (*tm->callback)(tm) &&
+                       (NSVC_TDELIVERY_HYBRID == tm->delivery);
+        }
+    #endif
+
+        if (!send_msg)
+        {
+            // Callback did the work
+        }
+    #if NUFR_CS_MSG_INDEX == 1
+        else if (tm->coalesce)
+        {
+            nufr_msg_send_coalesce(tm->msg_fields, tm->msg_parameter,
+                                   tm->dest_task_id);
+        }
+    #endif
+        else
+        {
+            nufr_msg_send(tm->msg_fields, tm->msg_parameter, tm->dest_task_id);
+        }
 
         // If timer is continuous, refire it.
         if (NSVC_TMODE_CONTINUOUS == tm->mode)
@@ -528,13 +757,7 @@ bool sl_timer_process_expired_timers(void)
             // Calculate new expiration time
             tm->expiration_time = tm->duration + nsvc_timer_latest_time;
 
-            is_new_head = false;                // suppress warning
-            before_this_tm = sl_timer_find_sorted_insert(tm->duration,
-                                                         &is_new_head);
-
-            a_new_head |= is_new_head || (NULL == before_this_tm);
-
-            sl_timer_active_insert(tm, before_this_tm);
+            a_new_head |= sl_timer_active_insert(tm);
         }
         else
         {
@@ -548,6 +771,69 @@ bool sl_timer_process_expired_timers(void)
     return a_new_head;
 }
 
+//!
+//! @name      sl_timer_quantum_reconfigure
+//!
+//! @brief     From task level, reprogram quantum timer for next expiry
+//!
+//! @details   With timer slack, the next expiry can move without
+//! @details   the head changing, and the head can change without
+//! @details   moving the next expiry, so the quantum timer is
+//! @details   reprogrammed only when the next expiry moves.
+//! @details   Caller must prioritize ('nufr_prioritize()') calling task.
+//!
+//! @param[in] 'a_new_head'-- head of active timer heap changed
+//!
+static void sl_timer_quantum_reconfigure(bool a_new_head)
+{
+    uint32_t         next_expiry;
+
+    // No active timers? Stop quantum timer
+    if (0 == nsvc_timer_queue_length)
+    {
+        if (!a_new_head)
+        {
+            return;
+        }
+
+    #if NUFR_CS_TIMER_SLACK == 1
+        nsvc_timer_quantum_is_set = false;
+        nsvc_timer_stats.reprograms++;
+    #endif
+        (*nsvc_timer_quantum_device_reconfigure_fcn_ptr)(0);
+
+        return;
+    }
+
+    next_expiry = sl_timer_next_expiry_time();
+
+#if NUFR_CS_TIMER_SLACK == 1
+    if (nsvc_timer_quantum_is_set &&
+        (nsvc_timer_quantum_deadline == next_expiry))
+    {
+        if (a_new_head)
+        {
+            nsvc_timer_stats.reprograms_saved++;
+        }
+
+        return;
+    }
+
+    nsvc_timer_quantum_deadline = next_expiry;
+    nsvc_timer_quantum_is_set = true;
+    nsvc_timer_stats.reprograms++;
+#else
+    if (!a_new_head)
+    {
+        return;
+    }
+#endif
+
+    // This handles wrap case too
+    (*nsvc_timer_quantum_device_reconfigure_fcn_ptr)(
+                                    next_expiry - nsvc_timer_latest_time);
+}
+
 //!
 //! @name      nsvc_timer_init
 //!
@@ -585,7 +871,14 @@ void nsvc_timer_init(nsvc_timer_get_current_time_fcn_ptr_t fptr_current_time,
     rutils_memset(nsvc_timer, 0, sizeof(nsvc_timer));
     nsvc_timer_free_list_head = NULL;
     nsvc_timer_free_list_tail = NULL;
+    nsvc_timer_queue_head = NULL;
     nsvc_timer_queue_length = 0;
+    nsvc_timer_queue_base_time = nsvc_timer_latest_time;
+#if NUFR_CS_TIMER_SLACK == 1
+    nsvc_timer_batch_deadline_valid = false;
+    nsvc_timer_quantum_is_set = false;
+    rutils_memset(&nsvc_timer_stats, 0, sizeof(nsvc_timer_stats));
+#endif
     nsvc_timer_expired_list_head = NULL;
     nsvc_timer_expired_list_tail = NULL;
 
@@ -599,6 +892,10 @@ void nsvc_timer_init(nsvc_timer_get_current_time_fcn_ptr_t fptr_current_time,
 
     // Register tick callback
     nufrplat_systick_sl_add_callback(nsvc_timer_expire_timer_callin);
+#if NUFR_CS_TICKLESS_IDLE == 1
+    // Register tickless idle callback
+    nufrplat_systick_sl_add_deadline_callback(nsvc_timer_next_expiration_callin);
+#endif
 }
 
 //!
@@ -710,16 +1007,19 @@ void nsvc_timer_free(nsvc_timer_t *tm)
 //! @param[in]     ->msg_parameter: parameter value to be set in message
 //! @param[in]     ->dest_task_id:  task to send expiration msg to.
 //! @param[in]                      Set to 'NUFR_TID_null' for self-task
+//! @param[in]     ->delivery:  (NUFR_CS_TIMER_CALLBACK only) message,
+//! @param[in]                  callback, or hybrid. Defaults to message.
+//! @param[in]     ->callback:  called on expiry, if not message delivery.
+//! @param[in]                  See 'nsvc_timer_callback_fcn_ptr_t'.
+//! @param[in]     ->coalesce:  (NUFR_CS_MSG_INDEX only) don't queue an
+//! @param[in]                  expiry message if its twin is unread.
 //!
 void nsvc_timer_start(nsvc_timer_t     *tm)
 {
     nufr_tid_t       dest_task;
     bool             is_valid_mode;
-    bool             is_new_head;
     bool             a_new_head;
     uint8_t          saved_task_priority;
-    uint32_t         previous_time;
-    nsvc_timer_t    *before_this_tm;
 
     if (IS_NOT_FROM_TIMER_POOL(tm))
     {
@@ -737,12 +1037,27 @@ void nsvc_timer_start(nsvc_timer_t     *tm)
     SL_REQUIRE_API(tm->dest_task_id < NUFR_TID_max);
     SL_REQUIRE_API(NULL == tm->flink);
     SL_REQUIRE_API(NULL == tm->blink);
+    SL_REQUIRE_API(NULL == tm->child);
+#if NUFR_CS_TIMER_SLACK == 1
+    SL_REQUIRE_API(tm->slack <= tm->duration);
+#endif
+#if NUFR_CS_TIMER_CALLBACK == 1
+    SL_REQUIRE_API(tm->delivery <= NSVC_TDELIVERY_HYBRID);
+    SL_REQUIRE_API((NSVC_TDELIVERY_MSG == tm->delivery) ||
+                   (NULL != tm->callback));
+#endif
 
     // Sanity checks
     if (!is_valid_mode || tm->is_active || (0 == tm->duration))
     {
         return;
     }
+#if NUFR_CS_TIMER_CALLBACK == 1
+    if ((NSVC_TDELIVERY_MSG != tm->delivery) && (NULL == tm->callback))
+    {
+        return;
+    }
+#endif
 
     if (NUFR_TID_null == tm->dest_task_id)
     {
@@ -767,8 +1082,8 @@ void nsvc_timer_start(nsvc_timer_t     *tm)
     //     Quantum timer/OS handler must take remedial action.
     //
     // nufr_prioritize() is used instead of NUFR_LOCK_INTERRUPTS() because
-    // timer inserts to active timer queue could take a while, as it's a
-    // an O(n) operation...to long to have interrupts locked.
+    // pending expirations are processed here too, each an O(log n) heap
+    // pop plus a message send...too long to have interrupts locked.
     nufr_prioritize();
 
     // Notify IRQ or SysTick handlers that it's not safe
@@ -778,29 +1093,23 @@ void nsvc_timer_start(nsvc_timer_t     *tm)
     // Take this opportunity to update 'nsvc_timer_latest_time'
     // Do this to avoid some timing headaches.
     // We might catch 1 or more pending expired timers.
-    previous_time = nsvc_timer_latest_time;
     nsvc_timer_latest_time = (*nsvc_timer_get_current_time_fcn_ptr)();
 
     tm->expiration_time = tm->duration + nsvc_timer_latest_time;
 
-    a_new_head = sl_timer_check_and_expire(previous_time) > 0;
+    a_new_head = sl_timer_check_and_expire(nsvc_timer_queue_base_time) > 0;
 
     a_new_head |= sl_timer_process_expired_timers();
 
-    before_this_tm = sl_timer_find_sorted_insert(tm->duration,
-                                                 &is_new_head);
-    a_new_head |= is_new_head;
-
     tm->is_active = true;
-    (void)sl_timer_active_insert(tm, before_this_tm);
+    a_new_head |= sl_timer_active_insert(tm);
 
     SL_REQUIRE(nsvc_timer_queue_length > 0);
 
     // Do we need to reconfigure quantum timer?
-    if (a_new_head && (NULL != nsvc_timer_quantum_device_reconfigure_fcn_ptr))
+    if (NULL != nsvc_timer_quantum_device_reconfigure_fcn_ptr)
     {
-        (*nsvc_timer_quantum_device_reconfigure_fcn_ptr)(
-                                          nsvc_timer_queue_head->duration);
+        sl_timer_quantum_reconfigure(a_new_head);
     }
 
     // It's safe for IRQ handlers/SysTick to touch timer lists now.
@@ -824,7 +1133,6 @@ bool nsvc_timer_kill(nsvc_timer_t     *tm)
     uint8_t          saved_task_priority;
     bool             is_timer_active;
     bool             a_new_head;
-    uint32_t         previous_time;
 
     if (IS_NOT_FROM_TIMER_POOL(tm))
     {
@@ -844,10 +1152,9 @@ bool nsvc_timer_kill(nsvc_timer_t     *tm)
     // Take this opportunity to update 'nsvc_timer_latest_time'
     // Do this to avoid some timing headaches.
     // We might catch 1 or more pending expired timers.
-    previous_time = nsvc_timer_latest_time;
     nsvc_timer_latest_time = (*nsvc_timer_get_current_time_fcn_ptr)();
 
-    a_new_head = sl_timer_check_and_expire(previous_time) > 0;
+    a_new_head = sl_timer_check_and_expire(nsvc_timer_queue_base_time) > 0;
 
     a_new_head |= sl_timer_process_expired_timers();
 
@@ -862,20 +1169,9 @@ bool nsvc_timer_kill(nsvc_timer_t     *tm)
 
     // Did either processing pending expired timers or removing
     // this timer necessitate a reprogramming of the quantum timer?
-    if (a_new_head && (NULL != nsvc_timer_quantum_device_reconfigure_fcn_ptr))
+    if (NULL != nsvc_timer_quantum_device_reconfigure_fcn_ptr)
     {
-        // Reconfigure to new timer value
-        if (nsvc_timer_queue_length > 0)
-        {
-            // Adjust quantum timeout
-            (*nsvc_timer_quantum_device_reconfigure_fcn_ptr)(
-                                        nsvc_timer_queue_head->duration);
-        }
-        // Timer that was killed was only active timer? Stop quantum timer
-        else
-        {
-            (*nsvc_timer_quantum_device_reconfigure_fcn_ptr)(0);        
-        }
+        sl_timer_quantum_reconfigure(a_new_head);
     }
 
     // It's safe for IRQ handlers/SysTick to touch timer lists now.
@@ -892,6 +1188,49 @@ bool nsvc_timer_kill(nsvc_timer_t     *tm)
 //!
 //! @name      nsvc_timer_next_expiration_callin
 //!
+//! @brief     Callin to get time until next app timer expires
+//!
+//! @details   For tickless idle: lets the platform program a one-shot
+//! @details   OS tick which expires no later than the next app timer.
+//! @details   Called with interrupts locked, from BG task.
+//! @details   Wrap-safe: all time comparisons are deltas from
+//! @details   'nsvc_timer_latest_time'.
+//!
+//! @return    Time in millisecs until next app timer expires.
+//! @return    0 if no app timers are running.
+//! @return    1 if a timer is overdue, or if timer queue is being
+//! @return      updated at task level, so that caller checks back soon.
+//!
+uint32_t nsvc_timer_next_expiration_callin(void)
+{
+    uint32_t since_latest;
+    uint32_t until_expiration;
+
+    if (nsvc_timer_queue_update_in_progress)
+    {
+        return 1;
+    }
+    else if (0 == nsvc_timer_queue_length)
+    {
+        return 0;
+    }
+
+    since_latest = (*nsvc_timer_get_current_time_fcn_ptr)() -
+                   nsvc_timer_latest_time;
+    until_expiration = sl_timer_next_expiry_time() -
+                       nsvc_timer_latest_time;
+
+    if (since_latest >= until_expiration)
+    {
+        return 1;
+    }
+
+    return until_expiration - since_latest;
+}
+
+//!
+//! @name      nsvc_timer_expire_timer_callin
+//!
 //! @brief     Callin to handle timer expirations
 //!
 //! @details   Called from one of the following:
@@ -913,11 +1252,11 @@ bool nsvc_timer_kill(nsvc_timer_t     *tm)
 //! @details   within this window to have expired.
 //! @details   
 //! @details   Expired timers are taken off the active timer
-//! @details   list and placed on the expired timer list.
+//! @details   heap and placed on the expired timer list.
 //! @details   The expired timer list is then processed/drained.
 //! @details   Each expired timer has its message sent.
 //! @details   If an expired timer is continuous, it is
-//! @details   reset: placed back on the active timer list.
+//! @details   reset: placed back on the active timer heap.
 //! @details   
 //! @details   For whatever actions are taken, a new interval
 //! @details   to the next timeout is calculated. If the caller
@@ -941,7 +1280,8 @@ bool nsvc_timer_kill(nsvc_timer_t     *tm)
 //!
 //! @return    Action for quantum timer, or perhaps OS tick handler,
 //! @return    to take:
-//! @return     'NSVC_TCRTN_DISABLE_QUANTUM_TIMER'-- halt quantum timer
+//! @return     'NSVC_TCRTN_DISABLE_QUANTUM_TIMER'-- halt quantum timer,
+//! @return         no active timers.
 //! @return     'NSVC_TCRTN_RECONFIGURE_QUANTUM_TIMER'-- set quantum
 //! @return         timeout to new value.
 //! @return     'NSVC_TCRTN_BACKOFF_QUANTUM_TIMER'-- SL timer module busy
@@ -954,9 +1294,7 @@ uint8_t nsvc_timer_expire_timer_callin(
                                     uint32_t     *reconfigured_time_ptr)
 {
     nsvc_timer_callin_return_t rv;
-    uint32_t                   previous_time;
     uint32_t                   expiration_time;
-    bool                       a_new_head;
 
     // If 'nsvc_timer_queue_update_in_progress' is set, tell
     // caller to do a spin-lock equivalent.
@@ -968,28 +1306,25 @@ uint8_t nsvc_timer_expire_timer_callin(
     }
 
     // Update 'nsvc_timer_latest_time'
-    previous_time = nsvc_timer_latest_time;
     nsvc_timer_latest_time = current_time;
 
-    // Any timers expired?
-    a_new_head = sl_timer_check_and_expire(previous_time) > 0;
-
-    // 'a_new_head'==true when the next active timer changed,
-    // also if there is no longer an active timer.
-    a_new_head |= sl_timer_process_expired_timers();
+    // Any timers expired? Expire them, and reset continuous timers.
+    (void)sl_timer_check_and_expire(nsvc_timer_queue_base_time);
+    (void)sl_timer_process_expired_timers();
 
     // Calculate 'reconfigured_time_ptr':
-    //   interval to next active timer's timeout
-    if (a_new_head && (nsvc_timer_queue_length > 0))
+    //   interval to next expiry. With timer slack, this may
+    //   be a callin which held back expiring timers for a batch.
+    if (nsvc_timer_queue_length > 0)
     {
-        expiration_time = nsvc_timer_queue_head->expiration_time;
+        expiration_time = sl_timer_next_expiry_time();
 
         // This handles wrap case too
         *reconfigured_time_ptr = expiration_time - nsvc_timer_latest_time;
 
         rv = NSVC_TCRTN_RECONFIGURE_QUANTUM_TIMER;
     }
-    // No change in next timer to expire
+    // No active timers
     else
     {
         *reconfigured_time_ptr = 0;
@@ -997,5 +1332,45 @@ uint8_t nsvc_timer_expire_timer_callin(
         rv = NSVC_TCRTN_DISABLE_QUANTUM_TIMER;
     }
 
+#if NUFR_CS_TIMER_SLACK == 1
+    // Caller reprograms quantum timer from return value
+    if (NULL != nsvc_timer_quantum_device_reconfigure_fcn_ptr)
+    {
+        nsvc_timer_quantum_deadline = *reconfigured_time_ptr +
+                                      nsvc_timer_latest_time;
+        nsvc_timer_quantum_is_set =
+                      (NSVC_TCRTN_RECONFIGURE_QUANTUM_TIMER == rv);
+        nsvc_timer_stats.reprograms++;
+    }
+#endif
+
     return rv;
-}
\ No newline at end of file
+}
+
+#if NUFR_CS_TIMER_SLACK == 1
+//!
+//! @name      nsvc_timer_stats_get
+//!
+//! @brief     Snapshot of timer coalescing statistics.
+//!
+//! @details   Not atomic with respect to timer callins in progress.
+//!
+//! @param[out] 'stats_ptr'
+//!
+void nsvc_timer_stats_get(nsvc_timer_stats_t *stats_ptr)
+{
+    SL_REQUIRE_API(NULL != stats_ptr);
+
+    rutils_memcpy(stats_ptr, &nsvc_timer_stats, sizeof(nsvc_timer_stats));
+}
+
+//!
+//! @name      nsvc_timer_stats_reset
+//!
+//! @brief     Clears timer coalescing statistics.
+//!
+void nsvc_timer_stats_reset(void)
+{
+    rutils_memset(&nsvc_timer_stats, 0, sizeof(nsvc_timer_stats));
+}
+#endif  //NUFR_CS_TIMER_SLACK
\ No newline at end of file
@@ -0,0 +1,348 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file    nsvc-work.c
+//! @authors agent
+//! @date    16Oct26
+//!
+//! @brief   SL deferred work queue
+//!
+//! @details ISRs (or tasks) call 'nsvc_work_defer()' to have a
+//! @details (function, argument) item run on the worker task, rather
+//! @details than sending a message per interrupt.
+//! @details
+//! @details Each priority has its own ring. A producer claims a slot
+//! @details by a compare-and-swap on 'head', fills it in, then
+//! @details publishes it by writing 'sequence' = claimed index + 1. No
+//! @details interrupt lock is taken, so nested ISRs may defer too.
+//! @details The worker only takes a slot whose 'sequence' matches, so a
+//! @details slot still being filled in by a preempted producer is left
+//! @details for the next batch.
+//! @details
+//! @details The worker is woken by one message per batch, not per item:
+//! @details only the producer which sets 'nsvc_work_pending' from 0 to 1
+//! @details sends it. The worker clears it before draining the rings.
+//! @details
+//! @details The app owns the worker task: it gives the task an entry of
+//! @details 'nsvc_work_task_entry()', at a priority above the tasks the
+//! @details work was deferred from, and passes its tid to
+//! @details 'nsvc_work_init()'.
+//!
+
+#include "nufr-global.h"
+
+#if NUFR_CS_DEFERRED_WORK == 1
+
+#include "nsvc-api.h"
+#include "nsvc.h"
+#include "nufr-api.h"
+#include "nufr-platform.h"
+#include "nufr-platform-app.h"
+
+#include "raging-contract.h"
+#include "raging-utils-mem.h"
+
+// Slot lookup masks the index, so ring size must be a power of 2
+#if (NSVC_WORK_RING_SIZE & (NSVC_WORK_RING_SIZE - 1)) != 0
+    #error "NSVC_WORK_RING_SIZE must be a power of 2"
+#endif
+
+//!
+//! @name      NSVC_WORK_WAKE_FIELDS
+//!
+//! @details   Wake message. No sender: it may come from an ISR.
+//!
+#define NSVC_WORK_WAKE_FIELDS                                          \
+    NUFR_SET_MSG_FIELDS(NSVC_MSG_PREFIX_local, 1, NUFR_TID_null,       \
+                        NUFR_MSG_PRI_MID)
+
+//!
+//! @struct    nsvc_work_item_t
+//!
+//! @details   'sequence' of claimed index + 1 means published
+//!
+typedef struct
+{
+    uint32_t            sequence;
+    uint32_t            timestamp;
+    nsvc_work_fcn_ptr_t fcn_ptr;
+    uint32_t            argument;
+} nsvc_work_item_t;
+
+//!
+//! @struct    nsvc_work_ring_t
+//!
+//! @details   'head' and 'tail' are free-running. Slot = index modulo
+//! @details   size. Producers advance 'head'; only the worker 'tail'.
+//!
+typedef struct
+{
+    volatile uint32_t   head;
+    volatile uint32_t   tail;
+    nsvc_work_item_t    items[NSVC_WORK_RING_SIZE];
+} nsvc_work_ring_t;
+
+//!
+//!  @brief       Rings, worker and statistics
+//!
+nsvc_work_ring_t         nsvc_work_rings[NSVC_WORK_PRIORITIES];
+nufr_tid_t               nsvc_work_tid;
+volatile uint32_t        nsvc_work_pending;
+nsvc_work_stats_t        nsvc_work_stats;
+
+
+//! @name      nsvc_work_init
+//
+//! @brief     Empties the rings and clears statistics.
+//
+//! @details   Call after 'nsvc_init()', before any defers or the
+//! @details   worker task is launched.
+//
+//! @param[in] 'worker_tid'-- task running 'nsvc_work_task_entry()'
+void nsvc_work_init(nufr_tid_t worker_tid)
+{
+    SL_REQUIRE_API(NUFR_TID_null != worker_tid);
+
+    rutils_memset(nsvc_work_rings, 0, sizeof(nsvc_work_rings));
+    rutils_memset(&nsvc_work_stats, 0, sizeof(nsvc_work_stats));
+
+    nsvc_work_tid = worker_tid;
+    nsvc_work_pending = 0;
+}
+
+//! @name      nsvc_work_defer
+//
+//! @brief     Queues 'fcn_ptr(argument)' to run on the worker task.
+//
+//! @details   Callable from an ISR or any task, interrupts locked or
+//! @details   not. Wakes the worker if it isn't already due to run.
+//
+//! @param[in] 'priority'-- ring, 0 is highest
+//! @param[in] 'fcn_ptr'
+//! @param[in] 'argument'-- passed to 'fcn_ptr'
+//
+//! @return    'false' if the ring was full. Item dropped.
+bool nsvc_work_defer(unsigned            priority,
+                     nsvc_work_fcn_ptr_t fcn_ptr,
+                     uint32_t            argument)
+{
+    nsvc_work_ring_t          *ring;
+    nsvc_work_ring_stats_t    *stats;
+    volatile nsvc_work_item_t *item;
+    nufr_msg_send_rtn_t        send_rv;
+    uint32_t                   head;
+
+    SL_REQUIRE_API(priority < NSVC_WORK_PRIORITIES);
+    SL_REQUIRE_API(NULL != fcn_ptr);
+    SL_REQUIRE_API(NUFR_TID_null != nsvc_work_tid);
+
+    ring = &nsvc_work_rings[priority];
+    stats = &nsvc_work_stats.ring[priority];
+
+    // Claim a slot
+    do
+    {
+        head = ring->head;
+
+        if (head - ring->tail >= NSVC_WORK_RING_SIZE)
+        {
+            (void)NUFR_ATOMIC_FETCH_INC32(&stats->dropped);
+
+            return false;
+        }
+    } while (!NUFR_ATOMIC_CAS32(&ring->head, head, head + 1));
+
+    item = &ring->items[head & (NSVC_WORK_RING_SIZE - 1)];
+
+    item->fcn_ptr = fcn_ptr;
+    item->argument = argument;
+    item->timestamp = NUFR_TASK_STATS_TIMESTAMP();
+
+    // Publish
+    item->sequence = head + 1;
+
+    (void)NUFR_ATOMIC_FETCH_INC32(&stats->deferred);
+
+    // First defer since worker last woke sends the wake
+    if (NUFR_ATOMIC_CAS32(&nsvc_work_pending, 0, 1))
+    {
+        send_rv = nufr_msg_send(NSVC_WORK_WAKE_FIELDS, 0, nsvc_work_tid);
+
+        // Worker didn't get it (not launched, queue at its limit):
+        //   let the next defer try again
+        if ((NUFR_MSG_SEND_ERROR == send_rv) ||
+            (NUFR_MSG_SEND_QUEUE_FULL == send_rv))
+        {
+            nsvc_work_pending = 0;
+            (void)NUFR_ATOMIC_FETCH_INC32(&nsvc_work_stats.wake_fails);
+        }
+    }
+
+    return true;
+}
+
+//! @name      nsvc_work_run_one
+//
+//! @brief     Runs the oldest published item of the highest priority
+//! @brief     ring which has one.
+//
+//! @return    'false' if there was nothing to run
+static bool nsvc_work_run_one(void)
+{
+    nsvc_work_ring_t          *ring;
+    nsvc_work_ring_stats_t    *stats;
+    volatile nsvc_work_item_t *item;
+    nsvc_work_fcn_ptr_t        fcn_ptr;
+    uint32_t                   argument;
+    uint32_t                   latency;
+    uint32_t                   tail;
+    unsigned                   priority;
+    unsigned                   bucket;
+
+    for (priority = 0; priority < NSVC_WORK_PRIORITIES; priority++)
+    {
+        ring = &nsvc_work_rings[priority];
+        tail = ring->tail;
+        item = &ring->items[tail & (NSVC_WORK_RING_SIZE - 1)];
+
+        // Empty, or producer still filling in slot
+        if (item->sequence != tail + 1)
+        {
+            continue;
+        }
+
+        fcn_ptr = item->fcn_ptr;
+        argument = item->argument;
+        latency = NUFR_TASK_STATS_TIMESTAMP() - item->timestamp;
+
+        // Slot can be reused now
+        ring->tail = tail + 1;
+
+        // log2 bucket: 0 for 0, 'n' for 2^(n-1) .. 2^n - 1
+        if (0 == latency)
+        {
+            bucket = 0;
+        }
+        else
+        {
+            bucket = BITS_PER_WORD32 - NUFR_CLZ32(latency);
+
+            if (bucket >= NSVC_WORK_LATENCY_BUCKETS)
+            {
+                bucket = NSVC_WORK_LATENCY_BUCKETS - 1;
+            }
+        }
+
+        stats = &nsvc_work_stats.ring[priority];
+        stats->executed++;
+        stats->latency_histogram[bucket]++;
+        if (latency > stats->latency_max)
+        {
+            stats->latency_max = latency;
+        }
+
+        fcn_ptr(argument);
+
+        return true;
+    }
+
+    return false;
+}
+
+//! @name      nsvc_work_run
+//
+//! @brief     Runs deferred items until all rings are empty.
+//
+//! @details   Called by the worker task. Rings are rescanned after each
+//! @details   item, so work deferred at a higher priority goes next.
+//
+//! @return    Number of items run
+unsigned nsvc_work_run(void)
+{
+    unsigned count = 0;
+
+    while (nsvc_work_run_one())
+    {
+        count++;
+    }
+
+    if (count > 0)
+    {
+        nsvc_work_stats.batches++;
+        if (count > nsvc_work_stats.batch_max)
+        {
+            nsvc_work_stats.batch_max = count;
+        }
+    }
+
+    return count;
+}
+
+//! @name      nsvc_work_task_entry
+//
+//! @brief     Worker task entry point. Never returns.
+//
+//! @param[in] 'parm'-- unused
+void nsvc_work_task_entry(unsigned parm)
+{
+    uint32_t fields;
+    uint32_t parameter;
+
+    UNUSED(parm);
+
+    while (1)
+    {
+        nufr_msg_getW(&fields, &parameter);
+
+        // Defers from here on must send a new wake
+        nsvc_work_pending = 0;
+
+        (void)nsvc_work_run();
+    }
+}
+
+//! @name      nsvc_work_stats_get
+//
+//! @brief     Snapshot of deferred work statistics.
+//
+//! @details   Not atomic with respect to defers in progress.
+//
+//! @param[out] 'stats_ptr'
+void nsvc_work_stats_get(nsvc_work_stats_t *stats_ptr)
+{
+    SL_REQUIRE_API(NULL != stats_ptr);
+
+    rutils_memcpy(stats_ptr, &nsvc_work_stats, sizeof(nsvc_work_stats));
+}
+
+//! @name      nsvc_work_stats_reset
+//
+//! @brief     Clears deferred work statistics.
+void nsvc_work_stats_reset(void)
+{
+    rutils_memset(&nsvc_work_stats, 0, sizeof(nsvc_work_stats));
+}
+
+#endif  //NUFR_CS_DEFERRED_WORK
@@ -0,0 +1,502 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file    nufr-kernel-event.c
+//! @authors agent
+//! @date    16Oct26
+//!
+//! @brief   Event flag groups
+//!
+//! @details Each group holds 32 flags. Tasks block until any or all
+//! @details of a set of flags are set. Setting flags walks the wait
+//! @details list, highest priority waiter first, readying each waiter
+//! @details whose wait is satisfied. With NUFR_EVENT_CONSUME, a woken
+//! @details waiter's flags are cleared before lower priority waiters
+//! @details are checked.
+
+#define NUFR_EVENT_GLOBAL_DEFS
+
+#include "nufr-global.h"
+
+#if NUFR_CS_EVENT == 1
+
+#include "nufr-kernel-base-event.h"
+#include "nufr-platform-app.h"
+#include "nufr-api.h"
+#include "nufr-kernel-event.h"
+#include "nufr-kernel-task.h"
+#include "nufr-kernel-trace.h"
+#if NUFR_CS_OPTIMIZATION_INLINES == 1
+    #include "nufr-kernel-task-inlines.h"
+#endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
+#include "nufr-kernel-timer.h"
+
+#include "raging-contract.h"
+#include "raging-utils-mem.h"
+
+#ifdef USING_SECONDARY_CONTEXT_SWITCH_FILE
+    #include "secondary-context-switch.h"
+#endif
+
+//!
+//!  @brief       Event flag group blocks
+//!
+nufr_event_block_t nufr_event_block[NUFR_NUM_EVENTS];
+
+
+//!
+//! @name      EVENT_IS_SATISFIED
+//!
+//! @brief     Are flags in 'matched' enough to satisfy a wait?
+//!
+#define EVENT_IS_SATISFIED(matched, wait_flags, options)                     \
+    (ANY_BITS_SET((options), NUFR_EVENT_WAIT_ALL) ?                          \
+        ((matched) == (wait_flags)) : (0 != (matched)))
+
+
+//!
+//! @name      nufrkernel_event_link_task
+//!
+//! @brief     Internal call to add a tcb to an event group's wait list.
+//! @brief     List is priority sorted; tcb goes behind others of its
+//! @brief     own priority.
+//!
+//! @details   Calling environment:
+//! @details     (1) Caller must lock interrupts
+//! @details     (2) This API intended for nufr kernel use
+//!
+//! @param[in] 'event_block'-- task added to this group's wait list
+//! @param[in] 'add_tcb'--task to be added
+//!
+void nufrkernel_event_link_task(nufr_event_block_t *event_block,
+                                nufr_tcb_t         *add_tcb)
+{
+    nufr_tcb_t            **link_ptr;
+
+    KERNEL_REQUIRE_IL(NUFR_IS_EVENT_BLOCK(event_block));
+    KERNEL_REQUIRE_IL(NUFR_IS_TCB(add_tcb));
+    KERNEL_REQUIRE_IL(add_tcb->flink == NULL);
+
+    link_ptr = &event_block->task_list_head;
+
+    while ((NULL != *link_ptr) &&
+           ((*link_ptr)->priority <= add_tcb->priority))
+    {
+        link_ptr = &(*link_ptr)->flink;
+    }
+
+    add_tcb->flink = *link_ptr;
+    *link_ptr = add_tcb;
+}
+
+//!
+//! @name      nufrkernel_event_unlink_task
+//!
+//! @brief     Internal call to remove a tcb from an event group's
+//! @brief     wait list. Assumes that tcb is on the list.
+//!
+//! @details   Calling environment:
+//! @details     (1) Caller must lock interrupts
+//! @details     (2) This API intended for nufr kernel use
+//!
+//! @param[in] 'event_block'-- task removed from this group's wait list
+//! @param[in] 'delete_tcb'--task to be removed
+//!
+void nufrkernel_event_unlink_task(nufr_event_block_t *event_block,
+                                  nufr_tcb_t         *delete_tcb)
+{
+    nufr_tcb_t            **link_ptr;
+
+    KERNEL_REQUIRE_IL(NUFR_IS_EVENT_BLOCK(event_block));
+    KERNEL_REQUIRE_IL(NUFR_IS_TCB(delete_tcb));
+
+    link_ptr = &event_block->task_list_head;
+
+    while (*link_ptr != delete_tcb)
+    {
+        KERNEL_ENSURE_IL(NULL != *link_ptr);
+
+        link_ptr = &(*link_ptr)->flink;
+    }
+
+    *link_ptr = delete_tcb->flink;
+    delete_tcb->flink = NULL;
+}
+
+//!
+//! @name      nufr_event_get
+//!
+//! @brief     Returns the flags currently set in an event group
+//!
+//! @param[in] 'event'
+//!
+//! @return    flags
+//!
+uint32_t nufr_event_get(nufr_event_t event)
+{
+    nufr_event_block_t *event_block;
+
+    event_block = NUFR_EVENT_ID_TO_BLOCK(event);
+
+    KERNEL_REQUIRE_API(NUFR_IS_EVENT_BLOCK(event_block));
+
+    // No interrupt locking needed
+    return event_block->flags;
+}
+
+//!
+//! @name      nufr_event_set
+//!
+//! @brief     Sets flags in an event group, readying waiters whose
+//! @brief     waits become satisfied.
+//!
+//! @details   Callable from ISRs and the BG task.
+//! @details   Waiters are checked in priority order. A woken waiter's
+//! @details   tcb->event_flags is set to the flags which satisfied it.
+//!
+//! @param[in] 'event'
+//! @param[in] 'flags'-- flags to set
+//!
+//! @return    'true' if one or more waiters were readied
+//!
+bool nufr_event_set(nufr_event_t event, uint32_t flags)
+{
+#if NUFR_CS_OPTIMIZATION_INLINES == 1
+    NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS;
+#endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
+    nufr_sr_reg_t           saved_psr;
+    nufr_event_block_t     *event_block;
+    nufr_tcb_t            **link_ptr;
+    nufr_tcb_t             *tcb;
+    uint32_t                matched;
+    bool                    woke = false;
+    bool                    invoke = false;
+
+    event_block = NUFR_EVENT_ID_TO_BLOCK(event);
+    KERNEL_REQUIRE_API(NUFR_IS_EVENT_BLOCK(event_block));
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    event_block->flags |= flags;
+
+    link_ptr = &event_block->task_list_head;
+
+    while (NULL != *link_ptr)
+    {
+        tcb = *link_ptr;
+
+        matched = event_block->flags & tcb->event_flags;
+
+        if (!EVENT_IS_SATISFIED(matched, tcb->event_flags,
+                                tcb->event_options))
+        {
+            link_ptr = &tcb->flink;
+            continue;
+        }
+
+        // Unlink, leaving 'link_ptr' pointing at the next waiter
+        *link_ptr = tcb->flink;
+        tcb->flink = NULL;
+
+        if (ANY_BITS_SET(tcb->event_options, NUFR_EVENT_CONSUME))
+        {
+            event_block->flags &= BITWISE_NOT32(matched);
+        }
+
+        tcb->event_flags = matched;
+        tcb->event_block = NULL;
+
+        // NOTE: Timer, if any, is killed by waiter on API exit,
+        //       as this can be called from an ISR.
+        tcb->block_flags = 0;
+
+    #if NUFR_CS_OPTIMIZATION_INLINES == 1
+        NUFRKERNEL_ADD_TASK_TO_READY_LIST(tcb);
+        invoke |= macro_do_switch;
+    #else
+        invoke |= nufrkernel_add_task_to_ready_list(tcb);
+    #endif
+
+        woke = true;
+    }
+
+    if (invoke)
+    {
+        NUFR_INVOKE_CONTEXT_SWITCH();
+    }
+
+    NUFR_TRACE(NUFR_TRACE_EVENT_SET, 0, event, event_block->flags);
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+
+    return woke;
+}
+
+//!
+//! @name      nufr_event_clear
+//!
+//! @brief     Clears flags in an event group
+//!
+//! @details   Callable from ISRs and the BG task. Never readies a task.
+//!
+//! @param[in] 'event'
+//! @param[in] 'flags'-- flags to clear
+//!
+void nufr_event_clear(nufr_event_t event, uint32_t flags)
+{
+    nufr_sr_reg_t           saved_psr;
+    nufr_event_block_t     *event_block;
+
+    event_block = NUFR_EVENT_ID_TO_BLOCK(event);
+    KERNEL_REQUIRE_API(NUFR_IS_EVENT_BLOCK(event_block));
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    event_block->flags &= BITWISE_NOT32(flags);
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+}
+
+//!
+//! @name      event_wait
+//!
+//! @brief     Common code for nufr_event_waitW() and nufr_event_waitT()
+//!
+//! @param[in] 'timed'-- 'false' for nufr_event_waitW(), 'timeout_ticks'
+//! @param[in]           then ignored
+//!
+static nufr_event_wait_rtn_t event_wait(nufr_event_t    event,
+                                        uint32_t        wait_flags,
+                                        unsigned        options,
+                                        uint32_t       *flags_ptr,
+                                        nufr_msg_pri_t  abort_priority_of_rx_msg,
+                                        unsigned        timeout_ticks,
+                                        bool            timed)
+{
+    nufr_sr_reg_t           saved_psr;
+    nufr_event_block_t     *event_block;
+    nufr_event_wait_rtn_t   return_value;
+    uint32_t                matched;
+    unsigned                notifications;
+    bool                    satisfied;
+    bool                    block_on_event = false;
+    bool                    immediate_timeout;
+
+    event_block = NUFR_EVENT_ID_TO_BLOCK(event);
+
+    KERNEL_REQUIRE_API(NUFR_IS_EVENT_BLOCK(event_block));
+    KERNEL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+    KERNEL_REQUIRE_API(0 != wait_flags);
+#if NUFR_CS_TASK_KILL == 1
+    KERNEL_REQUIRE_API(abort_priority_of_rx_msg < NUFR_CS_MSG_PRIORITIES);
+#else
+    UNUSED(abort_priority_of_rx_msg);
+#endif  //NUFR_CS_TASK_KILL
+
+    immediate_timeout = timed && (0 == timeout_ticks);
+
+    //######   Step One: Check flags, block if not satisfied
+    //###
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    matched = event_block->flags & wait_flags;
+    satisfied = EVENT_IS_SATISFIED(matched, wait_flags, options);
+
+    if (satisfied)
+    {
+        if (ANY_BITS_SET(options, NUFR_EVENT_CONSUME))
+        {
+            event_block->flags &= BITWISE_NOT32(matched);
+        }
+    }
+    else if (!immediate_timeout)
+    {
+        block_on_event = true;
+
+    #if NUFR_CS_OPTIMIZATION_INLINES == 1
+        NUFRKERNEL_BLOCK_RUNNING_TASK(NUFR_TASK_BLOCKED_EVENT);
+    #else
+        nufrkernel_block_running_task(NUFR_TASK_BLOCKED_EVENT);
+    #endif
+
+        nufr_running->event_block = event_block;
+        nufr_running->event_flags = wait_flags;
+        nufr_running->event_options = (uint8_t)options;
+
+        nufrkernel_event_link_task(event_block, nufr_running);
+
+        nufr_running->notifications = 0;
+    #if NUFR_CS_TASK_KILL == 1
+        nufr_running->abort_message_priority = abort_priority_of_rx_msg;
+    #endif  // NUFR_CS_TASK_KILL
+
+        if (timed)
+        {
+            nufrkernel_add_to_timer_list(nufr_running, timeout_ticks);
+        }
+
+        NUFR_INVOKE_CONTEXT_SWITCH();
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+
+    // Task will block/resume here if 'block_on_event' is 'true'
+
+
+    //##### Step Two: Kill zombie timer
+    if (block_on_event && timed)
+    {
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        if (NUFR_IS_STATUS_SET(nufr_running, NUFR_TASK_TIMER_RUNNING))
+        {
+            nufrkernel_purge_from_timer_list(nufr_running);
+        }
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+    }
+
+    //#####     Step Three: Calculate return value
+    //###
+    if (satisfied)
+    {
+        return_value = NUFR_EVENT_WAIT_OK_NO_BLOCK;
+    }
+    else if (!block_on_event)
+    {
+        return_value = NUFR_EVENT_WAIT_TIMEOUT;
+    }
+    else
+    {
+        // Interrupt locking not needed
+        notifications = nufr_running->notifications;
+
+    #if NUFR_CS_TASK_KILL == 1
+        if (ANY_BITS_SET(notifications, NUFR_TASK_UNBLOCKED_BY_MSG_SEND))
+        {
+            return_value = NUFR_EVENT_WAIT_MSG_ABORT;
+        }
+        else
+    #endif  //NUFR_CS_TASK_KILL
+        if (ANY_BITS_SET(notifications, NUFR_TASK_TIMEOUT))
+        {
+            return_value = NUFR_EVENT_WAIT_TIMEOUT;
+        }
+        else
+        {
+            return_value = NUFR_EVENT_WAIT_OK_BLOCK;
+        }
+
+        // Woken by nufr_event_set(): it saved flags which satisfied wait.
+        // Otherwise, report what's set now.
+        if (NUFR_EVENT_WAIT_OK_BLOCK == return_value)
+        {
+            matched = nufr_running->event_flags;
+        }
+        else
+        {
+            matched = event_block->flags & wait_flags;
+        }
+    }
+
+    if (NULL != flags_ptr)
+    {
+        *flags_ptr = matched;
+    }
+
+    NUFR_TRACE(NUFR_TRACE_EVENT_WAIT, NUFR_TRACE_TID(nufr_running), event,
+               return_value);
+
+    return return_value;
+}
+
+//!
+//! @name      nufr_event_waitW
+//!
+//! @brief     Waits, with no timeout, for any or all of 'wait_flags'
+//!
+//! @details   Cannot be called from an ISR or from BG task
+//!
+//! @param[in] 'event'
+//! @param[in] 'wait_flags'-- flags to wait for. Must be non-zero.
+//! @param[in] 'options'-- NUFR_EVENT_WAIT_ANY or NUFR_EVENT_WAIT_ALL,
+//! @param[in]             optionally or'd with NUFR_EVENT_CONSUME
+//! @param[out] 'flags_ptr'-- if not NULL, flags out of 'wait_flags'
+//! @param[out]               which were set. May be NULL.
+//! @param[in] 'abort_priority_of_rx_msg'--  If a message that's of a
+//! @param[in]     priority greater than 'abort_priority_of_rx_msg' is sent
+//! @param[in]     to the waiting task's message queue, the wait
+//! @param[in]     is aborted.
+//!
+//! @return     Wait result
+//!
+nufr_event_wait_rtn_t nufr_event_waitW(nufr_event_t    event,
+                                       uint32_t        wait_flags,
+                                       unsigned        options,
+                                       uint32_t       *flags_ptr,
+                                       nufr_msg_pri_t  abort_priority_of_rx_msg)
+{
+    return event_wait(event, wait_flags, options, flags_ptr,
+                      abort_priority_of_rx_msg, 0, false);
+}
+
+//!
+//! @name      nufr_event_waitT
+//!
+//! @brief     Waits, with a timeout, for any or all of 'wait_flags'
+//!
+//! @details   Cannot be called from an ISR or from BG task
+//!
+//! @param[in] 'event'
+//! @param[in] 'wait_flags'-- flags to wait for. Must be non-zero.
+//! @param[in] 'options'-- NUFR_EVENT_WAIT_ANY or NUFR_EVENT_WAIT_ALL,
+//! @param[in]             optionally or'd with NUFR_EVENT_CONSUME
+//! @param[out] 'flags_ptr'-- if not NULL, flags out of 'wait_flags'
+//! @param[out]               which were set. May be NULL.
+//! @param[in] 'abort_priority_of_rx_msg'--  If a message that's of a
+//! @param[in]     priority greater than 'abort_priority_of_rx_msg' is sent
+//! @param[in]     to the waiting task's message queue, the wait
+//! @param[in]     is aborted.
+//! @param[in] 'timeout_ticks'-- Timeout in OS ticks. If ==0, no waiting
+//! @param[in]                   if wait not already satisfied.
+//!
+//! @return     Wait result
+//!
+nufr_event_wait_rtn_t nufr_event_waitT(nufr_event_t    event,
+                                       uint32_t        wait_flags,
+                                       unsigned        options,
+                                       uint32_t       *flags_ptr,
+                                       nufr_msg_pri_t  abort_priority_of_rx_msg,
+                                       unsigned        timeout_ticks)
+{
+    return event_wait(event, wait_flags, options, flags_ptr,
+                      abort_priority_of_rx_msg, timeout_ticks, true);
+}
+
+#endif  //NUFR_CS_EVENT
@@ -0,0 +1,233 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file    nufr-kernel-lock-profile.c
+//! @authors agent
+//! @date    16Oct26
+//!
+//! @brief   Interrupt lock hold time profiler
+//!
+
+#define NUFR_LOCK_PROFILE_GLOBAL_DEFS
+
+#include "nufr-global.h"
+
+#if NUFR_CS_LOCK_PROFILE == 1
+
+#include "nufr-platform.h"
+#include "nufr-api.h"
+#include "nufr-kernel-lock-profile.h"
+
+#include "raging-contract.h"
+#include "raging-utils-mem.h"
+
+// Site lookup masks the hash, so table size must be a power of 2
+#if (NUFR_LOCK_PROFILE_SITES & (NUFR_LOCK_PROFILE_SITES - 1)) != 0
+    #error "NUFR_LOCK_PROFILE_SITES must be a power of 2"
+#endif
+
+//!
+//!  @brief       Per-site results, hashed by site. 'file' NULL if unused.
+//!
+nufr_lock_profile_site_t nufr_lock_profile_sites[NUFR_LOCK_PROFILE_SITES];
+
+//!
+//!  @brief       Holds not recorded because table was full
+//!
+uint32_t nufr_lock_profile_overflows;
+
+// Outermost lock in progress
+static uint32_t    lock_start_time;
+static const char *lock_file;
+static unsigned    lock_line;
+
+
+//! @name      lock_profile_record
+//
+//! @brief     Adds one lock hold time to its site's results.
+//
+//! @details   Sites match on __FILE__ pointer and line, so a lock
+//! @details   in a header shows up once per including file.
+//
+//! @param[in] file-- __FILE__ of NUFR_LOCK_INTERRUPTS()
+//! @param[in] line-- __LINE__ of NUFR_LOCK_INTERRUPTS()
+//! @param[in] hold_time-- in platform timestamp units
+static void lock_profile_record(const char *file,
+                                unsigned    line,
+                                uint32_t    hold_time)
+{
+    nufr_lock_profile_site_t *site;
+    unsigned                  index;
+    unsigned                  probes;
+    unsigned                  bucket;
+
+    index = line & (NUFR_LOCK_PROFILE_SITES - 1);
+
+    // Linear probe for site, or for an unused entry to claim
+    for (probes = 0; probes < NUFR_LOCK_PROFILE_SITES; probes++)
+    {
+        site = &nufr_lock_profile_sites[index];
+
+        if (NULL == site->file)
+        {
+            site->file = file;
+            site->line = line;
+            break;
+        }
+        else if ((file == site->file) && (line == site->line))
+        {
+            break;
+        }
+
+        index = (index + 1) & (NUFR_LOCK_PROFILE_SITES - 1);
+    }
+
+    if (NUFR_LOCK_PROFILE_SITES == probes)
+    {
+        nufr_lock_profile_overflows++;
+        return;
+    }
+
+    // log2 bucket: 0 for 0, 'n' for 2^(n-1) .. 2^n - 1
+    if (0 == hold_time)
+    {
+        bucket = 0;
+    }
+    else
+    {
+        bucket = BITS_PER_WORD32 - NUFR_CLZ32(hold_time);
+
+        if (bucket >= NUFR_LOCK_PROFILE_BUCKETS)
+        {
+            bucket = NUFR_LOCK_PROFILE_BUCKETS - 1;
+        }
+    }
+
+    site->count++;
+    site->histogram[bucket]++;
+    if (hold_time > site->max)
+    {
+        site->max = hold_time;
+    }
+}
+
+//! @name      nufrkernel_lock_profile_enter
+//
+//! @brief     Notes site and time of an outermost interrupt lock.
+//
+//! @details   Called from NUFR_LOCK_INTERRUPTS(), after the lock is
+//! @details   taken. A 'saved_psr' of 0 means interrupts weren't
+//! @details   already locked: on PC it's the prior lock depth, on ARM
+//! @details   the prior BASEPRI. Nested locks are part of the outer hold.
+//
+//! @param[in] saved_psr-- what the platform lock returned
+//! @param[in] file-- __FILE__ of NUFR_LOCK_INTERRUPTS()
+//! @param[in] line-- __LINE__ of NUFR_LOCK_INTERRUPTS()
+//
+//! @return    'saved_psr', passed through
+nufr_sr_reg_t nufrkernel_lock_profile_enter(nufr_sr_reg_t  saved_psr,
+                                            const char    *file,
+                                            unsigned       line)
+{
+    if (0 == saved_psr)
+    {
+        lock_file = file;
+        lock_line = line;
+        lock_start_time = NUFR_LOCK_PROFILE_TIMESTAMP();
+    }
+
+    return saved_psr;
+}
+
+//! @name      nufrkernel_lock_profile_exit
+//
+//! @brief     Records hold time when the outermost lock is released.
+//
+//! @details   Called from NUFR_UNLOCK_INTERRUPTS(), before the unlock.
+//
+//! @param[in] saved_psr-- value being restored by the unlock
+void nufrkernel_lock_profile_exit(nufr_sr_reg_t saved_psr)
+{
+    if (0 == saved_psr)
+    {
+        lock_profile_record(lock_file, lock_line,
+                            NUFR_LOCK_PROFILE_TIMESTAMP() - lock_start_time);
+    }
+}
+
+//! @name      nufr_lock_profile_get
+//
+//! @brief     Copies out results of all sites seen so far.
+//
+//! @details   Unordered. This call's own lock is recorded after the copy.
+//
+//! @param[out] sites_ptr-- array to fill
+//! @param[in]  max_sites-- size of 'sites_ptr' array
+//
+//! @return    number of sites copied
+unsigned nufr_lock_profile_get(nufr_lock_profile_site_t *sites_ptr,
+                               unsigned                  max_sites)
+{
+    nufr_sr_reg_t  saved_psr;
+    unsigned       i;
+    unsigned       count = 0;
+
+    KERNEL_REQUIRE_API(NULL != sites_ptr);
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    for (i = 0; (i < NUFR_LOCK_PROFILE_SITES) && (count < max_sites); i++)
+    {
+        if (NULL != nufr_lock_profile_sites[i].file)
+        {
+            rutils_memcpy(&sites_ptr[count], &nufr_lock_profile_sites[i],
+                          sizeof(nufr_lock_profile_site_t));
+            count++;
+        }
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    return count;
+}
+
+//! @name      nufr_lock_profile_reset
+//
+//! @brief     Clears all results.
+//
+//! @details   This call's own lock is recorded after the clear.
+void nufr_lock_profile_reset(void)
+{
+    nufr_sr_reg_t  saved_psr;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    rutils_memset(nufr_lock_profile_sites, 0, sizeof(nufr_lock_profile_sites));
+    nufr_lock_profile_overflows = 0;
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+}
+
+#endif  //NUFR_CS_LOCK_PROFILE
@@ -33,6 +33,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! @details blocks. Note that kernel has allocations from block pool
 //! @details which don't use these APIs throughout the kernel code.
 //! @details 
+//! @details With NUFR_CS_MSG_PAYLOAD, a second pool holds inline-payload
+//! @details blocks. nufr_msg_free_block() returns a block of either kind
+//! @details to its own pool.
+//! @details
+//! @details With NUFR_CS_MSG_BROADCAST, nufr_msg_free_block() also takes
+//! @details broadcast link entries, releasing the link's reference on
+//! @details its descriptor.
+//! @details
+//! @details With NUFR_CS_MSG_POOL_RESERVE, a count of free blocks is
+//! @details kept alongside the free list, by these routines and by
+//! @details kernel allocations, so the reserve check and statistics
+//! @details don't need a list walk.
 
 #include "nufr-global.h"
 #include "nufr-platform.h"
@@ -70,6 +82,36 @@ unsigned nufr_msg_pool_empty_count;
 //unsigned    nufr_msg_free_count;
 //unsigned    nufr_msg_pool_empty_count;
 
+#if NUFR_CS_MSG_PAYLOAD == 1
+//! @name      nufr_msg_payload_bpool
+//!
+//! @brief     Statically defined inline-payload message pool
+//!
+//! @details   Free list is LIFO, so most recently used block, likely
+//! @details   still in cache, is reused first.
+nufr_msg_payload_t nufr_msg_payload_bpool[NUFR_MAX_PAYLOAD_MSGS];
+
+nufr_msg_t *nufr_msg_payload_free_head;
+#endif  //NUFR_CS_MSG_PAYLOAD
+
+#if NUFR_CS_MSG_BROADCAST == 1
+//! @name      nufr_msg_bcast_overflow_count
+//!
+//! @brief     Broadcast receivers that were out of links, so were sent
+//! @brief     their own block instead
+unsigned nufr_msg_bcast_overflow_count;
+#endif  //NUFR_CS_MSG_BROADCAST
+
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+//! @name      nufr_msg_pool_free
+//!
+//! @brief     Blocks on free list, lowest value seen, and allocations
+//! @brief     refused, per 'nufr_msg_caller_t'
+unsigned nufr_msg_pool_free;
+unsigned nufr_msg_pool_low_water;
+unsigned nufr_msg_pool_alloc_fails[NUFR_MSG_CALLER_max];
+#endif  //NUFR_CS_MSG_POOL_RESERVE
+
 
 //! @name      nufr_msg_bpool_init
 //!
@@ -85,11 +127,32 @@ void nufr_msg_bpool_init(void)
     nufr_msg_free_tail = NULL;
 //    nufr_msg_free_count = 0;
 //    nufr_msg_pool_empty_count = 0;
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    nufr_msg_pool_free = 0;
+    rutils_memset(nufr_msg_pool_alloc_fails, 0,
+                  sizeof(nufr_msg_pool_alloc_fails));
+#endif  //NUFR_CS_MSG_POOL_RESERVE
 
     for (i = 0; i < NUFR_MAX_MSGS; i++)
     {
         nufr_msg_free_block(&nufr_msg_bpool[i]);
     }
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    nufr_msg_pool_low_water = nufr_msg_pool_free;
+#endif  //NUFR_CS_MSG_POOL_RESERVE
+
+#if NUFR_CS_MSG_PAYLOAD == 1
+    rutils_memset(nufr_msg_payload_bpool, 0, sizeof(nufr_msg_payload_bpool));
+    nufr_msg_payload_free_head = NULL;
+
+    for (i = 0; i < NUFR_MAX_PAYLOAD_MSGS; i++)
+    {
+        nufr_msg_free_block(&nufr_msg_payload_bpool[i].header);
+    }
+#endif  //NUFR_CS_MSG_PAYLOAD
+#if NUFR_CS_MSG_BROADCAST == 1
+    nufr_msg_bcast_overflow_count = 0;
+#endif  //NUFR_CS_MSG_BROADCAST
 }
 
 //! @name      nufr_msg_get_block
@@ -97,8 +160,8 @@ void nufr_msg_bpool_init(void)
 //! @brief     Get a free message block from the pool
 //!
 //! @details   Can be called from task or from ISR level
-//! @details   //
-//! @details   
+//! @details   With NUFR_CS_MSG_POOL_RESERVE, a task level caller
+//! @details   can't take the last NUFR_MSG_POOL_ISR_RESERVE blocks.
 //! @details   
 //!
 //! @return    ptr to block, or NULL if pool depleted
@@ -106,11 +169,20 @@ nufr_msg_t *nufr_msg_get_block(void)
 {
     nufr_sr_reg_t           saved_psr;
     nufr_msg_t             *msg_ptr;
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    nufr_msg_caller_t       caller;
+
+    caller = NUFR_IS_ISR() ? NUFR_MSG_CALLER_ISR : NUFR_MSG_CALLER_TASK;
+#endif  //NUFR_CS_MSG_POOL_RESERVE
 
     saved_psr = NUFR_LOCK_INTERRUPTS();
 
     // Any messages left in pool?
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    if ((NULL != nufr_msg_free_head) && NUFR_MSG_POOL_MAY_TAKE(caller, 1))
+#else
     if (NULL != nufr_msg_free_head)
+#endif  //NUFR_CS_MSG_POOL_RESERVE
     {
         msg_ptr = nufr_msg_free_head;
         KERNEL_ENSURE_IL(NUFR_IS_MSG_BLOCK(msg_ptr));
@@ -124,10 +196,14 @@ nufr_msg_t *nufr_msg_get_block(void)
         }
 
 //        nufr_msg_free_count--;
+        NUFR_MSG_POOL_TAKEN(1);
     }
     else
     {
         msg_ptr = NULL;
+    #if NUFR_CS_MSG_POOL_RESERVE == 1
+        nufr_msg_pool_alloc_fails[caller]++;
+    #endif  //NUFR_CS_MSG_POOL_RESERVE
     }
 
     // If list is empty, both head and tail must be NULL;
@@ -167,7 +243,16 @@ void nufr_msg_free_block(nufr_msg_t *msg_ptr)
     nufr_sr_reg_t         saved_psr;
 
     KERNEL_REQUIRE_API(NULL != msg_ptr);
+#if NUFR_CS_MSG_BROADCAST == 1
+    KERNEL_REQUIRE_API(NUFR_IS_MSG_BLOCK(msg_ptr) ||
+                       NUFR_IS_MSG_PAYLOAD_BLOCK(msg_ptr) ||
+                       NUFR_IS_MSG_BCAST_LINK(msg_ptr));
+#elif NUFR_CS_MSG_PAYLOAD == 1
+    KERNEL_REQUIRE_API(NUFR_IS_MSG_BLOCK(msg_ptr) ||
+                       NUFR_IS_MSG_PAYLOAD_BLOCK(msg_ptr));
+#else
     KERNEL_REQUIRE_API(NUFR_IS_MSG_BLOCK(msg_ptr));
+#endif
     // Contract is that msg's flink must be cleared when msg
     // is received ('nufr_msg_getW()' and 'nufr_msg_getT()')
     // and SL and apps shouldn't mess with it.
@@ -178,6 +263,33 @@ void nufr_msg_free_block(nufr_msg_t *msg_ptr)
         return;
     }
 
+#if NUFR_CS_MSG_BROADCAST == 1
+    if (NUFR_IS_MSG_BCAST_LINK(msg_ptr))
+    {
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        nufrkernel_msg_bcast_release(msg_ptr);
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+        return;
+    }
+#endif  //NUFR_CS_MSG_BROADCAST
+
+#if NUFR_CS_MSG_PAYLOAD == 1
+    if (NUFR_IS_MSG_PAYLOAD_BLOCK(msg_ptr))
+    {
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        msg_ptr->flink = nufr_msg_payload_free_head;
+        nufr_msg_payload_free_head = msg_ptr;
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+        return;
+    }
+#endif  //NUFR_CS_MSG_PAYLOAD
+
 
     saved_psr = NUFR_LOCK_INTERRUPTS();
 
@@ -194,6 +306,7 @@ void nufr_msg_free_block(nufr_msg_t *msg_ptr)
     nufr_msg_free_tail = msg_ptr;
 
 //    nufr_msg_free_count++;
+    NUFR_MSG_POOL_RETURNED();
 
     // If list is empty, both head and tail must be NULL;
     // If list is not empty, head and tail must be non-NULL.
@@ -239,9 +352,161 @@ unsigned nufr_msg_free_count(void)
         msg_ptr = msg_ptr->flink;
     }
 
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    KERNEL_ENSURE_IL(count == nufr_msg_pool_free);
+#endif  //NUFR_CS_MSG_POOL_RESERVE
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    return count;
+}
+
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+//!
+//! @name      nufr_msg_pool_stats_get
+//!
+//! @brief     Snapshot of message block pool statistics
+//!
+//! @details   Can be called from task or from ISR level
+//!
+//! @param[out] 'stats_ptr'
+//!
+void nufr_msg_pool_stats_get(nufr_msg_pool_stats_t *stats_ptr)
+{
+    nufr_sr_reg_t         saved_psr;
+
+    KERNEL_REQUIRE_API(NULL != stats_ptr);
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    stats_ptr->free = nufr_msg_pool_free;
+    stats_ptr->low_water = nufr_msg_pool_low_water;
+    rutils_memcpy(stats_ptr->alloc_fails, nufr_msg_pool_alloc_fails,
+                  sizeof(stats_ptr->alloc_fails));
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    stats_ptr->in_use = NUFR_MAX_MSGS - stats_ptr->free;
+}
+
+//!
+//! @name      nufr_msg_pool_stats_reset
+//!
+//! @brief     Restarts low-water mark at current free count and zeroes
+//! @brief     allocation failure counts
+//!
+void nufr_msg_pool_stats_reset(void)
+{
+    nufr_sr_reg_t         saved_psr;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    nufr_msg_pool_low_water = nufr_msg_pool_free;
+    rutils_memset(nufr_msg_pool_alloc_fails, 0,
+                  sizeof(nufr_msg_pool_alloc_fails));
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+}
+#endif  //NUFR_CS_MSG_POOL_RESERVE
+
+#if NUFR_CS_MSG_PAYLOAD == 1
+//! @name      nufr_msg_payload_get_block
+//!
+//! @brief     Get a free block from the inline-payload pool
+//!
+//! @details   Can be called from task or from ISR level.
+//! @details   Block is freed with nufr_msg_free_block().
+//!
+//! @return    ptr to block's 'header', or NULL if pool depleted
+nufr_msg_t *nufr_msg_payload_get_block(void)
+{
+    nufr_sr_reg_t           saved_psr;
+    nufr_msg_t             *msg_ptr;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    msg_ptr = nufr_msg_payload_free_head;
+    if (NULL != msg_ptr)
+    {
+        KERNEL_ENSURE_IL(NUFR_IS_MSG_PAYLOAD_BLOCK(msg_ptr));
+        nufr_msg_payload_free_head = msg_ptr->flink;
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    if (NULL != msg_ptr)
+    {
+        msg_ptr->flink = NULL;
+        msg_ptr->fields = 0;
+        msg_ptr->parameter = 0;
+    }
+
+    return msg_ptr;
+}
+
+//!
+//! @name      nufr_msg_payload_free_count
+//!
+//! @brief
+//!
+//! @return    number of free blocks in inline-payload pool
+//!
+unsigned nufr_msg_payload_free_count(void)
+{
+    nufr_sr_reg_t         saved_psr;
+    nufr_msg_t           *msg_ptr;
+    unsigned              count = 0;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    msg_ptr = nufr_msg_payload_free_head;
+
+    while (NULL != msg_ptr)
+    {
+        count++;
+        KERNEL_ENSURE_IL(count <= NUFR_MAX_PAYLOAD_MSGS);
+
+        KERNEL_ENSURE_IL(NUFR_IS_MSG_PAYLOAD_BLOCK(msg_ptr));
+        msg_ptr = msg_ptr->flink;
+    }
+
     NUFR_UNLOCK_INTERRUPTS(saved_psr);
 
     return count;
 }
+#endif  //NUFR_CS_MSG_PAYLOAD
+
+#endif  // NUFR_CS_MESSAGING
+
+#if NUFR_CS_MSG_BROADCAST == 1
+//! @name      nufrkernel_msg_bcast_release
+//!
+//! @brief     Frees a broadcast link entry, dropping its descriptor
+//! @brief     reference. Last reference returns descriptor to the
+//! @brief     inline-payload pool.
+//!
+//! @details   Interrupts locked by caller.
+//!
+//! @param[in] 'link'-- link entry in a tcb's 'bcast_links[]'
+void nufrkernel_msg_bcast_release(nufr_msg_t *link)
+{
+    nufr_msg_payload_t   *desc;
+
+    KERNEL_REQUIRE_IL(NUFR_IS_MSG_BCAST_LINK(link));
+    KERNEL_REQUIRE_IL((0 != link->parameter) &&
+                      (link->parameter <= NUFR_MAX_PAYLOAD_MSGS));
+
+    desc = NUFR_BCAST_LINK_TO_DESC(link);
+    KERNEL_REQUIRE_IL(desc->refcount > 0);
+
+    link->flink = NULL;
+    link->parameter = 0;
 
-#endif  // NUFR_CS_MESSAGING
\ No newline at end of file
+    desc->refcount--;
+    if (0 == desc->refcount)
+    {
+        desc->header.flink = nufr_msg_payload_free_head;
+        nufr_msg_payload_free_head = &desc->header;
+    }
+}
+#endif  //NUFR_CS_MSG_BROADCAST
\ No newline at end of file
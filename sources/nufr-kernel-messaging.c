@@ -36,20 +36,124 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-platform-app.h"
 #include "nufr-api.h"
 #include "nufr-kernel-task.h"
+#include "nufr-kernel-trace.h"
 #if NUFR_CS_OPTIMIZATION_INLINES == 1
     #include "nufr-kernel-task-inlines.h"
     #include "nufr-kernel-semaphore-inlines.h"
 #endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
 #include "nufr-kernel-timer.h"
 #include "nufr-kernel-semaphore.h"
+#if NUFR_CS_EVENT == 1
+    #include "nufr-kernel-event.h"
+#endif
 
 #include "raging-contract.h"
+#include "raging-utils-mem.h"
 
 #ifdef USING_SECONDARY_CONTEXT_SWITCH_FILE
     #include "secondary-context-switch.h"
 #endif
 
 
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+//!
+//! @name      msg_space_wake_il
+//!
+//! @brief     Readies tasks blocked in nufr_msg_sendW()/nufr_msg_sendT()
+//! @brief     on a full message queue
+//!
+//! @details   Interrupts locked by caller. Called after messages left
+//! @details   'tcb's queue. Wait list is priority sorted. Unless
+//! @details   'wake_all', only the first waiter whose message priority
+//! @details   now has room is readied: it retries its send on resume.
+//!
+//! @param[in] 'tcb'-- task whose queue has room
+//! @param[in] 'wake_all'-- ready all waiters, room or not
+//!
+//! @return    'true' if a context switch is needed
+//!
+static bool msg_space_wake_il(nufr_tcb_t *tcb, bool wake_all)
+{
+#if NUFR_CS_OPTIMIZATION_INLINES == 1
+    NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS;
+#endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
+    nufr_tcb_t            **link_ptr;
+    nufr_tcb_t             *waiter;
+    bool                    invoke = false;
+
+    link_ptr = &tcb->msg_space_waiters;
+
+    while (NULL != *link_ptr)
+    {
+        waiter = *link_ptr;
+
+        if (!wake_all &&
+            !NUFR_MSG_QUEUE_HAS_ROOM(tcb, waiter->msg_space_priority))
+        {
+            link_ptr = &waiter->flink;
+            continue;
+        }
+
+        // Unlink, leaving 'link_ptr' pointing at the next waiter
+        *link_ptr = waiter->flink;
+        waiter->flink = NULL;
+        waiter->msg_space_dest = NULL;
+
+        // NOTE: Timer, if any, is killed by waiter on API exit
+        waiter->block_flags = 0;
+
+    #if NUFR_CS_OPTIMIZATION_INLINES == 1
+        NUFRKERNEL_ADD_TASK_TO_READY_LIST(waiter);
+        invoke |= macro_do_switch;
+    #else
+        invoke |= nufrkernel_add_task_to_ready_list(waiter);
+    #endif
+
+        if (!wake_all)
+        {
+            break;
+        }
+    }
+
+    return invoke;
+}
+
+//!
+//! @name      nufrkernel_msg_space_unlink_task
+//!
+//! @brief     Internal call to remove a tcb blocked in nufr_msg_sendW()
+//! @brief     or nufr_msg_sendT() from its receiver's wait list.
+//! @brief     Assumes that tcb is on the list.
+//!
+//! @details   Calling environment:
+//! @details     (1) Caller must lock interrupts
+//! @details     (2) This API intended for nufr kernel use
+//!
+//! @param[in] 'delete_tcb'--task to be removed
+//!
+void nufrkernel_msg_space_unlink_task(nufr_tcb_t *delete_tcb)
+{
+    nufr_tcb_t            **link_ptr;
+
+    KERNEL_REQUIRE_IL(NUFR_IS_TCB(delete_tcb));
+    KERNEL_REQUIRE_IL(NUFR_IS_TCB(delete_tcb->msg_space_dest));
+
+    link_ptr = &delete_tcb->msg_space_dest->msg_space_waiters;
+
+    while (*link_ptr != delete_tcb)
+    {
+        KERNEL_ENSURE_IL(NULL != *link_ptr);
+
+        link_ptr = &(*link_ptr)->flink;
+    }
+
+    *link_ptr = delete_tcb->flink;
+    delete_tcb->flink = NULL;
+    delete_tcb->msg_space_dest = NULL;
+}
+#endif  //NUFR_CS_MSG_QUEUE_LIMIT
+
+
 // API calls
 
 //!
@@ -69,6 +173,9 @@ void nufr_msg_drain(nufr_tid_t task_id, nufr_msg_pri_t from_this_priority)
     nufr_msg_t             *local_head_msg;
     nufr_msg_t             *local_tail_msg;
     nufr_msg_t             *this_msg;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    unsigned                pri;
+#endif
 
     target_tcb = NUFR_TID_TO_TCB(task_id);
 
@@ -146,8 +253,32 @@ void nufr_msg_drain(nufr_tid_t task_id, nufr_msg_pri_t from_this_priority)
         target_tcb->msg_tail0 = NULL;
     }
 
+#if NUFR_CS_MSG_INDEX == 1
+    rutils_memset(&target_tcb->msg_index[from_this_priority], 0,
+                  (NUFR_CS_MSG_PRIORITIES - (unsigned)from_this_priority) *
+                  sizeof(target_tcb->msg_index[0]));
+#endif
+
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    for (pri = from_this_priority; pri < NUFR_CS_MSG_PRIORITIES; pri++)
+    {
+        target_tcb->msg_queue_depth -= target_tcb->msg_queue_pri_depth[pri];
+        target_tcb->msg_queue_pri_depth[pri] = 0;
+    }
+
+    // Blocked senders retry. Those to a killed task get an error.
+    if (msg_space_wake_il(target_tcb, true))
+    {
+        NUFR_INVOKE_CONTEXT_SWITCH();
+    }
+#endif
+
     NUFR_UNLOCK_INTERRUPTS(saved_psr);
 
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+#endif
+
     KERNEL_ENSURE(local_tail_msg != NULL?
                   local_tail_msg->flink == NULL :
                   true);
@@ -184,6 +315,10 @@ void nufr_msg_drain(nufr_tid_t task_id, nufr_msg_pri_t from_this_priority)
 //! @details         from another higher-priority task and calling this api.
 //! @details         OK to do with a task kill, that's about all.
 //!
+//! @details   With NUFR_CS_MSG_INDEX, no walk is done if no queued
+//! @details   message's prefix/ID hashes like 'msg_fields', and the walk
+//! @details   ends at the last one that does, rather than at queue end.
+//!
 //! @param[in] 'msg_fields'-- Message fields packed by macro. Needs
 //! @param[in]       to have msg prefix, msg id, and msg priority fields set.
 //! @param[in] 'do_all'-- if 'false', purge first match and abort;
@@ -204,6 +339,9 @@ unsigned nufr_msg_purge(uint32_t msg_fields, bool do_all)
     nufr_msg_t             *previous_msg;
     nufr_msg_t             *this_msg;
     nufr_msg_t             *next_msg;
+#if NUFR_CS_MSG_INDEX == 1
+    unsigned                bucket_remaining;
+#endif
 
     // Can't be called from BG task
     if (nufr_running == (nufr_tcb_t *)nufr_bg_sp)
@@ -234,6 +372,12 @@ unsigned nufr_msg_purge(uint32_t msg_fields, bool do_all)
     // appending a message
     saved_psr = NUFR_LOCK_INTERRUPTS();
     this_msg = *head_ptr;
+#if NUFR_CS_MSG_INDEX == 1
+    // Number of queued messages which could match. Messages appended
+    //   after this are behind all of these, so walk can stop once
+    //   this many have been seen.
+    bucket_remaining = NUFR_MSG_INDEX_SLOT(nufr_running, msg_fields);
+#endif
     NUFR_UNLOCK_INTERRUPTS(saved_psr);
 
     // Walk messages to end.
@@ -242,7 +386,11 @@ unsigned nufr_msg_purge(uint32_t msg_fields, bool do_all)
     // Otherwise, we'd have to lock interrupts across the entire walk,
     // and that doesn't scale.
 
+#if NUFR_CS_MSG_INDEX == 1
+    while ((NULL != this_msg) && (bucket_remaining > 0))
+#else
     while (NULL != this_msg)
+#endif
     {
         // Isolate msg prefix and ID
         this_fields = this_msg->fields;
@@ -250,6 +398,13 @@ unsigned nufr_msg_purge(uint32_t msg_fields, bool do_all)
                                   ==
                            prefix_id_pair;
 
+    #if NUFR_CS_MSG_INDEX == 1
+        if (NUFR_MSG_INDEX_HASH(this_fields) == NUFR_MSG_INDEX_HASH(msg_fields))
+        {
+            bucket_remaining--;
+        }
+    #endif
+
         // Does 'this_msg' need to be purged?
         if (matching_msg)
         {
@@ -283,8 +438,22 @@ unsigned nufr_msg_purge(uint32_t msg_fields, bool do_all)
                 *tail_ptr = previous_msg;
             }
 
+            NUFR_MSG_INDEX_DEC(nufr_running, this_fields);
+            NUFR_MSG_DEPTH_DEC(nufr_running, this_fields);
+
+        #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+            if (msg_space_wake_il(nufr_running, false))
+            {
+                NUFR_INVOKE_CONTEXT_SWITCH();
+            }
+        #endif
+
             NUFR_UNLOCK_INTERRUPTS(saved_psr);
 
+        #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+            NUFR_SECONDARY_CONTEXT_SWITCH();
+        #endif
+
             // Cap purged msg/'this_msg' off properly and return to pool
             this_msg->flink = NULL;
             nufr_msg_free_block(this_msg);
@@ -320,6 +489,120 @@ unsigned nufr_msg_purge(uint32_t msg_fields, bool do_all)
     return num_purges;
 }
 
+#if NUFR_CS_MSG_INDEX == 1
+//!
+//! @name      msg_find_pending_il
+//!
+//! @brief     Is a message with this prefix/ID queued to a task?
+//!
+//! @details   Interrupts locked by caller.
+//! @details   Walks queue to the first match or the last message in
+//! @details   'msg_fields' hash bucket, if that bucket isn't empty.
+//!
+//! @param[in] 'target_tcb'-- task whose queue is checked
+//! @param[in] 'msg_fields'-- prefix, ID and priority are checked
+//! @param[in] 'parameter_ptr'-- if not NULL, parameter must match too
+//!
+//! @return    'true' if one is queued
+//!
+static bool msg_find_pending_il(nufr_tcb_t     *target_tcb,
+                                uint32_t        msg_fields,
+                                const uint32_t *parameter_ptr)
+{
+    unsigned                bucket;
+    unsigned                bucket_remaining;
+    uint32_t                prefix_id_pair;
+    uint32_t                parameter;
+    nufr_msg_t             *this_msg;
+
+    prefix_id_pair = NUFR_GET_MSG_PREFIX_ID_PAIR(msg_fields);
+    bucket = NUFR_MSG_INDEX_HASH(msg_fields);
+
+    bucket_remaining = NUFR_MSG_INDEX_SLOT(target_tcb, msg_fields);
+    this_msg = (&target_tcb->msg_head0)[NUFR_GET_MSG_PRIORITY(msg_fields)];
+
+    while ((bucket_remaining > 0) && (NULL != this_msg))
+    {
+        if (NUFR_MSG_INDEX_HASH(this_msg->fields) == bucket)
+        {
+            if (NUFR_GET_MSG_PREFIX_ID_PAIR(this_msg->fields) == prefix_id_pair)
+            {
+                if (NULL == parameter_ptr)
+                {
+                    return true;
+                }
+
+                parameter = this_msg->parameter;
+            #if NUFR_CS_MSG_BROADCAST == 1
+                if (NUFR_IS_MSG_BCAST_LINK(this_msg))
+                {
+                    parameter = NUFR_BCAST_LINK_TO_DESC(this_msg)->header.parameter;
+                }
+            #endif
+                if (*parameter_ptr == parameter)
+                {
+                    return true;
+                }
+            }
+
+            bucket_remaining--;
+        }
+
+        this_msg = this_msg->flink;
+    }
+
+    return false;
+}
+
+//!
+//! @name      nufr_msg_is_pending
+//!
+//! @brief     Is a message with this prefix/ID queued to a task?
+//!
+//! @details   Can be called from an ISR or the BG task.
+//! @details   Answered from the task's message index when no queued
+//! @details   message's prefix/ID hashes like 'msg_fields'. Otherwise,
+//! @details   queue is walked with interrupts locked, to the first match
+//! @details   or the last message in the hash bucket.
+//!
+//! @param[in] 'task_id'-- use 'NUFR_TID_null' for running task
+//! @param[in] 'msg_fields'-- prefix, ID and priority are checked
+//!
+//! @return    'true' if one is queued
+//!
+bool nufr_msg_is_pending(nufr_tid_t task_id, uint32_t msg_fields)
+{
+    nufr_tcb_t             *target_tcb;
+    nufr_sr_reg_t           saved_psr;
+    unsigned                msg_priority;
+    bool                    found;
+
+    if (NUFR_TID_null == task_id)
+    {
+        target_tcb = nufr_running;
+    }
+    else
+    {
+        target_tcb = NUFR_TID_TO_TCB(task_id);
+    }
+
+    msg_priority = NUFR_GET_MSG_PRIORITY(msg_fields);
+    if (!NUFR_IS_TCB(target_tcb) || (msg_priority >= NUFR_CS_MSG_PRIORITIES))
+    {
+        KERNEL_REQUIRE_API(false);
+        return false;
+    }
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    found = msg_find_pending_il(target_tcb, msg_fields, NULL);
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    return found;
+}
+#endif  //NUFR_CS_MSG_INDEX
+
 //!
 //! @name      nufr_msg_send
 //!
@@ -346,7 +629,9 @@ unsigned nufr_msg_purge(uint32_t msg_fields, bool do_all)
 //! @param[in]         
 //! @param[in]  'dest_task_id'--task that will receive message
 //
-//! @return      Action applied to receiving task
+//! @return      Action applied to receiving task.
+//! @return      NUFR_MSG_SEND_QUEUE_FULL if receiver's queue is at its
+//! @return      limit (NUFR_CS_MSG_QUEUE_LIMIT).
 //!
 nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
                                   uint32_t   optional_parameter,
@@ -367,6 +652,12 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
     bool                    will_abort = false;
 #endif  //NUFR_CS_TASK_KILL
     bool                    invoke = false;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    bool                    queue_full;
+#endif
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    nufr_msg_caller_t       caller;
+#endif
     nufr_msg_t             *msg;
     nufr_tcb_t             *dest_tcb;
     nufr_msg_t            **head_ptr;
@@ -385,6 +676,9 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
 
     head_ptr = &(&dest_tcb->msg_head0)[send_priority];
     tail_ptr = &(&dest_tcb->msg_tail0)[send_priority];
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    caller = NUFR_MSG_CALLER(msg_fields);
+#endif
 
     saved_psr = NUFR_LOCK_INTERRUPTS();
 
@@ -392,10 +686,26 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
 
     // Sanity check: dest task must be active
     send_occured = ARE_BITS_CLR(block_flags, NUFR_TASK_NOT_LAUNCHED);
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    // Receiver's queue at its limit?
+    queue_full = send_occured && !NUFR_MSG_QUEUE_HAS_ROOM(dest_tcb, send_priority);
+    if (queue_full)
+    {
+        send_occured = false;
+        dest_tcb->msg_queue_full_count++;
+    }
+#endif
     if (send_occured)
     {
         // Grab next block from bpool head, update links
         msg = nufr_msg_free_head;
+    #if NUFR_CS_MSG_POOL_RESERVE == 1
+        // Last blocks are held back for ISRs and control messages
+        if ((NULL != msg) && !NUFR_MSG_POOL_MAY_TAKE(caller, 1))
+        {
+            msg = NULL;
+        }
+    #endif  //NUFR_CS_MSG_POOL_RESERVE
         if (NULL != msg)
         {
             nufr_msg_free_head = msg->flink;
@@ -406,6 +716,7 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
                 nufr_msg_pool_empty_count++;
                 KERNEL_ENSURE_IL(false);
             }
+            NUFR_MSG_POOL_TAKEN(1);
 
             // Assign all this block's struct fields
             msg->flink = NULL;
@@ -426,18 +737,25 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
 
             // Finish stitching links
             *tail_ptr = msg;
+            NUFR_MSG_INDEX_INC(dest_tcb, msg_fields);
+            NUFR_MSG_DEPTH_INC(dest_tcb, msg_fields);
+
+            NUFR_TRACE(NUFR_TRACE_MSG_SEND, (uint8_t)dest_task_id,
+                       NUFR_GET_MSG_ID(msg_fields), msg_fields);
 
             // Is task blocked in such a way that a msg send could
             //   possibly make it ready? :
             //      nufr_msg_getW(), nufr_msg_getT(),
             //      nufr_bop_waitW(), nufr_sema_waitW(),
             //      nufr_bop_waitT(), nufr_sema_waitT(),
+            //      nufr_event_waitW(), nufr_event_waitT(),
             //      nufr_sleep()
         #if NUFR_CS_TASK_KILL == 1
             is_awakeable = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_MSG |
                                                      NUFR_TASK_BLOCKED_ASLEEP |
                                                      NUFR_TASK_BLOCKED_BOP |
-                                                     NUFR_TASK_BLOCKED_SEMA);
+                                                     NUFR_TASK_BLOCKED_SEMA |
+                                                     NUFR_TASK_BLOCKED_EVENT);
         #else
             is_awakeable = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_MSG);
         #endif  //NUFR_CS_TASK_KILL
@@ -448,7 +766,8 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
                 is_abortable_api = ANY_BITS_SET(block_flags,
                                           NUFR_TASK_BLOCKED_ASLEEP |
                                           NUFR_TASK_BLOCKED_BOP |
-                                          NUFR_TASK_BLOCKED_SEMA);
+                                          NUFR_TASK_BLOCKED_SEMA |
+                                          NUFR_TASK_BLOCKED_EVENT);
 
                 // Send message's priority passes abort level check?
                 is_abort_level_met = send_priority < dest_tcb->abort_message_priority;
@@ -480,6 +799,13 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
                         #endif
                             dest_tcb->sema_block = NULL;
                         }
+                    #if NUFR_CS_EVENT == 1
+                        if (ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_EVENT))
+                        {
+                            nufrkernel_event_unlink_task(dest_tcb->event_block, dest_tcb);
+                            dest_tcb->event_block = NULL;
+                        }
+                    #endif  //NUFR_CS_EVENT
                     }
                 #endif  //NUFR_CS_TASK_KILL
 
@@ -534,7 +860,13 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
         else
         {
             send_occured = false;
+        #if NUFR_CS_MSG_POOL_RESERVE == 1
+            nufr_msg_pool_alloc_fails[caller]++;
+            // Refused for the reserve is not an error
+            KERNEL_ENSURE(NULL != nufr_msg_free_head);
+        #else
             KERNEL_ENSURE(false);
+        #endif  //NUFR_CS_MSG_POOL_RESERVE
         }
     }
 
@@ -550,6 +882,10 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
     if (invoke)
 #endif  //NUFR_CS_TASK_KILL
         return_value = NUFR_MSG_SEND_AWOKE_RECEIVER;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    else if (queue_full)
+        return_value = NUFR_MSG_SEND_QUEUE_FULL;
+#endif
     else if (!send_occured)
         return_value = NUFR_MSG_SEND_ERROR;
     else
@@ -590,7 +926,9 @@ nufr_msg_send_rtn_t nufr_msg_send(uint32_t   msg_fields,
 //! @param[in]         
 //! @param[in]  'dest_task_id'--task that will receive message
 //
-//! @return      Action applied to receiving task
+//! @return      Action applied to receiving task.
+//! @return      NUFR_MSG_SEND_QUEUE_FULL if receiver's queue is at its
+//! @return      limit (NUFR_CS_MSG_QUEUE_LIMIT).
 //!
 nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task_id)
 {
@@ -610,6 +948,9 @@ nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task
     bool                    will_abort = false;
 #endif  //NUFR_CS_TASK_KILL
     bool                    invoke = false;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    bool                    queue_full;
+#endif
     nufr_tcb_t             *dest_tcb;
     nufr_msg_t            **head_ptr;
     nufr_msg_t            **tail_ptr;
@@ -638,6 +979,15 @@ nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task
 
     // Sanity check: dest task must be active
     send_occured = ARE_BITS_CLR(block_flags, NUFR_TASK_NOT_LAUNCHED);
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    // Receiver's queue at its limit?
+    queue_full = send_occured && !NUFR_MSG_QUEUE_HAS_ROOM(dest_tcb, send_priority);
+    if (queue_full)
+    {
+        send_occured = false;
+        dest_tcb->msg_queue_full_count++;
+    }
+#endif
     if (send_occured)
     {
         is_queue_empty = (NULL == *head_ptr);
@@ -654,18 +1004,25 @@ nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task
 
         // Finish stitching links
         *tail_ptr = msg;
+        NUFR_MSG_INDEX_INC(dest_tcb, msg->fields);
+        NUFR_MSG_DEPTH_INC(dest_tcb, msg->fields);
+
+        NUFR_TRACE(NUFR_TRACE_MSG_SEND, (uint8_t)dest_task_id,
+                   NUFR_GET_MSG_ID(msg->fields), msg->fields);
 
         // Is task blocked in such a way that a msg send could
         //   possibly make it ready? :
         //      nufr_msg_getW(), nufr_msg_getT(),
         //      nufr_bop_waitW(), nufr_sema_waitW(),
         //      nufr_bop_waitT(), nufr_sema_waitT(),
+        //      nufr_event_waitW(), nufr_event_waitT(),
         //      nufr_sleep()
     #if NUFR_CS_TASK_KILL == 1
         is_awakeable = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_MSG |
                                                  NUFR_TASK_BLOCKED_ASLEEP |
                                                  NUFR_TASK_BLOCKED_BOP |
-                                                 NUFR_TASK_BLOCKED_SEMA);
+                                                 NUFR_TASK_BLOCKED_SEMA |
+                                                 NUFR_TASK_BLOCKED_EVENT);
     #else
         is_awakeable = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_MSG);
     #endif  //NUFR_CS_TASK_KILL
@@ -676,7 +1033,8 @@ nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task
             is_abortable_api = ANY_BITS_SET(block_flags,
                                       NUFR_TASK_BLOCKED_ASLEEP |
                                       NUFR_TASK_BLOCKED_BOP |
-                                      NUFR_TASK_BLOCKED_SEMA);
+                                      NUFR_TASK_BLOCKED_SEMA |
+                                      NUFR_TASK_BLOCKED_EVENT);
 
             // Send message's priority passes abort level check?
             is_abort_level_met = send_priority < dest_tcb->abort_message_priority;
@@ -708,6 +1066,13 @@ nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task
                     #endif
                         dest_tcb->sema_block = NULL;
                     }
+                #if NUFR_CS_EVENT == 1
+                    if (ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_EVENT))
+                    {
+                        nufrkernel_event_unlink_task(dest_tcb->event_block, dest_tcb);
+                        dest_tcb->event_block = NULL;
+                    }
+                #endif  //NUFR_CS_EVENT
                 }
             #endif  //NUFR_CS_TASK_KILL
 
@@ -771,6 +1136,10 @@ nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task
     if (invoke)
 #endif  //NUFR_CS_TASK_KILL
         return_value = NUFR_MSG_SEND_AWOKE_RECEIVER;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    else if (queue_full)
+        return_value = NUFR_MSG_SEND_QUEUE_FULL;
+#endif
     else if (!send_occured)
         return_value = NUFR_MSG_SEND_ERROR;
     else
@@ -779,128 +1148,387 @@ nufr_msg_send_rtn_t nufr_msg_send_by_block(nufr_msg_t *msg, nufr_tid_t dest_task
     return return_value;
 }
 
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
 //!
-//! @name      nufr_msg_getW
+//! @name      msg_send_wait
 //!
-//! @brief     Get a message, block indefinitely until you get one
+//! @brief     Common code for nufr_msg_sendW() and nufr_msg_sendT()
 //!
-//! @details   Cannot be called from an ISR or from BG task
-//! @details   Always returns having obtained a message: no other case.
-//! @details
+//! @details   Each pass tries nufr_msg_send(). On a full queue, caller
+//! @details   blocks on receiver's wait list until a message leaves the
+//! @details   queue, then tries again.
 //!
-//! @param[out] 'msg_fields_ptr'-- caller variable to put msg->fields
-//! @param[out]                for this msg.
-//! @param[out] 'parameter_ptr'-- caller variable to put msg->parameter
-//! @param[out]           If NULL, ignore
+//! @param[in] 'timed'-- 'false' for nufr_msg_sendW(), 'timeout_ticks'
+//! @param[in]           then ignored
 //!
-void nufr_msg_getW(uint32_t *msg_fields_ptr, uint32_t *parameter_ptr)
+static nufr_msg_send_rtn_t msg_send_wait(uint32_t   msg_fields,
+                                         uint32_t   optional_parameter,
+                                         nufr_tid_t dest_task_id,
+                                         unsigned   timeout_ticks,
+                                         bool       timed)
 {
     nufr_sr_reg_t           saved_psr;
-    unsigned                pri_index;
-    const unsigned          MSG_NOT_FOUND = 128;  // value is arbitrary
-    nufr_msg_t            **head_ptr;
-    nufr_msg_t            **tail_ptr;
-    nufr_msg_t             *msg;
-
-    KERNEL_REQUIRE_API(NUFR_IS_TCB(nufr_running));
-    KERNEL_REQUIRE_API(NULL != msg_fields_ptr);
+    nufr_msg_send_rtn_t     return_value;
+    nufr_tcb_t             *dest_tcb;
+    nufr_tcb_t            **link_ptr;
+    unsigned                send_priority;
+    unsigned                remaining_ticks = 0;
+    uint32_t                start_count;
+    uint32_t                elapsed;
+    bool                    block_on_space;
 
-    //###### First: Check if a message is already available,
-    //####          If there is one, get that message and be done with it.
-    //###
-    pri_index = MSG_NOT_FOUND;
-    msg = NULL;
+    KERNEL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
 
-    saved_psr = NUFR_LOCK_INTERRUPTS();
+    dest_tcb = NUFR_TID_TO_TCB(dest_task_id);
+    send_priority = NUFR_GET_MSG_PRIORITY(msg_fields);
+    start_count = nufr_tick_count_get();
 
-    if (NULL != nufr_running->msg_head0)
-    {
-        pri_index = 0;
-    }
-#if NUFR_CS_MSG_PRIORITIES > 1
-    else if (NULL != nufr_running->msg_head1)
-    {
-        pri_index = 1;
-    }
-#endif
-#if NUFR_CS_MSG_PRIORITIES > 2
-    else if (NULL != nufr_running->msg_head2)
+    while (true)
     {
-        pri_index = 2;
-    }
-#endif
-#if NUFR_CS_MSG_PRIORITIES > 3
-    else if (NULL != nufr_running->msg_head3)
-    {
-        pri_index = 3;
-    }
-#endif
+        return_value = nufr_msg_send(msg_fields, optional_parameter,
+                                     dest_task_id);
 
-    if (MSG_NOT_FOUND == pri_index)
-    {
-        //###### Second: Block on receiving a message
-        //###
-        nufr_running->notifications = 0;
+        // Waiting on our own queue would never end
+        if ((NUFR_MSG_SEND_QUEUE_FULL != return_value) ||
+            (dest_tcb == nufr_running))
+        {
+            return return_value;
+        }
 
-    #if NUFR_CS_OPTIMIZATION_INLINES == 1
-        NUFRKERNEL_BLOCK_RUNNING_TASK(NUFR_TASK_BLOCKED_MSG);
-    #else
-        nufrkernel_block_running_task(NUFR_TASK_BLOCKED_MSG);
-    #endif
+        if (timed)
+        {
+            elapsed = nufr_tick_count_delta(start_count);
+            if (elapsed >= timeout_ticks)
+            {
+                return NUFR_MSG_SEND_QUEUE_FULL;
+            }
+            remaining_ticks = timeout_ticks - elapsed;
+        }
 
-        NUFR_INVOKE_CONTEXT_SWITCH();
-    }
+        //######   Block until receiver dequeues
+        //###
+        saved_psr = NUFR_LOCK_INTERRUPTS();
 
-    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+        // Receiver may have dequeued since send was refused
+        block_on_space = !NUFR_MSG_QUEUE_HAS_ROOM(dest_tcb, send_priority);
+        if (block_on_space)
+        {
+        #if NUFR_CS_OPTIMIZATION_INLINES == 1
+            NUFRKERNEL_BLOCK_RUNNING_TASK(NUFR_TASK_BLOCKED_MSG_SPACE);
+        #else
+            nufrkernel_block_running_task(NUFR_TASK_BLOCKED_MSG_SPACE);
+        #endif
 
-    NUFR_SECONDARY_CONTEXT_SWITCH();
+            nufr_running->msg_space_dest = dest_tcb;
+            nufr_running->msg_space_priority = (uint8_t)send_priority;
 
-    // If no msg taken, task has gone to sleep and was awakened
-    //   by msg rx.
+            // Priority sorted; behind others of same priority
+            link_ptr = &dest_tcb->msg_space_waiters;
+            while ((NULL != *link_ptr) &&
+                   ((*link_ptr)->priority <= nufr_running->priority))
+            {
+                link_ptr = &(*link_ptr)->flink;
+            }
+            nufr_running->flink = *link_ptr;
+            *link_ptr = nufr_running;
 
-    //##### Third: If message was dequeued without task having
-    //##            waited for it, grab it and leave.
-    if (MSG_NOT_FOUND != pri_index)
-    {
-        saved_psr = NUFR_LOCK_INTERRUPTS();
+            nufr_running->notifications = 0;
 
-        head_ptr = &(&nufr_running->msg_head0)[pri_index];
-        tail_ptr = &(&nufr_running->msg_tail0)[pri_index];
+            if (timed)
+            {
+                nufrkernel_add_to_timer_list(nufr_running, remaining_ticks);
+            }
 
-        // Pop head, stitch links back together.
-        msg = *head_ptr;
-        KERNEL_ENSURE(msg != NULL);
-        *head_ptr = (*head_ptr)->flink;
-        if (msg == *tail_ptr)
-        {
-            *tail_ptr = NULL;
+            NUFR_INVOKE_CONTEXT_SWITCH();
         }
-        // Must always return to block pool a block with a NULL 'msg->flink'
-        msg->flink = NULL;
 
-        // Copy message block member values over to fcn. parameters
-        *msg_fields_ptr = msg->fields;
-        if (NULL != parameter_ptr)
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+        NUFR_SECONDARY_CONTEXT_SWITCH();
+
+        // Task will block/resume here if 'block_on_space' is 'true'
+
+        //##### Kill zombie timer
+        if (block_on_space && timed)
         {
-            *parameter_ptr = msg->parameter;
+            saved_psr = NUFR_LOCK_INTERRUPTS();
+
+            if (NUFR_IS_STATUS_SET(nufr_running, NUFR_TASK_TIMER_RUNNING))
+            {
+                nufrkernel_purge_from_timer_list(nufr_running);
+            }
+
+            NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+            // Interrupt locking not needed
+            if (ANY_BITS_SET(nufr_running->notifications, NUFR_TASK_TIMEOUT))
+            {
+                return NUFR_MSG_SEND_QUEUE_FULL;
+            }
         }
+    }
+}
+
+//!
+//! @name      nufr_msg_sendW
+//!
+//! @brief     nufr_msg_send(), waiting for room if receiver's queue
+//! @brief     is at its limit
+//!
+//! @details   Cannot be called from an ISR or from BG task.
+//! @details   Senders waiting on a receiver are readied in task priority
+//! @details   order as messages leave its queue. A drain or task kill
+//! @details   of the receiver readies them all.
+//!
+//! @param[in] see nufr_msg_send()
+//
+//! @return    as nufr_msg_send(). Never NUFR_MSG_SEND_QUEUE_FULL,
+//! @return    unless sending to self.
+//!
+nufr_msg_send_rtn_t nufr_msg_sendW(uint32_t   msg_fields,
+                                   uint32_t   optional_parameter,
+                                   nufr_tid_t dest_task_id)
+{
+    return msg_send_wait(msg_fields, optional_parameter, dest_task_id,
+                         0, false);
+}
+
+//!
+//! @name      nufr_msg_sendT
+//!
+//! @brief     nufr_msg_sendW(), with a timeout
+//!
+//! @details   Cannot be called from an ISR or from BG task
+//!
+//! @param[in] see nufr_msg_send()
+//! @param[in] 'timeout_ticks'-- OS ticks to wait for room. 0 never
+//! @param[in]                   waits.
+//
+//! @return    as nufr_msg_send(). NUFR_MSG_SEND_QUEUE_FULL on timeout.
+//!
+nufr_msg_send_rtn_t nufr_msg_sendT(uint32_t   msg_fields,
+                                   uint32_t   optional_parameter,
+                                   nufr_tid_t dest_task_id,
+                                   unsigned   timeout_ticks)
+{
+    return msg_send_wait(msg_fields, optional_parameter, dest_task_id,
+                         timeout_ticks, true);
+}
+#endif  //NUFR_CS_MSG_QUEUE_LIMIT
+
+//!
+//! @name      msg_rx_copy_and_free
+//!
+//! @brief     Copies a dequeued message out to receiver's variables,
+//! @brief     then returns block to its pool.
+//!
+//! @details   Interrupts locked by caller. A payload copy is at most
+//! @details   NUFR_MSG_PAYLOAD_SIZE bytes, which is cheaper than
+//! @details   a second interrupt lock to free the block after.
+//!
+//! @param[in] 'msg'-- dequeued message, 'msg->flink' already cleared
+//! @param[out] 'msg_fields_ptr', 'parameter_ptr'-- see nufr_msg_getW()
+//! @param[out] 'payload_ptr'-- where to copy payload of an inline-payload
+//! @param[out]       message. If NULL, payload is discarded.
+//! @param[in] 'payload_size'-- size of 'payload_ptr' buffer. Payload
+//! @param[in]        is truncated to this.
+//!
+static void msg_rx_copy_and_free(nufr_msg_t *msg,
+                                 uint32_t   *msg_fields_ptr,
+                                 uint32_t   *parameter_ptr,
+                                 void       *payload_ptr,
+                                 unsigned    payload_size)
+{
+#if NUFR_CS_MSG_PAYLOAD == 1
+    nufr_msg_payload_t *payload_msg;
+#endif
+
+    NUFR_MSG_INDEX_DEC(nufr_running, msg->fields);
+    NUFR_MSG_DEPTH_DEC(nufr_running, msg->fields);
+
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    // Caller does secondary context switch, after unlocking
+    if ((NULL != nufr_running->msg_space_waiters) &&
+        msg_space_wake_il(nufr_running, false))
+    {
+        NUFR_INVOKE_CONTEXT_SWITCH();
+    }
+#endif
 
-        // Free message block
-        // Is message block pool depleted?
-        if (NULL == nufr_msg_free_tail)
+    // Copy message block member values over to fcn. parameters
+    *msg_fields_ptr = msg->fields;
+
+#if NUFR_CS_MSG_BROADCAST == 1
+    // Link entry: parameter and payload are in shared descriptor
+    if (NUFR_IS_MSG_BCAST_LINK(msg))
+    {
+        payload_msg = NUFR_BCAST_LINK_TO_DESC(msg);
+
+        if (NULL != parameter_ptr)
         {
-            nufr_msg_free_head = msg;
-            nufr_msg_free_tail = msg;
+            *parameter_ptr = payload_msg->header.parameter;
         }
-        // Probable path: Message block pool not depleted
-        else
+        if ((NULL != payload_ptr) && (0 != payload_msg->length))
+        {
+            rutils_memcpy(payload_ptr, payload_msg->payload,
+                          payload_msg->length < payload_size ?
+                                   payload_msg->length : payload_size);
+        }
+
+        nufrkernel_msg_bcast_release(msg);
+
+        return;
+    }
+#endif  //NUFR_CS_MSG_BROADCAST
+
+    if (NULL != parameter_ptr)
+    {
+        *parameter_ptr = msg->parameter;
+    }
+
+#if NUFR_CS_MSG_PAYLOAD == 1
+    if (NUFR_IS_MSG_PAYLOAD_BLOCK(msg))
+    {
+        payload_msg = (nufr_msg_payload_t *)msg;
+
+        if ((NULL != payload_ptr) && (0 != payload_msg->length))
+        {
+            rutils_memcpy(payload_ptr, payload_msg->payload,
+                          payload_msg->length < payload_size ?
+                                   payload_msg->length : payload_size);
+        }
+
+        msg->flink = nufr_msg_payload_free_head;
+        nufr_msg_payload_free_head = msg;
+
+        return;
+    }
+#else
+    UNUSED(payload_ptr);
+    UNUSED(payload_size);
+#endif  //NUFR_CS_MSG_PAYLOAD
+
+    // Free message block
+    // Is message block pool depleted?
+    if (NULL == nufr_msg_free_tail)
+    {
+        nufr_msg_free_head = msg;
+        nufr_msg_free_tail = msg;
+    }
+    // Probable path: Message block pool not depleted
+    else
+    {
+        nufr_msg_free_tail->flink = msg;
+        nufr_msg_free_tail = msg;
+    }
+    NUFR_MSG_POOL_RETURNED();
+}
+
+//!
+//! @name      msg_getW
+//!
+//! @brief     Common code for nufr_msg_getW() and nufr_msg_payload_getW()
+//!
+static void msg_getW(uint32_t *msg_fields_ptr,
+                     uint32_t *parameter_ptr,
+                     void     *payload_ptr,
+                     unsigned  payload_size)
+{
+    nufr_sr_reg_t           saved_psr;
+    unsigned                pri_index;
+    const unsigned          MSG_NOT_FOUND = 128;  // value is arbitrary
+    nufr_msg_t            **head_ptr;
+    nufr_msg_t            **tail_ptr;
+    nufr_msg_t             *msg;
+
+    KERNEL_REQUIRE_API(NUFR_IS_TCB(nufr_running));
+    KERNEL_REQUIRE_API(NULL != msg_fields_ptr);
+
+    //###### First: Check if a message is already available,
+    //####          If there is one, get that message and be done with it.
+    //###
+    pri_index = MSG_NOT_FOUND;
+    msg = NULL;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    if (NULL != nufr_running->msg_head0)
+    {
+        pri_index = 0;
+    }
+#if NUFR_CS_MSG_PRIORITIES > 1
+    else if (NULL != nufr_running->msg_head1)
+    {
+        pri_index = 1;
+    }
+#endif
+#if NUFR_CS_MSG_PRIORITIES > 2
+    else if (NULL != nufr_running->msg_head2)
+    {
+        pri_index = 2;
+    }
+#endif
+#if NUFR_CS_MSG_PRIORITIES > 3
+    else if (NULL != nufr_running->msg_head3)
+    {
+        pri_index = 3;
+    }
+#endif
+
+    if (MSG_NOT_FOUND == pri_index)
+    {
+        //###### Second: Block on receiving a message
+        //###
+        nufr_running->notifications = 0;
+
+    #if NUFR_CS_OPTIMIZATION_INLINES == 1
+        NUFRKERNEL_BLOCK_RUNNING_TASK(NUFR_TASK_BLOCKED_MSG);
+    #else
+        nufrkernel_block_running_task(NUFR_TASK_BLOCKED_MSG);
+    #endif
+
+        NUFR_INVOKE_CONTEXT_SWITCH();
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+
+    // If no msg taken, task has gone to sleep and was awakened
+    //   by msg rx.
+
+    //##### Third: If message was dequeued without task having
+    //##            waited for it, grab it and leave.
+    if (MSG_NOT_FOUND != pri_index)
+    {
+        saved_psr = NUFR_LOCK_INTERRUPTS();
+
+        head_ptr = &(&nufr_running->msg_head0)[pri_index];
+        tail_ptr = &(&nufr_running->msg_tail0)[pri_index];
+
+        // Pop head, stitch links back together.
+        msg = *head_ptr;
+        KERNEL_ENSURE(msg != NULL);
+        *head_ptr = (*head_ptr)->flink;
+        if (msg == *tail_ptr)
         {
-            nufr_msg_free_tail->flink = msg;
-            nufr_msg_free_tail = msg;
+            *tail_ptr = NULL;
         }
+        // Must always return to block pool a block with a NULL 'msg->flink'
+        msg->flink = NULL;
+
+        NUFR_TRACE(NUFR_TRACE_MSG_RECEIVE, NUFR_TRACE_TID(nufr_running),
+                   NUFR_GET_MSG_ID(msg->fields), msg->fields);
+
+        msg_rx_copy_and_free(msg, msg_fields_ptr, parameter_ptr,
+                             payload_ptr, payload_size);
 
         NUFR_UNLOCK_INTERRUPTS(saved_psr);
 
+    #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+        NUFR_SECONDARY_CONTEXT_SWITCH();
+    #endif
+
         return;
     }
 
@@ -961,54 +1589,31 @@ void nufr_msg_getW(uint32_t *msg_fields_ptr, uint32_t *parameter_ptr)
         // Must always return to block pool a block with a NULL 'msg->flink'
         msg->flink = NULL;
 
-        // Copy message block member values over to fcn. parameters
-        *msg_fields_ptr = msg->fields;
-        if (NULL != parameter_ptr)
-        {
-            *parameter_ptr = msg->parameter;
-        }
+        NUFR_TRACE(NUFR_TRACE_MSG_RECEIVE, NUFR_TRACE_TID(nufr_running),
+                   NUFR_GET_MSG_ID(msg->fields), msg->fields);
 
-        // Free message block
-        // Is message block pool depleted?
-        if (NULL == nufr_msg_free_tail)
-        {
-            nufr_msg_free_head = msg;
-            nufr_msg_free_tail = msg;
-        }
-        // Probable path: Message block pool not depleted
-        else
-        {
-            nufr_msg_free_tail->flink = msg;
-            nufr_msg_free_tail = msg;
-        }
+        msg_rx_copy_and_free(msg, msg_fields_ptr, parameter_ptr,
+                             payload_ptr, payload_size);
     }
 
     NUFR_UNLOCK_INTERRUPTS(saved_psr);
 
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+#endif
+
 }
 
 //!
-//! @name      nufr_msg_getT
-//!
-//! @brief     Get a message, block until 'timeout_ticks'
-//!
-//! @details   Cannot be called from an ISR or from BG task
-//! @details
-//! @details   Same as 'nufr_msg_getW()', except with timeout
-//! @details   
-//!
-//! @params[in] timeout_ticks-- timeout. If == 0, return from API call
-//! @params[in]       immediately if no msg waiting.
-//! @param[out] 'msg_fields_ptr'-- caller variable to put msg->fields
-//! @param[out]                for this msg.
-//! @param[out] 'parameter_ptr'-- caller variable to put msg->parameter
-//! @param[out]           If NULL, ignore
+//! @name      msg_getT
 //!
-//! @return     'true' if timeout occured
+//! @brief     Common code for nufr_msg_getT() and nufr_msg_payload_getT()
 //!
-bool nufr_msg_getT(unsigned  timeout_ticks,
-                   uint32_t *msg_fields_ptr,
-                   uint32_t *parameter_ptr)
+static bool msg_getT(unsigned  timeout_ticks,
+                     uint32_t *msg_fields_ptr,
+                     uint32_t *parameter_ptr,
+                     void     *payload_ptr,
+                     unsigned  payload_size)
 {
     nufr_sr_reg_t           saved_psr;
     unsigned                pri_index;
@@ -1110,29 +1715,18 @@ bool nufr_msg_getT(unsigned  timeout_ticks,
         // Must always return to block pool a block with a NULL 'msg->flink'
         msg->flink = NULL;
 
-        // Copy message block member values over to fcn. parameters
-        *msg_fields_ptr = msg->fields;
-        if (NULL != parameter_ptr)
-        {
-            *parameter_ptr = msg->parameter;
-        }
+        NUFR_TRACE(NUFR_TRACE_MSG_RECEIVE, NUFR_TRACE_TID(nufr_running),
+                   NUFR_GET_MSG_ID(msg->fields), msg->fields);
 
-        // Free message block
-        // Is message block pool depleted?
-        if (NULL == nufr_msg_free_tail)
-        {
-            nufr_msg_free_head = msg;
-            nufr_msg_free_tail = msg;
-        }
-        // Probable path: Message block pool not depleted
-        else
-        {
-            nufr_msg_free_tail->flink = msg;
-            nufr_msg_free_tail = msg;
-        }
+        msg_rx_copy_and_free(msg, msg_fields_ptr, parameter_ptr,
+                             payload_ptr, payload_size);
 
         NUFR_UNLOCK_INTERRUPTS(saved_psr);
 
+    #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+        NUFR_SECONDARY_CONTEXT_SWITCH();
+    #endif
+
         return false;
     }
     // Immediate timeout and no message in inbox?
@@ -1192,42 +1786,990 @@ bool nufr_msg_getT(unsigned  timeout_ticks,
         // Must always return to block pool a block with a NULL 'msg->flink'
         msg->flink = NULL;
 
-        // Copy message block member values over to fcn. parameters
-        *msg_fields_ptr = msg->fields;
-        if (NULL != parameter_ptr)
-        {
-            *parameter_ptr = msg->parameter;
-        }
+        NUFR_TRACE(NUFR_TRACE_MSG_RECEIVE, NUFR_TRACE_TID(nufr_running),
+                   NUFR_GET_MSG_ID(msg->fields), msg->fields);
 
-        // Free message block
-        // Is message block pool depleted?
-        if (NULL == nufr_msg_free_tail)
-        {
-            nufr_msg_free_head = msg;
-            nufr_msg_free_tail = msg;
-        }
-        // Probable path: Message block pool not depleted
-        else
-        {
-            nufr_msg_free_tail->flink = msg;
-            nufr_msg_free_tail = msg;
-        }
+        msg_rx_copy_and_free(msg, msg_fields_ptr, parameter_ptr,
+                             payload_ptr, payload_size);
     }
 
     NUFR_UNLOCK_INTERRUPTS(saved_psr);
 
-    return MSG_NOT_FOUND != pri_index;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+#endif
+
+    // No message after wait: timed out
+    return MSG_NOT_FOUND == pri_index;
 }
 
 //!
-//! @name      nufr_msg_peek
+//! @name      msg_wake_receiver_il
 //!
-//! @brief     Returns the first message block without dequeing it
+//! @brief     Wakes a task, or aborts its wait, after messages were
+//! @brief     queued to it, following the rules of nufr_msg_send()
 //!
-//! @details   Caller might want to lock/unlock interrupts around this
-//! @details   call, as another task or an ISR may change the msg queue
-//! @details   at an inconvenient time.
-//! @details   
+//! @details   Interrupts locked by caller. Caller does the context
+//! @details   switch, so a fan-out to several tasks switches once.
+//!
+//! @param[in] 'dest_tcb'-- receiver, already known to be launched
+//! @param[in] 'send_priority'-- highest priority (lowest value) of
+//! @param[in]       the messages just queued
+//!
+//! @return    'true' if a context switch is needed
+//!
+static bool msg_wake_receiver_il(nufr_tcb_t *dest_tcb, unsigned send_priority)
+{
+#if NUFR_CS_OPTIMIZATION_INLINES == 1
+    NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS;
+#endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
+    unsigned                block_flags;
+    bool                    is_awakeable;
+#if NUFR_CS_TASK_KILL == 1
+    bool                    is_abort_level_met;
+    bool                    is_abortable_api;
+    bool                    will_abort = false;
+#else
+    UNUSED(send_priority);
+#endif  //NUFR_CS_TASK_KILL
+    bool                    invoke = false;
+
+    block_flags = dest_tcb->block_flags;
+
+    // Is task blocked in such a way that a msg send could
+    //   possibly make it ready?
+#if NUFR_CS_TASK_KILL == 1
+    is_awakeable = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_MSG |
+                                             NUFR_TASK_BLOCKED_ASLEEP |
+                                             NUFR_TASK_BLOCKED_BOP |
+                                             NUFR_TASK_BLOCKED_SEMA |
+                                             NUFR_TASK_BLOCKED_EVENT);
+#else
+    is_awakeable = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_MSG);
+#endif  //NUFR_CS_TASK_KILL
+    if (is_awakeable)
+    {
+    #if NUFR_CS_TASK_KILL == 1
+        // Does this API support abort feature?
+        is_abortable_api = ANY_BITS_SET(block_flags,
+                                  NUFR_TASK_BLOCKED_ASLEEP |
+                                  NUFR_TASK_BLOCKED_BOP |
+                                  NUFR_TASK_BLOCKED_SEMA |
+                                  NUFR_TASK_BLOCKED_EVENT);
+
+        // Highest priority message passes abort level check?
+        is_abort_level_met = send_priority < dest_tcb->abort_message_priority;
+
+        // All conditions met for an abort?
+        will_abort = is_abort_level_met && is_abortable_api;
+
+        if (will_abort || !is_abortable_api)
+    #else
+        //if (true)
+    #endif  //NUFR_CS_TASK_KILL
+        {
+        #if NUFR_CS_TASK_KILL == 1
+            if (will_abort)
+            {
+                KERNEL_INVARIANT_IL(dest_tcb->notifications == 0);
+                dest_tcb->notifications = NUFR_TASK_UNBLOCKED_BY_MSG_SEND;
+
+                if (ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_SEMA))
+                {
+                #if NUFR_CS_OPTIMIZATION_INLINES == 1
+                    NUFRKERNEL_SEMA_UNLINK_TASK(dest_tcb->sema_block, dest_tcb);
+                #else
+                    nufrkernel_sema_unlink_task(dest_tcb->sema_block, dest_tcb);
+                #endif
+                    dest_tcb->sema_block = NULL;
+                }
+            #if NUFR_CS_EVENT == 1
+                if (ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_EVENT))
+                {
+                    nufrkernel_event_unlink_task(dest_tcb->event_block, dest_tcb);
+                    dest_tcb->event_block = NULL;
+                }
+            #endif  //NUFR_CS_EVENT
+            }
+        #endif  //NUFR_CS_TASK_KILL
+
+        #if NUFR_CS_LOCAL_STRUCT == 1
+            // See nufr_msg_send() on bop locked tasks
+            if (NUFR_IS_STATUS_CLR(dest_tcb, NUFR_TASK_BOP_LOCKED))
+            {
+        #endif
+                // Set 'block_flags' to ready state
+                dest_tcb->block_flags = 0;
+
+            #if NUFR_CS_OPTIMIZATION_INLINES == 1
+                NUFRKERNEL_ADD_TASK_TO_READY_LIST(dest_tcb);
+                invoke = macro_do_switch;
+            #else
+                invoke = nufrkernel_add_task_to_ready_list(dest_tcb);
+            #endif
+
+        #if NUFR_CS_LOCAL_STRUCT == 1
+            }
+            else
+            {
+                dest_tcb->block_flags &= BITWISE_NOT8(NUFR_TASK_BLOCKED_BOP);
+            }
+        #endif
+        }
+    }
+
+    return invoke;
+}
+
+//!
+//! @name      nufr_msg_send_batch
+//!
+//! @brief     Sends several messages to one task, with one interrupt
+//! @brief     lock to enqueue them all and at most one wakeup
+//!
+//! @details   Can be called from an ISR or the BG task.
+//! @details   Blocks are detached from the bpool in one pass, filled in
+//! @details   and linked into per-priority chains with interrupts
+//! @details   unlocked, then each chain is spliced onto the receiver's
+//! @details   queue under a single lock. Receiver is woken, or its wait
+//! @details   aborted, as if the highest priority message in the batch
+//! @details   was sent by nufr_msg_send().
+//! @details   Messages of a priority keep their order in 'entries'.
+//! @details   If the bpool runs short, the first messages in 'entries'
+//! @details   are the ones sent.
+//! @details   With NUFR_CS_MSG_QUEUE_LIMIT, messages of a priority past
+//! @details   the receiver's queue limit are dropped, and counted in
+//! @details   its 'msg_queue_full_count'.
+//! @details   With NUFR_CS_MSG_POOL_RESERVE, a task-level batch may only
+//! @details   use the reserved blocks if every entry is priority 0.
+//!
+//! @param[in] 'entries'-- (fields, parameter) pairs. Fields packed as for
+//! @param[in]             nufr_msg_send()
+//! @param[in] 'count'-- number of 'entries'
+//! @param[in] 'dest_task_id'--task that will receive messages
+//
+//! @return    Number of messages sent
+//!
+unsigned nufr_msg_send_batch(const nufr_msg_batch_entry_t *entries,
+                             unsigned                      count,
+                             nufr_tid_t                    dest_task_id)
+{
+    nufr_msg_t             *chain_heads[NUFR_CS_MSG_PRIORITIES];
+    nufr_msg_t             *chain_tails[NUFR_CS_MSG_PRIORITIES];
+    unsigned                send_priority;
+    unsigned                wake_priority;
+    unsigned                priority;
+    nufr_sr_reg_t           saved_psr;
+    unsigned                num_sent;
+    unsigned                limit;
+    unsigned                refused = 0;
+    unsigned                i;
+    bool                    send_occured;
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    nufr_msg_caller_t       caller = NUFR_MSG_CALLER_CONTROL;
+#endif
+    nufr_msg_t             *msg;
+    nufr_msg_t             *first_msg;
+    nufr_msg_t             *last_msg;
+    nufr_msg_t             *splice_head;
+    nufr_msg_t             *splice_tail;
+    nufr_tcb_t             *dest_tcb;
+    nufr_msg_t            **head_ptr;
+    nufr_msg_t            **tail_ptr;
+
+    dest_tcb = NUFR_TID_TO_TCB(dest_task_id);
+    if ((NULL == entries) || !NUFR_IS_TCB(dest_tcb))
+    {
+        KERNEL_REQUIRE_API(false);
+        return 0;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if ((NUFR_GET_MSG_PRIORITY(entries[i].fields) >= NUFR_CS_MSG_PRIORITIES) ||
+            (NUFR_GET_MSG_SENDING_TASK(entries[i].fields) >= NUFR_TID_max))
+        {
+            KERNEL_REQUIRE_API(false);
+            return 0;
+        }
+    #if NUFR_CS_MSG_POOL_RESERVE == 1
+        // Any non-control entry makes the whole batch task-level
+        if (NUFR_MSG_CALLER_TASK == NUFR_MSG_CALLER(entries[i].fields))
+        {
+            caller = NUFR_MSG_CALLER_TASK;
+        }
+    #endif
+    }
+
+    if (0 == count)
+    {
+        return 0;
+    }
+
+    //###### First: Detach up to 'count' blocks from bpool head
+    //###
+    num_sent = 0;
+    limit = count;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    if (NUFR_IS_ISR())
+    {
+        caller = NUFR_MSG_CALLER_ISR;
+    }
+    // Keep task-level batches out of the reserved blocks
+    if (NUFR_MSG_CALLER_TASK == caller)
+    {
+        if (nufr_msg_pool_free <= NUFR_MSG_POOL_ISR_RESERVE)
+        {
+            limit = 0;
+        }
+        else if (limit > nufr_msg_pool_free - NUFR_MSG_POOL_ISR_RESERVE)
+        {
+            limit = nufr_msg_pool_free - NUFR_MSG_POOL_ISR_RESERVE;
+        }
+    }
+#endif  //NUFR_CS_MSG_POOL_RESERVE
+
+    first_msg = nufr_msg_free_head;
+    last_msg = NULL;
+    msg = first_msg;
+    while ((NULL != msg) && (num_sent < limit))
+    {
+        last_msg = msg;
+        msg = msg->flink;
+        num_sent++;
+    }
+
+    if (NULL != last_msg)
+    {
+        nufr_msg_free_head = msg;
+        last_msg->flink = NULL;
+
+        // Did this alloc deplete bpool? Not an error here: caller
+        //   learns from return value how many were sent.
+        if (NULL == msg)
+        {
+            nufr_msg_free_tail = NULL;
+            nufr_msg_pool_empty_count++;
+        }
+        NUFR_MSG_POOL_TAKEN(num_sent);
+    }
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    nufr_msg_pool_alloc_fails[caller] += count - num_sent;
+#endif
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    if (0 == num_sent)
+    {
+        return 0;
+    }
+
+    //###### Second: Fill in blocks, sort into per-priority chains
+    //###
+    rutils_memset(chain_heads, 0, sizeof(chain_heads));
+    rutils_memset(chain_tails, 0, sizeof(chain_tails));
+    send_priority = NUFR_CS_MSG_PRIORITIES;
+
+    msg = first_msg;
+    for (i = 0; i < num_sent; i++)
+    {
+        nufr_msg_t *next_msg = msg->flink;
+
+        priority = NUFR_GET_MSG_PRIORITY(entries[i].fields);
+        if (priority < send_priority)
+        {
+            send_priority = priority;
+        }
+
+        msg->flink = NULL;
+        msg->fields = entries[i].fields;
+        msg->parameter = entries[i].parameter;
+
+        if (NULL == chain_heads[priority])
+        {
+            chain_heads[priority] = msg;
+        }
+        else
+        {
+            chain_tails[priority]->flink = msg;
+        }
+        chain_tails[priority] = msg;
+
+        NUFR_TRACE(NUFR_TRACE_MSG_SEND, (uint8_t)dest_task_id,
+                   NUFR_GET_MSG_ID(msg->fields), msg->fields);
+
+        msg = next_msg;
+    }
+
+    //###### Third: Splice chains onto receiver's queues, wake receiver
+    //###
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    // Sanity check: dest task must be active
+    send_occured = ARE_BITS_CLR(dest_tcb->block_flags, NUFR_TASK_NOT_LAUNCHED);
+    if (send_occured)
+    {
+        // Highest priority of any message spliced
+        wake_priority = NUFR_CS_MSG_PRIORITIES;
+
+        for (priority = send_priority; priority < NUFR_CS_MSG_PRIORITIES;
+             priority++)
+        {
+            splice_head = chain_heads[priority];
+            if (NULL == splice_head)
+            {
+                continue;
+            }
+            splice_tail = chain_tails[priority];
+
+            // Spliced blocks are receiver's. Any left are given back.
+            chain_heads[priority] = NULL;
+
+        #if (NUFR_CS_MSG_INDEX == 1) || (NUFR_CS_MSG_QUEUE_LIMIT == 1)
+            splice_tail = NULL;
+            for (msg = splice_head; NULL != msg; msg = msg->flink)
+            {
+            #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+                if (!NUFR_MSG_QUEUE_HAS_ROOM(dest_tcb, priority))
+                {
+                    chain_heads[priority] = msg;
+                    for (; NULL != msg; msg = msg->flink)
+                    {
+                        refused++;
+                    }
+                    break;
+                }
+                NUFR_MSG_DEPTH_INC(dest_tcb, msg->fields);
+            #endif
+            #if NUFR_CS_MSG_INDEX == 1
+                dest_tcb->msg_index[priority][NUFR_MSG_INDEX_HASH(msg->fields)]++;
+            #endif
+                splice_tail = msg;
+            }
+
+            // Whole chain refused?
+            if (NULL == splice_tail)
+            {
+                continue;
+            }
+            splice_tail->flink = NULL;
+        #endif
+
+            head_ptr = &(&dest_tcb->msg_head0)[priority];
+            tail_ptr = &(&dest_tcb->msg_tail0)[priority];
+
+            if (NULL == *head_ptr)
+            {
+                *head_ptr = splice_head;
+            }
+            else
+            {
+                (*tail_ptr)->flink = splice_head;
+            }
+            *tail_ptr = splice_tail;
+
+            if (priority < wake_priority)
+            {
+                wake_priority = priority;
+            }
+        }
+
+    #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+        dest_tcb->msg_queue_full_count += refused;
+    #endif
+
+        if ((wake_priority < NUFR_CS_MSG_PRIORITIES) &&
+            msg_wake_receiver_il(dest_tcb, wake_priority))
+        {
+            NUFR_INVOKE_CONTEXT_SWITCH();
+        }
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+
+    // Dest not launched, or messages refused: give blocks back
+    if (!send_occured || (0 != refused))
+    {
+        for (priority = send_priority; priority < NUFR_CS_MSG_PRIORITIES;
+             priority++)
+        {
+            msg = chain_heads[priority];
+            while (NULL != msg)
+            {
+                nufr_msg_t *next_msg = msg->flink;
+
+                msg->flink = NULL;
+                nufr_msg_free_block(msg);
+                msg = next_msg;
+            }
+        }
+
+        if (!send_occured)
+        {
+            return 0;
+        }
+    }
+
+    return num_sent - refused;
+}
+
+#if NUFR_CS_MSG_INDEX == 1
+//!
+//! @name      nufr_msg_send_coalesce
+//!
+//! @brief     nufr_msg_send(), unless a message with the same prefix,
+//! @brief     ID, priority and parameter is already queued to receiver
+//!
+//! @details   Can be called from an ISR or the BG task.
+//! @details   For periodic notifications (timer ticks, status polls)
+//! @details   where one unread message says all that several would.
+//! @details   Check and enqueue are done under one interrupt lock, so
+//! @details   a message the receiver dequeues meanwhile isn't coalesced
+//! @details   against, and racing senders don't queue duplicates.
+//! @details   A block is taken from the bpool beforehand, and given
+//! @details   back if the message is coalesced.
+//! @details   Receiver is woken, or its wait aborted, as by
+//! @details   nufr_msg_send().
+//!
+//! @param[in] see nufr_msg_send()
+//
+//! @return    NUFR_MSG_SEND_OK if coalesced, else as nufr_msg_send()
+//!
+nufr_msg_send_rtn_t nufr_msg_send_coalesce(uint32_t   msg_fields,
+                                           uint32_t   optional_parameter,
+                                           nufr_tid_t dest_task_id)
+{
+    nufr_msg_t             *msg;
+    nufr_tcb_t             *dest_tcb;
+    nufr_msg_t            **head_ptr;
+    nufr_msg_t            **tail_ptr;
+    nufr_sr_reg_t           saved_psr;
+    unsigned                send_priority;
+    nufr_msg_send_rtn_t     return_value = NUFR_MSG_SEND_OK;
+
+    KERNEL_REQUIRE_API(NUFR_GET_MSG_SENDING_TASK(msg_fields) < NUFR_TID_max);
+
+    dest_tcb = NUFR_TID_TO_TCB(dest_task_id);
+    send_priority = NUFR_GET_MSG_PRIORITY(msg_fields);
+    if ((send_priority >= NUFR_CS_MSG_PRIORITIES) || !NUFR_IS_TCB(dest_tcb))
+    {
+        KERNEL_REQUIRE_API(false);
+        return NUFR_MSG_SEND_ERROR;
+    }
+
+    msg = nufr_msg_get_block();
+    if (NULL == msg)
+    {
+        return NUFR_MSG_SEND_ERROR;
+    }
+
+    msg->flink = NULL;
+    msg->fields = msg_fields;
+    msg->parameter = optional_parameter;
+
+    head_ptr = &(&dest_tcb->msg_head0)[send_priority];
+    tail_ptr = &(&dest_tcb->msg_tail0)[send_priority];
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    if (ANY_BITS_SET(dest_tcb->block_flags, NUFR_TASK_NOT_LAUNCHED))
+    {
+        return_value = NUFR_MSG_SEND_ERROR;
+    }
+    else if (msg_find_pending_il(dest_tcb, msg_fields, &optional_parameter))
+    {
+        // Coalesced: 'msg' not needed
+    }
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    else if (!NUFR_MSG_QUEUE_HAS_ROOM(dest_tcb, send_priority))
+    {
+        dest_tcb->msg_queue_full_count++;
+        return_value = NUFR_MSG_SEND_QUEUE_FULL;
+    }
+#endif
+    else
+    {
+        if (NULL == *head_ptr)
+        {
+            *head_ptr = msg;
+        }
+        else
+        {
+            (*tail_ptr)->flink = msg;
+        }
+        *tail_ptr = msg;
+        NUFR_MSG_INDEX_INC(dest_tcb, msg_fields);
+        NUFR_MSG_DEPTH_INC(dest_tcb, msg_fields);
+
+        NUFR_TRACE(NUFR_TRACE_MSG_SEND, (uint8_t)dest_task_id,
+                   NUFR_GET_MSG_ID(msg_fields), msg_fields);
+
+        if (msg_wake_receiver_il(dest_tcb, send_priority))
+        {
+            NUFR_INVOKE_CONTEXT_SWITCH();
+            return_value = NUFR_MSG_SEND_AWOKE_RECEIVER;
+        }
+
+        // Receiver owns it now
+        msg = NULL;
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+
+    if (NULL != msg)
+    {
+        nufr_msg_free_block(msg);
+    }
+
+    return return_value;
+}
+#endif  //NUFR_CS_MSG_INDEX
+
+#if NUFR_CS_MSG_PAYLOAD == 1
+//!
+//! @name      nufr_msg_send_payload
+//!
+//! @brief     Sends a message carrying up to NUFR_MSG_PAYLOAD_SIZE bytes
+//! @brief     of inline data
+//!
+//! @details   Can be called from an ISR or the BG task.
+//! @details   Payload is copied into a block from the inline-payload
+//! @details   pool, so it needn't outlive this call. Receiver gets
+//! @details   payload with nufr_msg_payload_getW()/nufr_msg_payload_getT().
+//!
+//! @param[in] 'msg_fields'-- see nufr_msg_send()
+//! @param[in] 'payload_ptr'-- data to send. May be NULL if 'length' is 0.
+//! @param[in] 'length'-- bytes at 'payload_ptr'
+//! @param[in] 'dest_task_id'--task that will receive message
+//
+//! @return      Action applied to receiving task.
+//! @return      NUFR_MSG_SEND_ERROR if inline-payload pool is depleted.
+//!
+nufr_msg_send_rtn_t nufr_msg_send_payload(uint32_t    msg_fields,
+                                          const void *payload_ptr,
+                                          unsigned    length,
+                                          nufr_tid_t  dest_task_id)
+{
+    nufr_msg_t            *msg;
+    nufr_msg_send_rtn_t    return_value;
+
+    KERNEL_REQUIRE_API(length <= NUFR_MSG_PAYLOAD_SIZE);
+    KERNEL_REQUIRE_API((NULL != payload_ptr) || (0 == length));
+
+    msg = nufr_msg_payload_get_block();
+    if (NULL == msg)
+    {
+        return NUFR_MSG_SEND_ERROR;
+    }
+
+    msg->fields = msg_fields;
+    msg->parameter = length;
+    ((nufr_msg_payload_t *)msg)->length = (uint16_t)length;
+    if (0 != length)
+    {
+        rutils_memcpy(((nufr_msg_payload_t *)msg)->payload, payload_ptr, length);
+    }
+
+    return_value = nufr_msg_send_by_block(msg, dest_task_id);
+
+    // Receiver didn't take ownership
+    if ((NUFR_MSG_SEND_ERROR == return_value) ||
+        (NUFR_MSG_SEND_QUEUE_FULL == return_value))
+    {
+        nufr_msg_free_block(msg);
+    }
+
+    return return_value;
+}
+#endif  //NUFR_CS_MSG_PAYLOAD
+
+#if NUFR_CS_MSG_BROADCAST == 1
+//!
+//! @name      msg_bcast_send_by_block
+//!
+//! @brief     nufr_msg_broadcast() to one receiver without a free link
+//!
+//! @details   Can be called from an ISR or the BG task.
+//! @details   Sends the receiver its own copy, from the message bpool,
+//! @details   or the inline-payload pool if there's a payload. Same
+//! @details   message, delivered the same way, as a link would give.
+//!
+//! @param[in] see nufr_msg_broadcast()
+//! @param[in] 'dest_task_id'--task that will receive message
+//
+//! @return    'true' if message was queued
+//!
+static bool msg_bcast_send_by_block(uint32_t    msg_fields,
+                                    uint32_t    parameter,
+                                    const void *payload_ptr,
+                                    unsigned    length,
+                                    nufr_tid_t  dest_task_id)
+{
+    nufr_msg_t            *msg;
+    nufr_msg_send_rtn_t    send_status;
+
+    if (0 == length)
+    {
+        msg = nufr_msg_get_block();
+    }
+    else
+    {
+        msg = nufr_msg_payload_get_block();
+        if (NULL != msg)
+        {
+            ((nufr_msg_payload_t *)msg)->length = (uint16_t)length;
+            rutils_memcpy(((nufr_msg_payload_t *)msg)->payload,
+                          payload_ptr, length);
+        }
+    }
+
+    if (NULL == msg)
+    {
+        return false;
+    }
+
+    msg->fields = msg_fields;
+    msg->parameter = parameter;
+
+    send_status = nufr_msg_send_by_block(msg, dest_task_id);
+
+    // Receiver didn't take ownership
+    if ((NUFR_MSG_SEND_ERROR == send_status) ||
+        (NUFR_MSG_SEND_QUEUE_FULL == send_status))
+    {
+        nufr_msg_free_block(msg);
+        return false;
+    }
+
+    return true;
+}
+
+//!
+//! @name      nufr_msg_broadcast
+//!
+//! @brief     Sends one message to several tasks, sharing a single
+//! @brief     reference-counted descriptor
+//!
+//! @details   Can be called from an ISR or the BG task.
+//! @details   Descriptor comes from the inline-payload pool and holds
+//! @details   'parameter' and the payload. Each receiver's queue gets
+//! @details   one of its tcb's 'bcast_links[]', so the message bpool
+//! @details   isn't touched however many receivers there are. The last
+//! @details   receiver to dequeue (or drain/purge) its link returns the
+//! @details   descriptor to its pool.
+//! @details   All receivers are queued and woken under one interrupt
+//! @details   lock, with at most one context switch.
+//! @details   Receivers get 'parameter' as a message's parameter; a
+//! @details   nufr_msg_payload_getW() caller gets it in 'length_ptr',
+//! @details   so pass payload length as 'parameter' for those.
+//! @details   If the inline-payload pool is depleted, every receiver
+//! @details   gets its own block.
+//! @details   Tasks not launched are skipped. Tasks with all links in
+//! @details   use get their own block instead, after the others are
+//! @details   queued (see msg_bcast_send_by_block()), and are counted
+//! @details   in 'nufr_msg_bcast_overflow_count'. With
+//! @details   NUFR_CS_MSG_QUEUE_LIMIT, tasks whose queue is at its limit
+//! @details   are skipped and counted in their 'msg_queue_full_count'.
+//!
+//! @param[in] 'msg_fields'-- see nufr_msg_send()
+//! @param[in] 'parameter'-- see nufr_msg_send()
+//! @param[in] 'payload_ptr'-- data to send. May be NULL if 'length' is 0.
+//! @param[in] 'length'-- bytes at 'payload_ptr'
+//! @param[in] 'tid_list'-- receivers
+//! @param[in] 'tid_count'-- number of 'tid_list' entries
+//
+//! @return    Number of tasks message was queued to
+//!
+unsigned nufr_msg_broadcast(uint32_t          msg_fields,
+                            uint32_t          parameter,
+                            const void       *payload_ptr,
+                            unsigned          length,
+                            const nufr_tid_t *tid_list,
+                            unsigned          tid_count)
+{
+    nufr_msg_payload_t     *desc;
+    nufr_msg_t             *link;
+    nufr_msg_t            **head_ptr;
+    nufr_msg_t            **tail_ptr;
+    nufr_tcb_t             *dest_tcb;
+    nufr_sr_reg_t           saved_psr;
+    unsigned                send_priority;
+    unsigned                num_receivers;
+    unsigned                i;
+    unsigned                j;
+    bool                    invoke = false;
+    // Per task, times it was out of links
+    uint8_t                 link_overflows[NUFR_NUM_TASKS];
+    bool                    any_link_overflow = false;
+
+    send_priority = NUFR_GET_MSG_PRIORITY(msg_fields);
+
+    if ((NULL == tid_list) ||
+        (send_priority >= NUFR_CS_MSG_PRIORITIES) ||
+        (NUFR_GET_MSG_SENDING_TASK(msg_fields) >= NUFR_TID_max) ||
+        (length > NUFR_MSG_PAYLOAD_SIZE) ||
+        ((NULL == payload_ptr) && (0 != length)))
+    {
+        KERNEL_REQUIRE_API(false);
+        return 0;
+    }
+
+    num_receivers = 0;
+
+    // No descriptor to share: every receiver gets its own block
+    desc = (nufr_msg_payload_t *)nufr_msg_payload_get_block();
+    if (NULL == desc)
+    {
+        for (i = 0; i < tid_count; i++)
+        {
+            if (msg_bcast_send_by_block(msg_fields, parameter,
+                                        payload_ptr, length, tid_list[i]))
+            {
+                num_receivers++;
+            }
+        }
+
+        return num_receivers;
+    }
+
+    // Descriptor isn't visible to receivers until a link is queued,
+    //   so fill it in unlocked
+    desc->header.fields = msg_fields;
+    desc->header.parameter = parameter;
+    desc->length = (uint16_t)length;
+    desc->refcount = 0;
+    if (0 != length)
+    {
+        rutils_memcpy(desc->payload, payload_ptr, length);
+    }
+
+    rutils_memset(link_overflows, 0, sizeof(link_overflows));
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    for (i = 0; i < tid_count; i++)
+    {
+        dest_tcb = NUFR_TID_TO_TCB(tid_list[i]);
+        if (!NUFR_IS_TCB(dest_tcb))
+        {
+            KERNEL_REQUIRE_IL(false);
+            continue;
+        }
+
+        if (ANY_BITS_SET(dest_tcb->block_flags, NUFR_TASK_NOT_LAUNCHED))
+        {
+            continue;
+        }
+
+    #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+        if (!NUFR_MSG_QUEUE_HAS_ROOM(dest_tcb, send_priority))
+        {
+            dest_tcb->msg_queue_full_count++;
+            continue;
+        }
+    #endif
+
+        link = NULL;
+        for (j = 0; j < NUFR_BCAST_LINKS_PER_TASK; j++)
+        {
+            if (0 == dest_tcb->bcast_links[j].parameter)
+            {
+                link = &dest_tcb->bcast_links[j];
+                break;
+            }
+        }
+
+        if (NULL == link)
+        {
+            nufr_msg_bcast_overflow_count++;
+            link_overflows[tid_list[i] - 1]++;
+            any_link_overflow = true;
+            continue;
+        }
+
+        link->flink = NULL;
+        link->fields = msg_fields;
+        link->parameter = (uint32_t)(desc - nufr_msg_payload_bpool) + 1;
+        desc->refcount++;
+
+        head_ptr = &(&dest_tcb->msg_head0)[send_priority];
+        tail_ptr = &(&dest_tcb->msg_tail0)[send_priority];
+        if (NULL == *head_ptr)
+        {
+            *head_ptr = link;
+        }
+        else
+        {
+            (*tail_ptr)->flink = link;
+        }
+        *tail_ptr = link;
+        NUFR_MSG_INDEX_INC(dest_tcb, msg_fields);
+        NUFR_MSG_DEPTH_INC(dest_tcb, msg_fields);
+
+        NUFR_TRACE(NUFR_TRACE_MSG_SEND, (uint8_t)tid_list[i],
+                   NUFR_GET_MSG_ID(msg_fields), msg_fields);
+
+        if (msg_wake_receiver_il(dest_tcb, send_priority))
+        {
+            invoke = true;
+        }
+
+        num_receivers++;
+    }
+
+    if (invoke)
+    {
+        NUFR_INVOKE_CONTEXT_SWITCH();
+    }
+
+    // Nobody took a reference
+    if (0 == desc->refcount)
+    {
+        desc->header.flink = nufr_msg_payload_free_head;
+        nufr_msg_payload_free_head = &desc->header;
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+
+    if (any_link_overflow)
+    {
+        for (i = 0; i < tid_count; i++)
+        {
+            if (0 == link_overflows[tid_list[i] - 1])
+            {
+                continue;
+            }
+            link_overflows[tid_list[i] - 1]--;
+
+            if (msg_bcast_send_by_block(msg_fields, parameter,
+                                        payload_ptr, length, tid_list[i]))
+            {
+                num_receivers++;
+            }
+        }
+    }
+
+    return num_receivers;
+}
+#endif  //NUFR_CS_MSG_BROADCAST
+
+//!
+//! @name      nufr_msg_getW
+//!
+//! @brief     Get a message, block indefinitely until you get one
+//!
+//! @details   Cannot be called from an ISR or from BG task
+//! @details   Always returns having obtained a message: no other case.
+//! @details
+//!
+//! @param[out] 'msg_fields_ptr'-- caller variable to put msg->fields
+//! @param[out]                for this msg.
+//! @param[out] 'parameter_ptr'-- caller variable to put msg->parameter
+//! @param[out]           If NULL, ignore
+//!
+void nufr_msg_getW(uint32_t *msg_fields_ptr, uint32_t *parameter_ptr)
+{
+    msg_getW(msg_fields_ptr, parameter_ptr, NULL, 0);
+}
+
+//!
+//! @name      nufr_msg_getT
+//!
+//! @brief     Get a message, block until 'timeout_ticks'
+//!
+//! @details   Cannot be called from an ISR or from BG task
+//! @details
+//! @details   Same as 'nufr_msg_getW()', except with timeout
+//! @details   
+//!
+//! @params[in] timeout_ticks-- timeout. If == 0, return from API call
+//! @params[in]       immediately if no msg waiting.
+//! @param[out] 'msg_fields_ptr'-- caller variable to put msg->fields
+//! @param[out]                for this msg.
+//! @param[out] 'parameter_ptr'-- caller variable to put msg->parameter
+//! @param[out]           If NULL, ignore
+//!
+//! @return     'true' if timeout occured
+//!
+bool nufr_msg_getT(unsigned  timeout_ticks,
+                   uint32_t *msg_fields_ptr,
+                   uint32_t *parameter_ptr)
+{
+    return msg_getT(timeout_ticks, msg_fields_ptr, parameter_ptr, NULL, 0);
+}
+
+#if NUFR_CS_MSG_PAYLOAD == 1
+//!
+//! @name      nufr_msg_payload_getW
+//!
+//! @brief     Same as nufr_msg_getW(), also copying out payload of an
+//! @brief     inline-payload message.
+//!
+//! @details   Cannot be called from an ISR or from BG task
+//! @details   A message sent with nufr_msg_send() can be received by
+//! @details   this too; nothing is copied to 'payload_ptr' then.
+//!
+//! @param[out] 'msg_fields_ptr'-- caller variable to put msg->fields
+//! @param[out]                for this msg.
+//! @param[out] 'length_ptr'-- caller variable to put payload length.
+//! @param[out]           For a message without payload, gets
+//! @param[out]           msg->parameter instead. If NULL, ignore
+//! @param[out] 'payload_ptr'-- buffer to copy payload to
+//! @param[in] 'payload_size'-- size of 'payload_ptr' buffer. Payload
+//! @param[in]        is truncated to this.
+//!
+void nufr_msg_payload_getW(uint32_t *msg_fields_ptr,
+                           uint32_t *length_ptr,
+                           void     *payload_ptr,
+                           unsigned  payload_size)
+{
+    msg_getW(msg_fields_ptr, length_ptr, payload_ptr, payload_size);
+}
+
+//!
+//! @name      nufr_msg_payload_getT
+//!
+//! @brief     Same as nufr_msg_getT(), also copying out payload of an
+//! @brief     inline-payload message.
+//!
+//! @details   Cannot be called from an ISR or from BG task
+//!
+//! @params[in] timeout_ticks-- timeout. If == 0, return from API call
+//! @params[in]       immediately if no msg waiting.
+//! @param[out] see nufr_msg_payload_getW()
+//!
+//! @return     'true' if timeout occured
+//!
+bool nufr_msg_payload_getT(unsigned  timeout_ticks,
+                           uint32_t *msg_fields_ptr,
+                           uint32_t *length_ptr,
+                           void     *payload_ptr,
+                           unsigned  payload_size)
+{
+    return msg_getT(timeout_ticks, msg_fields_ptr, length_ptr,
+                    payload_ptr, payload_size);
+}
+#endif  //NUFR_CS_MSG_PAYLOAD
+
+//!
+//! @name      nufr_msg_peek
+//!
+//! @brief     Returns the first message block without dequeing it
+//!
+//! @details   Caller might want to lock/unlock interrupts around this
+//! @details   call, as another task or an ISR may change the msg queue
+//! @details   at an inconvenient time.
+//! @details   With NUFR_CS_MSG_BROADCAST, head may be a broadcast link
+//! @details   entry: only its 'fields' are valid.
 //!
 //! @return      Message at head of list. NULL if no message.
 //!
@@ -38,6 +38,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-api.h"
 #include "nufr-kernel-semaphore.h"
 #include "nufr-kernel-task.h"
+#include "nufr-kernel-trace.h"
 #if NUFR_CS_OPTIMIZATION_INLINES == 1
     #include "nufr-kernel-task-inlines.h"
     #include "nufr-kernel-semaphore-inlines.h"
@@ -443,6 +444,9 @@ nufr_sema_get_rtn_t nufr_sema_getW(nufr_sema_t    sema,
     }
 #endif  // NUFR_CS_TASK_KILL
 
+    NUFR_TRACE(NUFR_TRACE_SEMA_GET, NUFR_TRACE_TID(nufr_running), sema,
+               return_value);
+
     return return_value;
 }
 
@@ -635,6 +639,9 @@ nufr_sema_get_rtn_t nufr_sema_getT(nufr_sema_t    sema,
         return_value = NUFR_SEMA_GET_OK_NO_BLOCK;
     }
 
+    NUFR_TRACE(NUFR_TRACE_SEMA_GET, NUFR_TRACE_TID(nufr_running), sema,
+               return_value);
+
     return return_value;
 }
 
@@ -733,6 +740,7 @@ bool nufr_sema_release(nufr_sema_t sema)
         //   from tcb.
         sema_block->owner_tcb = head_tcb;
         head_tcb->sema_block = sema_block;
+        head_tcb->block_flags &= BITWISE_NOT8(NUFR_TASK_BLOCKED_SEMA);
 
     #if NUFR_CS_OPTIMIZATION_INLINES == 1
         NUFRKERNEL_ADD_TASK_TO_READY_LIST(head_tcb);
@@ -751,7 +759,130 @@ bool nufr_sema_release(nufr_sema_t sema)
 
     NUFR_SECONDARY_CONTEXT_SWITCH();
 
+    NUFR_TRACE(NUFR_TRACE_SEMA_RELEASE, NUFR_TRACE_TID(nufr_running), sema,
+               !none_to_unblock);
+
     return !none_to_unblock;
 }
 
+//!
+//! @name      nufr_sema_release_count
+//
+//! @brief     Increment semaphore 'count' times
+//!
+//! @details   Same outcome as 'count' calls to 'nufr_sema_release()',
+//! @details   under one interrupt lock and with at most one context
+//! @details   switch. Up to 'count' waiters are woken, in wait list
+//! @details   order, and whatever is left over is added to the count.
+//! @details   Cannot be called from ISR or from Systick handler.
+//!
+//! @param[in] 'sema'
+//! @param[in] 'count'-- releases, > 0
+//!
+//! @return     Number of waiting tasks woken
+unsigned nufr_sema_release_count(nufr_sema_t sema, unsigned count)
+{
+#if NUFR_CS_OPTIMIZATION_INLINES == 1
+    NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS;
+#endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
+    nufr_sr_reg_t           saved_psr;
+    nufr_sema_block_t      *sema_block;
+    nufr_tcb_t             *head_tcb;
+    nufr_tcb_t             *old_head_tcb;
+    unsigned                woken = 0;
+    bool                    called_from_bg;
+    bool                    invoke = false;
+
+    sema_block = NUFR_SEMA_ID_TO_BLOCK(sema);
+    KERNEL_REQUIRE_API(NUFR_IS_SEMA_BLOCK(sema_block));
+    KERNEL_REQUIRE_API(count > 0);
+
+    called_from_bg = (nufr_running == (nufr_tcb_t *)nufr_bg_sp);
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    // See 'nufr_sema_release()'. Only first release can find
+    // running task's priority inverted.
+    if (!called_from_bg)
+    {
+        if (NUFR_IS_STATUS_SET(nufr_running, NUFR_TASK_INVERSION_PRIORITIZED))
+        {
+            nufr_running->statuses &=
+                            BITWISE_NOT8(NUFR_TASK_INVERSION_PRIORITIZED);
+
+            old_head_tcb = nufr_ready_list;
+
+        #if NUFR_CS_OPTIMIZATION_INLINES == 1
+            NUFRKERNEL_REMOVE_HEAD_TASK_FROM_READY_LIST();
+        #else
+            nufrkernel_remove_head_task_from_ready_list();
+        #endif
+
+            nufr_running->priority = nufr_running->priority_restore_inversion;
+
+        #if NUFR_CS_OPTIMIZATION_INLINES == 1
+            NUFRKERNEL_ADD_TASK_TO_READY_LIST(nufr_running);
+            UNUSED(macro_do_switch);                      // suppress warning
+        #else
+            (void)nufrkernel_add_task_to_ready_list(nufr_running);
+        #endif
+
+            invoke = (nufr_ready_list != old_head_tcb);
+        }
+
+        nufr_running->sema_block = NULL;
+    }
+
+    // If sema count is > 0, there can be no tasks waiting on a sema
+    KERNEL_ENSURE_IL((sema_block->count > 0)?
+                         (NULL == sema_block->task_list_head) : true);
+
+    // Hand a release to each waiter, first come first
+    while ((woken < count) && (NULL != sema_block->task_list_head))
+    {
+        head_tcb = sema_block->task_list_head;
+
+    #if NUFR_CS_OPTIMIZATION_INLINES == 1
+        NUFRKERNEL_SEMA_UNLINK_TASK(sema_block, head_tcb);
+    #else
+        nufrkernel_sema_unlink_task(sema_block, head_tcb);
+    #endif
+
+        sema_block->owner_tcb = head_tcb;
+        head_tcb->sema_block = sema_block;
+        head_tcb->block_flags &= BITWISE_NOT8(NUFR_TASK_BLOCKED_SEMA);
+
+    #if NUFR_CS_OPTIMIZATION_INLINES == 1
+        NUFRKERNEL_ADD_TASK_TO_READY_LIST(head_tcb);
+        invoke |= macro_do_switch;
+    #else
+        invoke |= nufrkernel_add_task_to_ready_list(head_tcb);
+    #endif
+
+        woken++;
+    }
+
+    // Rest go to the count. No one owns this sema anymore.
+    if (woken < count)
+    {
+        sema_block->owner_tcb = NULL;
+
+        sema_block->count += count - woken;
+    }
+
+    if (invoke)
+    {
+        NUFR_INVOKE_CONTEXT_SWITCH();
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    NUFR_SECONDARY_CONTEXT_SWITCH();
+
+    NUFR_TRACE(NUFR_TRACE_SEMA_RELEASE, NUFR_TRACE_TID(nufr_running), sema,
+               woken);
+
+    return woken;
+}
+
 #endif  //NUFR_CS_SEMAPHORE
\ No newline at end of file
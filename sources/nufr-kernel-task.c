@@ -39,6 +39,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-kernel-timer.h"
 #include "nufr-api.h"
 #include "nufr-kernel-semaphore.h"
+#if NUFR_CS_EVENT == 1
+    #include "nufr-kernel-event.h"
+#endif
+#include "nufr-kernel-trace.h"
 
 #include "raging-contract.h"
 #include "raging-utils-mem.h"
@@ -69,6 +73,34 @@ unsigned *nufr_bg_sp[NUFR_SP_INDEX_IN_TCB + 1];
 
 uint16_t nufr_bop_key;
 
+#if NUFR_CS_READY_LIST_BITMAP == 1
+// Bit set for each priority level which has 1 or more tasks on
+// the ready list. Priority 0 is the MSB.
+uint32_t nufr_ready_list_bitmap;
+
+// First and last ready list task of each priority level. NULL if none.
+nufr_tcb_t *nufr_ready_list_heads[NUFR_READY_LIST_LEVELS];
+nufr_tcb_t *nufr_ready_list_tails[NUFR_READY_LIST_LEVELS];
+#endif
+
+#if NUFR_CS_TASK_STATS == 1
+// BG task's stats (BG task has no TCB). 'run_time' is idle time.
+nufr_task_stats_t nufr_bg_stats;
+
+// NUFR_TASK_STATS_TIMESTAMP() value at last context switch
+uint32_t nufr_task_stats_timestamp;
+#endif
+
+#if NUFR_CS_TIME_SLICE == 1
+// Per priority level quantum, in OS ticks. 0 if level isn't time sliced.
+uint8_t nufr_time_slice_quantum[NUFR_TPR_MAX_VALUE + 1];
+
+// Task whose quantum is being counted, and ticks it has been seen running.
+// NULL if none.
+nufr_tcb_t *nufr_time_slice_tcb;
+uint8_t nufr_time_slice_ticks;
+#endif
+
 // .h's placed down here to pick up global variable definitions above
 #if NUFR_CS_OPTIMIZATION_INLINES == 1
     #include "nufr-kernel-task-inlines.h"
@@ -79,8 +111,332 @@ uint16_t nufr_bop_key;
 #endif
 
 
+#if NUFR_CS_READY_LIST_BITMAP == 1
+
+//! @name      ready_list_unlink
+//
+//! @brief     Removes a task from the ready list and from its
+//! @brief     priority level. O(1).
+//
+//! @details   When the ready list head is removed, the new head is
+//! @details   selected from the bitmap using a count leading zeroes.
+//! @details   Caller has verified that 'tcb' is on the ready list.
+//! @details   Interrupts blocked by caller, not in here.
+//
+//! @param[in] tcb-- task to be removed
+static void ready_list_unlink(nufr_tcb_t *tcb)
+{
+    nufr_tcb_t *prev_tcb = tcb->blink_ready;
+    nufr_tcb_t *next_tcb = tcb->flink;
+    unsigned    priority = tcb->priority;
+
+    KERNEL_ENSURE_IL(priority <= NUFR_TPR_MAX_VALUE);
+    KERNEL_ENSURE_IL(ANY_BITS_SET(nufr_ready_list_bitmap,
+                                  NUFR_READY_LIST_BIT(priority)));
+
+    // Adjust this priority level's head and tail
+    if (tcb == nufr_ready_list_heads[priority])
+    {
+        // Only task at this priority?
+        if (tcb == nufr_ready_list_tails[priority])
+        {
+            nufr_ready_list_heads[priority] = NULL;
+            nufr_ready_list_tails[priority] = NULL;
+            nufr_ready_list_bitmap &=
+                         BITWISE_NOT32(NUFR_READY_LIST_BIT(priority));
+        }
+        else
+        {
+            nufr_ready_list_heads[priority] = next_tcb;
+        }
+    }
+    else if (tcb == nufr_ready_list_tails[priority])
+    {
+        nufr_ready_list_tails[priority] = prev_tcb;
+    }
+
+    // Stitch links
+    if (NULL != next_tcb)
+    {
+        next_tcb->blink_ready = prev_tcb;
+    }
+    else
+    {
+        nufr_ready_list_tail = prev_tcb;
+    }
+
+    if (NULL != prev_tcb)
+    {
+        prev_tcb->flink = next_tcb;
+    }
+    // Removal task was head: new head is first task of highest
+    // priority level still populated.
+    else if (0 == nufr_ready_list_bitmap)
+    {
+        nufr_ready_list = NULL;
+    }
+    else
+    {
+        nufr_ready_list =
+            nufr_ready_list_heads[NUFR_CLZ32(nufr_ready_list_bitmap)];
+    }
+
+    nufr_ready_list_tail_nominal = nufr_ready_list_tails[NUFR_TPR_NOMINAL];
+
+    tcb->flink = NULL;
+    tcb->blink_ready = NULL;
+
+    KERNEL_ENSURE_IL(NULL == prev_tcb ? nufr_ready_list == next_tcb : true);
+    // If there is a head, there must be a tail
+    // If there is not head, there cannot be a tail
+    KERNEL_ENSURE_IL((nufr_ready_list == NULL) == (nufr_ready_list_tail == NULL));
+    // Last task on list must have an flink == NULL
+    KERNEL_ENSURE_IL(nufr_ready_list_tail != NULL?
+               nufr_ready_list_tail->flink == NULL : true);
+}
+
+//! @name      nufrkernel_add_task_to_ready_list
+//
+//! @brief     Inserts a task into the ready list. Bitmap version.
+//
+//! @details   Ready list is sorted by priority, highest priority on head.
+//! @details   Task is inserted behind the tail of its own priority level,
+//! @details   or, if none, behind the tail of the next higher populated
+//! @details   priority level. That level is found from the bitmap
+//! @details   with a count leading zeroes, so no list walk is needed.
+//! @details   Updates globals nufr_ready_list, nufr_ready_list_tail_nominal,
+//! @details   nufr_ready_list_tail, and the bitmap, heads and tails.
+//! @details   Interrupts blocked by caller, not in here.
+//
+//! @param[in] tcb-- task to be inserted
+//
+//! @return    'true' if the add necessitates a context switch
+bool nufrkernel_add_task_to_ready_list(nufr_tcb_t *tcb)
+{
+    bool        do_switch = false;
+    unsigned    priority;
+    uint32_t    higher_levels;
+    nufr_tcb_t *prev_tcb;
+
+    KERNEL_ENSURE_IL(NULL != tcb);
+    KERNEL_ENSURE_IL(NULL == tcb->flink);
+
+    priority = tcb->priority;
+
+    KERNEL_ENSURE_IL(priority <= NUFR_TPR_MAX_VALUE);
+
+    NUFR_TRACE(NUFR_TRACE_READY_INSERT, NUFR_TRACE_TID(tcb), priority, 0);
+
+    prev_tcb = nufr_ready_list_tails[priority];
+
+    // No other tasks at this priority? Then insert behind last task
+    // of next higher priority level which is populated.
+    if (NULL == prev_tcb)
+    {
+        // Bits of all priorities higher than 'priority'
+        higher_levels = nufr_ready_list_bitmap &
+                        BITWISE_NOT32(BIT_MASK32 >> priority);
+
+        if (0 != higher_levels)
+        {
+            // Lowest bit set is the nearest higher priority
+            prev_tcb = nufr_ready_list_tails[
+                           NUFR_CLZ32(BIT_LSB_SET32(higher_levels))];
+        }
+
+        nufr_ready_list_heads[priority] = tcb;
+        nufr_ready_list_bitmap |= NUFR_READY_LIST_BIT(priority);
+    }
+
+    nufr_ready_list_tails[priority] = tcb;
+
+    tcb->blink_ready = prev_tcb;
+
+    // Insert at head of Ready List?
+    if (NULL == prev_tcb)
+    {
+        tcb->flink = nufr_ready_list;
+        nufr_ready_list = tcb;
+
+        do_switch = true;
+    }
+    else
+    {
+        tcb->flink = prev_tcb->flink;
+        prev_tcb->flink = tcb;
+    }
+
+    if (NULL != tcb->flink)
+    {
+        tcb->flink->blink_ready = tcb;
+    }
+    else
+    {
+        nufr_ready_list_tail = tcb;
+    }
+
+    if (NUFR_TPR_NOMINAL == priority)
+    {
+        nufr_ready_list_tail_nominal = tcb;
+    }
+
+    // If there is a head, there must be a tail
+    // If there is not head, there cannot be a tail
+    KERNEL_ENSURE_IL((nufr_ready_list == NULL) == (nufr_ready_list_tail == NULL));
+    // Last task on list must have an flink == NULL
+    KERNEL_ENSURE_IL(nufr_ready_list_tail != NULL?
+               nufr_ready_list_tail->flink == NULL : true);
+    // Head is first task of highest priority populated
+    KERNEL_ENSURE_IL(nufr_ready_list ==
+               nufr_ready_list_heads[NUFR_CLZ32(nufr_ready_list_bitmap)]);
+
+    return do_switch;
+}
+
+//! @name      nufrkernel_block_running_task
+//
+//! @brief     Ready list head is popped, next task becomes current running
+//! @brief     task. Bitmap version.
+//
+//! @details   Updates tcb->block_flags, globals nufr_ready_list,
+//! @details   nufr_ready_list_tail_nominal, nufr_ready_list_tail,
+//! @details   and the bitmap, heads and tails.
+//! @details   Interrupts blocked by caller, not in here.
+//
+//! @param[in] block_flag-- single bit set into tcb->block_flags
+//! @param[in]                 indicating blocking condition
+void nufrkernel_block_running_task(unsigned block_flag)
+{
+    KERNEL_REQUIRE_IL(ANY_BITS_SET(block_flag, NUFR_TASK_NOT_LAUNCHED   |
+                                     NUFR_TASK_BLOCKED_ASLEEP |
+                                     NUFR_TASK_BLOCKED_BOP    |
+                                     NUFR_TASK_BLOCKED_MSG    |
+                                     NUFR_TASK_BLOCKED_SEMA   |
+                                     NUFR_TASK_BLOCKED_EVENT  |
+                                     NUFR_TASK_BLOCKED_MSG_SPACE));
+
+    // There must be a task to block
+    KERNEL_REQUIRE_IL(NULL != nufr_ready_list);
+    KERNEL_REQUIRE_IL(NULL != nufr_ready_list_tail);
+
+    nufr_ready_list->block_flags = block_flag;
+
+    NUFR_TRACE(NUFR_TRACE_BLOCK, NUFR_TRACE_TID(nufr_ready_list), 0,
+               block_flag);
+
+    ready_list_unlink(nufr_ready_list);
+}
+
+//! @name      nufrkernel_remove_head_task_from_ready_list
+//
+//! @brief     Ready list head is popped, next task becomes current running
+//! @brief     task. No TCB bits are changed. Bitmap version.
+//
+//! @details   Interrupts blocked by caller, not in here.
+void nufrkernel_remove_head_task_from_ready_list(void)
+{
+    KERNEL_ENSURE_IL(NULL != nufr_ready_list);
+    KERNEL_ENSURE_IL(NULL != nufr_ready_list_tail);
+
+    NUFR_TRACE(NUFR_TRACE_READY_REMOVE, NUFR_TRACE_TID(nufr_ready_list),
+               nufr_ready_list->priority, 0);
+
+    ready_list_unlink(nufr_ready_list);
+}
+
+//! @name      nufrkernel_delete_task_from_ready_list
+//
+//! @brief     Deletes a task from the ready list. Bitmap version.
+//
+//! @details   No list walk: 'tcb->blink_ready' gives the previous task.
+//! @details   A task is on the ready list if it's the head or if
+//! @details   it has a back link.
+//! @details   Interrupts blocked by caller, not in here.
+//
+//! @param[in] tcb-- task to be deleted
+void nufrkernel_delete_task_from_ready_list(nufr_tcb_t *tcb)
+{
+    // Cannot be BG task or be a NULL ptr
+    KERNEL_REQUIRE_IL(NUFR_IS_TCB(tcb));
+
+    // Empty list?
+    if (NULL == nufr_ready_list)
+    {
+        return;
+    }
+    // Sanity check: can't remove ourselves
+    else if (tcb == nufr_running)
+    {
+        return;
+    }
+    // Not on list?
+    else if ((tcb != nufr_ready_list) && (NULL == tcb->blink_ready))
+    {
+        return;
+    }
+
+    // Sanity check: only the BG task can remove the last task
+    KERNEL_ENSURE_IL(nufr_ready_list == nufr_ready_list_tail ? 
+              nufr_running == (nufr_tcb_t *)nufr_bg_sp
+              : true);
+
+    NUFR_TRACE(NUFR_TRACE_READY_REMOVE, NUFR_TRACE_TID(tcb), tcb->priority, 0);
+
+    ready_list_unlink(tcb);
+}
+
+//! @name      nufrkernel_reprioritize_head_task
+//
+//! @brief     Changes the priority of the ready list head, for the
+//! @brief     case where the head stays the head. Bitmap version only.
+//
+//! @details   Ready list order is unchanged, so only the bitmap,
+//! @details   heads and tails are updated. Caller must guarantee that no
+//! @details   other ready task is higher priority than 'new_priority'.
+//! @details   Interrupts blocked by caller, not in here.
+//
+//! @param[in] new_priority-- priority to set head task to
+void nufrkernel_reprioritize_head_task(unsigned new_priority)
+{
+    nufr_tcb_t *tcb = nufr_ready_list;
+    unsigned    old_priority;
+
+    KERNEL_REQUIRE_IL(NULL != tcb);
+    KERNEL_REQUIRE_IL(new_priority <= NUFR_TPR_MAX_VALUE);
+
+    old_priority = tcb->priority;
+
+    // Leave old priority level. Head is always first of its level.
+    if (tcb == nufr_ready_list_tails[old_priority])
+    {
+        nufr_ready_list_heads[old_priority] = NULL;
+        nufr_ready_list_tails[old_priority] = NULL;
+        nufr_ready_list_bitmap &=
+                         BITWISE_NOT32(NUFR_READY_LIST_BIT(old_priority));
+    }
+    else
+    {
+        nufr_ready_list_heads[old_priority] = tcb->flink;
+    }
+
+    tcb->priority = new_priority;
+
+    // Join new priority level as its first task
+    if (NULL == nufr_ready_list_heads[new_priority])
+    {
+        nufr_ready_list_tails[new_priority] = tcb;
+        nufr_ready_list_bitmap |= NUFR_READY_LIST_BIT(new_priority);
+    }
+    nufr_ready_list_heads[new_priority] = tcb;
+
+    nufr_ready_list_tail_nominal = nufr_ready_list_tails[NUFR_TPR_NOMINAL];
+
+    KERNEL_ENSURE_IL(nufr_ready_list ==
+               nufr_ready_list_heads[NUFR_CLZ32(nufr_ready_list_bitmap)]);
+}
+
 // If using inlines, forbid using these
-#if NUFR_CS_OPTIMIZATION_INLINES == 0
+#elif NUFR_CS_OPTIMIZATION_INLINES == 0
 
 //! @name      nufrkernel_add_task_to_ready_list
 //
@@ -104,6 +460,8 @@ bool nufrkernel_add_task_to_ready_list(nufr_tcb_t *tcb)
 
     priority = tcb->priority;
 
+    NUFR_TRACE(NUFR_TRACE_READY_INSERT, NUFR_TRACE_TID(tcb), priority, 0);
+
     // The "Fast-Inserts" are ones which use one, two, or three of
     // the head & tail pointers as a means to avoid a Ready List
     // walk. A Fast-Insert is an O**1 operation, vs. a Ready List walk,
@@ -295,7 +653,9 @@ void nufrkernel_block_running_task(unsigned block_flag)
                                      NUFR_TASK_BLOCKED_ASLEEP |
                                      NUFR_TASK_BLOCKED_BOP    |
                                      NUFR_TASK_BLOCKED_MSG    |
-                                     NUFR_TASK_BLOCKED_SEMA));
+                                     NUFR_TASK_BLOCKED_SEMA   |
+                                     NUFR_TASK_BLOCKED_EVENT  |
+                                     NUFR_TASK_BLOCKED_MSG_SPACE));
     KERNEL_REQUIRE_IL(ANY_BITS_SET(block_flag, NUFR_TASK_NOT_LAUNCHED)?
             ARE_BITS_CLR(block_flag, NUFR_TASK_BLOCKED_ASLEEP |
                                      NUFR_TASK_BLOCKED_BOP    |
@@ -321,6 +681,9 @@ void nufrkernel_block_running_task(unsigned block_flag)
 
     nufr_ready_list->block_flags = block_flag;
 
+    NUFR_TRACE(NUFR_TRACE_BLOCK, NUFR_TRACE_TID(nufr_ready_list), 0,
+               block_flag);
+
     next_tcb = nufr_ready_list->flink;
     nufr_ready_list->flink = NULL;
 
@@ -372,6 +735,9 @@ void nufrkernel_remove_head_task_from_ready_list(void)
     KERNEL_ENSURE_IL(NULL != nufr_ready_list);
     KERNEL_ENSURE_IL(NULL != nufr_ready_list_tail);
 
+    NUFR_TRACE(NUFR_TRACE_READY_REMOVE, NUFR_TRACE_TID(nufr_ready_list),
+               nufr_ready_list->priority, 0);
+
     next_tcb = nufr_ready_list->flink;
     nufr_ready_list->flink = NULL;
 
@@ -486,6 +852,8 @@ void nufrkernel_delete_task_from_ready_list(nufr_tcb_t *tcb)
         return;
     }
 
+    NUFR_TRACE(NUFR_TRACE_READY_REMOVE, NUFR_TRACE_TID(tcb), tcb->priority, 0);
+
     next_tcb = this_tcb->flink;
 
     // Adjust head, tail, nominal tail if necessary
@@ -544,7 +912,7 @@ void nufrkernel_delete_task_from_ready_list(nufr_tcb_t *tcb)
                nufr_ready_list->flink != NULL : true);
 }
 
-#endif  // NUFR_CS_OPTIMIZATION_INLINES == 0
+#endif  // NUFR_CS_READY_LIST_BITMAP, NUFR_CS_OPTIMIZATION_INLINES
 
 //! @name      nufr_launch_task
 // !
@@ -601,6 +969,11 @@ void nufr_launch_task(nufr_tid_t task_id, unsigned parameter)
 
     //#####    Set other fields in TCB
     target_tcb->priority = desc->start_priority;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    target_tcb->msg_queue_limit = desc->msg_queue_limit;
+    rutils_memcpy(target_tcb->msg_queue_pri_limit, desc->msg_queue_pri_limit,
+                  sizeof(target_tcb->msg_queue_pri_limit));
+#endif
 
     //####     Prepare stack for usage, according to demands of each CPU
     KERNEL_REQUIRE(IS_ALIGNED32(desc->stack_base_ptr) ||
@@ -620,6 +993,12 @@ void nufr_launch_task(nufr_tid_t task_id, unsigned parameter)
     saved_psr = NUFR_LOCK_INTERRUPTS();
 
     target_tcb->statuses = 0;    // clears NUFR_TASK_NOT_LAUNCHED
+#if NUFR_CS_TIME_SLICE == 1
+    if (desc->time_slice_opt_out)
+    {
+        target_tcb->statuses = NUFR_TASK_NO_TIME_SLICE;
+    }
+#endif
 
 #if NUFR_CS_OPTIMIZATION_INLINES == 1
     NUFRKERNEL_ADD_TASK_TO_READY_LIST(target_tcb);
@@ -830,6 +1209,25 @@ void nufr_kill_task(nufr_tid_t task_id)
         }
 
     #endif  //NUFR_CS_SEMAPHORE
+
+    #if NUFR_CS_EVENT == 1
+    //#######    Remove target from an event group wait list
+    //####
+        if (NUFR_IS_BLOCK_SET(target_tcb, NUFR_TASK_BLOCKED_EVENT))
+        {
+            nufrkernel_event_unlink_task(target_tcb->event_block, target_tcb);
+            target_tcb->event_block = NULL;
+        }
+    #endif  //NUFR_CS_EVENT
+
+    #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    //#######    Remove target from a message queue space wait list
+    //####
+        if (NUFR_IS_BLOCK_SET(target_tcb, NUFR_TASK_BLOCKED_MSG_SPACE))
+        {
+            nufrkernel_msg_space_unlink_task(target_tcb);
+        }
+    #endif  //NUFR_CS_MSG_QUEUE_LIMIT
     }
     else
     {
@@ -897,6 +1295,10 @@ nufr_bkd_t nufr_task_running_state(nufr_tid_t task_id)
     bool                    bop_blocked;
     bool                    msg_blocked;
     bool                    sema_blocked;
+    bool                    event_blocked;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    bool                    space_blocked;
+#endif
     bool                    timeout;
 
     target_tcb = NUFR_TID_TO_TCB(task_id);
@@ -916,6 +1318,10 @@ nufr_bkd_t nufr_task_running_state(nufr_tid_t task_id)
     bop_blocked = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_BOP);
     msg_blocked = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_MSG);
     sema_blocked = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_SEMA);
+    event_blocked = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_EVENT);
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    space_blocked = ANY_BITS_SET(block_flags, NUFR_TASK_BLOCKED_MSG_SPACE);
+#endif
     timeout = ANY_BITS_SET(statuses, NUFR_TASK_TIMER_RUNNING);
 
     if (not_launched)                 rv = NUFR_BKD_NOT_LAUNCHED;
@@ -926,43 +1332,57 @@ nufr_bkd_t nufr_task_running_state(nufr_tid_t task_id)
     else if (msg_blocked)             rv = NUFR_BKD_MSG;
     else if (sema_blocked && timeout) rv = NUFR_BKD_SEMA_TOUT;
     else if (sema_blocked)            rv = NUFR_BKD_SEMA;
+    else if (event_blocked && timeout) rv = NUFR_BKD_EVENT_TOUT;
+    else if (event_blocked)           rv = NUFR_BKD_EVENT;
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    else if (space_blocked && timeout) rv = NUFR_BKD_MSG_SPACE_TOUT;
+    else if (space_blocked)           rv = NUFR_BKD_MSG_SPACE;
+#endif
     else                              rv = NUFR_BKD_READY;
 
     return rv;
 }
 
-//! @name      nufr_sleep
+//! @name      sleep_common
 //!
-//! @brief     Cause currently running task to sleep for so many OS clock ticks
+//! @brief     Body of nufr_sleep() and nufr_sleep_until()
 //!
-//! @details   Cannot be called from an ISR or from BG task
-//! @details
+//! @details   An absolute wake tick is turned into a delay with
+//! @details   interrupts locked, so an OS tick can't land in between.
+//! @details   A wake tick which is now, or has passed, doesn't sleep.
 //!
-//! @param[in] sleep_delay_in_ticks-- sleep interval, in OS clock ticks
-//! @param[in]              recommend wrapping 'sleepDelayInTicks' parm with
-//! @param[in]              NUFR_MILLISECS_TO_TICKS or NUFR_SECS_TO_TICKS
-//! @param[in] abort_priority_of_rx_msg-- priority where, lower than that,
-//! @param[in]        message rx will abort sleep.
+//! @param[in] ticks-- delay, or if 'is_absolute', OS tick count to wake at
+//! @param[in] is_absolute-- see 'ticks'
+//! @param[in] abort_priority_of_rx_msg-- see nufr_sleep()
 //!
 //! @return    'true' if aborted by message send
-bool nufr_sleep(unsigned       sleep_delay_in_ticks,
-                nufr_msg_pri_t abort_priority_of_rx_msg)
+static bool sleep_common(uint32_t       ticks,
+                         bool           is_absolute,
+                         nufr_msg_pri_t abort_priority_of_rx_msg)
 {
     nufr_sr_reg_t    saved_psr;
 #if NUFR_CS_TASK_KILL == 1
     unsigned           notifications;
 #endif  //NUFR_CS_TASK_KILL
 
-    // Can't be called from BG task
-    KERNEL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+    //#####    First: sleep
+    saved_psr = NUFR_LOCK_INTERRUPTS();
 
-    if (0 == sleep_delay_in_ticks)
+#if NUFR_CS_TASK_PERIOD == 1
+    if (is_absolute)
     {
-        return false;
-    }
+        ticks -= nufr_os_tick_count;
 
-    //#####    First: sleep
-    saved_psr = NUFR_LOCK_INTERRUPTS();
+        if ((0 == ticks) || ((int32_t)ticks < 0))
+        {
+            NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+            return false;
+        }
+    }
+#else
+    UNUSED(is_absolute);
+#endif  //NUFR_CS_TASK_PERIOD
 
     // Clear notifications, as they'll be bitwise set elsewhere
     nufr_running->notifications = 0;
@@ -972,7 +1392,7 @@ bool nufr_sleep(unsigned       sleep_delay_in_ticks,
     UNUSED(abort_priority_of_rx_msg);
 #endif  //NUFR_CS_TASK_KILL
 
-    nufrkernel_add_to_timer_list(nufr_running, sleep_delay_in_ticks);
+    nufrkernel_add_to_timer_list(nufr_running, ticks);
 
 #if NUFR_CS_OPTIMIZATION_INLINES == 1
     NUFRKERNEL_BLOCK_RUNNING_TASK(NUFR_TASK_BLOCKED_ASLEEP);
@@ -1016,6 +1436,127 @@ bool nufr_sleep(unsigned       sleep_delay_in_ticks,
 #endif  //NUFR_CS_TASK_KILL
 }
 
+//! @name      nufr_sleep
+//!
+//! @brief     Cause currently running task to sleep for so many OS clock ticks
+//!
+//! @details   Cannot be called from an ISR or from BG task
+//! @details
+//!
+//! @param[in] sleep_delay_in_ticks-- sleep interval, in OS clock ticks
+//! @param[in]              recommend wrapping 'sleepDelayInTicks' parm with
+//! @param[in]              NUFR_MILLISECS_TO_TICKS or NUFR_SECS_TO_TICKS
+//! @param[in] abort_priority_of_rx_msg-- priority where, lower than that,
+//! @param[in]        message rx will abort sleep.
+//!
+//! @return    'true' if aborted by message send
+bool nufr_sleep(unsigned       sleep_delay_in_ticks,
+                nufr_msg_pri_t abort_priority_of_rx_msg)
+{
+    // Can't be called from BG task
+    KERNEL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+
+    if (0 == sleep_delay_in_ticks)
+    {
+        return false;
+    }
+
+    return sleep_common(sleep_delay_in_ticks, false,
+                        abort_priority_of_rx_msg);
+}
+
+#if NUFR_CS_TASK_PERIOD == 1
+//! @name      nufr_sleep_until
+//!
+//! @brief     Cause currently running task to sleep until the OS tick
+//! @brief     count reaches 'wake_tick'
+//!
+//! @details   Cannot be called from an ISR or from BG task.
+//! @details   Returns at once if 'wake_tick' is now, or up to half the
+//! @details   tick count range in the past.
+//!
+//! @param[in] wake_tick-- absolute OS tick count, as from
+//! @param[in]             nufr_tick_count_get()
+//! @param[in] abort_priority_of_rx_msg-- as with nufr_sleep()
+//!
+//! @return    'true' if aborted by message send
+bool nufr_sleep_until(uint32_t       wake_tick,
+                      nufr_msg_pri_t abort_priority_of_rx_msg)
+{
+    // Can't be called from BG task
+    KERNEL_REQUIRE_API(nufr_running != (nufr_tcb_t *)nufr_bg_sp);
+
+    return sleep_common(wake_tick, true, abort_priority_of_rx_msg);
+}
+
+//! @name      nufr_period_init
+//!
+//! @brief     Sets up a periodic task's state. First deadline is
+//! @brief     one period from now.
+//!
+//! @param[in] period-- owned by the calling task
+//! @param[in] period_ticks-- in OS clock ticks
+void nufr_period_init(nufr_period_t *period, uint32_t period_ticks)
+{
+    KERNEL_REQUIRE_API(NULL != period);
+    KERNEL_REQUIRE_API((int32_t)period_ticks > 0);
+
+    period->period_ticks = period_ticks;
+    period->next_deadline = nufr_os_tick_count + period_ticks;
+    period->overruns = 0;
+    period->missed_periods = 0;
+}
+
+//! @name      nufr_period_waitW
+//!
+//! @brief     Sleep until the period's next deadline, then advance it
+//! @brief     by one period
+//!
+//! @details   Deadlines stay on the grid set by nufr_period_init(), so
+//! @details   the task's run time doesn't add drift. If the deadline
+//! @details   has passed, the task isn't slept: the release is counted
+//! @details   as an overrun, and any further whole periods that have
+//! @details   gone by are skipped and counted in 'missed_periods'.
+//! @details   Cannot be called from an ISR or from BG task.
+//!
+//! @param[in] period-- from nufr_period_init()
+//! @param[in] abort_priority_of_rx_msg-- as with nufr_sleep()
+//!
+//! @return    NUFR_PERIOD_OVERRUN if deadline had passed.
+//! @return    If aborted, deadline is left for the next call.
+nufr_period_rtn_t nufr_period_waitW(nufr_period_t *period,
+                            nufr_msg_pri_t abort_priority_of_rx_msg)
+{
+    uint32_t late;
+    uint32_t skipped;
+
+    KERNEL_REQUIRE_API(NULL != period);
+
+    late = nufr_os_tick_count - period->next_deadline;
+
+    if ((int32_t)late <= 0)
+    {
+        if (nufr_sleep_until(period->next_deadline,
+                             abort_priority_of_rx_msg))
+        {
+            return NUFR_PERIOD_ABORTED_BY_MESSAGE;
+        }
+
+        period->next_deadline += period->period_ticks;
+
+        return NUFR_PERIOD_OK;
+    }
+
+    skipped = late / period->period_ticks;
+
+    period->overruns++;
+    period->missed_periods += skipped;
+    period->next_deadline += (skipped + 1) * period->period_ticks;
+
+    return NUFR_PERIOD_OVERRUN;
+}
+#endif  //NUFR_CS_TASK_PERIOD
+
 //! @name      nufr_yield
 //
 //! @brief     If other tasks of the same task priority are ready, current
@@ -1075,6 +1616,97 @@ bool nufr_yield(void)
     return invoke;
 }
 
+#if NUFR_CS_TIME_SLICE == 1
+//! @name      nufr_time_slice_set
+//
+//! @brief     Sets the time slice quantum of a task priority level
+//
+//! @details   Once a task at 'priority' has run for 'quantum_ticks'
+//! @details   OS ticks, it's rotated behind other ready tasks of the
+//! @details   same priority, as if it had called nufr_yield().
+//! @details   A task whose descriptor has 'time_slice_opt_out' set
+//! @details   is never rotated.
+//
+//! @param[in] priority-- of 'nufr_tpr_t'
+//! @param[in] quantum_ticks-- 0 disables slicing at 'priority'
+void nufr_time_slice_set(unsigned priority, unsigned quantum_ticks)
+{
+    KERNEL_REQUIRE_API(priority <= NUFR_TPR_MAX_VALUE);
+    KERNEL_REQUIRE_API(quantum_ticks <= BIT_MASK8);
+
+    nufr_time_slice_quantum[priority] = (uint8_t)quantum_ticks;
+}
+
+//! @name      nufrkernel_time_slice_tick
+//
+//! @brief     Called each OS tick to enforce time slice quanta.
+//
+//! @details   Called from nufrplat_systick_handler(). A task's quantum
+//! @details   starts counting from the first tick it's seen running,
+//! @details   so its first slice may be up to 1 tick short.
+//! @details   Rotation is a remove and re-insert of the ready list
+//! @details   head, same as nufr_yield(), so 'nufr_ready_list_tail_nominal'
+//! @details   and the bitmap lists stay consistent.
+void nufrkernel_time_slice_tick(void)
+{
+#if NUFR_CS_OPTIMIZATION_INLINES == 1
+    NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS;
+#endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
+    nufr_sr_reg_t       saved_psr;
+    nufr_tcb_t         *tcb;
+    unsigned            quantum;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    tcb = nufr_ready_list;
+
+    // BG task running, or a context switch is already pending
+    if ((NULL == tcb) || (tcb != nufr_running))
+    {
+        nufr_time_slice_tcb = NULL;
+
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+        return;
+    }
+
+    if (tcb != nufr_time_slice_tcb)
+    {
+        nufr_time_slice_tcb = tcb;
+        nufr_time_slice_ticks = 0;
+    }
+
+    quantum = nufr_time_slice_quantum[tcb->priority];
+
+    if (nufr_time_slice_ticks < BIT_MASK8)
+    {
+        nufr_time_slice_ticks++;
+    }
+
+    // Quantum used up, and a peer of the same priority is waiting?
+    if ((0 != quantum) && (nufr_time_slice_ticks >= quantum) &&
+        NUFR_IS_STATUS_CLR(tcb, NUFR_TASK_NO_TIME_SLICE) &&
+        (NULL != tcb->flink) && (tcb->flink->priority == tcb->priority))
+    {
+    #if NUFR_CS_OPTIMIZATION_INLINES == 1
+        NUFRKERNEL_REMOVE_HEAD_TASK_FROM_READY_LIST();
+
+        NUFRKERNEL_ADD_TASK_TO_READY_LIST(tcb);
+        UNUSED(macro_do_switch);                      // suppress warning
+    #else
+        nufrkernel_remove_head_task_from_ready_list();
+
+        (void)nufrkernel_add_task_to_ready_list(tcb);
+    #endif
+
+        nufr_time_slice_tcb = NULL;
+
+        NUFR_INVOKE_CONTEXT_SWITCH();
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+}
+#endif  // NUFR_CS_TIME_SLICE
+
 //! @name      nufr_prioritize
 //
 //! @brief     Sets current running task to a priority (NUFR_TPR_guaranteed_highest)
@@ -1182,13 +1814,21 @@ void nufr_unprioritize(void)
         // when it's restored. Safe to just restore priority.
         else
         {
+        #if NUFR_CS_READY_LIST_BITMAP == 1
+            nufrkernel_reprioritize_head_task(restore_priority);
+        #else
             nufr_running->priority = restore_priority;
+        #endif
         }
     }
     // No other ready tasks. Just restore priority.
     else
     {
+    #if NUFR_CS_READY_LIST_BITMAP == 1
+        nufrkernel_reprioritize_head_task(restore_priority);
+    #else
         nufr_running->priority = restore_priority;
+    #endif
     }
         
     NUFR_UNLOCK_INTERRUPTS(saved_psr);
@@ -1198,6 +1838,78 @@ void nufr_unprioritize(void)
     KERNEL_ENSURE(nufr_running == nufr_ready_list);
 }
 
+//! @name      nufrkernel_change_task_priority
+//!
+//! @brief     Changes priority of launched task 'tcb' to 'new_priority'
+//!
+//! @details   Interrupts locked by caller, so a caller can decide on
+//! @details   and make a priority change in one critical section.
+//! @details   Caller does NUFR_INVOKE_CONTEXT_SWITCH() if 'true' returned.
+//!
+//! @param[in] 'tcb'--
+//! @param[in] 'new_priority'-- already range checked by caller
+//!
+//! @return    'true' if ready list head changed
+bool nufrkernel_change_task_priority(nufr_tcb_t *tcb, unsigned new_priority)
+{
+#if NUFR_CS_OPTIMIZATION_INLINES == 1
+    NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS;
+#endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
+    nufr_tcb_t         *old_head_tcb;
+    bool                doing_another_task;
+
+    old_head_tcb = nufr_ready_list;
+
+    doing_another_task = tcb != nufr_running;
+
+    // Changing priority of task which is blocked?
+    // No ready list shuffling needed, as task isn't on ready list.
+    if (NUFR_IS_TASK_BLOCKED(tcb))
+    {
+        tcb->priority = new_priority;
+    }
+    // Else, we're changing our own/current running task's priority,
+    //   or we're changing another task's which isn't blocked.
+    // In both cases, we're changing the priority of a task on the
+    //   ready list.
+    else
+    {
+        // We must do a ready list remove and insert, instead
+        // of just poking in new priority value. Although the
+        // order of the ready list might not change,
+        //  'nufr_ready_list_tail_nominal' might change.
+
+        if (doing_another_task)
+        {
+        #if NUFR_CS_OPTIMIZATION_INLINES == 1
+            NUFRKERNEL_DELETE_TASK_FROM_READY_LIST(tcb);
+        #else
+            nufrkernel_delete_task_from_ready_list(tcb);
+        #endif
+        }
+        else
+        {
+        #if NUFR_CS_OPTIMIZATION_INLINES == 1
+            NUFRKERNEL_REMOVE_HEAD_TASK_FROM_READY_LIST();
+        #else
+            nufrkernel_remove_head_task_from_ready_list();
+        #endif
+        }
+
+        tcb->priority = (uint8_t)new_priority;
+
+        #if NUFR_CS_OPTIMIZATION_INLINES == 1
+            NUFRKERNEL_ADD_TASK_TO_READY_LIST(tcb);
+            UNUSED(macro_do_switch);                // suppress warning
+        #else
+            (void)nufrkernel_add_task_to_ready_list(tcb);
+        #endif
+    }
+
+    // Did any of above necessitate a context switch?
+    return nufr_ready_list != old_head_tcb;
+}
+
 //! @name      nufr_change_task_priority
 //!
 //! @brief     Changes task priority of task specified by 'tid' to new
@@ -1207,14 +1919,9 @@ void nufr_unprioritize(void)
 //! @param[in] 'new_priority'--
 void nufr_change_task_priority(nufr_tid_t tid, unsigned new_priority)
 {
-#if NUFR_CS_OPTIMIZATION_INLINES == 1
-    NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS;
-#endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
     nufr_tcb_t         *tcb;
-    nufr_tcb_t         *old_head_tcb;
     nufr_sr_reg_t       saved_psr;
     bool                is_task_launched;
-    bool                doing_another_task;
 
     tcb = NUFR_TID_TO_TCB(tid);
 
@@ -1227,10 +1934,11 @@ void nufr_change_task_priority(nufr_tid_t tid, unsigned new_priority)
     // Sanity check 'new_priority':
     //   #1 Do not allow change to 'NUFR_TPR_guaranteed_highest' or higher
     //      --that's reserved + illegal
-    //   #2 Don't allow priority beyong uint8_t size
+    //   #2 Don't allow priority beyong uint8_t size, or beyond
+    //      ready list bitmap size
     else if ( (new_priority <= NUFR_TPR_guaranteed_highest)
                               ||
-              (new_priority > (unsigned)BIT_MASK8))
+              (new_priority > (unsigned)NUFR_TPR_MAX_VALUE))
     {
         KERNEL_REQUIRE_API(false);
         return;
@@ -1243,56 +1951,7 @@ void nufr_change_task_priority(nufr_tid_t tid, unsigned new_priority)
     KERNEL_REQUIRE_IL(is_task_launched);
     if (is_task_launched)
     {
-        old_head_tcb = nufr_ready_list;
-
-        doing_another_task = tcb != nufr_running;
-
-        // Changing priority of task which is blocked?
-        // No ready list shuffling needed, as task isn't on ready list.
-        if (NUFR_IS_TASK_BLOCKED(tcb))
-        {
-            tcb->priority = new_priority;
-        }
-        // Else, we're changing our own/current running task's priority,
-        //   or we're changing another task's which isn't blocked.
-        // In both cases, we're changing the priority of a task on the
-        //   ready list.
-        else
-        {
-            // We must do a ready list remove and insert, instead
-            // of just poking in new priority value. Although the
-            // order of the ready list might not change,
-            //  'nufr_ready_list_tail_nominal' might change.
-
-            if (doing_another_task)
-            {
-            #if NUFR_CS_OPTIMIZATION_INLINES == 1
-                NUFRKERNEL_DELETE_TASK_FROM_READY_LIST(tcb);
-            #else
-                nufrkernel_delete_task_from_ready_list(tcb);
-            #endif
-            }
-            else
-            {
-            #if NUFR_CS_OPTIMIZATION_INLINES == 1
-                NUFRKERNEL_REMOVE_HEAD_TASK_FROM_READY_LIST();
-            #else
-                nufrkernel_remove_head_task_from_ready_list();
-            #endif
-            }
-
-            tcb->priority = (uint8_t)new_priority;
-
-            #if NUFR_CS_OPTIMIZATION_INLINES == 1
-                NUFRKERNEL_ADD_TASK_TO_READY_LIST(tcb);
-                UNUSED(macro_do_switch);                // suppress warning
-            #else
-                (void)nufrkernel_add_task_to_ready_list(tcb);
-            #endif
-        }
-
-        // Did any of above necessitate a context switch?
-        if (nufr_ready_list != old_head_tcb)
+        if (nufrkernel_change_task_priority(tcb, new_priority))
         {
             NUFR_INVOKE_CONTEXT_SWITCH();
         }
@@ -1438,6 +2097,9 @@ nufr_bop_wait_rtn_t nufr_bop_waitW(nufr_msg_pri_t abort_priority_of_rx_msg)
     return_value = NUFR_BOP_WAIT_OK;
 #endif  //NUFR_CS_TASK_KILL
         
+    NUFR_TRACE(NUFR_TRACE_BOP_WAIT, NUFR_TRACE_TID(nufr_running),
+               nufr_running->bop_key, return_value);
+
     KERNEL_ENSURE(nufr_running == nufr_ready_list);
 
     return return_value;
@@ -1559,6 +2221,9 @@ nufr_bop_wait_rtn_t nufr_bop_waitT(nufr_msg_pri_t abort_priority_of_rx_msg,
         return_value = NUFR_BOP_WAIT_OK;
     }
         
+    NUFR_TRACE(NUFR_TRACE_BOP_WAIT, NUFR_TRACE_TID(nufr_running),
+               nufr_running->bop_key, return_value);
+
     KERNEL_ENSURE(nufr_running == nufr_ready_list);
 
     return return_value;
@@ -1650,6 +2315,8 @@ nufr_bop_rtn_t nufr_bop_send(nufr_tid_t task_id, uint16_t key)
         return_value = NUFR_BOP_RTN_TAKEN;
     }
 
+    NUFR_TRACE(NUFR_TRACE_BOP_SEND, (uint8_t)task_id, key, return_value);
+
     KERNEL_ENSURE(nufr_running == nufr_ready_list);
 
     return return_value;
@@ -1721,6 +2388,9 @@ nufr_bop_rtn_t nufr_bop_send_with_key_override(nufr_tid_t task_id)
         return_value = NUFR_BOP_RTN_TAKEN;
     }
 
+    NUFR_TRACE(NUFR_TRACE_BOP_SEND, (uint8_t)task_id, target_tcb->bop_key,
+               return_value);
+
     KERNEL_ENSURE(nufr_running == nufr_ready_list);
 
     return return_value;
@@ -1894,3 +2564,109 @@ void *nufr_local_struct_get(nufr_tid_t task_id)
     return local_struct_ptr;
 }
 #endif  //NUFR_CS_LOCAL_STRUCT
+
+#if NUFR_CS_TASK_STATS == 1
+//! @name      task_stats_for
+//
+//! @brief     Maps a TCB to its stats block
+//
+//! @details   BG task is either 'nufr_bg_sp' or NULL, depending
+//! @details   on which context switch path calls in.
+static nufr_task_stats_t *task_stats_for(nufr_tcb_t *tcb)
+{
+    if ((NULL == tcb) || ((nufr_tcb_t *)nufr_bg_sp == tcb))
+    {
+        return &nufr_bg_stats;
+    }
+
+    return &tcb->stats;
+}
+
+//! @name      nufrkernel_task_stats_switch
+//
+//! @brief     Context switch accounting
+//
+//! @details   Called by the context switch (PendSV handler on ARM)
+//! @details   with interrupts locked, before 'nufr_running' changes.
+//! @details   Charges time since the last switch to the out-task.
+//! @details   An out-task which is still ready was preempted (or yielded);
+//! @details   otherwise it blocked.
+//
+//! @param[in] 'out_tcb'-- task being switched out
+//! @param[in] 'in_tcb'-- task being switched in
+void nufrkernel_task_stats_switch(nufr_tcb_t *out_tcb, nufr_tcb_t *in_tcb)
+{
+    nufr_task_stats_t *out_stats = task_stats_for(out_tcb);
+    nufr_task_stats_t *in_stats = task_stats_for(in_tcb);
+    uint32_t           now;
+
+    if (out_stats == in_stats)
+    {
+        return;
+    }
+
+    now = NUFR_TASK_STATS_TIMESTAMP();
+
+    out_stats->run_time += (uint32_t)(now - nufr_task_stats_timestamp);
+    nufr_task_stats_timestamp = now;
+
+    if ((out_stats != &nufr_bg_stats) && NUFR_IS_TASK_BLOCKED(out_tcb))
+    {
+        out_stats->blocks++;
+    }
+    else
+    {
+        out_stats->preemptions++;
+    }
+
+    in_stats->switch_ins++;
+}
+
+//! @name      nufr_task_stats_get
+//
+//! @brief     Snapshot of a task's CPU time and context switch stats
+//
+//! @details   If the task is running, its 'run_time' includes time
+//! @details   up to now. Utilization over an interval is the delta
+//! @details   of 'run_time' over the delta of all tasks' 'run_time'
+//! @details   summed (including BG).
+//
+//! @param[in] 'task_id'-- task, or NUFR_TID_null for BG task (idle time)
+//! @param[out] 'stats_ptr'-- snapshot
+//
+//! @return    'false' if 'task_id' is out of range
+bool nufr_task_stats_get(nufr_tid_t task_id, nufr_task_stats_t *stats_ptr)
+{
+    nufr_sr_reg_t      saved_psr;
+    nufr_tcb_t        *target_tcb = NULL;
+    nufr_task_stats_t *source_stats;
+
+    KERNEL_REQUIRE_API(NULL != stats_ptr);
+
+    if (task_id > NUFR_NUM_TASKS)
+    {
+        return false;
+    }
+
+    if (NUFR_TID_null != task_id)
+    {
+        target_tcb = NUFR_TID_TO_TCB(task_id);
+    }
+
+    source_stats = task_stats_for(target_tcb);
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    *stats_ptr = *source_stats;
+
+    if (task_stats_for(nufr_running) == source_stats)
+    {
+        stats_ptr->run_time += (uint32_t)(NUFR_TASK_STATS_TIMESTAMP() -
+                                          nufr_task_stats_timestamp);
+    }
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    return true;
+}
+#endif  //NUFR_CS_TASK_STATS
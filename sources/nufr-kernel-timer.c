@@ -40,6 +40,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-platform-export.h"
 #include "nufr-kernel-task.h"
 #include "nufr-kernel-semaphore.h"
+#if NUFR_CS_EVENT == 1
+    #include "nufr-kernel-event.h"
+#endif
+#include "nufr-kernel-trace.h"
 #if NUFR_CS_OPTIMIZATION_INLINES == 1
     #include "nufr-kernel-task-inlines.h"
     #include "nufr-kernel-semaphore-inlines.h"
@@ -56,6 +60,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //!
 //! @brief     Kernel-maintained linked list of all tasks waiting
 //! @brief     on an API timeout, or a sleep timeout.
+//!
+//! @details   List is a delta list: it's sorted by expiration time,
+//! @details   soonest first, and each tcb->timer holds the number of
+//! @details   ticks after the previous task's expiration that this
+//! @details   task expires. The head's tcb->timer is the number of
+//! @details   ticks remaining until the head expires.
 nufr_tcb_t *nufr_timer_list;
 nufr_tcb_t *nufr_timer_list_tail;
 
@@ -64,39 +74,153 @@ nufr_tcb_t *nufr_timer_list_tail;
 //! @brief     Continuous counter, increments each OS tick, wraps
 uint32_t nufr_os_tick_count;
 
+//! @name      timer_list_insert
+//
+//! @brief     Inserts task into timer list, sorted by expiration
+//
+//! @details   List is walked, subtracting off each task's delta,
+//! @details   until a task which expires later is found. Task is
+//! @details   inserted behind any tasks expiring on the same tick.
+//! @details   Following task's delta is reduced by new task's delta.
+//
+//! params[in] 'tcb'
+//! params[in] 'ticks'-- ticks from now until expiration
+static void timer_list_insert(nufr_tcb_t *tcb, uint32_t ticks)
+{
+    nufr_tcb_t *prev_tcb = NULL;
+    nufr_tcb_t *next_tcb = nufr_timer_list;
+
+    SL_REQUIRE_IL(tcb->flink_timer == NULL);
+    SL_REQUIRE_IL(tcb->blink_timer == NULL);
+
+    while ((NULL != next_tcb) && (next_tcb->timer <= ticks))
+    {
+        ticks -= next_tcb->timer;
+
+        prev_tcb = next_tcb;
+        next_tcb = next_tcb->flink_timer;
+    }
+
+    tcb->timer = ticks;
+    tcb->blink_timer = prev_tcb;
+    tcb->flink_timer = next_tcb;
+
+    if (NULL == prev_tcb)
+    {
+        nufr_timer_list = tcb;
+    }
+    else
+    {
+        prev_tcb->flink_timer = tcb;
+    }
+
+    if (NULL == next_tcb)
+    {
+        nufr_timer_list_tail = tcb;
+    }
+    else
+    {
+        next_tcb->blink_timer = tcb;
+        next_tcb->timer -= ticks;
+    }
+
+    // If there's a head, there must be a tail
+    SL_ENSURE_IL((nufr_timer_list == NULL) == (nufr_timer_list_tail == NULL));
+    // Head/tail blink/flink ptrs must be NULL
+    SL_ENSURE_IL((nufr_timer_list != NULL) ?
+                 (nufr_timer_list->blink_timer == NULL) &&
+                     (nufr_timer_list_tail->flink_timer == NULL)
+                 : true);
+}
+
+//! @name      timer_list_unlink
+//
+//! @brief     Removes task from timer list
+//
+//! @details   Task's delta is folded into the following task's delta,
+//! @details   so that following tasks' expirations are unchanged.
+//
+//! params[in] 'tcb'
+static void timer_list_unlink(nufr_tcb_t *tcb)
+{
+    // Is 'tcb' at list head?
+    if (nufr_timer_list == tcb)
+    {
+        SL_ENSURE_IL(NULL == tcb->blink_timer);
+        nufr_timer_list = tcb->flink_timer;
+    }
+    else
+    {
+        SL_ENSURE_IL(NULL != tcb->blink_timer);
+        (tcb->blink_timer)->flink_timer = tcb->flink_timer;
+    }
+
+    // Is 'tcb' at list tail?
+    if (nufr_timer_list_tail == tcb)
+    {
+        SL_ENSURE_IL(NULL == tcb->flink_timer);
+        nufr_timer_list_tail = tcb->blink_timer;
+    }
+    else
+    {
+        SL_ENSURE_IL(NULL != tcb->flink_timer);
+        (tcb->flink_timer)->blink_timer = tcb->blink_timer;
+        (tcb->flink_timer)->timer += tcb->timer;
+    }
+
+    tcb->flink_timer = NULL;
+    tcb->blink_timer = NULL;
+
+    // If there's a head, there must be a tail
+    SL_ENSURE_IL((nufr_timer_list == NULL) == (nufr_timer_list_tail == NULL));
+    // Head/tail blink/flink ptrs must be NULL
+    SL_ENSURE_IL((nufr_timer_list != NULL) ?
+                 (nufr_timer_list->blink_timer == NULL) &&
+                     (nufr_timer_list_tail->flink_timer == NULL)
+                 : true);
+    // If > 1 task on list, must have non-NULL flink/blinks on head/tail
+    SL_ENSURE_IL((nufr_timer_list != NULL) &&
+                      (nufr_timer_list != nufr_timer_list_tail) ?
+                 (nufr_timer_list->flink_timer != NULL) &&
+                     (nufr_timer_list_tail->blink_timer != NULL)
+                 : true);
+}
+
 //! @name      nufrkernel_update_task_timers
 //
 //! @brief     Kernel's function which updates task timers for nufr_sleep(),
 //! @brief     nufr_bop_waitT(), etc
 //
 //! @details   When an API call starts a task timer:
-//! @details     (1) The tcb->timer value is set to the timeout specifed by
-//! @details         the API call
-//! @details     (2) Calls 'nufrkernel_add_to_timer_list' for task
-//! @details     (3) That task's tcb is marked as "timer running"
+//! @details     (1) Calls 'nufrkernel_add_to_timer_list' for task
+//! @details     (2) That task's tcb is marked as "timer running"
 //! @details         (tcb->statuses NUFR_TASK_TIMER_RUNNING)
-//! @details     (4) The tcb is added to 'nufr_timer_list', no ordering.
+//! @details     (3) The tcb is inserted into 'nufr_timer_list', sorted
+//! @details         by expiration. The tcb->timer value is set to the
+//! @details         delta from the previous task's expiration.
 //! @details         Of note is that the timer list uses the tcb->flink_timer
 //! @details         and tcb->blink_timer instead of tcb->flink.
 //! @details
 //! @details   Each OS tick exception:
-//! @details     (1) The timer list is walked. Each tcb on list is checked.
+//! @details     (1) Only the timer of the task at the head of the timer
+//! @details         list is decremented. Tasks behind it are
+//! @details         untouched, so cost doesn't grow with list size.
 //! @details         Note that interrutps are NOT locked while list is
-//! @details         traversed.
-//! @details     (2) Each task's timer is decremented.
-//! @details     (3) If task's timer reached zero, then it has timed out.
-//! @details     (4) A timeout causes the task to be taken off the timer list.
-//! @details         (Algorithm described in nufrkernel_purge_from_timer_list).
-//! @details     (5) For the timed out task, interrupts are locked while
+//! @details         modified.
+//! @details     (2) If head task's timer reached zero, then it has timed out.
+//! @details         Any tasks behind it with a zero delta timed out
+//! @details         on the same tick.
+//! @details     (3) A timeout causes the task to be taken off the timer list.
+//! @details     (4) For the timed out task, interrupts are locked while
 //! @details         shared tcb variables are modified.
-//! @details     (6) [Task timeout algorithm proceeds, described below.]
-//! @details     (7) A flag keeps track of whether a context switch is needed.
+//! @details     (5) [Task timeout algorithm proceeds, described below.]
+//! @details     (6) A flag keeps track of whether a context switch is needed.
 //! @details
 //! @details   When a given task's timer has timed out:
-//! @details     (1) Remove the tcb from the timer list by calling
-//! @details         'nufr_purge_from_timer_list'.
+//! @details     (1) Remove the tcb from the timer list.
 //! @details     (2) Lock interrupts
-//! @details     (3) Check if bop locked ('nufr_bop_lock_waiter')
+//! @details     (3) Check if bop locked ('nufr_bop_lock_waiter').
+//! @details         If so, re-insert task on timer list 1 tick out.
 //! @details     (3) Clear tcb->statuses : NUFR_TASK_TIMER_RUNNING
 //! @details     (4) Set tcb->notifications : NUFR_TASK_TIMEOUT
 //! @details     (5) Most likely, the task is still blocked (there's
@@ -121,7 +245,6 @@ void nufrkernel_update_task_timers(void)
     NUFRKERNEL_ADD_TASK_TO_READY_LIST_DECLARATIONS;
 #endif  // NUFR_CS_OPTIMIZATION_INLINES == 1
     nufr_tcb_t        *tcb;
-    nufr_tcb_t        *next_tcb;
     nufr_sr_reg_t      saved_psr;
     bool               bop_locked;
     bool               invoke = false;
@@ -148,142 +271,117 @@ void nufrkernel_update_task_timers(void)
                (nufr_timer_list_tail->blink_timer != NULL)
            : true);
 
-    // Note that interrupts are not locked while traversing the timer
+    // Note that interrupts are not locked while modifying the timer
     //  list. The timer list is only modified by API calls at task level,
     //  never by ISRs, so no interrupt locking needed.
 
-    // Walk timer list
+    // Only the head is decremented
+    SL_ENSURE(nufr_timer_list->timer > 0);
+
+    nufr_timer_list->timer--;
+
+    // Pop each task which timed out on this tick.
+    // Tasks behind the head with a zero delta expire on same tick.
     tcb = nufr_timer_list;
 
-    while (NULL != tcb)
+    while ((NULL != tcb) && (0 == tcb->timer))
     {
-        // When a timer expires, its flink_timer gets cleared, so
-        // must save away flink_timer now.
-        next_tcb = tcb->flink_timer;
+        bop_locked = false;
 
-        SL_ENSURE(tcb->timer > 0);
+        timer_list_unlink(tcb);
 
-        tcb->timer--;
+    #if NUFR_CS_LOCAL_STRUCT == 1
+        saved_psr = NUFR_LOCK_INTERRUPTS();
 
-        // Timeout occured?
-        if (0 == tcb->timer)
+        // If this task is being bop-locked, and timer
+        // has expired, just extend timeout until unlock
+        // occurs, which shouldn't take long.
+        if (NUFR_IS_STATUS_SET(tcb, NUFR_TASK_BOP_LOCKED))
         {
-            bop_locked = false;
-
-        #if NUFR_CS_LOCAL_STRUCT == 1
-            saved_psr = NUFR_LOCK_INTERRUPTS();
-
-            // If this task is being bop-locked, and timer
-            // has expired, just extend timeout until unlock
-            // occurs, which shouldn't take long.
-            if (NUFR_IS_STATUS_SET(tcb, NUFR_TASK_BOP_LOCKED))
+            if (NUFR_IS_BLOCK_SET(tcb, NUFR_TASK_BLOCKED_BOP))
             {
-                if (NUFR_IS_BLOCK_SET(tcb, NUFR_TASK_BLOCKED_BOP))
-                {
-                    tcb->timer = 1;
-                    bop_locked = true;
-                }
+                // Goes behind any other zero delta tasks,
+                // so won't be seen again on this tick.
+                timer_list_insert(tcb, 1);
+                bop_locked = true;
             }
+        }
 
-            NUFR_UNLOCK_INTERRUPTS(saved_psr);
-        #endif  // NUFR_CS_LOCAL_STRUCT
+        NUFR_UNLOCK_INTERRUPTS(saved_psr);
+    #endif  // NUFR_CS_LOCAL_STRUCT
+
+        if (!bop_locked)
+        {
+            saved_psr = NUFR_LOCK_INTERRUPTS();
 
-            if (!bop_locked)
+            tcb->statuses &= BITWISE_NOT8(NUFR_TASK_TIMER_RUNNING);
+
+            NUFR_TRACE(NUFR_TRACE_TIMER_EXPIRE, NUFR_TRACE_TID(tcb), 0,
+                       tcb->block_flags);
+
+            // Cannot assume task is still blocked on blocking condition
+            //   which caused it to be put on timer list.
+            //   Cases:
+            //    -- Task may have been unblocked at ISR level, with
+            //       ISR sending task a message, sending a bop, or
+            //       incrementing a sema.
+            //    -- Another task may have unblocked task whose timer
+            //       just expired. The task being unblocked, and not the
+            //       unblocker, is responsible for removing task from
+            //       timer list. It's possible to have task on ready
+            //       list and timer still being decremented here.
+            //
+            // Only this fcn. and exit points to API calls /w timeouts
+            //   can unlink a tcb from the timer list.
+            if (NUFR_IS_TASK_BLOCKED(tcb))
             {
-                // Is 'tcb' at list head?
-                if (nufr_timer_list == tcb)
-                {
-                    SL_ENSURE(NULL == tcb->blink_timer);
-                    nufr_timer_list = tcb->flink_timer;
-                }
-                else
-                {
-                    SL_ENSURE(NULL != tcb->blink_timer);
-                    (tcb->blink_timer)->flink_timer = tcb->flink_timer;
-                }
+                SL_REQUIRE_IL(ANY_BITS_SET(tcb->block_flags,
+                                     NUFR_TASK_BLOCKED_ALL));
 
-                // Is 'tcb' at list tail?
-                if (nufr_timer_list_tail == tcb)
+            #if NUFR_CS_SEMAPHORE == 1
+                if (NUFR_IS_BLOCK_SET(tcb, NUFR_TASK_BLOCKED_SEMA))
                 {
-                    SL_ENSURE(NULL == tcb->flink_timer);
-                    nufr_timer_list_tail = tcb->blink_timer;
+                #if NUFR_CS_OPTIMIZATION_INLINES == 1
+                    NUFRKERNEL_SEMA_UNLINK_TASK(tcb->sema_block, tcb);
+                #else
+                    nufrkernel_sema_unlink_task(tcb->sema_block, tcb);
+                #endif
                 }
-                else
+            #endif  // NUFR_CS_SEMAPHORE
+
+            #if NUFR_CS_EVENT == 1
+                if (NUFR_IS_BLOCK_SET(tcb, NUFR_TASK_BLOCKED_EVENT))
                 {
-                    SL_ENSURE(NULL != tcb->flink_timer);
-                    (tcb->flink_timer)->blink_timer = tcb->blink_timer;
+                    nufrkernel_event_unlink_task(tcb->event_block, tcb);
+                    tcb->event_block = NULL;
                 }
+            #endif  // NUFR_CS_EVENT
 
-                tcb->flink_timer = NULL;
-                tcb->blink_timer = NULL;
-
-                // If there's a head, there must be a tail
-                SL_ENSURE((nufr_timer_list == NULL) == (nufr_timer_list_tail == NULL));
-                // Head/tail blink/flink ptrs must be NULL
-                SL_ENSURE((nufr_timer_list != NULL) ?
-                          (nufr_timer_list->blink_timer == NULL) &&
-                              (nufr_timer_list_tail->flink_timer == NULL)
-                          : true);
-                // If > 1 task on list, must have non-NULL flink/blinks on head/tail
-                SL_ENSURE((nufr_timer_list != NULL) &&
-                               (nufr_timer_list != nufr_timer_list_tail) ?
-                          (nufr_timer_list->flink_timer != NULL) &&
-                              (nufr_timer_list_tail->blink_timer != NULL)
-                          : true);
-
-                saved_psr = NUFR_LOCK_INTERRUPTS();
-
-                tcb->statuses &= BITWISE_NOT8(NUFR_TASK_TIMER_RUNNING);
-
-                // Cannot assume task is still blocked on blocking condition
-                //   which caused it to be put on timer list.
-                //   Cases:
-                //    -- Task may have been unblocked at ISR level, with
-                //       ISR sending task a message, sending a bop, or
-                //       incrementing a sema.
-                //    -- Another task may have unblocked task whose timer
-                //       just expired. The task being unblocked, and not the
-                //       unblocker, is responsible for removing task from
-                //       timer list. It's possible to have task on ready
-                //       list and timer still being decremented here.
-                //
-                // Only this fcn. and exit points to API calls /w timeouts
-                //   can unlink a tcb from the timer list.
-                if (NUFR_IS_TASK_BLOCKED(tcb))
+            #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+                if (NUFR_IS_BLOCK_SET(tcb, NUFR_TASK_BLOCKED_MSG_SPACE))
                 {
-                    SL_REQUIRE_IL(ANY_BITS_SET(tcb->block_flags,
-                                         NUFR_TASK_BLOCKED_ALL));
-
-                #if NUFR_CS_SEMAPHORE == 1
-                    if (NUFR_IS_BLOCK_SET(tcb, NUFR_TASK_BLOCKED_SEMA))
-                    {
-                    #if NUFR_CS_OPTIMIZATION_INLINES == 1
-                        NUFRKERNEL_SEMA_UNLINK_TASK(tcb->sema_block, tcb);
-                    #else
-                        nufrkernel_sema_unlink_task(tcb->sema_block, tcb);
-                    #endif
-                    }
-                #endif  // NUFR_CS_SEMAPHORE
+                    nufrkernel_msg_space_unlink_task(tcb);
+                }
+            #endif  // NUFR_CS_MSG_QUEUE_LIMIT
 
-                    tcb->block_flags = 0;
+                tcb->block_flags = 0;
 
-                    // Nofify task being released by timeout at exit of API
-                    tcb->notifications |= NUFR_TASK_TIMEOUT;
+                // Nofify task being released by timeout at exit of API
+                tcb->notifications |= NUFR_TASK_TIMEOUT;
 
-                #if NUFR_CS_OPTIMIZATION_INLINES == 1
-                    NUFRKERNEL_ADD_TASK_TO_READY_LIST(tcb);
-                    invoke |= macro_do_switch;
-                #else
-                    invoke |= nufrkernel_add_task_to_ready_list(tcb);
-                #endif
-                }
+            #if NUFR_CS_OPTIMIZATION_INLINES == 1
+                NUFRKERNEL_ADD_TASK_TO_READY_LIST(tcb);
+                invoke |= macro_do_switch;
+            #else
+                invoke |= nufrkernel_add_task_to_ready_list(tcb);
+            #endif
+            }
 
-                NUFR_UNLOCK_INTERRUPTS(saved_psr);
-            }  // end 'if (!bop_locked)'
-        }  // end 'if (0 == tcb->timer)'
+            NUFR_UNLOCK_INTERRUPTS(saved_psr);
+        }  // end 'if (!bop_locked)'
 
-        tcb = next_tcb;
-    }  // end 'while (NULL != tcb)'
+        tcb = nufr_timer_list;
+    }  // end 'while ((NULL != tcb) && (0 == tcb->timer))'
 
     // Did we trigger a context switch?
     // NOTE: small timing corner case: ISR might've requested context
@@ -297,9 +395,73 @@ void nufrkernel_update_task_timers(void)
     }
 }
 
+#if NUFR_CS_TICKLESS_IDLE == 1
+//! @name      nufrkernel_update_task_timers_elapsed
+//
+//! @brief     Tickless idle version of nufrkernel_update_task_timers():
+//! @brief     accounts for several OS ticks at once.
+//
+//! @details   Equivalent to calling nufrkernel_update_task_timers()
+//! @details   'elapsed_ticks' times. Ticks on which no task times out
+//! @details   are skipped over in bulk, by subtracting them from the
+//! @details   head's delta and adding them to 'nufr_os_tick_count'.
+//! @details   Ticks on which a task times out are processed normally.
+//! @details   Called from OS tick handler, or from BG task with
+//! @details   interrupts locked.
+//
+//! @param[in] 'elapsed_ticks'-- OS ticks since previous update
+void nufrkernel_update_task_timers_elapsed(uint32_t elapsed_ticks)
+{
+    uint32_t skipped;
+
+    while (elapsed_ticks > 0)
+    {
+        // No more expirations in window? Skip all remaining ticks.
+        if ((NULL == nufr_timer_list) ||
+            (nufr_timer_list->timer > elapsed_ticks))
+        {
+            if (NULL != nufr_timer_list)
+            {
+                nufr_timer_list->timer -= elapsed_ticks;
+            }
+
+            nufr_os_tick_count += elapsed_ticks;
+
+            break;
+        }
+
+        // Skip ticks up to the one the head expires on
+        skipped = nufr_timer_list->timer - 1;
+        nufr_timer_list->timer = 1;
+        nufr_os_tick_count += skipped;
+        elapsed_ticks -= skipped;
+
+        nufrkernel_update_task_timers();
+        elapsed_ticks--;
+    }
+}
+
+//! @name      nufrkernel_ticks_to_next_timeout
+//
+//! @brief     Number of OS ticks until earliest task timeout.
+//
+//! @details   Used to program one-shot for tickless idle.
+//
+//! @return    ticks, or 0 if no task timers are running
+uint32_t nufrkernel_ticks_to_next_timeout(void)
+{
+    if (NULL == nufr_timer_list)
+    {
+        return 0;
+    }
+
+    return nufr_timer_list->timer;
+}
+#endif  //NUFR_CS_TICKLESS_IDLE
+
 //! @name      nufrkernel_add_to_timer_list
 //
-//! @brief     Append this task to timer list.
+//! @brief     Insert this task into timer list.
 //
 //! @details   Notes:
 //! @details     -- Intended to be called from task level; cannot be
@@ -307,10 +469,12 @@ void nufrkernel_update_task_timers(void)
 //! @details     -- Caller must lock interrupts.
 //! @details     -- No checks here for tcb->blocked bits. Caller must
 //! @details        do that independently.
+//! @details     -- List is walked to find insertion point, so this
+//! @details        is O(N) with number of tasks on timer list.
 //! @details   
 //!
 //! params[in] 'task'
-//! params[in] 'initial_timer_value'
+//! params[in] 'initial_timer_value'-- must be > 0
 void nufrkernel_add_to_timer_list(nufr_tcb_t *tcb,
                                   uint32_t    initial_timer_value)
 {
@@ -318,6 +482,7 @@ void nufrkernel_add_to_timer_list(nufr_tcb_t *tcb,
 
     SL_REQUIRE_IL(tcb->flink_timer == NULL);
     SL_REQUIRE_IL(tcb->blink_timer == NULL);
+    SL_REQUIRE_IL(initial_timer_value > 0);
 
     // Sanity check, not necessary    
     already_on_timer_list = NUFR_IS_STATUS_SET(tcb, NUFR_TASK_TIMER_RUNNING);
@@ -333,37 +498,7 @@ void nufrkernel_add_to_timer_list(nufr_tcb_t *tcb,
         // Notifications should have already been cleared by API caller
     }
 
-    // Empty list?
-    if (NULL == nufr_timer_list)
-    {
-        SL_ENSURE_IL(NULL == nufr_timer_list_tail);
-        nufr_timer_list = tcb;
-    }
-    // Else, append to tail
-    else
-    {
-        SL_ENSURE_IL(NULL != nufr_timer_list_tail);
-        nufr_timer_list_tail->flink_timer = tcb;
-        tcb->blink_timer = nufr_timer_list_tail;
-    }
-
-    nufr_timer_list_tail = tcb;
-
-    tcb->timer = initial_timer_value;
-
-    // If there's a head, there must be a tail
-    SL_ENSURE_IL((nufr_timer_list == NULL) == (nufr_timer_list_tail == NULL));
-    // Head/tail blink/flink ptrs must be NULL
-    SL_ENSURE_IL((nufr_timer_list != NULL) ?
-                 (nufr_timer_list->blink_timer == NULL) &&
-                     (nufr_timer_list_tail->flink_timer == NULL)
-                 : true);
-    // If > 1 task on list, must have non-NULL flink/blinks on head/tail
-    SL_ENSURE_IL((nufr_timer_list != NULL) &&
-                      (nufr_timer_list != nufr_timer_list_tail) ?
-                 (nufr_timer_list->flink_timer != NULL) &&
-                     (nufr_timer_list_tail->blink_timer != NULL)
-                 : true);
+    timer_list_insert(tcb, initial_timer_value);
 }
 
 //! @name      nufrkernel_purge_from_timer_list
@@ -392,46 +527,7 @@ bool nufrkernel_purge_from_timer_list(nufr_tcb_t *tcb)
     // Clear bit which indicates task is on timer list
     tcb->statuses &= BITWISE_NOT8(NUFR_TASK_TIMER_RUNNING);
 
-    // Is 'tcb' at list head?
-    if (nufr_timer_list == tcb)
-    {
-        SL_ENSURE_IL(NULL == tcb->blink_timer);
-        nufr_timer_list = tcb->flink_timer;
-    }
-    else
-    {
-        SL_ENSURE_IL(NULL != tcb->blink_timer);
-        (tcb->blink_timer)->flink_timer = tcb->flink_timer;
-    }
-
-    // Is 'tcb' at list tail?
-    if (nufr_timer_list_tail == tcb)
-    {
-        SL_ENSURE_IL(NULL == tcb->flink_timer);
-        nufr_timer_list_tail = tcb->blink_timer;
-    }
-    else
-    {
-        SL_ENSURE_IL(NULL != tcb->flink_timer);
-        (tcb->flink_timer)->blink_timer = tcb->blink_timer;
-    }
-
-    tcb->flink_timer = NULL;
-    tcb->blink_timer = NULL;
-
-    // If there's a head, there must be a tail
-    SL_ENSURE_IL((nufr_timer_list == NULL) == (nufr_timer_list_tail == NULL));
-    // Head/tail blink/flink ptrs must be NULL
-    SL_ENSURE_IL((nufr_timer_list != NULL) ?
-                 (nufr_timer_list->blink_timer == NULL) &&
-                     (nufr_timer_list_tail->flink_timer == NULL)
-                 : true);
-    // If > 1 task on list, must have non-NULL flink/blinks on head/tail
-    SL_ENSURE_IL((nufr_timer_list != NULL) &&
-                      (nufr_timer_list != nufr_timer_list_tail) ?
-                 (nufr_timer_list->flink_timer != NULL) &&
-                     (nufr_timer_list_tail->blink_timer != NULL)
-                 : true);
+    timer_list_unlink(tcb);
 
     return true;
 }
@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file    nufr-kernel-trace.c
+//! @authors agent
+//! @date    16Oct26
+//!
+//! @brief   Kernel event trace ring
+//!
+
+#define NUFR_TRACE_GLOBAL_DEFS
+
+#include "nufr-global.h"
+
+#if NUFR_CS_TRACE == 1
+
+#include "nufr-platform.h"
+#include "nufr-api.h"
+#include "nufr-kernel-trace.h"
+
+#include "raging-contract.h"
+#include "raging-utils-mem.h"
+
+// Slot lookup masks the index, so capacity must be a power of 2
+#if (NUFR_TRACE_RECORDS & (NUFR_TRACE_RECORDS - 1)) != 0
+    #error "NUFR_TRACE_RECORDS must be a power of 2"
+#endif
+
+//!
+//!  @brief       The trace ring
+//!
+nufr_trace_ring_t nufr_trace_ring;
+
+
+//! @name      nufr_trace_init
+//
+//! @brief     Clears the ring and writes its header.
+//
+//! @details   Called from nufr_init(), before any trace point can fire.
+void nufr_trace_init(void)
+{
+    rutils_memset(&nufr_trace_ring, 0, sizeof(nufr_trace_ring));
+
+    nufr_trace_ring.magic = NUFR_TRACE_MAGIC;
+    nufr_trace_ring.capacity = NUFR_TRACE_RECORDS;
+    nufr_trace_ring.record_size = sizeof(nufr_trace_record_t);
+}
+
+//! @name      nufr_trace_write
+//
+//! @brief     Writes one record into the ring.
+//
+//! @details   Callable from task or ISR level, interrupts locked or not.
+//! @details   The slot is claimed with an atomic increment, rather than
+//! @details   an interrupt lock, so nothing is held while the record is
+//! @details   filled in. An ISR which preempts a writer claims the next
+//! @details   slot and completes first: records can land out of time
+//! @details   order, but 'sequence' keeps them sortable.
+//
+//! @param[in] event-- 'nufr_trace_event_t'
+//! @param[in] tid-- task the event applies to, 0 for BG/none
+//! @param[in] object_id-- event-specific, see 'nufr_trace_event_t'
+//! @param[in] param-- event-specific, see 'nufr_trace_event_t'
+void nufr_trace_write(nufr_trace_event_t event,
+                      uint8_t            tid,
+                      uint16_t           object_id,
+                      uint32_t           param)
+{
+    uint32_t                      index;
+    volatile nufr_trace_record_t *record;
+
+    index = NUFR_ATOMIC_FETCH_INC32(&nufr_trace_ring.write_index);
+    record = &nufr_trace_ring.records[index & (NUFR_TRACE_RECORDS - 1)];
+
+    // Invalidate slot until the record is complete
+    record->sequence = 0;
+
+    record->timestamp = NUFR_TASK_STATS_TIMESTAMP();
+    record->event = (uint8_t)event;
+    record->tid = tid;
+    record->object_id = object_id;
+    record->param = param;
+
+    // Commit. Once every 2^32 records this is 0 and the record is lost.
+    record->sequence = index + 1;
+}
+
+#endif  //NUFR_CS_TRACE
@@ -0,0 +1,493 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file    nufr-simulation-coroutine.c
+//! @authors agent
+//! @date    16Oct26
+
+//!
+//! @brief     Single-threaded coroutine layer which allows the nufr
+//! @brief     kernel+platform to run in a PC environment
+//!
+//! @details   Alternative to nufr-simulation.c, selected with
+//! @details   NUFR_CS_SIM_COROUTINE. Each task is a ucontext coroutine
+//! @details   with its own host stack. Everything runs on one host
+//! @details   thread, so a run is repeatable.
+//! @details
+//! @details   NUFR_INVOKE_CONTEXT_SWITCH() pends a switch, as triggering
+//! @details   PendSV does. The switch is taken once interrupts are
+//! @details   unlocked and no ISR is active, and goes to the head of
+//! @details   'nufr_ready_list', or to the BG task if it's empty.
+//! @details
+//! @details   Time is virtual. Each outermost interrupt unlock at task
+//! @details   level costs NUFR_SIM_UNLOCK_COST_NS. When virtual time
+//! @details   crosses an OS tick boundary, the OS tick handler is run
+//! @details   synchronously, as an ISR, at that unlock. When the BG task
+//! @details   idles, virtual time skips ahead to the next tick.
+//!
+
+#include "nufr-global.h"
+
+#if NUFR_CS_SIM_COROUTINE == 1
+
+#include "nufr-api.h"
+#include "nufr-platform-app.h"
+#include "nufr-platform.h"
+#include "nsvc-app.h"
+#include "nsvc-api.h"
+#include "nsvc.h"
+#include "nufr-simulation.h"
+
+#include "nufr-kernel-task.h"
+
+#include "raging-global.h"
+#include "raging-utils.h"
+#include "raging-utils-mem.h"
+#include "raging-contract.h"
+
+#include <ucontext.h>
+
+//!
+//! @name      NUFR_SIM_STACK_SIZE
+//!
+//! @brief     Host stack size per task, in bytes. Task descriptor
+//! @brief     stacks are sized for the target, not the host.
+//!
+#ifndef NUFR_SIM_STACK_SIZE
+    #define NUFR_SIM_STACK_SIZE       (64 * 1024)
+#endif
+
+//!
+//! @name      NUFR_SIM_UNLOCK_COST_NS
+//!
+//! @brief     Virtual nanosecs charged per outermost interrupt unlock
+//!
+#ifndef NUFR_SIM_UNLOCK_COST_NS
+    #define NUFR_SIM_UNLOCK_COST_NS   1000
+#endif
+
+#define SIM_NS_PER_TICK               ((uint64_t)NUFR_TICK_PERIOD * 1000000)
+
+//!
+//! @struct    sim_task_t
+//!
+//! @brief     Task simulation state
+//!
+typedef struct
+{
+    ucontext_t context;
+    bool       is_launched;          // coroutine started since last launch
+    void       (*entry_point_fcn_ptr)(unsigned);
+    void       (*exit_point_fcn_ptr)(void);
+    unsigned   entry_parameter;
+} sim_task_t;
+
+//!
+//! @name      sim_tasks
+//! @name      sim_stacks
+//!
+//! @brief     Per task coroutine state and host stack
+//!
+static sim_task_t sim_tasks[NUFR_NUM_TASKS];
+static uint64_t   sim_stacks[NUFR_NUM_TASKS][NUFR_SIM_STACK_SIZE / sizeof(uint64_t)];
+
+//!
+//! @name      sim_bg_context
+//! @name      sim_exit_context
+//!
+//! @brief     BG task context; context nufr_sim_entry() returns through
+//!
+static ucontext_t sim_bg_context;
+static ucontext_t sim_exit_context;
+
+//!
+//! @name      sim_switch_pending
+//!
+//! @brief     Simulated PendSV pending bit
+//!
+static bool       sim_switch_pending;
+
+//!
+//! @name      nufr_sim_in_isr
+//! @name      nufr_sim_virtual_ns
+//! @name      nufr_sim_ticks
+//! @name      nufr_sim_switch_count
+//! @name      nufr_sim_stop_ticks
+//!
+//! @brief     Non-zero while the OS tick handler runs
+//! @brief     Virtual time since nufr_sim_entry(), in nanosecs
+//! @brief     OS ticks injected
+//! @brief     Context switches taken
+//! @brief     If non-zero, nufr_sim_entry() returns after this many ticks
+//!
+unsigned          nufr_sim_in_isr;
+uint64_t          nufr_sim_virtual_ns;
+uint32_t          nufr_sim_ticks;
+uint32_t          nufr_sim_switch_count;
+uint32_t          nufr_sim_stop_ticks;
+
+//!
+//! @name      sim_task_main
+//!
+//! @brief     Coroutine entry. Runs task's entry point, then its exit.
+//!
+//! @param[in] 'index'-- task index, TID - 1
+//!
+static void sim_task_main(int index)
+{
+    sim_task_t *task = &sim_tasks[index];
+
+    (*task->entry_point_fcn_ptr)(task->entry_parameter);
+
+    // Task returned from entry point. Exit never switches back here.
+    (*task->exit_point_fcn_ptr)();
+
+    UT_ENSURE(false);
+}
+
+//!
+//! @name      sim_task_create
+//!
+//! @brief     Builds a task's coroutine, entering at sim_task_main()
+//!
+//! @details   Kept out of sim_switch(): getcontext() there would let
+//! @details   the compiler assume sim_switch() locals get clobbered.
+//!
+static void sim_task_create(unsigned task_index)
+{
+    sim_task_t *task = &sim_tasks[task_index];
+
+    task->is_launched = true;
+
+    getcontext(&task->context);
+    task->context.uc_stack.ss_sp = sim_stacks[task_index];
+    task->context.uc_stack.ss_size = sizeof(sim_stacks[task_index]);
+    task->context.uc_link = NULL;
+    makecontext(&task->context, (void (*)(void))sim_task_main,
+                1, (int)task_index);
+}
+
+//!
+//! @name      sim_switch
+//!
+//! @brief     Takes a pended context switch
+//!
+//! @details   Does what PendSV does: saves the running task's context,
+//! @details   then restores the context of the head of the ready list.
+//!
+static void sim_switch(void)
+{
+    nufr_tcb_t *old_running_task;
+    nufr_tcb_t *new_running_task;
+    ucontext_t *old_context;
+    ucontext_t *new_context;
+    sim_task_t *task;
+    unsigned    task_index;
+
+    sim_switch_pending = false;
+
+    old_running_task = nufr_running;
+    new_running_task = (NULL != nufr_ready_list)?
+                       nufr_ready_list : (nufr_tcb_t *)nufr_bg_sp;
+
+    // Ready list changed back before switch was taken?
+    if (old_running_task == new_running_task)
+    {
+        return;
+    }
+
+#if NUFR_CS_TASK_STATS == 1
+    nufrkernel_task_stats_switch(nufr_running, nufr_ready_list);
+#endif
+
+    nufr_running = new_running_task;
+    nufr_sim_switch_count++;
+
+    if (NUFR_IS_TCB(old_running_task))
+    {
+        old_context = &sim_tasks[NUFR_TCB_TO_TID(old_running_task) - 1].context;
+    }
+    else
+    {
+        old_context = &sim_bg_context;
+    }
+
+    if (NUFR_IS_TCB(new_running_task))
+    {
+        task_index = NUFR_TCB_TO_TID(new_running_task) - 1;
+        task = &sim_tasks[task_index];
+        new_context = &task->context;
+
+        // First switch-in since nufr_launch_task(): start coroutine
+        if (!task->is_launched)
+        {
+            sim_task_create(task_index);
+        }
+    }
+    else
+    {
+        new_context = &sim_bg_context;
+    }
+
+    swapcontext(old_context, new_context);
+}
+
+//!
+//! @name      nufr_sim_prepare_task
+//!
+//! @brief     Called when a task is launched, in place of stack prep
+//!
+//! @details   Any earlier coroutine for the task (it exited or was killed)
+//! @details   is dropped. A new one starts when the task is switched in.
+//!
+//! @param[in] 'ptr'-- as passed to _IMPORT_PREPARE_STACK
+//!
+void nufr_sim_prepare_task(_IMPORT_stack_specifier_t *ptr)
+{
+    unsigned i;
+
+    for (i = 0; i < NUFR_NUM_TASKS; i++)
+    {
+        if ((void *)ptr->stack_ptr_ptr == (void *)&nufr_tcb_block[i].stack_ptr)
+        {
+            sim_tasks[i].is_launched = false;
+            sim_tasks[i].entry_point_fcn_ptr = ptr->entry_point_fcn_ptr;
+            sim_tasks[i].exit_point_fcn_ptr = ptr->exit_point_fcn_ptr;
+            sim_tasks[i].entry_parameter = ptr->entry_parameter;
+            return;
+        }
+    }
+
+    UT_REQUIRE(false);
+}
+
+//!
+//! @name      nufr_sim_context_switch
+//!
+//! @brief     NUFR_INVOKE_CONTEXT_SWITCH() handler in coroutine mode
+//!
+//! @details   Pends a switch. Taken now if interrupts are unlocked
+//! @details   and no ISR is active, else when that's so.
+//!
+void nufr_sim_context_switch(void)
+{
+    sim_switch_pending = true;
+
+    if ((0 == ut_interrupt_count) && (0 == nufr_sim_in_isr))
+    {
+        sim_switch();
+    }
+}
+
+//!
+//! @name      nufr_sim_tick
+//!
+//! @brief     Runs the OS tick handler as an ISR, then takes any
+//! @brief     switch it pended
+//!
+void nufr_sim_tick(void)
+{
+    nufr_sim_in_isr++;
+
+#if NUFR_CS_TICKLESS_IDLE == 1
+    nufrplat_sim_oneshot_clock();
+#else
+    nufrplat_systick_handler();
+#endif
+    nufr_sim_ticks++;
+
+    nufr_sim_in_isr--;
+
+    if ((0 != nufr_sim_stop_ticks) && (nufr_sim_ticks >= nufr_sim_stop_ticks))
+    {
+        // Unwind out of whatever context is running
+        setcontext(&sim_exit_context);
+    }
+
+    // Exception return: pended switch taken
+    if (sim_switch_pending && (0 == nufr_sim_in_isr))
+    {
+        sim_switch();
+    }
+}
+
+//!
+//! @name      nufr_sim_unlocked
+//!
+//! @brief     Called after each NUFR_UNLOCK_INTERRUPTS()
+//!
+//! @details   On the outermost unlock at task level: charges virtual
+//! @details   time, injects a tick if one is due, then takes any
+//! @details   pended switch.
+//!
+void nufr_sim_unlocked(void)
+{
+    if ((0 != ut_interrupt_count) || (0 != nufr_sim_in_isr))
+    {
+        return;
+    }
+
+    nufr_sim_virtual_ns += NUFR_SIM_UNLOCK_COST_NS;
+
+    if (nufr_sim_virtual_ns >= (nufr_sim_ticks + 1) * SIM_NS_PER_TICK)
+    {
+        nufr_sim_tick();
+    }
+    else if (sim_switch_pending)
+    {
+        sim_switch();
+    }
+}
+
+#if NUFR_CS_TICKLESS_IDLE == 1
+//!
+//! @name      nufr_sim_fast_forward
+//!
+//! @brief     Simulated wait-for-interrupt with the one-shot programmed
+//!
+//! @details   Called by nufrplat_tickless_idle() with no task ready.
+//! @details   Nothing can happen until the one-shot expires, so virtual
+//! @details   time jumps straight to it: the skipped ticks are clocked
+//! @details   in one step and the OS tick handler accounts for them all,
+//! @details   advancing 'nufr_os_tick_count' and 'nufrplat_simulated_time'
+//! @details   to the deadline. Never jumps past 'nufr_sim_stop_ticks'.
+//!
+void nufr_sim_fast_forward(void)
+{
+    uint32_t remaining;
+
+    if (nufrplat_oneshot_count >= nufrplat_oneshot_ticks)
+    {
+        return;
+    }
+
+    remaining = nufrplat_oneshot_ticks - nufrplat_oneshot_count;
+
+    if ((0 != nufr_sim_stop_ticks) &&
+        (nufr_sim_ticks + remaining > nufr_sim_stop_ticks))
+    {
+        remaining = nufr_sim_stop_ticks - nufr_sim_ticks;
+    }
+
+    // All but the last tick: one-shot counts, handler doesn't run
+    nufrplat_oneshot_count += remaining - 1;
+    nufr_sim_ticks += remaining - 1;
+    nufr_sim_virtual_ns = (nufr_sim_ticks + 1) * SIM_NS_PER_TICK;
+
+    nufr_sim_tick();
+}
+#endif
+
+//!
+//! @name      nufr_sim_idle
+//!
+//! @brief     Called by the BG task when it has nothing to do
+//!
+//! @details   No task is ready, so nothing can happen until the next
+//! @details   timeout. With tickless idle, virtual time jumps straight
+//! @details   to the earliest kernel or SL timer deadline. Otherwise,
+//! @details   or if the deadline is the next tick, it skips ahead to
+//! @details   the next tick.
+//!
+void nufr_sim_idle(void)
+{
+#if NUFR_CS_TICKLESS_IDLE == 1
+    uint32_t ticks_before = nufr_sim_ticks;
+
+    nufrplat_tickless_idle();
+
+    if (ticks_before != nufr_sim_ticks)
+    {
+        return;
+    }
+#endif
+
+    nufr_sim_virtual_ns = (nufr_sim_ticks + 1) * SIM_NS_PER_TICK;
+
+    nufr_sim_tick();
+}
+
+//!
+//! @name      nufr_sim_timestamp_us
+//!
+//! @brief     Virtual time, in microsecs. Wraps.
+//!
+uint32_t nufr_sim_timestamp_us(void)
+{
+    return (uint32_t)(nufr_sim_virtual_ns / 1000);
+}
+
+//!
+//! @name      nufr_sim_entry
+//!
+//! @brief     Callin for simulation.
+//!
+//! @details   Runs BG task on the calling host thread. Returns only if
+//! @details   'nufr_sim_stop_ticks' is set, once that many ticks have
+//! @details   been injected.
+//!
+//! @param[in] 'bg_fcn_ptr'-- BG task. Should call nufr_sim_idle() when
+//! @param[in]                it has nothing to do.
+//! @param[in] 'tick_fcn_ptr'-- unused, ticks are injected by the
+//! @param[in]                  simulation. Pass NULL.
+//!
+void nufr_sim_entry(nufr_sim_generic_fcn_ptr bg_fcn_ptr,
+                    nufr_sim_generic_fcn_ptr tick_fcn_ptr)
+{
+    volatile bool  stopped = false;
+
+    UNUSED(tick_fcn_ptr);
+
+    nufr_sim_in_isr = 0;
+    nufr_sim_virtual_ns = 0;
+    nufr_sim_ticks = 0;
+    nufr_sim_switch_count = 0;
+    sim_switch_pending = false;
+    rutils_memset(sim_tasks, 0, sizeof(sim_tasks));
+
+    nufr_init();
+    nsvc_init();
+    nsvc_mutex_init();
+#ifdef NSVC_NUM_RWLOCK
+    nsvc_rwlock_init();
+#endif
+    nsvc_timer_init(nufrplat_systick_get_reference_time, NULL);
+    nsvc_pcl_init();
+
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+
+    // Returned to when run stops
+    getcontext(&sim_exit_context);
+    if (stopped)
+    {
+        return;
+    }
+    stopped = true;
+
+    // Invoke BG task. Becomes 'sim_bg_context' at its first switch-out.
+    (*bg_fcn_ptr)(NULL);
+}
+
+#endif  //NUFR_CS_SIM_COROUTINE
@@ -33,6 +33,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //!
 
 #include "nufr-global.h"
+
+#if NUFR_CS_SIM_COROUTINE == 0
+
 #include "nufr-api.h"
 #include "nufr-platform-app.h"
 #include "nufr-platform.h"
@@ -167,6 +170,10 @@ void nufr_sim_context_switch(void)
     // There could be some corner cases which are unavoidable, however.
     UT_REQUIRE(nufr_running != nufr_ready_list);
 
+#if NUFR_CS_TASK_STATS == 1
+    nufrkernel_task_stats_switch(nufr_running, nufr_ready_list);
+#endif
+
     old_running_task = nufr_running;
 
     // If a task is being switched in, that task needs either needs
@@ -307,6 +314,9 @@ void nufr_sim_entry(nufr_sim_generic_fcn_ptr bg_fcn_ptr,
     nufr_init();
     nsvc_init();
     nsvc_mutex_init();
+#ifdef NSVC_NUM_RWLOCK
+    nsvc_rwlock_init();
+#endif
     nsvc_timer_init(nufrplat_systick_get_reference_time, NULL);
     nsvc_pcl_init();
 
@@ -329,4 +339,6 @@ void nufr_sim_entry(nufr_sim_generic_fcn_ptr bg_fcn_ptr,
     (*bg_fcn_ptr)(NULL);
 
     // Cannot return from here or all threads will killed
-}
\ No newline at end of file
+}
+
+#endif  //NUFR_CS_SIM_COROUTINE
@@ -103,6 +103,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ssp-app.h"
 #include "ssp-driver.h"
+#include "ssp-assignments.h"
+
+#if NUFR_CS_TRACE == 1
+    #include "nufr-kernel-trace.h"
+#endif
 
 #if 0
 //*********   Example ssp-app.h
@@ -713,4 +718,70 @@ void ssp_tx_obtain_next_bytes(unsigned  channel_number,
             //   nsvc_pool_free(&ssp_pool, this_buffer);
         }
     }
-}
\ No newline at end of file
+}
+
+#if NUFR_CS_TRACE == 1
+//!
+//! @name      ssp_trace_dump_next
+//!
+//! @brief     Packs the next piece of the kernel trace ring image
+//! @brief     into a packet
+//!
+//! @details   Payload is dest app SSP_DAPP_CLEAR_TRACE_DUMP_RESPONSE,
+//! @details   circuit SSP_CIR_PRIMARY_PEER, then the bytes of
+//! @details   'nufr_trace_ring' from '*offset_ptr' on. Call until it
+//! @details   returns NULL, with '*offset_ptr' 0 at first, sending each
+//! @details   packet as it's returned. tools/linux/nufr-trace-decode
+//! @details   concatenates the pieces.
+//! @details
+//! @details   Tracing carries on during the dump. Records written
+//! @details   meanwhile are newer than the image header and get
+//! @details   dropped by the decoder.
+//! @details
+//! @details   Waits for a free buffer, so call from a task which
+//! @details   isn't the one draining SSP tx.
+//!
+//! @param[in] 'channel_number'--
+//! @param[in,out] 'offset_ptr'-- bytes of image sent so far
+//!
+//! @return    packet, or NULL if whole image has been sent
+//!
+ssp_buf_t *ssp_trace_dump_next(unsigned  channel_number,
+                               unsigned *offset_ptr)
+{
+    ssp_buf_t           *buf;
+    uint8_t             *ptr;
+    unsigned             length;
+
+    APP_REQUIRE_API(NULL != offset_ptr);
+
+    if (*offset_ptr >= sizeof(nufr_trace_ring))
+    {
+        return NULL;
+    }
+
+    buf = ssp_allocate_buffer_from_taskW(channel_number);
+    if (NULL == buf)
+    {
+        return NULL;
+    }
+
+    // L3 header takes 2 bytes of payload
+    length = sizeof(nufr_trace_ring) - *offset_ptr;
+    if (length > SSP_MAX_PAYLOAD_SIZE - 2)
+    {
+        length = SSP_MAX_PAYLOAD_SIZE - 2;
+    }
+
+    ptr = SSP_FREE_PAYLOAD_PTR(buf);
+    *ptr++ = SSP_DAPP_CLEAR_TRACE_DUMP_RESPONSE;
+    *ptr++ = SSP_CIR_PRIMARY_PEER;
+    rutils_memcpy(ptr, (const uint8_t *)&nufr_trace_ring + *offset_ptr,
+                  length);
+
+    buf->header.length += 2 + length;
+    *offset_ptr += length;
+
+    return buf;
+}
+#endif  //NUFR_CS_TRACE
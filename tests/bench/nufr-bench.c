@@ -0,0 +1,1129 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     nufr-bench.c
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief   Kernel micro-benchmarks
+//!
+//! @details The driver task times each benchmark in rounds of
+//! @details BENCH_ITERATIONS operations, then prints a CSV line.
+//! @details Benchmarks needing a second task hand it a command message
+//! @details carrying the iteration count. The partner task runs at a
+//! @details higher priority than the driver, so a send to it preempts.
+//! @details The peer task runs at the driver's priority, so the two hand
+//! @details off by blocking or yielding.
+//!
+
+#include "nufr-global.h"
+#include "nufr-platform-app.h"
+
+#if NUFR_BENCH == 1
+
+#include "nufr-platform.h"
+#include "nufr-api.h"
+#include "nufr-kernel-semaphore.h"
+#include "nufr-kernel-timer.h"
+#include "nsvc.h"
+#include "nsvc-api.h"
+#include "nufr-bench.h"
+
+#include "raging-contract.h"
+#include "raging-utils-scan-print.h"
+#include "raging-utils-mem.h"
+
+//!
+//! @enum      bench_cmd_t
+//!
+//! @details   Message IDs of commands to the partner and peer tasks.
+//! @details   Message parameter is the iteration count.
+//!
+typedef enum
+{
+    BENCH_CMD_ECHO = 1,       // partner: reply to each message
+    BENCH_CMD_BOP_WAIT,       // partner: wait for bops
+    BENCH_CMD_YIELD,          // peer: yield
+    BENCH_CMD_BOP_PONG,       // peer: wait for bop, bop back
+    BENCH_CMD_SEMA,           // peer: get/release contended sema
+    BENCH_CMD_MUTEX,          // peer: get/release contended mutex
+    BENCH_CMD_READ_RWLOCK,    // peer: read sections under rwlock
+    BENCH_CMD_READ_MUTEX,     // peer: read sections under mutex
+    BENCH_CMD_WRITE_RWLOCK,   // partner: one write under rwlock
+    BENCH_CMD_WRITE_MUTEX,    // partner: one write under mutex
+    BENCH_CMD_TIMER_TICK      // partner: count timer expiries
+} bench_cmd_t;
+
+#define BENCH_CMD_FIELDS(cmd)                                            \
+    NUFR_SET_MSG_FIELDS(NSVC_MSG_PREFIX_local, (cmd), NUFR_TID_null,     \
+                        NUFR_MSG_PRI_MID)
+
+//!
+//! @name      BENCH_PCL_CAPACITY
+//!
+//! @details   Bytes asked for per chain: spans 3 particles
+//!
+#define BENCH_PCL_CAPACITY      (NSVC_PCL_SIZE_AT_HEAD + 2 * NSVC_PCL_SIZE)
+
+//!
+//! @name      BENCH_POOL_SIZE
+//!
+#define BENCH_POOL_SIZE          4
+
+//!
+//! @name      BENCH_BULK_POOL_SIZE
+//!
+//! @details   Bulk pool benchmarks: elements per pool, and most
+//! @details   taken by one call
+//!
+#define BENCH_BULK_POOL_SIZE     32
+
+//!
+//! @name      BENCH_MSG_BURST
+//!
+//! @details   Messages sent per burst by the message send benchmarks
+//!
+#define BENCH_MSG_BURST          8
+
+//!
+//! @name      BENCH_TIMER_DURATION
+//!
+//! @details   Long enough that no timer expires during a run
+//!
+#define BENCH_TIMER_DURATION     1000000
+
+//!
+//! @name      BENCH_TIMER_TASKS
+//!
+//! @details   Tick benchmarks: most sleeping tasks on the timer list
+//!
+#define BENCH_TIMER_TASKS        128
+
+//!
+//! @name      BENCH_TIMER_PERIOD
+//!
+//! @details   Timer delivery benchmarks: continuous timer interval
+//!
+#define BENCH_TIMER_PERIOD       1
+
+//!
+//! @name      BENCH_WRITE_INTERVAL
+//!
+//! @details   Reader benchmarks: driver iterations per write
+//!
+#define BENCH_WRITE_INTERVAL     16
+
+//!
+//! @struct    bench_element_t
+//!
+//! @brief     Element of the benchmark 'nsvc_pool_t'
+//!
+typedef struct bench_element_t_
+{
+    struct bench_element_t_ *flink;
+    uint32_t                 data[3];
+} bench_element_t;
+
+static bench_element_t   bench_elements[BENCH_POOL_SIZE];
+static nsvc_pool_t       bench_pool;
+
+#if NUFR_CS_POOL_BULK == 1
+//!
+//! @struct    bench_big_element_t
+//!
+//! @brief     1 KB element, for the bulk and lazy zeroing benchmarks
+//!
+typedef struct bench_big_element_t_
+{
+    struct bench_big_element_t_ *flink;
+    uint32_t                     header;
+    uint8_t                      data[1016];
+} bench_big_element_t;
+
+static bench_big_element_t bench_zeroed_elements[BENCH_BULK_POOL_SIZE];
+static bench_big_element_t bench_lazy_elements[BENCH_BULK_POOL_SIZE];
+static nsvc_pool_t         bench_zeroed_pool;
+static nsvc_pool_t         bench_lazy_pool;
+#endif  // NUFR_CS_POOL_BULK
+// Sleepers for the tick benchmarks, not in 'nufr_tcb_block'
+static nufr_tcb_t        bench_timer_tcbs[BENCH_TIMER_TASKS];
+static nufr_sema_t       bench_sema;
+static volatile bool     bench_peer_busy;
+static volatile unsigned bench_timer_ticks;
+
+//!
+//! @struct    bench_result_t
+//!
+//! @brief     Per-operation times over all rounds of one benchmark
+//!
+typedef struct
+{
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+} bench_result_t;
+
+//!
+//! @name      bench_fcn_ptr_t
+//!
+//! @brief     Runs one round of 'iterations' operations
+//!
+//! @return    Elapsed time of round, in 'bench_timestamp()' units
+//!
+typedef uint32_t (*bench_fcn_ptr_t)(unsigned iterations);
+
+
+//! @name      bench_send_cmd
+//
+//! @brief     Hands a command to the partner or peer
+static void bench_send_cmd(bench_cmd_t cmd, unsigned iterations,
+                           nufr_tid_t tid)
+{
+    nufr_msg_send_rtn_t send_rv;
+
+    send_rv = nufr_msg_send(BENCH_CMD_FIELDS(cmd), iterations, tid);
+    UT_ENSURE(NUFR_MSG_SEND_ERROR != send_rv);
+    UNUSED_BY_ASSERT(send_rv);
+}
+
+//! @name      bench_ctx_switch
+//
+//! @brief     Yield between driver and peer: 2 switches per operation
+static uint32_t bench_ctx_switch(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+
+    bench_send_cmd(BENCH_CMD_YIELD, iterations, BENCH_TID_PEER);
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nufr_yield();
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_msg_round_trip
+//
+//! @brief     nufr_msg_send() to partner, partner replies,
+//! @brief     nufr_msg_getW() gets reply
+static uint32_t bench_msg_round_trip(unsigned iterations)
+{
+    uint32_t start;
+    uint32_t fields;
+    uint32_t parameter;
+    unsigned i;
+
+    // Partner echoes until it gets a 0 count
+    bench_send_cmd(BENCH_CMD_ECHO, iterations, BENCH_TID_PARTNER);
+    nufr_msg_getW(&fields, &parameter);
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        bench_send_cmd(BENCH_CMD_ECHO, i + 1, BENCH_TID_PARTNER);
+        nufr_msg_getW(&fields, &parameter);
+    }
+
+    bench_send_cmd(BENCH_CMD_ECHO, 0, BENCH_TID_PARTNER);
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_bop_wake
+//
+//! @brief     nufr_bop_send() to a waiting partner, which preempts
+//! @brief     and waits again
+static uint32_t bench_bop_wake(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+
+    bench_send_cmd(BENCH_CMD_BOP_WAIT, iterations, BENCH_TID_PARTNER);
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nufr_bop_send_with_key_override(BENCH_TID_PARTNER);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_bop_ping_pong
+//
+//! @brief     Driver and peer take turns waking each other with bops
+static uint32_t bench_bop_ping_pong(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+
+    // Let peer get into its first bop wait
+    bench_send_cmd(BENCH_CMD_BOP_PONG, iterations, BENCH_TID_PEER);
+    nufr_yield();
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nufr_bop_send_with_key_override(BENCH_TID_PEER);
+        nufr_bop_waitW(NUFR_MSG_PRI_MID);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_sema_uncontended
+//
+//! @brief     nufr_sema_getW() then nufr_sema_release(), no waiters
+static uint32_t bench_sema_uncontended(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nufr_sema_getW(bench_sema, NUFR_MSG_PRI_MID);
+        nufr_sema_release(bench_sema);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_sema_contended
+//
+//! @brief     Driver and peer each block on the sema the other holds.
+//! @brief     Every get blocks and every release hands it over.
+static uint32_t bench_sema_contended(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+
+    nufr_sema_getW(bench_sema, NUFR_MSG_PRI_MID);
+
+    // Let peer block on the sema
+    bench_send_cmd(BENCH_CMD_SEMA, iterations, BENCH_TID_PEER);
+    nufr_yield();
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nufr_sema_release(bench_sema);
+        nufr_sema_getW(bench_sema, NUFR_MSG_PRI_MID);
+    }
+    start = bench_timestamp() - start;
+
+    nufr_sema_release(bench_sema);
+
+    return start;
+}
+
+//! @name      bench_mutex_uncontended
+//
+//! @brief     nsvc_mutex_getW() then nsvc_mutex_release(), no waiters.
+//! @brief     With NUFR_CS_MUTEX_FAST_PATH, never touches the sema.
+static uint32_t bench_mutex_uncontended(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID);
+        nsvc_mutex_release(NSVC_MUTEX_1);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_mutex_contended
+//
+//! @brief     As 'bench_sema_contended', on an SL mutex
+static uint32_t bench_mutex_contended(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+
+    nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID);
+
+    // Let peer block on the mutex
+    bench_send_cmd(BENCH_CMD_MUTEX, iterations, BENCH_TID_PEER);
+    nufr_yield();
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nsvc_mutex_release(NSVC_MUTEX_1);
+        nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID);
+    }
+    start = bench_timestamp() - start;
+
+    nsvc_mutex_release(NSVC_MUTEX_1);
+
+    return start;
+}
+
+//! @name      bench_read_section
+//
+//! @brief     A reader's critical section. The yield stands in for
+//! @brief     being preempted while holding the lock.
+static void bench_read_section(bool use_rwlock)
+{
+    if (use_rwlock)
+    {
+        nsvc_rwlock_read_getW(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID);
+        nufr_yield();
+        nsvc_rwlock_read_release(NSVC_RWLOCK_1);
+    }
+    else
+    {
+        nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID);
+        nufr_yield();
+        nsvc_mutex_release(NSVC_MUTEX_1);
+    }
+}
+
+//! @name      bench_readers
+//
+//! @brief     2 readers (driver, peer) and 1 writer (partner, every
+//! @brief     BENCH_WRITE_INTERVAL ops) share a lock. Readers overlap
+//! @brief     under a rwlock, but serialize under a mutex.
+static uint32_t bench_readers(unsigned iterations, bool use_rwlock)
+{
+    uint32_t start;
+    unsigned i;
+
+    bench_peer_busy = true;
+    bench_send_cmd(use_rwlock? BENCH_CMD_READ_RWLOCK : BENCH_CMD_READ_MUTEX,
+                   iterations, BENCH_TID_PEER);
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        // Partner preempts to write
+        if (0 == (i % BENCH_WRITE_INTERVAL))
+        {
+            bench_send_cmd(use_rwlock? BENCH_CMD_WRITE_RWLOCK :
+                                       BENCH_CMD_WRITE_MUTEX,
+                           1, BENCH_TID_PARTNER);
+        }
+
+        bench_read_section(use_rwlock);
+    }
+
+    while (bench_peer_busy)
+    {
+        nufr_yield();
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_rwlock_readers
+//
+//! @brief     'bench_readers()' with an rwlock
+static uint32_t bench_rwlock_readers(unsigned iterations)
+{
+    return bench_readers(iterations, true);
+}
+
+//! @name      bench_mutex_readers
+//
+//! @brief     'bench_readers()' with a mutex, for comparison
+static uint32_t bench_mutex_readers(unsigned iterations)
+{
+    return bench_readers(iterations, false);
+}
+
+//! @name      bench_pool_alloc_free
+//
+//! @brief     nsvc_pool_allocate() then nsvc_pool_free()
+static uint32_t bench_pool_alloc_free(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+    void    *element_ptr;
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        element_ptr = nsvc_pool_allocate(&bench_pool, false);
+        nsvc_pool_free(&bench_pool, element_ptr);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_msg_send_burst
+//
+//! @brief     Driver sends itself a burst of BENCH_MSG_BURST messages,
+//! @brief     then drains them
+//
+//! @param[in] 'use_batch'-- one nufr_msg_send_batch() per burst,
+//! @param[in]        otherwise a nufr_msg_send() per message
+static uint32_t bench_msg_send_burst(unsigned iterations, bool use_batch)
+{
+    nufr_msg_batch_entry_t entries[BENCH_MSG_BURST];
+    uint32_t               start;
+    unsigned               i;
+    unsigned               j;
+
+    for (j = 0; j < BENCH_MSG_BURST; j++)
+    {
+        entries[j].fields = BENCH_CMD_FIELDS(BENCH_CMD_ECHO);
+        entries[j].parameter = j;
+    }
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        if (use_batch)
+        {
+            nufr_msg_send_batch(entries, BENCH_MSG_BURST, BENCH_TID_DRIVER);
+        }
+        else
+        {
+            for (j = 0; j < BENCH_MSG_BURST; j++)
+            {
+                nufr_msg_send(entries[j].fields, entries[j].parameter,
+                              BENCH_TID_DRIVER);
+            }
+        }
+
+        nufr_msg_drain(BENCH_TID_DRIVER, NUFR_MSG_PRI_CONTROL);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_msg_send_loop
+//
+//! @brief     'bench_msg_send_burst()' with a nufr_msg_send() loop
+static uint32_t bench_msg_send_loop(unsigned iterations)
+{
+    return bench_msg_send_burst(iterations, false);
+}
+
+//! @name      bench_msg_send_batch
+//
+//! @brief     'bench_msg_send_burst()' with nufr_msg_send_batch()
+static uint32_t bench_msg_send_batch(unsigned iterations)
+{
+    return bench_msg_send_burst(iterations, true);
+}
+
+#if NUFR_CS_POOL_BULK == 1
+//! @name      bench_pool_1k_alloc_free
+//
+//! @brief     nsvc_pool_allocate() then nsvc_pool_free() of a 1 KB
+//! @brief     element which is cleared in full
+static uint32_t bench_pool_1k_alloc_free(unsigned iterations)
+{
+    uint32_t start;
+    unsigned i;
+    void    *element_ptr;
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        element_ptr = nsvc_pool_allocate(&bench_zeroed_pool, false);
+        nsvc_pool_free(&bench_zeroed_pool, element_ptr);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_pool_bulk
+//
+//! @brief     nsvc_pool_allocate_bulk() then nsvc_pool_free_bulk() of
+//! @brief     'per_call' 1 KB elements, only their headers cleared
+static uint32_t bench_pool_bulk(unsigned iterations, unsigned per_call)
+{
+    void     *element_ptrs[BENCH_BULK_POOL_SIZE];
+    uint32_t  start;
+    unsigned  taken;
+    unsigned  i;
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        taken = nsvc_pool_allocate_bulk(&bench_lazy_pool, element_ptrs,
+                                        per_call, false);
+        UT_ENSURE(per_call == taken);
+        nsvc_pool_free_bulk(&bench_lazy_pool, element_ptrs, taken);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_pool_bulk_1
+//! @name      bench_pool_bulk_8
+//! @name      bench_pool_bulk_32
+//
+//! @brief     'bench_pool_bulk()' per call counts
+static uint32_t bench_pool_bulk_1(unsigned iterations)
+{
+    return bench_pool_bulk(iterations, 1);
+}
+
+static uint32_t bench_pool_bulk_8(unsigned iterations)
+{
+    return bench_pool_bulk(iterations, 8);
+}
+
+static uint32_t bench_pool_bulk_32(unsigned iterations)
+{
+    return bench_pool_bulk(iterations, 32);
+}
+#endif  // NUFR_CS_POOL_BULK
+
+//! @name      bench_pcl_chain
+//
+//! @brief     nsvc_pcl_alloc_chainWT() of a 3-particle chain, then
+//! @brief     nsvc_pcl_free_chain()
+static uint32_t bench_pcl_chain(unsigned iterations)
+{
+    uint32_t            start;
+    unsigned            i;
+    nsvc_pcl_t         *head_pcl;
+    nufr_sema_get_rtn_t alloc_rv;
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        alloc_rv = nsvc_pcl_alloc_chainWT(&head_pcl, NULL,
+                                          BENCH_PCL_CAPACITY,
+                                          NSVC_PCL_NO_TIMEOUT);
+        UT_ENSURE(NUFR_SEMA_GET_OK_NO_BLOCK == alloc_rv);
+        UNUSED_BY_ASSERT(alloc_rv);
+
+        nsvc_pcl_free_chain(head_pcl);
+    }
+
+    return bench_timestamp() - start;
+}
+
+//! @name      bench_timer_start_kill
+//
+//! @brief     nsvc_timer_start() then nsvc_timer_kill(), with all other
+//! @brief     timers in the pool active
+//
+//! @details   Active timers get staggered durations, and the timed timer
+//! @details   expires mid-pack, so neither first nor last in the heap.
+static uint32_t bench_timer_start_kill(unsigned iterations)
+{
+    nsvc_timer_t *timers[NSVC_NUM_TIMER];
+    nsvc_timer_t *tm;
+    uint32_t      start;
+    unsigned      num_timers;
+    unsigned      i;
+
+    for (num_timers = 0; num_timers < NSVC_NUM_TIMER; num_timers++)
+    {
+        tm = nsvc_timer_alloc();
+        if (NULL == tm)
+        {
+            break;
+        }
+
+        tm->duration = BENCH_TIMER_DURATION + num_timers * 2;
+        tm->msg_fields = NSVC_TIMER_SET_ID(num_timers);
+        timers[num_timers] = tm;
+    }
+    UT_ENSURE(num_timers > 0);
+
+    // Last one is timed, the rest are the load
+    tm = timers[num_timers - 1];
+    tm->duration = BENCH_TIMER_DURATION + num_timers - 1;
+    for (i = 0; i < num_timers - 1; i++)
+    {
+        nsvc_timer_start(timers[i]);
+    }
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nsvc_timer_start(tm);
+        nsvc_timer_kill(tm);
+    }
+    start = bench_timestamp() - start;
+
+    for (i = 0; i < num_timers; i++)
+    {
+        nsvc_timer_kill(timers[i]);
+        nsvc_timer_free(timers[i]);
+    }
+
+    return start;
+}
+
+//! @name      bench_timer_tick
+//
+//! @brief     nufrkernel_update_task_timers() with 'num_tasks' tasks
+//! @brief     asleep on the kernel timer list, none expiring
+//
+//! @details   The real timer list is set aside for the round, with
+//! @details   interrupts locked so no OS tick runs meanwhile. Cost
+//! @details   should not grow with 'num_tasks'.
+static uint32_t bench_timer_tick(unsigned iterations, unsigned num_tasks)
+{
+    nufr_tcb_t    *saved_list;
+    nufr_tcb_t    *saved_list_tail;
+    uint32_t       saved_tick_count;
+    nufr_sr_reg_t  saved_psr;
+    uint32_t       start;
+    unsigned       i;
+
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+
+    saved_list = nufr_timer_list;
+    saved_list_tail = nufr_timer_list_tail;
+    saved_tick_count = nufr_os_tick_count;
+    nufr_timer_list = NULL;
+    nufr_timer_list_tail = NULL;
+
+    rutils_memset(bench_timer_tcbs, 0, sizeof(bench_timer_tcbs));
+    for (i = 0; i < num_tasks; i++)
+    {
+        bench_timer_tcbs[i].block_flags = NUFR_TASK_BLOCKED_ASLEEP;
+        nufrkernel_add_to_timer_list(&bench_timer_tcbs[i],
+                                     iterations + 1 + i);
+    }
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        nufrkernel_update_task_timers();
+    }
+    start = bench_timestamp() - start;
+
+    nufr_timer_list = saved_list;
+    nufr_timer_list_tail = saved_list_tail;
+    nufr_os_tick_count = saved_tick_count;
+
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    return start;
+}
+
+//! @name      bench_timer_tick_4
+//! @name      bench_timer_tick_32
+//! @name      bench_timer_tick_128
+//
+//! @brief     'bench_timer_tick()' sleeping task counts
+static uint32_t bench_timer_tick_4(unsigned iterations)
+{
+    return bench_timer_tick(iterations, 4);
+}
+
+static uint32_t bench_timer_tick_32(unsigned iterations)
+{
+    return bench_timer_tick(iterations, 32);
+}
+
+static uint32_t bench_timer_tick_128(unsigned iterations)
+{
+    return bench_timer_tick(iterations, 128);
+}
+
+//! @name      bench_timer_msg_delivery
+//
+//! @brief     Continuous timer expiry, delivered as a message to the
+//! @brief     partner, which counts it
+//
+//! @details   Partner replies once the count is reached. Per-op time
+//! @details   includes waiting out each timer period.
+static uint32_t bench_timer_msg_delivery(unsigned iterations)
+{
+    nsvc_timer_t *tm;
+    uint32_t      fields;
+    uint32_t      parameter;
+    uint32_t      start;
+
+    tm = nsvc_timer_alloc();
+    UT_ENSURE(NULL != tm);
+
+    tm->mode = NSVC_TMODE_CONTINUOUS;
+    tm->duration = BENCH_TIMER_PERIOD;
+    tm->msg_fields = BENCH_CMD_FIELDS(BENCH_CMD_TIMER_TICK);
+    tm->msg_parameter = iterations;
+    tm->dest_task_id = BENCH_TID_PARTNER;
+    bench_timer_ticks = 0;
+
+    start = bench_timestamp();
+    nsvc_timer_start(tm);
+    nufr_msg_getW(&fields, &parameter);
+    start = bench_timestamp() - start;
+
+    nsvc_timer_kill(tm);
+    nsvc_timer_free(tm);
+
+    return start;
+}
+
+#if NUFR_CS_TIMER_CALLBACK == 1
+//! @name      bench_timer_count
+//
+//! @brief     Hybrid timer callback: count expiry, message driver
+//! @brief     once the count in 'msg_parameter' is reached
+static bool bench_timer_count(nsvc_timer_t *tm)
+{
+    return ++bench_timer_ticks == tm->msg_parameter;
+}
+
+//! @name      bench_timer_callback
+//
+//! @brief     Same as 'bench_timer_msg_delivery()', but counted in
+//! @brief     a hybrid timer's callback
+static uint32_t bench_timer_callback(unsigned iterations)
+{
+    nsvc_timer_t *tm;
+    uint32_t      fields;
+    uint32_t      parameter;
+    uint32_t      start;
+
+    tm = nsvc_timer_alloc();
+    UT_ENSURE(NULL != tm);
+
+    tm->mode = NSVC_TMODE_CONTINUOUS;
+    tm->duration = BENCH_TIMER_PERIOD;
+    tm->delivery = NSVC_TDELIVERY_HYBRID;
+    tm->callback = bench_timer_count;
+    tm->msg_fields = BENCH_CMD_FIELDS(BENCH_CMD_TIMER_TICK);
+    tm->msg_parameter = iterations;
+    tm->dest_task_id = BENCH_TID_DRIVER;
+    bench_timer_ticks = 0;
+
+    start = bench_timestamp();
+    nsvc_timer_start(tm);
+    nufr_msg_getW(&fields, &parameter);
+    start = bench_timestamp() - start;
+
+    nsvc_timer_kill(tm);
+    nsvc_timer_free(tm);
+
+    return start;
+}
+#endif  // NUFR_CS_TIMER_CALLBACK
+
+#if NUFR_CS_TASK_PERIOD == 1
+//! @name      bench_period_wait
+//
+//! @brief     Driver as a 1 tick periodic task: nufr_period_waitW()
+//! @brief     sleeps, the tick wakes it
+//
+//! @details   Per-op time includes waiting out each tick. Overruns,
+//! @details   if any, must skip periods, not shift the grid.
+static uint32_t bench_period_wait(unsigned iterations)
+{
+    nufr_period_t period;
+    uint32_t      first_deadline;
+    uint32_t      start;
+    unsigned      i;
+
+    nufr_period_init(&period, 1);
+    first_deadline = period.next_deadline;
+
+    start = bench_timestamp();
+    for (i = 0; i < iterations; i++)
+    {
+        (void)nufr_period_waitW(&period, NUFR_MSG_PRI_MID);
+    }
+    start = bench_timestamp() - start;
+
+    UT_ENSURE(period.next_deadline - first_deadline ==
+              iterations + period.missed_periods);
+
+    return start;
+}
+#endif  // NUFR_CS_TASK_PERIOD
+
+//! @name      bench_report
+//
+//! @brief     Writes one CSV line
+static void bench_report(const char *name, const bench_result_t *result)
+{
+    char line[100];
+
+    rutils_sprintf(line, sizeof(line), "%s,%s,%u,%u,%s,%u,%u,%u\n",
+                   bench_platform_name, name,
+                   (unsigned)BENCH_ITERATIONS, (unsigned)BENCH_ROUNDS,
+                   bench_timestamp_units,
+                   (unsigned)result->min,
+                   (unsigned)(result->sum / BENCH_ROUNDS),
+                   (unsigned)result->max);
+    bench_output(line);
+}
+
+//! @name      bench_run
+//
+//! @brief     Runs one benchmark for all rounds, reports it
+//
+//! @param[in] 'name'-- CSV 'benchmark' column
+//! @param[in] 'fcn_ptr'-- times one round
+//! @param[in] 'ops_per_iteration'-- divides round time into per-op time
+static void bench_run(const char     *name,
+                      bench_fcn_ptr_t fcn_ptr,
+                      unsigned        ops_per_iteration)
+{
+    bench_result_t result;
+    uint32_t       per_op;
+    unsigned       round;
+
+    result.min = 0xFFFFFFFF;
+    result.max = 0;
+    result.sum = 0;
+
+    // Warm-up round, not counted
+    (void)fcn_ptr(BENCH_ITERATIONS);
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        per_op = fcn_ptr(BENCH_ITERATIONS) /
+                             (BENCH_ITERATIONS * ops_per_iteration);
+
+        result.min = per_op < result.min? per_op : result.min;
+        result.max = per_op > result.max? per_op : result.max;
+        result.sum += per_op;
+    }
+
+    bench_report(name, &result);
+}
+
+//! @name      bench_init
+//
+//! @brief     Sets up the benchmark pool and sema
+static void bench_init(void)
+{
+    bool alloc_rv;
+
+    bench_pool.base_ptr = bench_elements;
+    bench_pool.pool_size = BENCH_POOL_SIZE;
+    bench_pool.element_size = sizeof(bench_element_t);
+    bench_pool.element_index_size = (unsigned)((uint8_t *)&bench_elements[1] -
+                                        (uint8_t *)&bench_elements[0]);
+    bench_pool.flink_offset = OFFSETOF(bench_element_t, flink);
+    nsvc_pool_init(&bench_pool);
+
+#if NUFR_CS_POOL_BULK == 1
+    bench_zeroed_pool.base_ptr = bench_zeroed_elements;
+    bench_zeroed_pool.pool_size = BENCH_BULK_POOL_SIZE;
+    bench_zeroed_pool.element_size = sizeof(bench_big_element_t);
+    bench_zeroed_pool.element_index_size = sizeof(bench_big_element_t);
+    bench_zeroed_pool.flink_offset = OFFSETOF(bench_big_element_t, flink);
+    bench_lazy_pool = bench_zeroed_pool;
+    bench_lazy_pool.base_ptr = bench_lazy_elements;
+    bench_lazy_pool.zero_size = OFFSETOF(bench_big_element_t, data);
+    nsvc_pool_init(&bench_zeroed_pool);
+    nsvc_pool_init(&bench_lazy_pool);
+#endif  // NUFR_CS_POOL_BULK
+
+    alloc_rv = nsvc_sema_pool_alloc(&bench_sema);
+    UT_REQUIRE(alloc_rv);
+    UNUSED_BY_ASSERT(alloc_rv);
+
+    // Binary sema, no priority inversion protection
+    nufrkernel_sema_reset(NUFR_SEMA_ID_TO_BLOCK(bench_sema), 1, false);
+}
+
+//! @name      bench_driver_entry
+//
+//! @brief     Runs all benchmarks, then calls 'bench_done()'
+void bench_driver_entry(unsigned parm)
+{
+    UNUSED(parm);
+
+    bench_init();
+
+    nufr_launch_task(BENCH_TID_PARTNER, 0);
+    nufr_launch_task(BENCH_TID_PEER, 0);
+
+    bench_output("platform,benchmark,iterations,rounds,units,min,avg,max\n");
+
+    bench_run("ctx_switch", bench_ctx_switch, 2);
+    bench_run("msg_round_trip", bench_msg_round_trip, 1);
+    bench_run("msg_send_loop", bench_msg_send_loop, BENCH_MSG_BURST);
+    bench_run("msg_send_batch", bench_msg_send_batch, BENCH_MSG_BURST);
+    bench_run("bop_wake", bench_bop_wake, 1);
+    bench_run("bop_ping_pong", bench_bop_ping_pong, 1);
+    bench_run("sema_uncontended", bench_sema_uncontended, 1);
+    bench_run("sema_contended", bench_sema_contended, 1);
+    bench_run("mutex_uncontended", bench_mutex_uncontended, 1);
+    bench_run("mutex_contended", bench_mutex_contended, 1);
+    bench_run("mutex_readers", bench_mutex_readers, 1);
+    bench_run("rwlock_readers", bench_rwlock_readers, 1);
+    bench_run("pool_alloc_free", bench_pool_alloc_free, 1);
+#if NUFR_CS_POOL_BULK == 1
+    bench_run("pool_1k_alloc_free", bench_pool_1k_alloc_free, 1);
+    bench_run("pool_bulk_1", bench_pool_bulk_1, 1);
+    bench_run("pool_bulk_8", bench_pool_bulk_8, 8);
+    bench_run("pool_bulk_32", bench_pool_bulk_32, 32);
+#endif
+    bench_run("pcl_chain_alloc_free", bench_pcl_chain, 1);
+    bench_run("timer_start_kill", bench_timer_start_kill, 1);
+    bench_run("timer_tick_4", bench_timer_tick_4, 1);
+    bench_run("timer_tick_32", bench_timer_tick_32, 1);
+    bench_run("timer_tick_128", bench_timer_tick_128, 1);
+    bench_run("timer_msg_delivery", bench_timer_msg_delivery, 1);
+#if NUFR_CS_TIMER_CALLBACK == 1
+    bench_run("timer_callback", bench_timer_callback, 1);
+#endif
+#if NUFR_CS_TASK_PERIOD == 1
+    bench_run("period_wait", bench_period_wait, 1);
+#endif
+
+    bench_done();
+}
+
+//! @name      bench_partner_entry
+//
+//! @brief     Higher priority than driver. Serves ECHO, BOP_WAIT,
+//! @brief     TIMER_TICK and the WRITE commands.
+void bench_partner_entry(unsigned parm)
+{
+    uint32_t fields;
+    uint32_t parameter;
+    unsigned i;
+
+    UNUSED(parm);
+
+    while (1)
+    {
+        nufr_msg_getW(&fields, &parameter);
+
+        switch (NUFR_GET_MSG_ID(fields))
+        {
+        case BENCH_CMD_ECHO:
+            // Reply to all until told to stop with a 0
+            while (0 != parameter)
+            {
+                bench_send_cmd(BENCH_CMD_ECHO, parameter, BENCH_TID_DRIVER);
+                nufr_msg_getW(&fields, &parameter);
+            }
+            break;
+
+        case BENCH_CMD_BOP_WAIT:
+            for (i = 0; i < parameter; i++)
+            {
+                nufr_bop_waitW(NUFR_MSG_PRI_MID);
+            }
+            break;
+
+        case BENCH_CMD_WRITE_RWLOCK:
+            nsvc_rwlock_write_getW(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID);
+            nsvc_rwlock_write_release(NSVC_RWLOCK_1);
+            break;
+
+        case BENCH_CMD_WRITE_MUTEX:
+            nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID);
+            nsvc_mutex_release(NSVC_MUTEX_1);
+            break;
+
+        case BENCH_CMD_TIMER_TICK:
+            // Reply once, on reaching count. Stragglers are dropped.
+            if (++bench_timer_ticks == parameter)
+            {
+                bench_send_cmd(BENCH_CMD_TIMER_TICK, parameter,
+                               BENCH_TID_DRIVER);
+            }
+            break;
+
+        default:
+            UT_ENSURE(false);
+            break;
+        }
+    }
+}
+
+//! @name      bench_peer_entry
+//
+//! @brief     Same priority as driver. Serves YIELD, BOP_PONG, SEMA,
+//! @brief     MUTEX and the READ commands.
+void bench_peer_entry(unsigned parm)
+{
+    uint32_t fields;
+    uint32_t parameter;
+    unsigned i;
+
+    UNUSED(parm);
+
+    while (1)
+    {
+        nufr_msg_getW(&fields, &parameter);
+
+        switch (NUFR_GET_MSG_ID(fields))
+        {
+        case BENCH_CMD_YIELD:
+            for (i = 0; i < parameter; i++)
+            {
+                nufr_yield();
+            }
+            break;
+
+        case BENCH_CMD_BOP_PONG:
+            for (i = 0; i < parameter; i++)
+            {
+                nufr_bop_waitW(NUFR_MSG_PRI_MID);
+                nufr_bop_send_with_key_override(BENCH_TID_DRIVER);
+            }
+            break;
+
+        case BENCH_CMD_SEMA:
+            for (i = 0; i < parameter; i++)
+            {
+                nufr_sema_getW(bench_sema, NUFR_MSG_PRI_MID);
+                nufr_sema_release(bench_sema);
+            }
+            break;
+
+        case BENCH_CMD_MUTEX:
+            for (i = 0; i < parameter; i++)
+            {
+                nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID);
+                nsvc_mutex_release(NSVC_MUTEX_1);
+            }
+            break;
+
+        case BENCH_CMD_READ_RWLOCK:
+        case BENCH_CMD_READ_MUTEX:
+            for (i = 0; i < parameter; i++)
+            {
+                bench_read_section(BENCH_CMD_READ_RWLOCK ==
+                                   NUFR_GET_MSG_ID(fields));
+            }
+            bench_peer_busy = false;
+            break;
+
+        default:
+            UT_ENSURE(false);
+            break;
+        }
+    }
+}
+
+#endif  //NUFR_BENCH
@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     nufr-bench.h
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief   Kernel micro-benchmarks
+//!
+//! @details Platform-independent. The app supplies the task table (see
+//! @details BENCH_TID_*), the hooks below, and defines NUFR_BENCH to 1
+//! @details in its nufr-platform-app.h.
+//! @details
+//! @details Results are written as CSV, one line per benchmark:
+//! @details   platform,benchmark,iterations,rounds,units,min,avg,max
+//! @details 'min', 'avg', 'max' are per operation, over all rounds.
+//!
+
+#ifndef NUFR_BENCH_H
+#define NUFR_BENCH_H
+
+#include "nufr-global.h"
+#include "nufr-platform-app.h"
+
+//!
+//! @name      BENCH_ITERATIONS
+//! @name      BENCH_ROUNDS
+//!
+//! @details   Operations timed per round, and rounds per benchmark.
+//! @details   A round must complete before 'bench_timestamp()' wraps.
+//!
+#ifndef BENCH_ITERATIONS
+    #define BENCH_ITERATIONS          1000
+#endif
+#ifndef BENCH_ROUNDS
+    #define BENCH_ROUNDS                 5
+#endif
+
+//!
+//! @name      BENCH_TID_DRIVER
+//! @name      BENCH_TID_PARTNER
+//! @name      BENCH_TID_PEER
+//!
+//! @details   Task roles. App must define these in its task table:
+//! @details   'DRIVER'-- runs the benchmarks, 'bench_driver_entry'.
+//! @details       App launches it once the OS is up.
+//! @details   'PARTNER'-- higher priority than the driver,
+//! @details       'bench_partner_entry'.
+//! @details   'PEER'-- same priority as the driver, 'bench_peer_entry'.
+//! @details   PARTNER and PEER are launched by the driver.
+//!
+
+//  Task entry points
+RAGING_EXTERN_C_START
+void bench_driver_entry(unsigned parm);
+void bench_partner_entry(unsigned parm);
+void bench_peer_entry(unsigned parm);
+
+//  Supplied by the app
+uint32_t bench_timestamp(void);
+void bench_output(const char *text);
+void bench_done(void);
+RAGING_EXTERN_C_END
+
+//  Supplied by the app: platform column, and 'bench_timestamp()' units
+extern const char bench_platform_name[];
+extern const char bench_timestamp_units[];
+
+#endif  //NUFR_BENCH_H
@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     bench-main.c
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief    Kernel micro-benchmarks on the PC simulation
+//!
+//! @details  Runs on the coroutine backend: all tasks share one host
+//! @details  thread, so numbers are kernel path plus a ucontext switch,
+//! @details  free of host scheduler noise. Times are host nanosecs.
+//! @details  CSV goes to stdout.
+//!
+
+#define EXIT_SUCCESS 0
+
+#include "nufr-global.h"
+#include "nufr-platform.h"
+#include "nufr-api.h"
+#include "nufr-bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if NUFR_CS_SIM_COROUTINE == 0
+    #error "Benchmarks need NUFR_CS_SIM_COROUTINE"
+#endif
+
+int ut_interrupt_count;
+
+const char bench_platform_name[] = "pc-coroutine";
+const char bench_timestamp_units[] = "ns";
+
+//! @name      bench_timestamp
+//
+//! @brief     Host monotonic nanosecs. Wraps every 4.29 secs.
+uint32_t bench_timestamp(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull +
+                      (uint64_t)ts.tv_nsec);
+}
+
+//! @name      bench_output
+void bench_output(const char *text)
+{
+    fputs(text, stdout);
+}
+
+//! @name      bench_done
+//
+//! @brief     Called from driver task. Simulation doesn't return, so exit.
+void bench_done(void)
+{
+    fflush(stdout);
+    exit(EXIT_SUCCESS);
+}
+
+//! @name      bench_background_task
+//
+//! @brief     BG task: launches driver, then idles
+void *bench_background_task(void *void_ptr)
+{
+    UNUSED(void_ptr);
+
+    nufr_launch_task(BENCH_TID_DRIVER, 0);
+
+    while (1)
+    {
+        nufr_sim_idle();
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    // Run until 'bench_done()'
+    nufr_sim_stop_ticks = 0;
+
+    nufr_sim_entry(bench_background_task, NULL);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     bench-app.c
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief    QEMU hooks for the kernel benchmarks (QEMU_PROJECT 3)
+//!
+//! @details  CSV goes out over ARM semihosting, so QEMU must be run
+//! @details  with '-semihosting'. Times are core clock cycles, read
+//! @details  from SysTick. Run QEMU with '-icount' for repeatable
+//! @details  numbers.
+//!
+
+#include "nufr-global.h"
+#include "nufr-api.h"
+#include "nufr-platform-app.h"
+
+#if QEMU_PROJECT == 3
+
+#include "nufr-bench.h"
+
+// SysTick reload and current value registers
+#define BENCH_SYST_RVR     (*(volatile uint32_t *)0xE000E014)
+#define BENCH_SYST_CVR     (*(volatile uint32_t *)0xE000E018)
+
+// Semihosting operations
+#define BENCH_SYS_WRITE0                 0x04
+#define BENCH_SYS_EXIT                   0x18
+#define BENCH_ADP_STOPPED_APP_EXIT       0x20026
+
+const char bench_platform_name[] = "qemu-lm3s6965";
+const char bench_timestamp_units[] = "cycles";
+
+//! @name      bench_semihost
+//
+//! @brief     Semihosting call
+static int bench_semihost(int operation, const void *argument)
+{
+    register int         r0 __asm__("r0") = operation;
+    register const void *r1 __asm__("r1") = argument;
+
+    __asm__ volatile ("bkpt 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+
+    return r0;
+}
+
+//! @name      bench_timestamp
+//
+//! @brief     Cycles since boot, from the OS tick count and SysTick.
+//
+//! @details   Re-reads if a tick lands between the two reads.
+uint32_t bench_timestamp(void)
+{
+    uint32_t reload = BENCH_SYST_RVR;
+    uint32_t ticks;
+    uint32_t current;
+
+    do
+    {
+        ticks = nufr_tick_count_get();
+        current = BENCH_SYST_CVR;
+    } while (ticks != nufr_tick_count_get());
+
+    // SysTick counts down
+    return ticks * (reload + 1) + (reload - current);
+}
+
+//! @name      bench_output
+void bench_output(const char *text)
+{
+    (void)bench_semihost(BENCH_SYS_WRITE0, text);
+}
+
+//! @name      bench_done
+//
+//! @brief     Stops QEMU
+void bench_done(void)
+{
+    (void)bench_semihost(BENCH_SYS_EXIT,
+                         (const void *)BENCH_ADP_STOPPED_APP_EXIT);
+
+    while (1)
+    {
+    }
+}
+
+#endif  //QEMU_PROJECT
@@ -107,6 +107,13 @@ int main()
     // Call after nsvc_init()
     nsvc_timer_init(nufrplat_systick_get_reference_time, NULL);
 
+#if QEMU_PROJECT == 3
+    // Benchmarks allocate particle chains, and take locks
+    nsvc_pcl_init();
+    nsvc_mutex_init();
+    nsvc_rwlock_init();
+#endif
+
     // SysTick's priority should be the same or greater than PendSV's in
     //  order to guarantee tail chaining on context switches triggered
     //  by SysTick.
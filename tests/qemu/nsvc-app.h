@@ -63,6 +63,18 @@ typedef enum
 
 #define NSVC_NUM_MUTEX      (NSVC_MUTEX_max - 1)
 
+//!
+//! @enum     SL Reader-writer locks
+//!
+typedef enum
+{
+    NSVC_RWLOCK_null = 0,
+    NSVC_RWLOCK_1,
+    NSVC_RWLOCK_max
+} nsvc_rwlock_t;
+
+#define NSVC_NUM_RWLOCK     (NSVC_RWLOCK_max - 1)
+
 //!
 //! @enum      nsvc_tm_divisor_t
 //!
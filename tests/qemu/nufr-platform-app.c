@@ -91,4 +91,29 @@ const nufr_task_desc_t nufr_task_desc[NUFR_NUM_TASKS] = {
     {"task 03", entry_state_task, Stack_state_task, STACK_SIZE, NUFR_TPR_NOMINAL, 0},
 };
 
+// kernel benchmarks
+#elif QEMU_PROJECT == 3
+
+#include "nufr-bench.h"
+
+//!
+//!  @brief       Task stacks
+//!
+#define STACK_SIZE 256
+uint32_t Stack_driver[STACK_SIZE / BYTES_PER_WORD32];
+uint32_t Stack_partner[STACK_SIZE / BYTES_PER_WORD32];
+uint32_t Stack_peer[STACK_SIZE / BYTES_PER_WORD32];
+
+
+//!
+//!  @brief       Task descriptors
+//!
+//!  @details     Partner must be higher priority than driver, peer the same
+//!
+const nufr_task_desc_t nufr_task_desc[NUFR_NUM_TASKS] = {
+    {"driver", bench_driver_entry, Stack_driver, STACK_SIZE, NUFR_TPR_NOMINAL, 0},
+    {"partner", bench_partner_entry, Stack_partner, STACK_SIZE, NUFR_TPR_HIGH, 0},
+    {"peer", bench_peer_entry, Stack_peer, STACK_SIZE, NUFR_TPR_NOMINAL, 0},
+};
+
 #endif
\ No newline at end of file
@@ -38,9 +38,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-kernel-base-task.h"
 
 
-//#define QEMU_PROJECT   1
-// Knight Rider on by default
-#define QEMU_PROJECT   2
+// 1: sleeper, 2: Knight Rider, 3: kernel benchmarks (tests/bench)
+// Knight Rider on by default. Build may override.
+#ifndef QEMU_PROJECT
+    #define QEMU_PROJECT   2
+#endif
 
 
 //!
@@ -73,6 +75,22 @@ typedef enum
     NUFR_TID_max          // not a task, do not change
 } nufr_tid_t;
 
+#elif QEMU_PROJECT == 3
+typedef enum
+{
+    NUFR_TID_null = 0,    // not a task, do not change
+    NUFR_TID_01,
+    NUFR_TID_02,
+    NUFR_TID_03,
+    NUFR_TID_max          // not a task, do not change
+} nufr_tid_t;
+
+// Builds in nufr-bench.c. main() launches the driver.
+#define NUFR_BENCH                  1
+#define BENCH_TID_DRIVER            NUFR_TID_01
+#define BENCH_TID_PARTNER           NUFR_TID_02
+#define BENCH_TID_PEER              NUFR_TID_03
+
 #else
     #error "Invalid QEMU_PROJECT value!!!"
 #endif
@@ -124,7 +142,7 @@ typedef enum
 {
     NUFR_SEMA_null = 0,  // not a sema, do not change
     NUFR_SEMA_POOL_START,      // fixed enum name, used by SL
-    NUFR_SEMA_POOL_END = NUFR_SEMA_POOL_START + 2,  // fixed too
+    NUFR_SEMA_POOL_END = NUFR_SEMA_POOL_START + 6,  // fixed too
     NUFR_SEMA_max        // not a sema, do not change
 } nufr_sema_t;
 
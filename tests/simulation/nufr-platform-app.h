@@ -109,6 +109,22 @@ typedef enum
 //!
 #define NUFR_MAX_MSGS                        10
 
+//!
+//! @name     NUFR_MAX_PAYLOAD_MSGS
+//!
+//! @brief    Size of inline-payload message block pool
+//! @brief    Mandatory definition if NUFR_CS_MSG_PAYLOAD is set
+//!
+#define NUFR_MAX_PAYLOAD_MSGS                 4
+
+//!
+//! @name     NUFR_MSG_PAYLOAD_SIZE
+//!
+//! @brief    Bytes of payload in an inline-payload message block
+//! @brief    Mandatory definition if NUFR_CS_MSG_PAYLOAD is set
+//!
+#define NUFR_MSG_PAYLOAD_SIZE                16
+
 //!
 //! @brief     Semaphore
 //!
@@ -129,6 +145,19 @@ typedef enum
 
 #define NUFR_SEMA_POOL_SIZE (NUFR_SEMA_POOL_END - NUFR_SEMA_POOL_START + 1)
 
+//!
+//! @brief     Event flag groups
+//!
+typedef enum
+{
+    NUFR_EVENT_null = 0,  // not an event group, do not change
+    NUFR_EVENT_X,
+    NUFR_EVENT_Y,
+    NUFR_EVENT_max        // not an event group, do not change
+} nufr_event_t;
+
+#define NUFR_NUM_EVENTS     (NUFR_EVENT_max - 1)
+
 
 #ifndef NUFR_PLAT_APP_GLOBAL_DEFS
     extern const nufr_task_desc_t nufr_task_desc[NUFR_NUM_TASKS];
@@ -35,6 +35,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nufr-global.h"
 #include "nufr-platform.h"
 
+#if NUFR_CS_SIM_COROUTINE == 1
+    #include <stdio.h>
+    #include <time.h>
+
+// Length of a coroutine simulation run, in OS ticks
+#define SIM_RUN_TICKS        1000
+#endif
 
 
 int ut_interrupt_count;
@@ -42,6 +49,34 @@ int ut_interrupt_count;
 void *sim_background_task(void *void_ptr);
 void *sim_tick(void *void_ptr);
 
+#if NUFR_CS_SIM_COROUTINE == 1
+int main(void)
+{
+    struct timespec start;
+    struct timespec stop;
+    uint64_t        host_ns;
+
+    nufr_sim_stop_ticks = SIM_RUN_TICKS;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    nufr_sim_entry(sim_background_task, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    host_ns = (uint64_t)(stop.tv_sec - start.tv_sec) * 1000000000ull +
+              (uint64_t)stop.tv_nsec - (uint64_t)start.tv_nsec;
+
+    // First line is the same every run; second is host timing
+    printf("ticks %u, virtual ns %llu, switches %u\n",
+           (unsigned)nufr_sim_ticks,
+           (unsigned long long)nufr_sim_virtual_ns,
+           (unsigned)nufr_sim_switch_count);
+    printf("host ms %llu, ns per switch %llu\n",
+           (unsigned long long)(host_ns / 1000000),
+           (unsigned long long)(host_ns / (nufr_sim_switch_count + 1)));
+
+    return EXIT_SUCCESS;
+}
+#else
 int main(void)
 {
 
@@ -53,3 +88,4 @@ int main(void)
 
     return EXIT_SUCCESS;
 }
+#endif  // NUFR_CS_SIM_COROUTINE
@@ -83,8 +83,10 @@ typedef enum
     MSG_ID_CIRCLE,
 } msg_id_t;
 
+#if NUFR_CS_SIM_COROUTINE == 0
 extern sem_t     nufr_sim_os_tick_sem;
 extern sem_t     nufr_sim_bg_sem;
+#endif
 
 uint16_t         bops_key1;
 uint16_t         bops_key2;
@@ -1132,6 +1134,22 @@ void entry_03(unsigned parm)
 
       gmtime_s(&s, &t);
 #endif
+#if NUFR_CS_SIM_COROUTINE == 1
+void *sim_background_task(void *void_ptr)
+{
+    UNUSED(void_ptr);
+
+    nufr_launch_task(NUFR_TID_01, 0);
+
+    // Only runs when no task is ready: skip ahead to next tick
+    while (1)
+    {
+        nufr_sim_idle();
+    }
+
+    return NULL;
+}
+#else
 void *sim_background_task(void *void_ptr)
 {
     int rv;
@@ -1188,6 +1206,11 @@ void *sim_background_task(void *void_ptr)
             //break;
         }
 
+    #if NUFR_CS_TICKLESS_IDLE == 1
+        // Nothing for BG to do: idle until next timer deadline
+        nufrplat_tickless_idle();
+    #endif
+
         // TBD
     }
 
@@ -1253,10 +1276,15 @@ void *sim_tick(void *void_ptr)
         if (!disable_systick)
         {
             systick_active = true;
+        #if NUFR_CS_TICKLESS_IDLE == 1
+            nufrplat_sim_oneshot_clock();
+        #else
             nufrplat_systick_handler();
+        #endif
             systick_active = false;
         }
     }
 
     return NULL;
-}
\ No newline at end of file
+}
+#endif  // NUFR_CS_SIM_COROUTINE
\ No newline at end of file
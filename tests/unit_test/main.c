@@ -34,6 +34,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 int ut_interrupt_count;
 
 CU_ErrorCode ut_setup_ready_list_tests(void);
+CU_ErrorCode ut_setup_kernel_timer_tests(void);
+CU_ErrorCode ut_setup_kernel_event_tests(void);
+CU_ErrorCode ut_setup_kernel_messaging_tests(void);
+CU_ErrorCode ut_setup_kernel_semaphore_tests(void);
+CU_ErrorCode ut_setup_kernel_diag_tests(void);
+CU_ErrorCode ut_setup_kernel_time_slice_tests(void);
+CU_ErrorCode ut_setup_nsvc_tests(void);
 
 
 
@@ -49,6 +56,34 @@ int main(int argc, char *arg[])
     if (CUE_SUCCESS == result)
     {
         result = ut_setup_ready_list_tests();
+        if (CUE_SUCCESS == result)
+        {
+            result = ut_setup_kernel_timer_tests();
+        }
+        if (CUE_SUCCESS == result)
+        {
+            result = ut_setup_kernel_event_tests();
+        }
+        if (CUE_SUCCESS == result)
+        {
+            result = ut_setup_kernel_messaging_tests();
+        }
+        if (CUE_SUCCESS == result)
+        {
+            result = ut_setup_kernel_semaphore_tests();
+        }
+        if (CUE_SUCCESS == result)
+        {
+            result = ut_setup_kernel_diag_tests();
+        }
+        if (CUE_SUCCESS == result)
+        {
+            result = ut_setup_kernel_time_slice_tests();
+        }
+        if (CUE_SUCCESS == result)
+        {
+            result = ut_setup_nsvc_tests();
+        }
      
         ut_kernel_timer_tests();   
         ut_kernel_semaphore_tests();
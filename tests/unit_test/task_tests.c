@@ -26,11 +26,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <task_tests.h>
 #include <inttypes.h>
+#include <string.h>
 #include <nufr-kernel-message-blocks.h>
 
 void ut_clean_list(void)
 {
     nufr_ready_list = nufr_ready_list_tail = nufr_ready_list_tail_nominal = NULL;
+#if NUFR_CS_READY_LIST_BITMAP == 1
+    nufr_ready_list_bitmap = 0;
+    memset(nufr_ready_list_heads, 0, sizeof(nufr_ready_list_heads));
+    memset(nufr_ready_list_tails, 0, sizeof(nufr_ready_list_tails));
+#endif
     memset(nufr_tcb_block, 0, sizeof(nufr_tcb_block));
 
     nufr_msg_free_head = nufr_msg_free_tail = NULL;
@@ -1123,7 +1129,12 @@ void ut_exit_running_task_with_semaphore(void)
     // When Task 1 exits, it'll context swith in the 
     // middle of the exit, and UT environment can't
     // handle that.
+#if NUFR_CS_READY_LIST_BITMAP == 1
+    // Priority level bookkeeping must follow the poke
+    nufrkernel_reprioritize_head_task(NUFR_TPR_NOMINAL);
+#else
     task_2->priority = NUFR_TPR_NOMINAL;
+#endif
 
     // Better to call 'nufrkernel_block_running_task()' before
     //   'nufrkernel_sema_link_task()', as flink is shared between
@@ -1444,6 +1455,7 @@ CU_ErrorCode ut_setup_ready_list_tests(void)
             CU_cleanup_registry();
             result = CU_get_error();
         }
+
     }
     else
     {
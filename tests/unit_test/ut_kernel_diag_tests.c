@@ -0,0 +1,248 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <CUnit/CUnit.h>
+#include <string.h>
+#include <test_helper.h>
+#include <nufr-platform.h>
+#include <nufr-platform-app.h>
+#include <nufr-api.h>
+#include <nufr-kernel-task.h>
+#include <nufr-kernel-trace.h>
+#include <nufr-kernel-lock-profile.h>
+
+#define DIAG_TEST_SUITE            "Kernel Diagnostics Test Suite"
+
+#if NUFR_CS_TASK_STATS == 1
+void ut_task_stats(void)
+{
+    ut_clean_list();
+    nufr_tcb_t        *task_1 = &nufr_tcb_block[0];
+    nufr_tcb_t        *task_2 = &nufr_tcb_block[1];
+    nufr_task_stats_t  stats;
+
+    memset(&nufr_bg_stats, 0, sizeof(nufr_bg_stats));
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    nufrplat_sim_timestamp = 1000;
+    nufr_task_stats_timestamp = 1000;
+
+    // BG preempted by task 1
+    nufrplat_sim_timestamp = 1100;
+    nufrkernel_task_stats_switch(nufr_running, task_1);
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(100 == nufr_bg_stats.run_time);
+    CU_ASSERT_TRUE(1 == nufr_bg_stats.preemptions);
+    CU_ASSERT_TRUE(1 == task_1->stats.switch_ins);
+
+    // Task 1 blocks, task 2 runs
+    nufrplat_sim_timestamp = 1150;
+    task_1->block_flags = NUFR_TASK_BLOCKED_ASLEEP;
+    nufrkernel_task_stats_switch(nufr_running, task_2);
+    nufr_running = task_2;
+    CU_ASSERT_TRUE(50 == task_1->stats.run_time);
+    CU_ASSERT_TRUE(1 == task_1->stats.blocks);
+    CU_ASSERT_TRUE(0 == task_1->stats.preemptions);
+
+    // Task 2 switched out while ready, BG runs
+    nufrplat_sim_timestamp = 1170;
+    nufrkernel_task_stats_switch(nufr_running, NULL);
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    CU_ASSERT_TRUE(20 == task_2->stats.run_time);
+    CU_ASSERT_TRUE(1 == task_2->stats.preemptions);
+    CU_ASSERT_TRUE(1 == nufr_bg_stats.switch_ins);
+
+    // Not a switch
+    nufrkernel_task_stats_switch(nufr_running, NULL);
+    CU_ASSERT_TRUE(1 == nufr_bg_stats.switch_ins);
+
+    // Snapshot of running task includes time up to now
+    nufrplat_sim_timestamp = 1200;
+    CU_ASSERT_TRUE(nufr_task_stats_get(NUFR_TID_null, &stats));
+    CU_ASSERT_TRUE(130 == stats.run_time);
+    CU_ASSERT_TRUE(100 == nufr_bg_stats.run_time);
+    CU_ASSERT_TRUE(nufr_task_stats_get(NUFR_TID_01, &stats));
+    CU_ASSERT_TRUE(50 == stats.run_time);
+    CU_ASSERT_TRUE(1 == stats.switch_ins);
+    CU_ASSERT_FALSE(nufr_task_stats_get((nufr_tid_t)(NUFR_NUM_TASKS + 1), &stats));
+
+    // Timestamp wrap
+    nufr_task_stats_timestamp = 0xFFFFFFF0;
+    nufrplat_sim_timestamp = 0x10;
+    nufrkernel_task_stats_switch(nufr_running, task_2);
+    CU_ASSERT_TRUE(100 + 0x20 == nufr_bg_stats.run_time);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_TASK_STATS
+
+#if NUFR_CS_TRACE == 1
+void ut_trace_ring(void)
+{
+    ut_clean_list();
+    nufr_tcb_t                   *task_1 = &nufr_tcb_block[0];
+    volatile nufr_trace_record_t *record;
+    unsigned                      i;
+
+    nufr_trace_init();
+    CU_ASSERT_TRUE(NUFR_TRACE_MAGIC == nufr_trace_ring.magic);
+    CU_ASSERT_TRUE(NUFR_TRACE_RECORDS == nufr_trace_ring.capacity);
+    CU_ASSERT_TRUE(sizeof(nufr_trace_record_t) == nufr_trace_ring.record_size);
+    CU_ASSERT_TRUE(0 == nufr_trace_ring.write_index);
+
+    // Ready list insert is traced
+    nufrplat_sim_timestamp = 500;
+    task_1->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    CU_ASSERT_TRUE(1 == nufr_trace_ring.write_index);
+    record = &nufr_trace_ring.records[0];
+    CU_ASSERT_TRUE(1 == record->sequence);
+    CU_ASSERT_TRUE(500 == record->timestamp);
+    CU_ASSERT_TRUE(NUFR_TRACE_READY_INSERT == record->event);
+    CU_ASSERT_TRUE(NUFR_TID_01 == record->tid);
+    CU_ASSERT_TRUE(NUFR_TPR_NOMINAL == record->object_id);
+
+    // Block is traced
+    nufr_running = task_1;
+    nufrkernel_block_running_task(NUFR_TASK_BLOCKED_ASLEEP);
+    record = &nufr_trace_ring.records[1];
+    CU_ASSERT_TRUE(2 == record->sequence);
+    CU_ASSERT_TRUE(NUFR_TRACE_BLOCK == record->event);
+    CU_ASSERT_TRUE(NUFR_TID_01 == record->tid);
+    CU_ASSERT_TRUE(NUFR_TASK_BLOCKED_ASLEEP == record->param);
+
+    // Wrap: oldest records overwritten, sequence shows where
+    for (i = 0; i < NUFR_TRACE_RECORDS; i++)
+    {
+        nufr_trace_write(NUFR_TRACE_BOP_SEND, 0, (uint16_t)i, 0);
+    }
+    record = &nufr_trace_ring.records[1];
+    CU_ASSERT_TRUE(NUFR_TRACE_RECORDS + 2 == record->sequence);
+    CU_ASSERT_TRUE(NUFR_TRACE_RECORDS - 1 == record->object_id);
+    record = &nufr_trace_ring.records[2];
+    CU_ASSERT_TRUE(3 == record->sequence);
+    CU_ASSERT_TRUE(0 == record->object_id);
+
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_TRACE
+
+#if NUFR_CS_LOCK_PROFILE == 1
+void ut_lock_profile(void)
+{
+    nufr_lock_profile_site_t  sites[NUFR_LOCK_PROFILE_SITES];
+    nufr_lock_profile_site_t *site = NULL;
+    nufr_sr_reg_t             saved_psr;
+    nufr_sr_reg_t             nested_psr;
+    unsigned                  lock_line;
+    unsigned                  count;
+    unsigned                  i;
+
+    nufr_lock_profile_reset();
+    nufrplat_sim_timestamp = 1000;
+
+    // Held 100, with a nested lock that isn't a separate hold
+    lock_line = __LINE__ + 1;
+    saved_psr = NUFR_LOCK_INTERRUPTS();
+    nufrplat_sim_timestamp += 40;
+    nested_psr = NUFR_LOCK_INTERRUPTS();
+    nufrplat_sim_timestamp += 20;
+    NUFR_UNLOCK_INTERRUPTS(nested_psr);
+    nufrplat_sim_timestamp += 40;
+    NUFR_UNLOCK_INTERRUPTS(saved_psr);
+
+    count = nufr_lock_profile_get(sites, NUFR_LOCK_PROFILE_SITES);
+    for (i = 0; i < count; i++)
+    {
+        if ((lock_line == sites[i].line) &&
+            (0 == strcmp(__FILE__, sites[i].file)))
+        {
+            site = &sites[i];
+        }
+    }
+    CU_ASSERT_TRUE(NULL != site);
+    if (NULL != site)
+    {
+        CU_ASSERT_TRUE(1 == site->count);
+        CU_ASSERT_TRUE(100 == site->max);
+        // 64..127 is bucket 7
+        CU_ASSERT_TRUE(1 == site->histogram[7]);
+    }
+    CU_ASSERT_TRUE(0 == nufr_lock_profile_overflows);
+
+    // Reset clears everything but reset's own lock
+    nufr_lock_profile_reset();
+    count = nufr_lock_profile_get(sites, NUFR_LOCK_PROFILE_SITES);
+    CU_ASSERT_TRUE(1 == count);
+    CU_ASSERT_TRUE(lock_line != sites[0].line);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_LOCK_PROFILE
+
+CU_ErrorCode ut_setup_kernel_diag_tests(void)
+{
+    CU_pSuite ptrDiagSuite = NULL;
+    CU_ErrorCode result = CUE_SUCCESS;
+
+    ptrDiagSuite = CU_add_suite(DIAG_TEST_SUITE, NULL, NULL);
+    if (NULL != ptrDiagSuite)
+    {
+        CU_pTest outcome = NULL;
+
+    #if NUFR_CS_TASK_STATS == 1
+        outcome = CU_ADD_TEST(ptrDiagSuite, ut_task_stats);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_TASK_STATS
+
+    #if NUFR_CS_TRACE == 1
+        outcome = CU_ADD_TEST(ptrDiagSuite, ut_trace_ring);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_TRACE
+
+    #if NUFR_CS_LOCK_PROFILE == 1
+        outcome = CU_ADD_TEST(ptrDiagSuite, ut_lock_profile);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_LOCK_PROFILE
+    }
+    else
+    {
+        CU_cleanup_registry();
+        result = CU_get_error();
+    }
+    return result;
+}
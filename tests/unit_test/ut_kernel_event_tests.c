@@ -0,0 +1,292 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <CUnit/CUnit.h>
+#include <string.h>
+#include <test_helper.h>
+#include <nufr-platform.h>
+#include <nufr-platform-app.h>
+#include <nufr-api.h>
+#include <nufr-kernel-task.h>
+#include <nufr-kernel-timer.h>
+
+#if NUFR_CS_EVENT == 1
+
+#include <nufr-kernel-event.h>
+
+#define EVENT_TEST_SUITE           "Kernel Event Test Suite"
+
+static void ut_event_clean(void)
+{
+    ut_clean_list();
+    memset(nufr_event_block, 0, sizeof(nufr_event_block));
+    nufr_timer_list = nufr_timer_list_tail = NULL;
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    ut_interrupt_count = 0;
+}
+
+// Puts 'tid' on an event wait list, as nufr_event_waitW() would
+static nufr_tcb_t *ut_event_block_task(nufr_tid_t  tid,
+                                       nufr_tpr_t  priority,
+                                       nufr_event_t event,
+                                       uint32_t    wait_flags,
+                                       unsigned    options)
+{
+    nufr_tcb_t *tcb = NUFR_TID_TO_TCB(tid);
+
+    tcb->priority = priority;
+    tcb->block_flags = NUFR_TASK_BLOCKED_EVENT;
+    tcb->event_block = NUFR_EVENT_ID_TO_BLOCK(event);
+    tcb->event_flags = wait_flags;
+    tcb->event_options = (uint8_t)options;
+    tcb->abort_message_priority = NUFR_MSG_PRI_MID;
+    nufrkernel_event_link_task(tcb->event_block, tcb);
+
+    return tcb;
+}
+
+void ut_event_set_clear(void)
+{
+    ut_event_clean();
+
+    CU_ASSERT_TRUE(0 == nufr_event_get(NUFR_EVENT_X));
+
+    CU_ASSERT_FALSE(nufr_event_set(NUFR_EVENT_X, 0x5));
+    CU_ASSERT_TRUE(0x5 == nufr_event_get(NUFR_EVENT_X));
+    CU_ASSERT_TRUE(0 == nufr_event_get(NUFR_EVENT_Y));
+
+    nufr_event_clear(NUFR_EVENT_X, 0x1);
+    CU_ASSERT_TRUE(0x4 == nufr_event_get(NUFR_EVENT_X));
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+// Waits already satisfied, or with a 0 timeout, don't block
+void ut_event_wait_no_block(void)
+{
+    nufr_tcb_t            *task = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_event_wait_rtn_t  rc;
+    uint32_t               flags;
+
+    ut_event_clean();
+    task->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task);
+    nufr_running = task;
+
+    nufr_event_set(NUFR_EVENT_X, 0x3);
+
+    rc = nufr_event_waitT(NUFR_EVENT_X, 0x5, NUFR_EVENT_WAIT_ANY, &flags,
+                          NUFR_MSG_PRI_MID, 0);
+    CU_ASSERT_TRUE(NUFR_EVENT_WAIT_OK_NO_BLOCK == rc);
+    CU_ASSERT_TRUE(0x1 == flags);
+
+    rc = nufr_event_waitT(NUFR_EVENT_X, 0x5, NUFR_EVENT_WAIT_ALL, &flags,
+                          NUFR_MSG_PRI_MID, 0);
+    CU_ASSERT_TRUE(NUFR_EVENT_WAIT_TIMEOUT == rc);
+    CU_ASSERT_TRUE(0x1 == flags);
+
+    rc = nufr_event_waitW(NUFR_EVENT_X, 0x3,
+                          NUFR_EVENT_WAIT_ALL | NUFR_EVENT_CONSUME, &flags,
+                          NUFR_MSG_PRI_MID);
+    CU_ASSERT_TRUE(NUFR_EVENT_WAIT_OK_NO_BLOCK == rc);
+    CU_ASSERT_TRUE(0x3 == flags);
+    CU_ASSERT_TRUE(0 == nufr_event_get(NUFR_EVENT_X));
+
+    CU_ASSERT_TRUE(task == nufr_ready_list);
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task));
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+// Set checks waiters highest priority first. A consuming waiter
+//  takes its flags before lower priority waiters see them.
+void ut_event_set_wakes_by_priority(void)
+{
+    nufr_tcb_t *task_any_consume;
+    nufr_tcb_t *task_all;
+    nufr_tcb_t *task_any;
+
+    ut_event_clean();
+
+    task_any_consume = ut_event_block_task(NUFR_TID_01, NUFR_TPR_NOMINAL,
+                          NUFR_EVENT_X, 0x1,
+                          NUFR_EVENT_WAIT_ANY | NUFR_EVENT_CONSUME);
+    task_all = ut_event_block_task(NUFR_TID_02, NUFR_TPR_HIGH,
+                          NUFR_EVENT_X, 0x3, NUFR_EVENT_WAIT_ALL);
+    task_any = ut_event_block_task(NUFR_TID_03, NUFR_TPR_LOW,
+                          NUFR_EVENT_X, 0x1, NUFR_EVENT_WAIT_ANY);
+
+    CU_ASSERT_TRUE(task_all == nufr_event_block[0].task_list_head);
+    CU_ASSERT_TRUE(NUFR_BKD_EVENT == nufr_task_running_state(NUFR_TID_01));
+
+    CU_ASSERT_TRUE(nufr_event_set(NUFR_EVENT_X, 0x1));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_any_consume));
+    CU_ASSERT_TRUE(0x1 == task_any_consume->event_flags);
+    CU_ASSERT_TRUE(NULL == task_any_consume->event_block);
+    CU_ASSERT_TRUE(task_any_consume == nufr_ready_list);
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task_all));
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task_any));
+    CU_ASSERT_TRUE(0 == nufr_event_get(NUFR_EVENT_X));
+
+    CU_ASSERT_FALSE(nufr_event_set(NUFR_EVENT_X, 0x2));
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task_all));
+
+    CU_ASSERT_TRUE(nufr_event_set(NUFR_EVENT_X, 0x1));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_all));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_any));
+    CU_ASSERT_TRUE(0x3 == task_all->event_flags);
+    CU_ASSERT_TRUE(0x1 == task_any->event_flags);
+    CU_ASSERT_TRUE(0x3 == nufr_event_get(NUFR_EVENT_X));
+    CU_ASSERT_TRUE(NULL == nufr_event_block[0].task_list_head);
+
+    // Highest priority task now running
+    CU_ASSERT_TRUE(task_all == nufr_ready_list);
+    CU_ASSERT_TRUE(task_all == nufr_running);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+// Timer expiry takes waiter off the wait list
+void ut_event_timeout(void)
+{
+    nufr_tcb_t *task_a;
+    nufr_tcb_t *task_b;
+
+    ut_event_clean();
+
+    task_a = ut_event_block_task(NUFR_TID_01, NUFR_TPR_NOMINAL,
+                                 NUFR_EVENT_Y, 0x1, NUFR_EVENT_WAIT_ANY);
+    task_b = ut_event_block_task(NUFR_TID_02, NUFR_TPR_NOMINAL,
+                                 NUFR_EVENT_Y, 0x1, NUFR_EVENT_WAIT_ANY);
+    nufrkernel_add_to_timer_list(task_a, 2);
+
+    CU_ASSERT_TRUE(NUFR_BKD_EVENT_TOUT == nufr_task_running_state(NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_BKD_EVENT == nufr_task_running_state(NUFR_TID_02));
+
+    nufrkernel_update_task_timers();
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task_a));
+    nufrkernel_update_task_timers();
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_a));
+    CU_ASSERT_TRUE(NUFR_IS_NOTIF_SET(task_a, NUFR_TASK_TIMEOUT));
+    CU_ASSERT_TRUE(NULL == task_a->event_block);
+    CU_ASSERT_TRUE(task_b == nufr_event_block[1].task_list_head);
+    CU_ASSERT_TRUE(NULL == task_b->flink);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+#if NUFR_CS_TASK_KILL == 1
+// Message above waiter's abort priority aborts the wait
+void ut_event_msg_abort(void)
+{
+    nufr_tcb_t          *task;
+    nufr_msg_send_rtn_t  rc;
+
+    ut_event_clean();
+
+    task = ut_event_block_task(NUFR_TID_01, NUFR_TPR_NOMINAL,
+                               NUFR_EVENT_X, 0x1, NUFR_EVENT_WAIT_ANY);
+
+    rc = nufr_msg_send(NUFR_SET_MSG_FIELDS(1, 1, NUFR_TID_02,
+                                           NUFR_MSG_PRI_MID),
+                       0, NUFR_TID_01);
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK == rc);
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task));
+
+    rc = nufr_msg_send(NUFR_SET_MSG_FIELDS(1, 2, NUFR_TID_02,
+                                           NUFR_MSG_PRI_HIGH),
+                       0, NUFR_TID_01);
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_ABORTED_RECEIVER == rc);
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task));
+    CU_ASSERT_TRUE(NUFR_IS_NOTIF_SET(task, NUFR_TASK_UNBLOCKED_BY_MSG_SEND));
+    CU_ASSERT_TRUE(NULL == task->event_block);
+    CU_ASSERT_TRUE(NULL == nufr_event_block[0].task_list_head);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_TASK_KILL
+
+CU_ErrorCode ut_setup_kernel_event_tests(void)
+{
+    CU_pSuite ptrEventSuite = NULL;
+    CU_ErrorCode result = CUE_SUCCESS;
+
+    ptrEventSuite = CU_add_suite(EVENT_TEST_SUITE, NULL, NULL);
+    if (NULL != ptrEventSuite)
+    {
+        CU_pTest outcome = NULL;
+
+        outcome = CU_ADD_TEST(ptrEventSuite, ut_event_set_clear);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+        outcome = CU_ADD_TEST(ptrEventSuite, ut_event_wait_no_block);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+        outcome = CU_ADD_TEST(ptrEventSuite, ut_event_set_wakes_by_priority);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+        outcome = CU_ADD_TEST(ptrEventSuite, ut_event_timeout);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+    #if NUFR_CS_TASK_KILL == 1
+        outcome = CU_ADD_TEST(ptrEventSuite, ut_event_msg_abort);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_TASK_KILL
+    }
+    else
+    {
+        CU_cleanup_registry();
+        result = CU_get_error();
+    }
+    return result;
+}
+
+#else
+
+CU_ErrorCode ut_setup_kernel_event_tests(void)
+{
+    return CUE_SUCCESS;
+}
+
+#endif  // NUFR_CS_EVENT
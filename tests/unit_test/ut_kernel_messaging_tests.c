@@ -24,6 +24,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 // By Chris Martin
+#include <CUnit/CUnit.h>
+#include <string.h>
 #include <test_helper.h>
 #include <nufr-kernel-base-messaging.h>
 #include <nufr-platform.h>
@@ -31,6 +33,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <nufr-api.h>
 #include <nufr-kernel-task.h>
 #include <nufr-kernel-message-send-inline.h>
+#include <nufr-kernel-message-blocks.h>
+#include <nsvc-api.h>
+#include <nsvc.h>
 
 
 
@@ -42,6 +47,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define PARAM_DEFAULT_A               0xFADEDFAD
 #define PARAM_DEFAULT_B               0xFADEDBAD
 
+#define MESSAGING_TEST_SUITE       "Kernel Messaging Test Suite"
+
 
 void ut_nufr_msg_verify_setup(void)
 {
@@ -420,3 +427,831 @@ void ut_kernel_messaging_tests(void)
     ut_clean_list();
 
 }
+
+void ut_msg_getT_after_wait(void)
+{
+    nufr_tcb_t *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_tcb_t *task_2 = NUFR_TID_TO_TCB(NUFR_TID_02);
+    uint32_t    fields;
+    uint32_t    parameter;
+
+    ut_clean_list();
+    // Task 1 heads ready list, so it's the one getT blocks
+    task_1->priority = NUFR_TPR_HIGH;
+    task_2->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufrkernel_add_task_to_ready_list(task_2);
+    nufr_running = task_1;
+
+    // Message already queued
+    nufr_msg_send(NUFR_SET_MSG_FIELDS(1, 1, 0, NUFR_MSG_PRI_MID), 11,
+                  NUFR_TID_01);
+    CU_ASSERT_FALSE(nufr_msg_getT(5, &fields, &parameter));
+    CU_ASSERT_TRUE(11 == parameter);
+
+    // None queued, no wait
+    CU_ASSERT_TRUE(nufr_msg_getT(0, &fields, &parameter));
+
+    // Message there after the wait: not a timeout.
+    // UT context switch only moves 'nufr_running' to the ready list
+    //   head, so it's task 2's queue that's found non-empty.
+    nufr_msg_send(NUFR_SET_MSG_FIELDS(1, 2, 0, NUFR_MSG_PRI_MID), 22,
+                  NUFR_TID_02);
+    CU_ASSERT_FALSE(nufr_msg_getT(5, &fields, &parameter));
+    CU_ASSERT_TRUE(task_2 == nufr_running);
+    CU_ASSERT_TRUE(2 == NUFR_GET_MSG_ID(fields));
+    CU_ASSERT_TRUE(22 == parameter);
+
+    // Task 1's timeout is left running
+    CU_ASSERT_TRUE(nufrkernel_purge_from_timer_list(task_1));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+#if NUFR_CS_MSG_PAYLOAD == 1
+// Inline-payload messages share queues with plain ones, but come
+//  from and return to their own pool.
+void ut_msg_payload(void)
+{
+    nufr_tcb_t *task = NUFR_TID_TO_TCB(NUFR_TID_01);
+    const char  data[NUFR_MSG_PAYLOAD_SIZE] = "0123456789abcdef";
+    char        buffer[NUFR_MSG_PAYLOAD_SIZE];
+    uint32_t    fields;
+    uint32_t    length;
+    unsigned    i;
+
+    ut_clean_list();
+    task->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task);
+    nufr_running = task;
+
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send_payload(NUFR_SET_MSG_FIELDS(1, 1, NUFR_TID_02,
+                                                  NUFR_MSG_PRI_MID),
+                              data, 8, NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send(NUFR_SET_MSG_FIELDS(1, 2, NUFR_TID_02,
+                                          NUFR_MSG_PRI_HIGH),
+                      0x1234, NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS - 1 == nufr_msg_payload_free_count());
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 1 == nufr_msg_free_count());
+
+    // Plain message: parameter out, nothing copied
+    memset(buffer, 0, sizeof(buffer));
+    nufr_msg_payload_getW(&fields, &length, buffer, sizeof(buffer));
+    CU_ASSERT_TRUE(2 == NUFR_GET_MSG_ID(fields));
+    CU_ASSERT_TRUE(0x1234 == length);
+    CU_ASSERT_TRUE(0 == buffer[0]);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+
+    nufr_msg_payload_getW(&fields, &length, buffer, sizeof(buffer));
+    CU_ASSERT_TRUE(1 == NUFR_GET_MSG_ID(fields));
+    CU_ASSERT_TRUE(8 == length);
+    CU_ASSERT_TRUE(0 == memcmp(buffer, data, 8));
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+
+    // Truncated to receiver's buffer
+    memset(buffer, 0, sizeof(buffer));
+    nufr_msg_send_payload(NUFR_SET_MSG_FIELDS(1, 3, NUFR_TID_02,
+                                              NUFR_MSG_PRI_MID),
+                          data, sizeof(data), NUFR_TID_01);
+    CU_ASSERT_FALSE(nufr_msg_payload_getT(0, &fields, &length, buffer, 4));
+    CU_ASSERT_TRUE(sizeof(data) == length);
+    CU_ASSERT_TRUE(0 == memcmp(buffer, data, 4));
+    CU_ASSERT_TRUE(0 == buffer[4]);
+
+    // Pool depletion
+    for (i = 0; i < NUFR_MAX_PAYLOAD_MSGS; i++)
+    {
+        CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+            nufr_msg_send_payload(NUFR_SET_MSG_FIELDS(1, 4, NUFR_TID_02,
+                                                      NUFR_MSG_PRI_LOW),
+                                  data, 1, NUFR_TID_01));
+    }
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_ERROR ==
+        nufr_msg_send_payload(NUFR_SET_MSG_FIELDS(1, 4, NUFR_TID_02,
+                                                  NUFR_MSG_PRI_LOW),
+                              data, 1, NUFR_TID_01));
+
+    // Purge and drain return blocks of either kind to their pool
+    nufr_msg_send(NUFR_SET_MSG_FIELDS(1, 4, NUFR_TID_02, NUFR_MSG_PRI_LOW),
+                  0, NUFR_TID_01);
+    CU_ASSERT_TRUE(2 == nufr_msg_purge(NUFR_SET_MSG_FIELDS(1, 4, 0,
+                                                   NUFR_MSG_PRI_LOW), false) +
+                        nufr_msg_purge(NUFR_SET_MSG_FIELDS(1, 4, 0,
+                                                   NUFR_MSG_PRI_LOW), false));
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS - 2 == nufr_msg_payload_free_count());
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_LOW);
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_MSG_PAYLOAD
+
+#define UT_BATCH_ENTRY(id, pri)                                        \
+    { NUFR_SET_MSG_FIELDS(1, (id), NUFR_TID_02, (pri)), (id) }
+
+// Blocks a task-level sender can get
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+    #define UT_TASK_MSGS   (NUFR_MAX_MSGS - NUFR_MSG_POOL_ISR_RESERVE)
+#else
+    #define UT_TASK_MSGS   NUFR_MAX_MSGS
+#endif
+
+void ut_msg_send_batch(void)
+{
+    nufr_tcb_t *task = NUFR_TID_TO_TCB(NUFR_TID_01);
+    const nufr_msg_batch_entry_t entries[] =
+    {
+        UT_BATCH_ENTRY(1, NUFR_MSG_PRI_MID),
+        UT_BATCH_ENTRY(2, NUFR_MSG_PRI_HIGH),
+        UT_BATCH_ENTRY(3, NUFR_MSG_PRI_MID),
+        UT_BATCH_ENTRY(4, NUFR_MSG_PRI_LOW),
+    };
+    nufr_msg_batch_entry_t many[NUFR_MAX_MSGS + 2];
+    unsigned i;
+
+    ut_clean_list();
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    task->priority = NUFR_TPR_NOMINAL;
+
+    // Blocked receiver woken once, messages queued by priority
+    task->block_flags = NUFR_TASK_BLOCKED_MSG;
+    CU_ASSERT_TRUE(3 == nufr_msg_send_batch(entries, 3, NUFR_TID_01));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task));
+    CU_ASSERT_TRUE(task == nufr_ready_list);
+    CU_ASSERT_TRUE(task == nufr_running);
+    CU_ASSERT_TRUE(2 == task->msg_head1->parameter);
+    CU_ASSERT_TRUE(task->msg_head1 == task->msg_tail1);
+    CU_ASSERT_TRUE(1 == task->msg_head2->parameter);
+    CU_ASSERT_TRUE(3 == task->msg_head2->flink->parameter);
+    CU_ASSERT_TRUE(task->msg_head2->flink == task->msg_tail2);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 3 == nufr_msg_free_count());
+
+    // Appends behind messages already queued
+    CU_ASSERT_TRUE(1 == nufr_msg_send_batch(&entries[2], 1, NUFR_TID_01));
+    CU_ASSERT_TRUE(3 == task->msg_tail2->parameter);
+    CU_ASSERT_TRUE(task->msg_tail2 != task->msg_head2->flink);
+
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+
+    // Highest priority message in batch decides abort
+    ut_clean_list();
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    task->priority = NUFR_TPR_NOMINAL;
+    task->block_flags = NUFR_TASK_BLOCKED_ASLEEP;
+    task->abort_message_priority = NUFR_MSG_PRI_MID;
+    CU_ASSERT_TRUE(2 == nufr_msg_send_batch(&entries[2], 2, NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task));
+    CU_ASSERT_TRUE(2 == nufr_msg_send_batch(&entries[1], 2, NUFR_TID_01));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task));
+    CU_ASSERT_TRUE(NUFR_IS_NOTIF_SET(task, NUFR_TASK_UNBLOCKED_BY_MSG_SEND));
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+
+    // Short bpool: first messages sent
+    for (i = 0; i < NUFR_MAX_MSGS + 2; i++)
+    {
+        many[i].fields = NUFR_SET_MSG_FIELDS(1, 5, NUFR_TID_02,
+                                             NUFR_MSG_PRI_LOW);
+        many[i].parameter = i;
+    }
+    CU_ASSERT_TRUE(UT_TASK_MSGS ==
+                   nufr_msg_send_batch(many, NUFR_MAX_MSGS + 2, NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - UT_TASK_MSGS == nufr_msg_free_count());
+    CU_ASSERT_TRUE(UT_TASK_MSGS - 1 == task->msg_tail3->parameter);
+    CU_ASSERT_TRUE(0 == nufr_msg_send_batch(many, 1, NUFR_TID_01));
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+
+    // Receiver not launched: nothing sent, blocks returned
+    task->block_flags = NUFR_TASK_NOT_LAUNCHED;
+    CU_ASSERT_TRUE(0 == nufr_msg_send_batch(entries, 4, NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NULL == task->msg_head2);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+#if NUFR_CS_MSG_BROADCAST == 1
+void ut_msg_broadcast(void)
+{
+    nufr_tcb_t *task1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_tcb_t *task2 = NUFR_TID_TO_TCB(NUFR_TID_02);
+    nufr_tcb_t *task3 = NUFR_TID_TO_TCB(NUFR_TID_03);
+    const nufr_tid_t   tids[] = { NUFR_TID_01, NUFR_TID_02, NUFR_TID_03 };
+    const char         data[4] = "abcd";
+    char               buffer[NUFR_MSG_PAYLOAD_SIZE];
+    nufr_msg_t        *held[NUFR_MAX_PAYLOAD_MSGS];
+    uint32_t           fields;
+    uint32_t           parameter;
+    unsigned           i;
+    nsvc_msg_lookup_t  route;
+
+    ut_clean_list();
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    task1->priority = NUFR_TPR_NOMINAL;
+    task2->priority = NUFR_TPR_NOMINAL;
+    task3->priority = NUFR_TPR_NOMINAL;
+
+    // One descriptor, no bpool blocks, blocked receiver woken
+    task1->block_flags = NUFR_TASK_BLOCKED_MSG;
+    CU_ASSERT_TRUE(3 == nufr_msg_broadcast(NUFR_SET_MSG_FIELDS(1, 7, 0,
+                                                     NUFR_MSG_PRI_MID),
+                                           0x55, data, sizeof(data),
+                                           tids, 3));
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS - 1 == nufr_msg_payload_free_count());
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task1));
+    CU_ASSERT_TRUE(task1 == nufr_ready_list);
+    CU_ASSERT_TRUE(7 == NUFR_GET_MSG_ID(task3->msg_head2->fields));
+
+    // Receivers share descriptor's parameter and payload
+    nufr_running = task2;
+    memset(buffer, 0, sizeof(buffer));
+    nufr_msg_payload_getW(&fields, &parameter, buffer, sizeof(buffer));
+    CU_ASSERT_TRUE(7 == NUFR_GET_MSG_ID(fields));
+    CU_ASSERT_TRUE(0x55 == parameter);
+    CU_ASSERT_TRUE(0 == memcmp(buffer, data, sizeof(data)));
+    CU_ASSERT_TRUE(0 == task2->bcast_links[0].parameter);
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS - 1 == nufr_msg_payload_free_count());
+
+    // Drained link drops its reference too
+    nufr_msg_drain(NUFR_TID_03, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS - 1 == nufr_msg_payload_free_count());
+
+    // Last receiver frees descriptor
+    nufr_running = task1;
+    nufr_msg_getW(&fields, &parameter);
+    CU_ASSERT_TRUE(0x55 == parameter);
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+
+    // Links exhausted: receiver gets its own blocks, from bpool
+    //   without payload, inline-payload pool with
+    nufr_running = task2;
+    for (i = 1; i <= NUFR_BCAST_LINKS_PER_TASK + 2; i++)
+    {
+        CU_ASSERT_TRUE(1 == nufr_msg_broadcast(NUFR_SET_MSG_FIELDS(1, 8, 0,
+                                                         NUFR_MSG_PRI_LOW),
+                                    i, data,
+                                    i > NUFR_BCAST_LINKS_PER_TASK + 1 ?
+                                                      sizeof(data) : 0,
+                                    &tids[1], 1));
+    }
+    CU_ASSERT_TRUE(2 == nufr_msg_bcast_overflow_count);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 1 == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS - NUFR_BCAST_LINKS_PER_TASK - 1
+                   == nufr_msg_payload_free_count());
+
+    // All arrive, in order
+    for (i = 1; i <= NUFR_BCAST_LINKS_PER_TASK + 2; i++)
+    {
+        memset(buffer, 0, sizeof(buffer));
+        nufr_msg_payload_getW(&fields, &parameter, buffer, sizeof(buffer));
+        CU_ASSERT_TRUE(8 == NUFR_GET_MSG_ID(fields));
+        CU_ASSERT_TRUE(i == parameter);
+    }
+    CU_ASSERT_TRUE(0 == memcmp(buffer, data, sizeof(data)));
+    CU_ASSERT_TRUE(NULL == task2->msg_head3);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+
+    // Receiver not launched
+    task3->block_flags = NUFR_TASK_NOT_LAUNCHED;
+    CU_ASSERT_TRUE(0 == nufr_msg_broadcast(NUFR_SET_MSG_FIELDS(1, 9, 0,
+                                                     NUFR_MSG_PRI_LOW),
+                                           0, NULL, 0, &tids[2], 1));
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+
+    // Multi-destination nsvc send goes through broadcast
+    route.single_tid = NUFR_TID_null;
+    route.tid_list_ptr = tids;
+    route.tid_list_length = 2;
+    CU_ASSERT_TRUE(NSVC_MSRT_OK ==
+        nsvc_msg_send_multi(NUFR_SET_MSG_FIELDS(1, 10, 0, NUFR_MSG_PRI_HIGH),
+                            0x77, &route));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS - 1 == nufr_msg_payload_free_count());
+
+    // Receivers see who sent it
+    nufr_running = task1;
+    nufr_msg_getW(&fields, &parameter);
+    CU_ASSERT_TRUE(10 == NUFR_GET_MSG_ID(fields));
+    CU_ASSERT_TRUE(NUFR_TID_02 == NUFR_GET_MSG_SENDING_TASK(fields));
+    CU_ASSERT_TRUE(0x77 == parameter);
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+
+    // BG task sends as NUFR_TID_null
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    CU_ASSERT_TRUE(NSVC_MSRT_OK ==
+        nsvc_msg_send_multi(NUFR_SET_MSG_FIELDS(1, 11, 0, NUFR_MSG_PRI_HIGH),
+                            0, &route));
+    CU_ASSERT_TRUE(NUFR_TID_null ==
+                   NUFR_GET_MSG_SENDING_TASK(task1->msg_head1->fields));
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+
+    // Receiver out of links still gets it
+    nufr_running = task2;
+    CU_ASSERT_TRUE(1 == nufr_msg_broadcast(NUFR_SET_MSG_FIELDS(1, 8, 0,
+                                                     NUFR_MSG_PRI_LOW),
+                                           1, NULL, 0, &tids[1], 1));
+    CU_ASSERT_TRUE(1 == nufr_msg_broadcast(NUFR_SET_MSG_FIELDS(1, 8, 0,
+                                                     NUFR_MSG_PRI_LOW),
+                                           2, NULL, 0, &tids[1], 1));
+    CU_ASSERT_TRUE(NSVC_MSRT_OK ==
+        nsvc_msg_send_multi(NUFR_SET_MSG_FIELDS(1, 12, 0, NUFR_MSG_PRI_HIGH),
+                            0, &route));
+    CU_ASSERT_TRUE(12 == NUFR_GET_MSG_ID(task1->msg_head1->fields));
+    CU_ASSERT_TRUE(12 == NUFR_GET_MSG_ID(task2->msg_head1->fields));
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+
+    // Inline-payload pool depleted: each receiver gets its own block
+    for (i = 0; i < NUFR_MAX_PAYLOAD_MSGS; i++)
+    {
+        held[i] = nufr_msg_payload_get_block();
+    }
+    route.tid_list_length = 2;
+    CU_ASSERT_TRUE(NSVC_MSRT_OK ==
+        nsvc_msg_send_multi(NUFR_SET_MSG_FIELDS(1, 13, 0, NUFR_MSG_PRI_HIGH),
+                            0, &route));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 2 == nufr_msg_free_count());
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+    for (i = 0; i < NUFR_MAX_PAYLOAD_MSGS; i++)
+    {
+        nufr_msg_free_block(held[i]);
+    }
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NUFR_MAX_PAYLOAD_MSGS == nufr_msg_payload_free_count());
+
+    route.tid_list_ptr = &tids[2];
+    route.tid_list_length = 1;
+    CU_ASSERT_TRUE(NSVC_MSRT_ERROR ==
+        nsvc_msg_send_multi(NUFR_SET_MSG_FIELDS(1, 10, 0, NUFR_MSG_PRI_HIGH),
+                            0x77, &route));
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_MSG_BROADCAST
+
+#if NUFR_CS_MSG_INDEX == 1
+#define UT_INDEX_FIELDS(id, pri)   NUFR_SET_MSG_FIELDS(1, (id), NUFR_TID_02, (pri))
+
+void ut_msg_index(void)
+{
+    nufr_tcb_t *task = NUFR_TID_TO_TCB(NUFR_TID_01);
+    const nufr_msg_index_count_t zeros[NUFR_CS_MSG_PRIORITIES]
+                                      [NUFR_MSG_INDEX_BUCKETS] = { { 0 } };
+    // Same hash bucket as id 1
+    const unsigned collide_id = 1 + NUFR_MSG_INDEX_BUCKETS;
+#if NUFR_CS_MSG_BROADCAST == 1
+    const nufr_tid_t task_id = NUFR_TID_01;
+#endif
+    uint32_t    fields;
+    uint32_t    parameter;
+
+    ut_clean_list();
+    task->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task);
+    nufr_running = task;
+
+    CU_ASSERT_TRUE(NUFR_MSG_INDEX_HASH(UT_INDEX_FIELDS(1, 0)) ==
+                   NUFR_MSG_INDEX_HASH(UT_INDEX_FIELDS(collide_id, 0)));
+
+    nufr_msg_send(UT_INDEX_FIELDS(1, NUFR_MSG_PRI_MID), 0, NUFR_TID_01);
+    nufr_msg_send(UT_INDEX_FIELDS(2, NUFR_MSG_PRI_MID), 0, NUFR_TID_01);
+    nufr_msg_send(UT_INDEX_FIELDS(1, NUFR_MSG_PRI_MID), 0, NUFR_TID_01);
+    nufr_msg_send(UT_INDEX_FIELDS(collide_id, NUFR_MSG_PRI_MID), 0,
+                  NUFR_TID_01);
+    CU_ASSERT_TRUE(3 == NUFR_MSG_INDEX_SLOT(task,
+                            UT_INDEX_FIELDS(1, NUFR_MSG_PRI_MID)));
+
+    // Pending check, including a hash collision and another priority
+    CU_ASSERT_TRUE(nufr_msg_is_pending(NUFR_TID_01,
+                                       UT_INDEX_FIELDS(1, NUFR_MSG_PRI_MID)));
+    CU_ASSERT_TRUE(nufr_msg_is_pending(NUFR_TID_null,
+                                       UT_INDEX_FIELDS(2, NUFR_MSG_PRI_MID)));
+    CU_ASSERT_TRUE(nufr_msg_is_pending(NUFR_TID_01,
+                             UT_INDEX_FIELDS(collide_id, NUFR_MSG_PRI_MID)));
+    CU_ASSERT_FALSE(nufr_msg_is_pending(NUFR_TID_01,
+                                        UT_INDEX_FIELDS(3, NUFR_MSG_PRI_MID)));
+    CU_ASSERT_FALSE(nufr_msg_is_pending(NUFR_TID_01,
+                                        UT_INDEX_FIELDS(1, NUFR_MSG_PRI_LOW)));
+
+    // Coalescing: duplicate dropped, new ID sent
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send_coalesce(UT_INDEX_FIELDS(2, NUFR_MSG_PRI_MID), 0,
+                               NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 4 == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send_coalesce(UT_INDEX_FIELDS(3, NUFR_MSG_PRI_MID), 0,
+                               NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 5 == nufr_msg_free_count());
+
+    // Purge keeps colliding message and index in step
+    CU_ASSERT_TRUE(2 == nufr_msg_purge(UT_INDEX_FIELDS(1, NUFR_MSG_PRI_MID),
+                                       true));
+    CU_ASSERT_TRUE(1 == NUFR_MSG_INDEX_SLOT(task,
+                            UT_INDEX_FIELDS(1, NUFR_MSG_PRI_MID)));
+    CU_ASSERT_FALSE(nufr_msg_is_pending(NUFR_TID_01,
+                                        UT_INDEX_FIELDS(1, NUFR_MSG_PRI_MID)));
+    CU_ASSERT_TRUE(nufr_msg_is_pending(NUFR_TID_01,
+                             UT_INDEX_FIELDS(collide_id, NUFR_MSG_PRI_MID)));
+    CU_ASSERT_TRUE(0 == nufr_msg_purge(UT_INDEX_FIELDS(4, NUFR_MSG_PRI_MID),
+                                       true));
+
+    // Receive
+    nufr_msg_getW(&fields, &parameter);
+    CU_ASSERT_TRUE(2 == NUFR_GET_MSG_ID(fields));
+    CU_ASSERT_FALSE(nufr_msg_is_pending(NUFR_TID_01,
+                                        UT_INDEX_FIELDS(2, NUFR_MSG_PRI_MID)));
+
+    // Drain
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(0 == memcmp(task->msg_index, zeros, sizeof(zeros)));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+
+    // Coalescing matches parameter too
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send_coalesce(UT_INDEX_FIELDS(5, NUFR_MSG_PRI_LOW), 1,
+                               NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send_coalesce(UT_INDEX_FIELDS(5, NUFR_MSG_PRI_LOW), 1,
+                               NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 1 == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send_coalesce(UT_INDEX_FIELDS(5, NUFR_MSG_PRI_LOW), 2,
+                               NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 2 == nufr_msg_free_count());
+#if NUFR_CS_MSG_BROADCAST == 1
+    // ...a broadcast's parameter is in its descriptor
+    CU_ASSERT_TRUE(1 == nufr_msg_broadcast(UT_INDEX_FIELDS(6, NUFR_MSG_PRI_LOW),
+                                           9, NULL, 0, &task_id, 1));
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send_coalesce(UT_INDEX_FIELDS(6, NUFR_MSG_PRI_LOW), 9,
+                               NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 2 == nufr_msg_free_count());
+#endif
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+
+    // Task not launched: block given back
+    task->block_flags = NUFR_TASK_NOT_LAUNCHED;
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_ERROR ==
+        nufr_msg_send_coalesce(UT_INDEX_FIELDS(5, NUFR_MSG_PRI_LOW), 1,
+                               NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    task->block_flags = 0;
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_MSG_INDEX
+
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+#define UT_LIMIT_FIELDS(id, pri)   NUFR_SET_MSG_FIELDS(1, (id), NUFR_TID_02, (pri))
+
+void ut_msg_queue_limit(void)
+{
+    nufr_tcb_t *task = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_tcb_t *task2 = NUFR_TID_TO_TCB(NUFR_TID_02);
+    nufr_tcb_t *waiter3 = NUFR_TID_TO_TCB(NUFR_TID_03);
+    nufr_tcb_t *waiter4 = NUFR_TID_TO_TCB(NUFR_TID_04);
+    nufr_msg_batch_entry_t entries[3];
+    uint32_t    fields;
+    uint32_t    parameter;
+    unsigned    i;
+
+    ut_clean_list();
+    task->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task);
+    nufr_running = task;
+
+    task->msg_queue_limit = 3;
+    task->msg_queue_pri_limit[NUFR_MSG_PRI_HIGH] = 1;
+
+    // Per-priority limit
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send(UT_LIMIT_FIELDS(1, NUFR_MSG_PRI_HIGH), 0, NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_QUEUE_FULL ==
+        nufr_msg_send(UT_LIMIT_FIELDS(2, NUFR_MSG_PRI_HIGH), 0, NUFR_TID_01));
+    CU_ASSERT_TRUE(1 == task->msg_queue_full_count);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 1 == nufr_msg_free_count());
+
+    // Total limit
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send(UT_LIMIT_FIELDS(3, NUFR_MSG_PRI_MID), 0, NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send(UT_LIMIT_FIELDS(4, NUFR_MSG_PRI_MID), 0, NUFR_TID_01));
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_QUEUE_FULL ==
+        nufr_msg_send(UT_LIMIT_FIELDS(5, NUFR_MSG_PRI_LOW), 0, NUFR_TID_01));
+    CU_ASSERT_TRUE(2 == task->msg_queue_full_count);
+    CU_ASSERT_TRUE(3 == task->msg_queue_depth);
+    CU_ASSERT_TRUE(3 == task->msg_queue_hwm);
+    CU_ASSERT_TRUE(1 == task->msg_queue_pri_hwm[NUFR_MSG_PRI_HIGH]);
+    CU_ASSERT_TRUE(2 == task->msg_queue_pri_hwm[NUFR_MSG_PRI_MID]);
+
+    // Space waiters, built by hand: a sender blocked on room at
+    //   high priority, then one on room at low priority
+    waiter3->priority = NUFR_TPR_LOW;
+    waiter3->block_flags = NUFR_TASK_BLOCKED_MSG_SPACE;
+    waiter3->msg_space_dest = task;
+    waiter3->msg_space_priority = NUFR_MSG_PRI_HIGH;
+    waiter4->priority = NUFR_TPR_LOW;
+    waiter4->block_flags = NUFR_TASK_BLOCKED_MSG_SPACE;
+    waiter4->msg_space_dest = task;
+    waiter4->msg_space_priority = NUFR_MSG_PRI_LOW;
+    task->msg_space_waiters = waiter3;
+    waiter3->flink = waiter4;
+    CU_ASSERT_TRUE(NUFR_BKD_MSG_SPACE == nufr_task_running_state(NUFR_TID_03));
+
+    // Receive frees a high priority slot: first waiter readied only
+    nufr_msg_getW(&fields, &parameter);
+    CU_ASSERT_TRUE(1 == NUFR_GET_MSG_ID(fields));
+    CU_ASSERT_TRUE(2 == task->msg_queue_depth);
+    CU_ASSERT_TRUE(0 == waiter3->block_flags);
+    CU_ASSERT_TRUE(NULL == waiter3->msg_space_dest);
+    CU_ASSERT_TRUE(task->msg_space_waiters == waiter4);
+    CU_ASSERT_TRUE(nufr_running == task);
+
+    // Unlink, as on a timeout or kill
+    nufrkernel_msg_space_unlink_task(waiter4);
+    CU_ASSERT_TRUE(NULL == task->msg_space_waiters);
+    CU_ASSERT_TRUE(NULL == waiter4->msg_space_dest);
+
+    // Drain readies all waiters and zeroes depths, not high-water marks
+    waiter4->msg_space_dest = task;
+    task->msg_space_waiters = waiter4;
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(0 == task->msg_queue_depth);
+    CU_ASSERT_TRUE(0 == task->msg_queue_pri_depth[NUFR_MSG_PRI_MID]);
+    CU_ASSERT_TRUE(3 == task->msg_queue_hwm);
+    CU_ASSERT_TRUE(0 == waiter4->block_flags);
+    CU_ASSERT_TRUE(NULL == task->msg_space_waiters);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    nufr_running = task;
+
+    // Timed send with no wait, to a full queue
+    task2->msg_queue_limit = 2;
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_sendT(UT_LIMIT_FIELDS(1, NUFR_MSG_PRI_MID), 0,
+                       NUFR_TID_02, 0));
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_sendT(UT_LIMIT_FIELDS(1, NUFR_MSG_PRI_MID), 0,
+                       NUFR_TID_02, 0));
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_QUEUE_FULL ==
+        nufr_msg_sendT(UT_LIMIT_FIELDS(1, NUFR_MSG_PRI_MID), 0,
+                       NUFR_TID_02, 0));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 2 == nufr_msg_free_count());
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+
+    // Batch takes what fits, gives the rest back
+    for (i = 0; i < 3; i++)
+    {
+        entries[i].fields = UT_LIMIT_FIELDS(i, NUFR_MSG_PRI_MID);
+        entries[i].parameter = i;
+    }
+    CU_ASSERT_TRUE(2 == nufr_msg_send_batch(entries, 3, NUFR_TID_02));
+    CU_ASSERT_TRUE(2 == task2->msg_queue_depth);
+    CU_ASSERT_TRUE(2 == task2->msg_queue_full_count);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 2 == nufr_msg_free_count());
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_MSG_QUEUE_LIMIT
+
+#if NUFR_CS_MSG_POOL_RESERVE == 1
+#define UT_RESERVE_FIELDS(id, pri)   NUFR_SET_MSG_FIELDS(1, (id), NUFR_TID_02, (pri))
+
+void ut_msg_pool_reserve(void)
+{
+    nufr_tcb_t *task = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_msg_pool_stats_t stats;
+    uint32_t    fields;
+    uint32_t    parameter;
+    unsigned    i;
+
+    ut_clean_list();
+    task->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task);
+    nufr_running = task;
+
+    nufr_msg_pool_stats_reset();
+    nufr_msg_pool_stats_get(&stats);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == stats.free);
+    CU_ASSERT_TRUE(0 == stats.in_use);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == stats.low_water);
+
+    // Task level sends stop short of the reserve
+    for (i = 0; i < NUFR_MAX_MSGS - NUFR_MSG_POOL_ISR_RESERVE; i++)
+    {
+        CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+            nufr_msg_send(UT_RESERVE_FIELDS(i, NUFR_MSG_PRI_MID), 0, NUFR_TID_01));
+    }
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_ERROR ==
+        nufr_msg_send(UT_RESERVE_FIELDS(20, NUFR_MSG_PRI_MID), 0, NUFR_TID_01));
+    CU_ASSERT_TRUE(NULL == nufr_msg_get_block());
+    CU_ASSERT_TRUE(NUFR_MSG_POOL_ISR_RESERVE == nufr_msg_free_count());
+
+    // Priority 0 sender may use the reserve
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send(UT_RESERVE_FIELDS(21, NUFR_MSG_PRI_CONTROL), 0, NUFR_TID_01));
+    nufr_msg_getW(&fields, &parameter);
+    CU_ASSERT_TRUE(21 == NUFR_GET_MSG_ID(fields));
+
+    // So may an ISR
+    nufrplat_sim_in_isr = 1;
+    CU_ASSERT_TRUE(NUFR_MSG_SEND_OK ==
+        nufr_msg_send(UT_RESERVE_FIELDS(22, NUFR_MSG_PRI_MID), 0, NUFR_TID_01));
+    nufrplat_sim_in_isr = 0;
+
+    nufr_msg_pool_stats_get(&stats);
+    CU_ASSERT_TRUE(NUFR_MSG_POOL_ISR_RESERVE - 1 == stats.free);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - stats.free == stats.in_use);
+    CU_ASSERT_TRUE(NUFR_MSG_POOL_ISR_RESERVE - 1 == stats.low_water);
+    CU_ASSERT_TRUE(2 == stats.alloc_fails[NUFR_MSG_CALLER_TASK]);
+    CU_ASSERT_TRUE(0 == stats.alloc_fails[NUFR_MSG_CALLER_CONTROL]);
+    CU_ASSERT_TRUE(0 == stats.alloc_fails[NUFR_MSG_CALLER_ISR]);
+
+    // Drain; low-water mark holds until reset
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+    nufr_msg_pool_stats_get(&stats);
+    CU_ASSERT_TRUE(NUFR_MSG_POOL_ISR_RESERVE - 1 == stats.low_water);
+    nufr_msg_pool_stats_reset();
+    nufr_msg_pool_stats_get(&stats);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == stats.low_water);
+    CU_ASSERT_TRUE(0 == stats.alloc_fails[NUFR_MSG_CALLER_TASK]);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_MSG_POOL_RESERVE
+
+#if NUFR_CS_MSG_INDEX == 1
+static uint32_t ut_coalesce_now;
+
+static uint32_t ut_coalesce_now_get(void)
+{
+    return ut_coalesce_now;
+}
+
+void ut_nsvc_timer_coalesce(void)
+{
+    nufr_tcb_t         *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nsvc_timer_t       *coalesce_tm;
+    nsvc_timer_t       *plain_tm;
+    uint32_t            reconfigured;
+    uint32_t            fields;
+    uint32_t            parameter;
+    unsigned            i;
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufr_running = task_1;
+
+    ut_coalesce_now = 0;
+    nsvc_timer_init(ut_coalesce_now_get, NULL);
+
+    coalesce_tm = nsvc_timer_alloc();
+    plain_tm = nsvc_timer_alloc();
+    CU_ASSERT_TRUE_FATAL((NULL != coalesce_tm) && (NULL != plain_tm));
+    CU_ASSERT_FALSE(plain_tm->coalesce);
+
+    coalesce_tm->mode = NSVC_TMODE_CONTINUOUS;
+    coalesce_tm->duration = 10;
+    coalesce_tm->msg_fields = NSVC_TIMER_SET_ID(1);
+    coalesce_tm->dest_task_id = NUFR_TID_01;
+    coalesce_tm->coalesce = true;
+
+    plain_tm->mode = NSVC_TMODE_CONTINUOUS;
+    plain_tm->duration = 10;
+    plain_tm->msg_fields = NSVC_TIMER_SET_ID(2);
+    plain_tm->dest_task_id = NUFR_TID_01;
+
+    nsvc_timer_start(coalesce_tm);
+    nsvc_timer_start(plain_tm);
+
+    // Unread: opted-in timer queues one message, other one each expiry
+    for (i = 1; i <= 3; i++)
+    {
+        ut_coalesce_now = 10 * i;
+        (void)nsvc_timer_expire_timer_callin(ut_coalesce_now, &reconfigured);
+    }
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 4 == nufr_msg_free_count());
+
+    // Read, and opted-in timer sends again
+    nufr_msg_getW(&fields, &parameter);
+    CU_ASSERT_TRUE(1 == NUFR_GET_MSG_ID(fields));
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    ut_coalesce_now = 40;
+    (void)nsvc_timer_expire_timer_callin(ut_coalesce_now, &reconfigured);
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 2 == nufr_msg_free_count());
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+
+    CU_ASSERT_TRUE(nsvc_timer_kill(coalesce_tm));
+    CU_ASSERT_TRUE(nsvc_timer_kill(plain_tm));
+    nsvc_timer_free(coalesce_tm);
+    nsvc_timer_free(plain_tm);
+    CU_ASSERT_TRUE(0 == nsvc_timer_next_expiration_callin());
+
+    nufrplat_systick_sl_add_callback(NULL);
+    nufrplat_systick_sl_add_deadline_callback(NULL);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_MSG_INDEX
+
+CU_ErrorCode ut_setup_kernel_messaging_tests(void)
+{
+    CU_pSuite ptrMessagingSuite = NULL;
+    CU_ErrorCode result = CUE_SUCCESS;
+
+    ptrMessagingSuite = CU_add_suite(MESSAGING_TEST_SUITE, NULL, NULL);
+    if (NULL != ptrMessagingSuite)
+    {
+        CU_pTest outcome = NULL;
+
+        outcome = CU_ADD_TEST(ptrMessagingSuite, ut_msg_getT_after_wait);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+    #if NUFR_CS_MSG_PAYLOAD == 1
+        outcome = CU_ADD_TEST(ptrMessagingSuite, ut_msg_payload);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_MSG_PAYLOAD
+
+        outcome = CU_ADD_TEST(ptrMessagingSuite, ut_msg_send_batch);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+    #if NUFR_CS_MSG_BROADCAST == 1
+        outcome = CU_ADD_TEST(ptrMessagingSuite, ut_msg_broadcast);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_MSG_BROADCAST
+
+    #if NUFR_CS_MSG_INDEX == 1
+        outcome = CU_ADD_TEST(ptrMessagingSuite, ut_msg_index);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_MSG_INDEX
+
+    #if NUFR_CS_MSG_QUEUE_LIMIT == 1
+        outcome = CU_ADD_TEST(ptrMessagingSuite, ut_msg_queue_limit);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_MSG_QUEUE_LIMIT
+
+    #if NUFR_CS_MSG_POOL_RESERVE == 1
+        outcome = CU_ADD_TEST(ptrMessagingSuite, ut_msg_pool_reserve);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_MSG_POOL_RESERVE
+
+    #if NUFR_CS_MSG_INDEX == 1
+        outcome = CU_ADD_TEST(ptrMessagingSuite, ut_nsvc_timer_coalesce);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_MSG_INDEX
+    }
+    else
+    {
+        CU_cleanup_registry();
+        result = CU_get_error();
+    }
+    return result;
+}
@@ -25,9 +25,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // By Chris Martin
 
+#include <CUnit/CUnit.h>
+#include <test_helper.h>
 #include <nufr-kernel-base-semaphore.h>
 #include <nufr-platform.h>
 #include <nufr-api.h>
+#include <nufr-kernel-task.h>
+#include <nufr-kernel-semaphore.h>
+
+#define SEMAPHORE_TEST_SUITE       "Kernel Semaphore Test Suite"
 
 void ut_nufr_sema_reset(void)
 {    
@@ -88,3 +94,121 @@ void ut_kernel_semaphore_tests(void)
     ut_nufr_sema_getT();
     ut_nufr_sema_release();
 }
+
+void ut_sema_release_to_waiter(void)
+{
+    nufr_tcb_t        *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_tcb_t        *task_2 = NUFR_TID_TO_TCB(NUFR_TID_02);
+    nufr_sema_block_t *semaphore = NUFR_SEMA_ID_TO_BLOCK(NUFR_SEMA_X);
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    // Task 2 heads ready list, so it's the one blocked
+    task_2->priority = NUFR_TPR_HIGH;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufrkernel_add_task_to_ready_list(task_2);
+
+    // Task 1 owns sema, task 2 waits on it
+    nufrkernel_sema_reset(semaphore, 0, true);
+    task_1->sema_block = semaphore;
+    semaphore->owner_tcb = task_1;
+    nufr_running = task_2;
+    nufrkernel_block_running_task(NUFR_TASK_BLOCKED_SEMA);
+    task_2->sema_block = semaphore;
+    nufrkernel_sema_link_task(semaphore, task_2);
+    nufr_running = nufr_ready_list;
+    CU_ASSERT_TRUE_FATAL(task_1 == nufr_running);
+
+    // Handoff readies waiter: blocked flag must go
+    CU_ASSERT_TRUE(nufr_sema_release(NUFR_SEMA_X));
+    CU_ASSERT_TRUE(task_2 == semaphore->owner_tcb);
+    CU_ASSERT_TRUE(0 == semaphore->count);
+    CU_ASSERT_FALSE(NUFR_IS_BLOCK_SET(task_2, NUFR_TASK_BLOCKED_SEMA));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_2));
+    CU_ASSERT_TRUE(task_2 == nufr_ready_list);
+    CU_ASSERT_TRUE(NULL == task_1->sema_block);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+void ut_sema_release_count(void)
+{
+    nufr_tcb_t        *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_tcb_t        *task_2 = NUFR_TID_TO_TCB(NUFR_TID_02);
+    nufr_tcb_t        *task_3 = NUFR_TID_TO_TCB(NUFR_TID_03);
+    nufr_sema_block_t *semaphore = NUFR_SEMA_ID_TO_BLOCK(NUFR_SEMA_X);
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    task_2->priority = NUFR_TPR_HIGH;
+    task_3->priority = NUFR_TPR_HIGH;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufrkernel_add_task_to_ready_list(task_2);
+    nufrkernel_add_task_to_ready_list(task_3);
+
+    // Counting sema, empty. Tasks 2 then 3 wait on it.
+    nufrkernel_sema_reset(semaphore, 0, false);
+    semaphore->owner_tcb = task_1;
+    nufr_running = task_2;
+    nufrkernel_block_running_task(NUFR_TASK_BLOCKED_SEMA);
+    nufrkernel_sema_link_task(semaphore, task_2);
+    nufr_running = task_3;
+    nufrkernel_block_running_task(NUFR_TASK_BLOCKED_SEMA);
+    nufrkernel_sema_link_task(semaphore, task_3);
+    nufr_running = nufr_ready_list;
+    CU_ASSERT_TRUE_FATAL(task_1 == nufr_running);
+
+    // Fewer releases than waiters: first waiter only
+    CU_ASSERT_TRUE(1 == nufr_sema_release_count(NUFR_SEMA_X, 1));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_2));
+    CU_ASSERT_TRUE(NUFR_IS_BLOCK_SET(task_3, NUFR_TASK_BLOCKED_SEMA));
+    CU_ASSERT_TRUE(task_2 == semaphore->owner_tcb);
+    CU_ASSERT_TRUE(0 == semaphore->count);
+
+    // More releases than waiters: rest go to count
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(1 == nufr_sema_release_count(NUFR_SEMA_X, 4));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_3));
+    CU_ASSERT_TRUE(task_3 == task_2->flink);
+    CU_ASSERT_TRUE(NULL == semaphore->task_list_head);
+    CU_ASSERT_TRUE(NULL == semaphore->owner_tcb);
+    CU_ASSERT_TRUE(3 == semaphore->count);
+
+    // No waiters
+    CU_ASSERT_TRUE(0 == nufr_sema_release_count(NUFR_SEMA_X, 2));
+    CU_ASSERT_TRUE(5 == semaphore->count);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+CU_ErrorCode ut_setup_kernel_semaphore_tests(void)
+{
+    CU_pSuite ptrSemaphoreSuite = NULL;
+    CU_ErrorCode result = CUE_SUCCESS;
+
+    ptrSemaphoreSuite = CU_add_suite(SEMAPHORE_TEST_SUITE, NULL, NULL);
+    if (NULL != ptrSemaphoreSuite)
+    {
+        CU_pTest outcome = NULL;
+
+        outcome = CU_ADD_TEST(ptrSemaphoreSuite, ut_sema_release_to_waiter);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+        outcome = CU_ADD_TEST(ptrSemaphoreSuite, ut_sema_release_count);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    }
+    else
+    {
+        CU_cleanup_registry();
+        result = CU_get_error();
+    }
+    return result;
+}
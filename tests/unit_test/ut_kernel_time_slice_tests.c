@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <CUnit/CUnit.h>
+#include <test_helper.h>
+#include <nufr-platform.h>
+#include <nufr-platform-app.h>
+#include <nufr-api.h>
+#include <nufr-kernel-task.h>
+
+#define TIME_SLICE_TEST_SUITE      "Kernel Time Slice Test Suite"
+
+#if NUFR_CS_TIME_SLICE == 1
+void ut_time_slice(void)
+{
+    ut_clean_list();
+    nufr_tcb_t *task_1 = &nufr_tcb_block[0];
+    nufr_tcb_t *task_2 = &nufr_tcb_block[1];
+    nufr_tcb_t *task_3 = &nufr_tcb_block[2];
+
+    task_1->priority = NUFR_TPR_NOMINAL;
+    task_2->priority = NUFR_TPR_NOMINAL;
+    task_3->priority = NUFR_TPR_LOW;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufrkernel_add_task_to_ready_list(task_2);
+    nufrkernel_add_task_to_ready_list(task_3);
+    nufr_running = nufr_ready_list;
+    nufr_time_slice_tcb = NULL;
+
+    // Level not sliced
+    nufrkernel_time_slice_tick();
+    nufrkernel_time_slice_tick();
+    nufrkernel_time_slice_tick();
+    CU_ASSERT_TRUE(task_1 == nufr_ready_list);
+
+    // Rotated behind its peer on 2nd tick, ahead of lower priority
+    nufr_time_slice_set(NUFR_TPR_NOMINAL, 2);
+    nufr_time_slice_tcb = NULL;
+    nufrkernel_time_slice_tick();
+    CU_ASSERT_TRUE(task_1 == nufr_ready_list);
+    nufrkernel_time_slice_tick();
+    CU_ASSERT_TRUE(task_2 == nufr_ready_list);
+    CU_ASSERT_TRUE(task_2 == nufr_running);
+    CU_ASSERT_TRUE(task_1 == task_2->flink);
+    CU_ASSERT_TRUE(task_3 == task_1->flink);
+    CU_ASSERT_TRUE(task_1 == nufr_ready_list_tail_nominal);
+    CU_ASSERT_TRUE(task_3 == nufr_ready_list_tail);
+
+    // Opted out task keeps running
+    task_2->statuses |= NUFR_TASK_NO_TIME_SLICE;
+    nufrkernel_time_slice_tick();
+    nufrkernel_time_slice_tick();
+    nufrkernel_time_slice_tick();
+    CU_ASSERT_TRUE(task_2 == nufr_ready_list);
+    task_2->statuses = 0;
+
+    // Quantum already used up, rotated on next tick
+    nufrkernel_time_slice_tick();
+    CU_ASSERT_TRUE(task_1 == nufr_ready_list);
+    CU_ASSERT_TRUE(task_2 == nufr_ready_list_tail_nominal);
+
+    // No peer: no rotation
+    nufrkernel_remove_head_task_from_ready_list();
+    nufr_running = nufr_ready_list;
+    CU_ASSERT_TRUE(task_2 == nufr_running);
+    nufrkernel_time_slice_tick();
+    nufrkernel_time_slice_tick();
+    nufrkernel_time_slice_tick();
+    CU_ASSERT_TRUE(task_2 == nufr_ready_list);
+    CU_ASSERT_TRUE(task_2 == nufr_ready_list_tail_nominal);
+
+    nufr_time_slice_set(NUFR_TPR_NOMINAL, 0);
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_TIME_SLICE
+
+CU_ErrorCode ut_setup_kernel_time_slice_tests(void)
+{
+    CU_pSuite ptrTimeSliceSuite = NULL;
+    CU_ErrorCode result = CUE_SUCCESS;
+
+    ptrTimeSliceSuite = CU_add_suite(TIME_SLICE_TEST_SUITE, NULL, NULL);
+    if (NULL != ptrTimeSliceSuite)
+    {
+        CU_pTest outcome = NULL;
+
+    #if NUFR_CS_TIME_SLICE == 1
+        outcome = CU_ADD_TEST(ptrTimeSliceSuite, ut_time_slice);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_TIME_SLICE
+    }
+    else
+    {
+        CU_cleanup_registry();
+        result = CU_get_error();
+    }
+    return result;
+}
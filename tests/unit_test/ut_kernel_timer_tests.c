@@ -24,8 +24,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 // By Chris Martin
 
+#include <CUnit/CUnit.h>
+#include <string.h>
 #include <test_helper.h>
 
+#define TIMER_TEST_SUITE           "Kernel Timer Test Suite"
+
+#define UT_TIMER_TICKS             1000
+#define UT_TIMER_MAX_TASKS         128
+
+// Tcb's not in 'nufr_tcb_block', so any number of them can be timed
+static nufr_tcb_t ut_timer_tcbs[UT_TIMER_MAX_TASKS];
+
 
 void ut_nufrkernel_update_task_timers(void)
 {
@@ -60,3 +70,335 @@ void ut_kernel_timer_tests(void)
     ut_nufrkernel_purge_from_timer_list();
 }
 
+static void ut_timer_clean(void)
+{
+    ut_clean_list();
+    memset(ut_timer_tcbs, 0, sizeof(ut_timer_tcbs));
+    nufr_timer_list = nufr_timer_list_tail = NULL;
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+    ut_interrupt_count = 0;
+}
+
+static void ut_timer_sleep(nufr_tcb_t *tcb, uint32_t ticks)
+{
+    tcb->priority = NUFR_TPR_NOMINAL;
+    tcb->block_flags = NUFR_TASK_BLOCKED_ASLEEP;
+    nufrkernel_add_to_timer_list(tcb, ticks);
+}
+
+// Timer list is sorted by expiration, each tcb->timer a delta
+//  to the one before it.
+void ut_timer_list_sorted_expiry(void)
+{
+    nufr_tcb_t *task_a = &ut_timer_tcbs[0];
+    nufr_tcb_t *task_b = &ut_timer_tcbs[1];
+    nufr_tcb_t *task_c = &ut_timer_tcbs[2];
+    nufr_tcb_t *task_d = &ut_timer_tcbs[3];
+
+    ut_timer_clean();
+
+    ut_timer_sleep(task_a, 5);
+    ut_timer_sleep(task_b, 2);
+    ut_timer_sleep(task_c, 9);
+    ut_timer_sleep(task_d, 5);
+
+    // Same expiration as 'task_a' goes behind it
+    CU_ASSERT_TRUE(task_b == nufr_timer_list);
+    CU_ASSERT_TRUE(task_a == task_b->flink_timer);
+    CU_ASSERT_TRUE(task_d == task_a->flink_timer);
+    CU_ASSERT_TRUE(task_c == task_d->flink_timer);
+    CU_ASSERT_TRUE(task_c == nufr_timer_list_tail);
+    CU_ASSERT_TRUE(2 == task_b->timer);
+    CU_ASSERT_TRUE(3 == task_a->timer);
+    CU_ASSERT_TRUE(0 == task_d->timer);
+    CU_ASSERT_TRUE(4 == task_c->timer);
+
+    // Only head is decremented
+    nufrkernel_update_task_timers();
+    CU_ASSERT_TRUE(1 == task_b->timer);
+    CU_ASSERT_TRUE(3 == task_a->timer);
+
+    nufrkernel_update_task_timers();
+    CU_ASSERT_TRUE(task_a == nufr_timer_list);
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_b));
+    CU_ASSERT_TRUE(NUFR_IS_STATUS_CLR(task_b, NUFR_TASK_TIMER_RUNNING));
+    CU_ASSERT_TRUE(NUFR_IS_NOTIF_SET(task_b, NUFR_TASK_TIMEOUT));
+    CU_ASSERT_TRUE(task_b == nufr_ready_list);
+
+    // Purge folds delta into next task
+    CU_ASSERT_TRUE(nufrkernel_purge_from_timer_list(task_a));
+    CU_ASSERT_TRUE(task_d == nufr_timer_list);
+    CU_ASSERT_TRUE(3 == task_d->timer);
+    CU_ASSERT_FALSE(nufrkernel_purge_from_timer_list(task_a));
+
+    nufrkernel_update_task_timers();
+    nufrkernel_update_task_timers();
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task_d));
+    nufrkernel_update_task_timers();
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_d));
+    CU_ASSERT_TRUE(task_c == nufr_timer_list);
+    CU_ASSERT_TRUE(task_c == nufr_timer_list_tail);
+    CU_ASSERT_TRUE(4 == task_c->timer);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+#if NUFR_CS_LOCAL_STRUCT == 1
+// A bop locked task which times out has its timeout extended 1 tick
+void ut_timer_bop_locked_extend(void)
+{
+    nufr_tcb_t *task_a = &ut_timer_tcbs[0];
+    nufr_tcb_t *task_b = &ut_timer_tcbs[1];
+
+    ut_timer_clean();
+
+    task_a->statuses |= NUFR_TASK_BOP_LOCKED;
+    ut_timer_sleep(task_a, 1);
+    task_a->block_flags = NUFR_TASK_BLOCKED_BOP;
+    ut_timer_sleep(task_b, 1);
+
+    nufrkernel_update_task_timers();
+    CU_ASSERT_TRUE(NUFR_IS_BLOCK_SET(task_a, NUFR_TASK_BLOCKED_BOP));
+    CU_ASSERT_TRUE(NUFR_IS_STATUS_SET(task_a, NUFR_TASK_TIMER_RUNNING));
+    CU_ASSERT_TRUE(task_a == nufr_timer_list);
+    CU_ASSERT_TRUE(1 == task_a->timer);
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_b));
+
+    task_a->statuses &= BITWISE_NOT8(NUFR_TASK_BOP_LOCKED);
+
+    nufrkernel_update_task_timers();
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_a));
+    CU_ASSERT_TRUE(NUFR_IS_NOTIF_SET(task_a, NUFR_TASK_TIMEOUT));
+    CU_ASSERT_TRUE(NULL == nufr_timer_list);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_LOCAL_STRUCT
+
+#if NUFR_CS_TICKLESS_IDLE == 1
+static uint32_t ut_timer_sl_deadline_ms;
+
+static uint32_t ut_timer_sl_deadline(void)
+{
+    return ut_timer_sl_deadline_ms;
+}
+
+// BG idles with a one-shot programmed for the earliest timer
+//  deadline. Skipped ticks are accounted for on wakeup.
+void ut_timer_tickless_idle(void)
+{
+    nufr_tcb_t *task_a = &ut_timer_tcbs[0];
+    nufr_tcb_t *task_b = &ut_timer_tcbs[1];
+    uint32_t    start_count;
+
+    ut_timer_clean();
+    start_count = nufr_tick_count_get();
+
+    ut_timer_sleep(task_a, 5);
+    ut_timer_sleep(task_b, 12);
+
+    // One-shot expires when 'task_a' times out
+    nufrplat_tickless_idle();
+    CU_ASSERT_TRUE(start_count + 5 == nufr_tick_count_get());
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_a));
+    CU_ASSERT_TRUE(task_a == nufr_ready_list);
+    CU_ASSERT_TRUE(task_b == nufr_timer_list);
+    CU_ASSERT_TRUE(7 == task_b->timer);
+    CU_ASSERT_TRUE(1 == nufrplat_oneshot_ticks);
+
+    // Task ready: no idling
+    nufrplat_tickless_idle();
+    CU_ASSERT_TRUE(start_count + 5 == nufr_tick_count_get());
+
+    ut_clean_list();
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+
+    // Another interrupt wakes CPU 3 ticks in
+    nufrplat_sim_wake_after_ticks = 3;
+    nufrplat_tickless_idle();
+    nufrplat_sim_wake_after_ticks = 0;
+    CU_ASSERT_TRUE(start_count + 8 == nufr_tick_count_get());
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task_b));
+    CU_ASSERT_TRUE(4 == task_b->timer);
+    CU_ASSERT_TRUE(1 == nufrplat_oneshot_ticks);
+
+    // Periodic ticks still work after early wake
+    nufrplat_sim_oneshot_clock();
+    CU_ASSERT_TRUE(start_count + 9 == nufr_tick_count_get());
+    CU_ASSERT_TRUE(3 == task_b->timer);
+
+    // Earlier SL timer deadline wins, rounded up to whole ticks
+    ut_timer_sl_deadline_ms = NUFR_TICK_PERIOD + 1;
+    nufrplat_systick_sl_add_deadline_callback(ut_timer_sl_deadline);
+    nufrplat_tickless_idle();
+    nufrplat_systick_sl_add_deadline_callback(NULL);
+    CU_ASSERT_TRUE(start_count + 11 == nufr_tick_count_get());
+    CU_ASSERT_TRUE(1 == task_b->timer);
+
+    // Only one tick to deadline: nothing to skip
+    nufrplat_tickless_idle();
+    CU_ASSERT_TRUE(start_count + 11 == nufr_tick_count_get());
+
+    nufrplat_sim_oneshot_clock();
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_b));
+    CU_ASSERT_TRUE(NULL == nufr_timer_list);
+
+    ut_clean_list();
+    nufr_running = (nufr_tcb_t *)nufr_bg_sp;
+
+    // No deadlines: sleep as long as one-shot allows
+    nufrplat_tickless_idle();
+    CU_ASSERT_TRUE(start_count + 12 + BIT_MASK16 == nufr_tick_count_get());
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_TICKLESS_IDLE
+
+#if NUFR_CS_TASK_PERIOD == 1
+// Period deadlines advance on a fixed grid. A passed deadline is an
+//  overrun, released without sleeping. Whole periods gone by are skipped.
+void ut_timer_period(void)
+{
+    nufr_tcb_t    *task_a = &ut_timer_tcbs[0];
+    nufr_period_t  period;
+    uint32_t       saved_count = nufr_os_tick_count;
+    uint32_t       start_count;
+
+    ut_timer_clean();
+    nufr_running = task_a;
+
+    start_count = 0xFFFFFFF8;
+    nufr_os_tick_count = start_count;
+    nufr_period_init(&period, 10);
+    CU_ASSERT_TRUE(start_count + 10 == period.next_deadline);
+
+    // Wake tick reached or passed: no sleep
+    CU_ASSERT_FALSE(nufr_sleep_until(start_count, NUFR_MSG_PRI_MID));
+    CU_ASSERT_FALSE(nufr_sleep_until(start_count - 5, NUFR_MSG_PRI_MID));
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_a));
+    CU_ASSERT_TRUE(NULL == nufr_timer_list);
+
+    // On deadline, across the wrap
+    nufr_os_tick_count = start_count + 10;
+    CU_ASSERT_TRUE(NUFR_PERIOD_OK ==
+                   nufr_period_waitW(&period, NUFR_MSG_PRI_MID));
+    CU_ASSERT_TRUE(start_count + 20 == period.next_deadline);
+    CU_ASSERT_TRUE(NULL == nufr_timer_list);
+
+    // Late by less than a period: grid kept
+    nufr_os_tick_count = start_count + 23;
+    CU_ASSERT_TRUE(NUFR_PERIOD_OVERRUN ==
+                   nufr_period_waitW(&period, NUFR_MSG_PRI_MID));
+    CU_ASSERT_TRUE(start_count + 30 == period.next_deadline);
+    CU_ASSERT_TRUE(1 == period.overruns);
+    CU_ASSERT_TRUE(0 == period.missed_periods);
+
+    // Late by 2 more periods: those are skipped
+    nufr_os_tick_count = start_count + 57;
+    CU_ASSERT_TRUE(NUFR_PERIOD_OVERRUN ==
+                   nufr_period_waitW(&period, NUFR_MSG_PRI_MID));
+    CU_ASSERT_TRUE(start_count + 60 == period.next_deadline);
+    CU_ASSERT_TRUE(2 == period.overruns);
+    CU_ASSERT_TRUE(2 == period.missed_periods);
+
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_a));
+    CU_ASSERT_TRUE(NULL == nufr_timer_list);
+
+    nufr_os_tick_count = saved_count;
+    ut_timer_clean();
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_TASK_PERIOD
+
+// A tick only touches the head of a long timer list
+void ut_timer_tick_head_only(void)
+{
+    unsigned i;
+
+    ut_timer_clean();
+
+    for (i = 0; i < UT_TIMER_MAX_TASKS; i++)
+    {
+        ut_timer_sleep(&ut_timer_tcbs[i], UT_TIMER_TICKS + 1 + i);
+    }
+
+    for (i = 0; i < UT_TIMER_TICKS; i++)
+    {
+        nufrkernel_update_task_timers();
+    }
+
+    // Head counted down, deltas behind it untouched
+    CU_ASSERT_TRUE(&ut_timer_tcbs[0] == nufr_timer_list);
+    CU_ASSERT_TRUE(1 == ut_timer_tcbs[0].timer);
+    for (i = 1; i < UT_TIMER_MAX_TASKS; i++)
+    {
+        CU_ASSERT_TRUE(1 == ut_timer_tcbs[i].timer);
+        CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(&ut_timer_tcbs[i]));
+    }
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(&ut_timer_tcbs[0]));
+
+    ut_timer_clean();
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+CU_ErrorCode ut_setup_kernel_timer_tests(void)
+{
+    CU_pSuite ptrTimerSuite = NULL;
+    CU_ErrorCode result = CUE_SUCCESS;
+
+    ptrTimerSuite = CU_add_suite(TIMER_TEST_SUITE, NULL, NULL);
+    if (NULL != ptrTimerSuite)
+    {
+        CU_pTest outcome = NULL;
+
+        outcome = CU_ADD_TEST(ptrTimerSuite, ut_timer_list_sorted_expiry);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+    #if NUFR_CS_LOCAL_STRUCT == 1
+        outcome = CU_ADD_TEST(ptrTimerSuite, ut_timer_bop_locked_extend);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_LOCAL_STRUCT
+
+    #if NUFR_CS_TICKLESS_IDLE == 1
+        outcome = CU_ADD_TEST(ptrTimerSuite, ut_timer_tickless_idle);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_TICKLESS_IDLE
+
+    #if NUFR_CS_TASK_PERIOD == 1
+        outcome = CU_ADD_TEST(ptrTimerSuite, ut_timer_period);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_TASK_PERIOD
+
+        outcome = CU_ADD_TEST(ptrTimerSuite, ut_timer_tick_head_only);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    }
+    else
+    {
+        CU_cleanup_registry();
+        result = CU_get_error();
+    }
+    return result;
+}
+
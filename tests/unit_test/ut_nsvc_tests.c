@@ -0,0 +1,918 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <CUnit/CUnit.h>
+#include <string.h>
+#include <test_helper.h>
+#include <nufr-platform.h>
+#include <nufr-platform-app.h>
+#include <nufr-api.h>
+#include <nufr-kernel-task.h>
+#include <nufr-kernel-timer.h>
+#include <nufr-kernel-semaphore.h>
+#include <nufr-kernel-message-blocks.h>
+#include <nsvc-api.h>
+#include <nsvc.h>
+
+#define NSVC_TEST_SUITE            "Service Layer Test Suite"
+
+#if NUFR_CS_MUTEX_FAST_PATH == 1
+void ut_mutex_fast_path(void)
+{
+    nufr_tcb_t        *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_tcb_t        *task_2 = NUFR_TID_TO_TCB(NUFR_TID_02);
+    nufr_sema_block_t *sema_block;
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    task_2->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufrkernel_add_task_to_ready_list(task_2);
+
+    // First sema out of a fresh pool
+    nsvc_init();
+    nsvc_mutex_init();
+    sema_block = NUFR_SEMA_ID_TO_BLOCK(NUFR_SEMA_POOL_START);
+
+    // Uncontended: sema never touched
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID));
+    CU_ASSERT_TRUE(1 == sema_block->count);
+    CU_ASSERT_TRUE(NULL == sema_block->owner_tcb);
+    CU_ASSERT_FALSE(nsvc_mutex_release(NSVC_MUTEX_1));
+    CU_ASSERT_TRUE(1 == sema_block->count);
+
+    // Contender inflates: sema now shows task 1 as owner
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_mutex_getT(NSVC_MUTEX_1, NUFR_MSG_PRI_MID, 1));
+    nufr_running = task_2;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_TIMEOUT ==
+                   nsvc_mutex_getT(NSVC_MUTEX_1, NUFR_MSG_PRI_MID, 0));
+    CU_ASSERT_TRUE(0 == sema_block->count);
+    CU_ASSERT_TRUE(task_1 == sema_block->owner_tcb);
+
+    // Release goes through the sema, then deflates
+    nufr_running = task_1;
+    CU_ASSERT_FALSE(nsvc_mutex_release(NSVC_MUTEX_1));
+    CU_ASSERT_TRUE(1 == sema_block->count);
+    CU_ASSERT_TRUE(NULL == sema_block->owner_tcb);
+
+    // Deflated: fast path again, for the other task
+    nufr_running = task_2;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID));
+    CU_ASSERT_TRUE(1 == sema_block->count);
+    CU_ASSERT_FALSE(nsvc_mutex_release(NSVC_MUTEX_1));
+
+#if NUFR_CS_TASK_KILL == 1
+    // Waiter killed while on sema: release still deflates.
+    // Waiter must head ready list to block.
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    task_2->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_2);
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID));
+    nufr_running = task_2;
+    (void)nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID);
+    CU_ASSERT_TRUE(task_2 == sema_block->task_list_head);
+    CU_ASSERT_TRUE(task_1 == nufr_running);
+    nufr_kill_task(NUFR_TID_02);
+    CU_ASSERT_TRUE(NULL == sema_block->task_list_head);
+    CU_ASSERT_FALSE(nsvc_mutex_release(NSVC_MUTEX_1));
+    CU_ASSERT_TRUE(1 == sema_block->count);
+
+    // Deflated: fast path, sema untouched
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_mutex_getW(NSVC_MUTEX_1, NUFR_MSG_PRI_MID));
+    CU_ASSERT_TRUE(1 == sema_block->count);
+    CU_ASSERT_TRUE(NULL == sema_block->owner_tcb);
+    CU_ASSERT_FALSE(nsvc_mutex_release(NSVC_MUTEX_1));
+#endif  // NUFR_CS_TASK_KILL
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_MUTEX_FAST_PATH
+
+#if NUFR_CS_DEFERRED_WORK == 1
+static uint32_t ut_work_log[4];
+static unsigned ut_work_count;
+
+static void ut_work_fcn(uint32_t argument)
+{
+    ut_work_log[ut_work_count++ & 3] = argument;
+}
+
+void ut_deferred_work(void)
+{
+    nufr_tcb_t        *task = NUFR_TID_TO_TCB(NUFR_TID_01);
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    nufr_tcb_t        *worker = NUFR_TID_TO_TCB(NUFR_TID_02);
+#endif
+    nsvc_work_stats_t  stats;
+    unsigned           i;
+
+    ut_clean_list();
+    task->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task);
+    nufr_running = task;
+
+    nsvc_work_init(NUFR_TID_02);
+    ut_work_count = 0;
+
+    // One wake message for the whole batch
+    nufrplat_sim_timestamp = 100;
+    nufrplat_sim_in_isr = 1;
+    CU_ASSERT_TRUE(nsvc_work_defer(1, ut_work_fcn, 10));
+    CU_ASSERT_TRUE(nsvc_work_defer(0, ut_work_fcn, 20));
+    CU_ASSERT_TRUE(nsvc_work_defer(1, ut_work_fcn, 30));
+    nufrplat_sim_in_isr = 0;
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 1 == nufr_msg_free_count());
+
+    // Higher priority ring first, FIFO within a ring
+    nufrplat_sim_timestamp = 150;
+    CU_ASSERT_TRUE(3 == nsvc_work_run());
+    CU_ASSERT_TRUE(3 == ut_work_count);
+    CU_ASSERT_TRUE(20 == ut_work_log[0]);
+    CU_ASSERT_TRUE(10 == ut_work_log[1]);
+    CU_ASSERT_TRUE(30 == ut_work_log[2]);
+    CU_ASSERT_TRUE(0 == nsvc_work_run());
+
+    nsvc_work_stats_get(&stats);
+    CU_ASSERT_TRUE(1 == stats.batches);
+    CU_ASSERT_TRUE(3 == stats.batch_max);
+    CU_ASSERT_TRUE(1 == stats.ring[0].deferred);
+    CU_ASSERT_TRUE(2 == stats.ring[1].executed);
+    CU_ASSERT_TRUE(50 == stats.ring[1].latency_max);
+    // 50 is in 32..63
+    CU_ASSERT_TRUE(2 == stats.ring[1].latency_histogram[6]);
+
+    // Full ring drops. Wake still pending, so no more messages.
+    for (i = 0; i < NSVC_WORK_RING_SIZE; i++)
+    {
+        CU_ASSERT_TRUE(nsvc_work_defer(0, ut_work_fcn, i));
+    }
+    CU_ASSERT_FALSE(nsvc_work_defer(0, ut_work_fcn, i));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 1 == nufr_msg_free_count());
+    CU_ASSERT_TRUE(NSVC_WORK_RING_SIZE == nsvc_work_run());
+
+    nsvc_work_stats_get(&stats);
+    CU_ASSERT_TRUE(1 == stats.ring[0].dropped);
+    CU_ASSERT_TRUE(NSVC_WORK_RING_SIZE + 1 == stats.ring[0].executed);
+    nsvc_work_stats_reset();
+    nsvc_work_stats_get(&stats);
+    CU_ASSERT_TRUE(0 == stats.batches);
+
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+
+#if NUFR_CS_MSG_QUEUE_LIMIT == 1
+    // Worker's queue full: wake refused, so next defer sends it
+    nsvc_work_init(NUFR_TID_02);
+    worker->msg_queue_limit = 1;
+    nufr_msg_send(NUFR_SET_MSG_FIELDS(1, 1, 0, NUFR_MSG_PRI_LOW), 0,
+                  NUFR_TID_02);
+    CU_ASSERT_TRUE(nsvc_work_defer(0, ut_work_fcn, 1));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 1 == nufr_msg_free_count());
+    nsvc_work_stats_get(&stats);
+    CU_ASSERT_TRUE(1 == stats.wake_fails);
+
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+    CU_ASSERT_TRUE(nsvc_work_defer(0, ut_work_fcn, 2));
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS - 1 == nufr_msg_free_count());
+    CU_ASSERT_TRUE(2 == nsvc_work_run());
+
+    worker->msg_queue_limit = 0;
+    nufr_msg_drain(NUFR_TID_02, NUFR_MSG_PRI_CONTROL);
+#endif  // NUFR_CS_MSG_QUEUE_LIMIT
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_DEFERRED_WORK
+
+void ut_rwlock(void)
+{
+    nufr_tcb_t        *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nufr_tcb_t        *task_2 = NUFR_TID_TO_TCB(NUFR_TID_02);
+    nufr_sema_block_t *gate_block;
+    nufr_sema_block_t *semaphore = NUFR_SEMA_ID_TO_BLOCK(NUFR_SEMA_X);
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    task_2->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufrkernel_add_task_to_ready_list(task_2);
+
+    // Gate sema is first out of a fresh pool
+    nsvc_init();
+    nsvc_rwlock_init();
+    gate_block = NUFR_SEMA_ID_TO_BLOCK(NUFR_SEMA_POOL_START);
+
+    // Readers share, without touching the gate
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_rwlock_read_getW(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID));
+    nufr_running = task_2;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_rwlock_read_getT(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID, 0));
+    CU_ASSERT_TRUE(1 == gate_block->count);
+
+    // Writer can't get in while readers are inside; backs out
+    CU_ASSERT_FALSE(nsvc_rwlock_read_release(NSVC_RWLOCK_1));
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_TIMEOUT ==
+                   nsvc_rwlock_write_getT(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID, 0));
+    CU_ASSERT_TRUE(1 == gate_block->count);
+
+    // Last reader out
+    nufr_running = task_1;
+    CU_ASSERT_FALSE(nsvc_rwlock_read_release(NSVC_RWLOCK_1));
+
+    // Writer excludes readers, which queue at the gate
+    nufr_running = task_2;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_rwlock_write_getT(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID, 0));
+    CU_ASSERT_TRUE(0 == gate_block->count);
+    CU_ASSERT_TRUE(task_2 == gate_block->owner_tcb);
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_TIMEOUT ==
+                   nsvc_rwlock_read_getT(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID, 0));
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_TIMEOUT ==
+                   nsvc_rwlock_write_getT(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID, 0));
+
+    nufr_running = task_2;
+    CU_ASSERT_FALSE(nsvc_rwlock_write_release(NSVC_RWLOCK_1));
+    CU_ASSERT_TRUE(1 == gate_block->count);
+
+    // Open to readers again
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_rwlock_read_getW(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID));
+    CU_ASSERT_FALSE(nsvc_rwlock_read_release(NSVC_RWLOCK_1));
+
+    // Higher priority writer at head of ready list, so it's the
+    // one which blocks
+    nufrkernel_delete_task_from_ready_list(task_2);
+    task_2->priority = NUFR_TPR_HIGH;
+    nufrkernel_add_task_to_ready_list(task_2);
+
+    // Draining writer raises reader inside to its priority
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_rwlock_read_getW(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID));
+    nufr_running = task_2;
+    (void)nsvc_rwlock_write_getW(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID);
+    CU_ASSERT_TRUE(NUFR_IS_TASK_BLOCKED(task_2));
+    CU_ASSERT_TRUE(NUFR_TPR_HIGH == task_1->priority);
+
+    // Reader leaving wakes writer and drops back
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(nsvc_rwlock_read_release(NSVC_RWLOCK_1));
+    CU_ASSERT_TRUE(NUFR_TPR_NOMINAL == task_1->priority);
+    CU_ASSERT_FALSE(NUFR_IS_TASK_BLOCKED(task_2));
+    CU_ASSERT_TRUE(task_2 == nufr_ready_list);
+
+    nufr_running = task_2;
+    CU_ASSERT_FALSE(nsvc_rwlock_write_release(NSVC_RWLOCK_1));
+    CU_ASSERT_TRUE(1 == gate_block->count);
+
+    // Reader holding a sema, which raised it above the writer
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nsvc_rwlock_read_getW(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID));
+    nufrkernel_sema_reset(semaphore, 0, true);
+    task_1->sema_block = semaphore;
+    semaphore->owner_tcb = task_1;
+    nufr_running = task_2;
+    nufrkernel_delete_task_from_ready_list(task_1);
+    task_1->statuses |= NUFR_TASK_INVERSION_PRIORITIZED;
+    task_1->priority_restore_inversion = NUFR_TPR_NOMINAL;
+    task_1->priority = NUFR_TPR_HIGHER;
+    nufrkernel_add_task_to_ready_list(task_1);
+
+    // Writer raise goes under the sema's, and outlasts the writer
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_TIMEOUT ==
+                   nsvc_rwlock_write_getT(NSVC_RWLOCK_1, NUFR_MSG_PRI_MID, 0));
+    CU_ASSERT_TRUE(NUFR_TPR_HIGHER == task_1->priority);
+    CU_ASSERT_TRUE(NUFR_TPR_HIGH == task_1->priority_restore_inversion);
+
+    // Sema release drops reader to writer's priority, not below it
+    nufr_running = task_1;
+    CU_ASSERT_TRUE(task_1 == nufr_ready_list);
+    CU_ASSERT_FALSE(nufr_sema_release(NUFR_SEMA_X));
+    CU_ASSERT_FALSE(NUFR_IS_STATUS_SET(task_1,
+                                       NUFR_TASK_INVERSION_PRIORITIZED));
+    CU_ASSERT_TRUE(NUFR_TPR_HIGH == task_1->priority);
+
+    // Reader leaving drops back to its own
+    nufr_running = task_2;
+    nufrkernel_block_running_task(NUFR_TASK_BLOCKED_ASLEEP);
+    nufr_running = task_1;
+    CU_ASSERT_TRUE_FATAL(task_1 == nufr_ready_list);
+    CU_ASSERT_FALSE(nsvc_rwlock_read_release(NSVC_RWLOCK_1));
+    CU_ASSERT_TRUE(NUFR_TPR_NOMINAL == task_1->priority);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+static uint32_t ut_timer_now;
+
+static uint32_t ut_timer_now_get(void)
+{
+    return ut_timer_now;
+}
+
+static uint32_t ut_timer_random;
+
+static uint32_t ut_timer_next_random(void)
+{
+    ut_timer_random = ut_timer_random * 1103515245 + 12345;
+
+    return ut_timer_random >> 16;
+}
+
+void ut_nsvc_timer_heap(void)
+{
+    static const uint32_t durations[] = { 40, 10, 30, 10, 50, 20, 60, 25 };
+    static const uint32_t expected[] = { 1, 3, 5, 7, 0, 6 };
+    nufr_tcb_t   *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nsvc_timer_t *timers[NSVC_NUM_TIMER];
+    nsvc_timer_t *tm;
+    nufr_msg_t   *msg;
+    uint32_t      reconfigured;
+    uint32_t      until_expiration;
+    uint32_t      next_expiration;
+    uint32_t      r;
+    unsigned      i;
+    unsigned      step;
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufr_running = task_1;
+
+    // Expirations straddle the 32-bit time wrap
+    ut_timer_now = 0xFFFFFFF0;
+    nsvc_timer_init(ut_timer_now_get, NULL);
+
+    for (i = 0; i < NSVC_NUM_TIMER; i++)
+    {
+        timers[i] = nsvc_timer_alloc();
+        CU_ASSERT_TRUE_FATAL(NULL != timers[i]);
+        timers[i]->msg_fields = NSVC_TIMER_SET_ID(i + 1);
+        timers[i]->msg_parameter = i;
+        timers[i]->dest_task_id = NUFR_TID_01;
+    }
+
+    for (i = 0; i < ARRAY_SIZE(durations); i++)
+    {
+        timers[i]->duration = durations[i];
+        timers[i]->mode = (6 == i)? NSVC_TMODE_CONTINUOUS :
+                                    NSVC_TMODE_SIMPLE;
+        nsvc_timer_start(timers[i]);
+    }
+    CU_ASSERT_TRUE(10 == nsvc_timer_next_expiration_callin());
+
+    // Kill from mid-heap
+    CU_ASSERT_TRUE(nsvc_timer_kill(timers[2]));
+    CU_ASSERT_TRUE(nsvc_timer_kill(timers[4]));
+    CU_ASSERT_FALSE(nsvc_timer_kill(timers[4]));
+    CU_ASSERT_TRUE(10 == nsvc_timer_next_expiration_callin());
+
+    // Expire both 10's, across the wrap
+    ut_timer_now += 10;
+    CU_ASSERT_TRUE(NSVC_TCRTN_RECONFIGURE_QUANTUM_TIMER ==
+                   nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured));
+    CU_ASSERT_TRUE(10 == reconfigured);
+
+    ut_timer_now += 25;
+    CU_ASSERT_TRUE(NSVC_TCRTN_RECONFIGURE_QUANTUM_TIMER ==
+                   nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured));
+    CU_ASSERT_TRUE(5 == reconfigured);
+
+    // Continuous timer is rearmed 60 out
+    ut_timer_now += 25;
+    CU_ASSERT_TRUE(NSVC_TCRTN_RECONFIGURE_QUANTUM_TIMER ==
+                   nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured));
+    CU_ASSERT_TRUE(60 == reconfigured);
+    CU_ASSERT_TRUE(timers[6]->is_active);
+    CU_ASSERT_FALSE(timers[0]->is_active);
+
+    // Messages went out in expiration order
+    msg = task_1->msg_head2;
+    for (i = 0; i < ARRAY_SIZE(expected); i++)
+    {
+        CU_ASSERT_TRUE_FATAL(NULL != msg);
+        CU_ASSERT_TRUE(expected[i] == msg->parameter);
+        msg = msg->flink;
+    }
+    CU_ASSERT_TRUE(NULL == msg);
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+
+    ut_timer_now += 60;
+    (void)nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured);
+    CU_ASSERT_TRUE(6 == task_1->msg_head2->parameter);
+    CU_ASSERT_TRUE(nsvc_timer_kill(timers[6]));
+    CU_ASSERT_TRUE(0 == nsvc_timer_next_expiration_callin());
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+
+    // Random starts, kills and time steps: head is always the
+    // earliest active timer, and nothing active is overdue.
+    ut_timer_random = 1;
+    for (i = 0; i < NSVC_NUM_TIMER; i++)
+    {
+        timers[i]->mode = NSVC_TMODE_SIMPLE;
+    }
+    for (step = 0; step < 2000; step++)
+    {
+        r = ut_timer_next_random();
+        tm = timers[r % NSVC_NUM_TIMER];
+
+        if (0 == (r & 0x300))
+        {
+            ut_timer_now += (r >> 10) % 30;
+            (void)nsvc_timer_expire_timer_callin(ut_timer_now,
+                                                 &reconfigured);
+        }
+        else if (tm->is_active)
+        {
+            CU_ASSERT_TRUE(nsvc_timer_kill(tm));
+        }
+        else
+        {
+            tm->duration = 1 + (r >> 10) % 100;
+            nsvc_timer_start(tm);
+        }
+
+        next_expiration = 0;
+        for (i = 0; i < NSVC_NUM_TIMER; i++)
+        {
+            if (timers[i]->is_active)
+            {
+                until_expiration = timers[i]->expiration_time - ut_timer_now;
+                CU_ASSERT_TRUE((until_expiration > 0) &&
+                               (until_expiration <= 100));
+                if ((0 == next_expiration) ||
+                    (until_expiration < next_expiration))
+                {
+                    next_expiration = until_expiration;
+                }
+            }
+        }
+        CU_ASSERT_TRUE(next_expiration == nsvc_timer_next_expiration_callin());
+
+        nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+    }
+
+    for (i = 0; i < NSVC_NUM_TIMER; i++)
+    {
+        (void)nsvc_timer_kill(timers[i]);
+        nsvc_timer_free(timers[i]);
+    }
+    CU_ASSERT_TRUE(0 == nsvc_timer_next_expiration_callin());
+    CU_ASSERT_TRUE(NUFR_MAX_MSGS == nufr_msg_free_count());
+
+    // Detach from SysTick, so later tick tests don't see SL timers
+    nufrplat_systick_sl_add_callback(NULL);
+    nufrplat_systick_sl_add_deadline_callback(NULL);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+
+#if NUFR_CS_TIMER_SLACK == 1
+static uint32_t ut_quantum_timeout;
+static unsigned ut_quantum_reprograms;
+
+static void ut_quantum_reconfigure(uint32_t timeout)
+{
+    ut_quantum_timeout = timeout;
+    ut_quantum_reprograms++;
+}
+
+void ut_nsvc_timer_slack(void)
+{
+    static const uint32_t durations[] = { 100, 110, 105, 90 };
+    static const uint32_t slacks[] = { 20, 30, 0, 30 };
+    static const uint32_t expected[] = { 3, 0, 2, 1 };
+    nufr_tcb_t         *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nsvc_timer_t       *timers[ARRAY_SIZE(durations)];
+    nsvc_timer_stats_t  stats;
+    nufr_msg_t         *msg;
+    uint32_t            reconfigured;
+    uint32_t            start_time;
+    unsigned            i;
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufr_running = task_1;
+
+    start_time = 0xFFFFFFC0;
+    ut_timer_now = start_time;
+    ut_quantum_reprograms = 0;
+    nsvc_timer_init(ut_timer_now_get, ut_quantum_reconfigure);
+
+    for (i = 0; i < ARRAY_SIZE(durations); i++)
+    {
+        timers[i] = nsvc_timer_alloc();
+        CU_ASSERT_TRUE_FATAL(NULL != timers[i]);
+        timers[i]->duration = durations[i];
+        timers[i]->slack = slacks[i];
+        timers[i]->msg_fields = NSVC_TIMER_SET_ID(i + 1);
+        timers[i]->msg_parameter = i;
+        timers[i]->dest_task_id = NUFR_TID_01;
+    }
+
+    // Window 100..120: quantum set for latest
+    nsvc_timer_start(timers[0]);
+    CU_ASSERT_TRUE(1 == ut_quantum_reprograms);
+    CU_ASSERT_TRUE(120 == ut_quantum_timeout);
+
+    // Window 110..140 overlaps, deadline doesn't move
+    nsvc_timer_start(timers[1]);
+    CU_ASSERT_TRUE(1 == ut_quantum_reprograms);
+
+    // No slack, at 105: pulls deadline in, without being head
+    nsvc_timer_start(timers[2]);
+    CU_ASSERT_TRUE(2 == ut_quantum_reprograms);
+    CU_ASSERT_TRUE(105 == ut_quantum_timeout);
+
+    // New head, window 90..120: deadline stays, reprogram saved
+    nsvc_timer_start(timers[3]);
+    CU_ASSERT_TRUE(2 == ut_quantum_reprograms);
+    CU_ASSERT_TRUE(105 == nsvc_timer_next_expiration_callin());
+
+    // Nothing due before deadline, even with windows open
+    ut_timer_now = start_time + 100;
+    CU_ASSERT_TRUE(NSVC_TCRTN_RECONFIGURE_QUANTUM_TIMER ==
+                   nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured));
+    CU_ASSERT_TRUE(5 == reconfigured);
+    CU_ASSERT_TRUE(NULL == task_1->msg_head2);
+
+    // One expiry for 90, 100 and 105, across the wrap. 110 not open yet.
+    ut_timer_now = start_time + 105;
+    CU_ASSERT_TRUE(NSVC_TCRTN_RECONFIGURE_QUANTUM_TIMER ==
+                   nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured));
+    CU_ASSERT_TRUE(35 == reconfigured);
+    CU_ASSERT_TRUE(timers[1]->is_active);
+
+    // Open, but held back until its own deadline
+    ut_timer_now = start_time + 130;
+    (void)nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured);
+    CU_ASSERT_TRUE(10 == reconfigured);
+    CU_ASSERT_TRUE(timers[1]->is_active);
+
+    ut_timer_now = start_time + 140;
+    CU_ASSERT_TRUE(NSVC_TCRTN_DISABLE_QUANTUM_TIMER ==
+                   nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured));
+    CU_ASSERT_FALSE(timers[1]->is_active);
+
+    msg = task_1->msg_head2;
+    for (i = 0; i < ARRAY_SIZE(expected); i++)
+    {
+        CU_ASSERT_TRUE_FATAL(NULL != msg);
+        CU_ASSERT_TRUE(expected[i] == msg->parameter);
+        msg = msg->flink;
+    }
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+
+    nsvc_timer_stats_get(&stats);
+    CU_ASSERT_TRUE(2 == stats.expiries);
+    CU_ASSERT_TRUE(4 == stats.timers_expired);
+    CU_ASSERT_TRUE(2 == stats.wakeups_saved);
+    CU_ASSERT_TRUE(1 == stats.reprograms_saved);
+    nsvc_timer_stats_reset();
+    nsvc_timer_stats_get(&stats);
+    CU_ASSERT_TRUE(0 == stats.reprograms);
+
+    for (i = 0; i < ARRAY_SIZE(durations); i++)
+    {
+        nsvc_timer_free(timers[i]);
+    }
+
+    nufrplat_systick_sl_add_callback(NULL);
+    nufrplat_systick_sl_add_deadline_callback(NULL);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_TIMER_SLACK
+
+#if NUFR_CS_TIMER_CALLBACK == 1
+static unsigned ut_callback_calls;
+static unsigned ut_hybrid_calls;
+
+static bool ut_timer_callback(nsvc_timer_t *tm)
+{
+    UNUSED(tm);
+
+    ut_callback_calls++;
+
+    // Ignored for callback delivery
+    return true;
+}
+
+static bool ut_timer_hybrid(nsvc_timer_t *tm)
+{
+    ut_hybrid_calls++;
+    tm->msg_parameter = 100 + ut_hybrid_calls;
+
+    // Message on every other expiry
+    return 0 == (ut_hybrid_calls & 1);
+}
+
+void ut_nsvc_timer_callback(void)
+{
+    nufr_tcb_t         *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    nsvc_timer_t       *callback_tm;
+    nsvc_timer_t       *hybrid_tm;
+    nsvc_timer_t       *msg_tm;
+    nufr_msg_t         *msg;
+    uint32_t            reconfigured;
+    unsigned            i;
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufr_running = task_1;
+
+    ut_timer_now = 0;
+    ut_callback_calls = 0;
+    ut_hybrid_calls = 0;
+    nsvc_timer_init(ut_timer_now_get, NULL);
+
+    callback_tm = nsvc_timer_alloc();
+    hybrid_tm = nsvc_timer_alloc();
+    msg_tm = nsvc_timer_alloc();
+    CU_ASSERT_TRUE_FATAL((NULL != callback_tm) && (NULL != hybrid_tm) &&
+                         (NULL != msg_tm));
+    CU_ASSERT_TRUE(NSVC_TDELIVERY_MSG == msg_tm->delivery);
+
+    callback_tm->duration = 10;
+    callback_tm->delivery = NSVC_TDELIVERY_CALLBACK;
+    callback_tm->callback = ut_timer_callback;
+    callback_tm->msg_fields = NSVC_TIMER_SET_ID(1);
+    callback_tm->dest_task_id = NUFR_TID_01;
+
+    hybrid_tm->mode = NSVC_TMODE_CONTINUOUS;
+    hybrid_tm->duration = 10;
+    hybrid_tm->delivery = NSVC_TDELIVERY_HYBRID;
+    hybrid_tm->callback = ut_timer_hybrid;
+    hybrid_tm->msg_fields = NSVC_TIMER_SET_ID(2);
+    hybrid_tm->dest_task_id = NUFR_TID_01;
+
+    msg_tm->duration = 10;
+    msg_tm->msg_fields = NSVC_TIMER_SET_ID(3);
+    msg_tm->msg_parameter = 3;
+    msg_tm->dest_task_id = NUFR_TID_01;
+
+    nsvc_timer_start(callback_tm);
+    nsvc_timer_start(hybrid_tm);
+    nsvc_timer_start(msg_tm);
+
+    for (i = 1; i <= 3; i++)
+    {
+        ut_timer_now = 10 * i;
+        (void)nsvc_timer_expire_timer_callin(ut_timer_now, &reconfigured);
+    }
+
+    // Callback-only timer fired once, without a message
+    CU_ASSERT_TRUE(1 == ut_callback_calls);
+    CU_ASSERT_FALSE(callback_tm->is_active);
+
+    // Continuous hybrid timer rearmed after each callback
+    CU_ASSERT_TRUE(3 == ut_hybrid_calls);
+    CU_ASSERT_TRUE(hybrid_tm->is_active);
+
+    // Plain message, then the one hybrid expiry that asked for a message,
+    // carrying the parameter its callback set.
+    msg = task_1->msg_head2;
+    CU_ASSERT_TRUE_FATAL(NULL != msg);
+    CU_ASSERT_TRUE(3 == msg->parameter);
+    msg = msg->flink;
+    CU_ASSERT_TRUE_FATAL(NULL != msg);
+    CU_ASSERT_TRUE(102 == msg->parameter);
+    CU_ASSERT_TRUE(2 == NUFR_GET_MSG_ID(msg->fields));
+    CU_ASSERT_TRUE(NULL == msg->flink);
+    nufr_msg_drain(NUFR_TID_01, NUFR_MSG_PRI_CONTROL);
+
+    CU_ASSERT_TRUE(nsvc_timer_kill(hybrid_tm));
+    nsvc_timer_free(callback_tm);
+    nsvc_timer_free(hybrid_tm);
+    nsvc_timer_free(msg_tm);
+    CU_ASSERT_TRUE(0 == nsvc_timer_next_expiration_callin());
+
+    nufrplat_systick_sl_add_callback(NULL);
+    nufrplat_systick_sl_add_deadline_callback(NULL);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_TIMER_CALLBACK
+
+#if NUFR_CS_POOL_BULK == 1
+#define UT_POOL_SIZE              8
+
+typedef struct ut_pool_element_t_
+{
+    struct ut_pool_element_t_ *flink;
+    uint32_t                   header;
+    uint32_t                   payload[4];
+} ut_pool_element_t;
+
+static ut_pool_element_t ut_pool_elements[UT_POOL_SIZE];
+static nsvc_pool_t       ut_pool;
+
+void ut_nsvc_pool_bulk(void)
+{
+    nufr_tcb_t        *task_1 = NUFR_TID_TO_TCB(NUFR_TID_01);
+    ut_pool_element_t *elements[UT_POOL_SIZE + 2];
+    unsigned           dirty;
+    unsigned           i;
+
+    ut_clean_list();
+    task_1->priority = NUFR_TPR_NOMINAL;
+    nufrkernel_add_task_to_ready_list(task_1);
+    nufr_running = task_1;
+
+    nsvc_init();
+    memset(&ut_pool, 0, sizeof(ut_pool));
+    ut_pool.base_ptr = ut_pool_elements;
+    ut_pool.pool_size = UT_POOL_SIZE;
+    ut_pool.element_size = sizeof(ut_pool_element_t);
+    ut_pool.element_index_size = sizeof(ut_pool_element_t);
+    ut_pool.flink_offset = OFFSETOF(ut_pool_element_t, flink);
+    ut_pool.zero_size = OFFSETOF(ut_pool_element_t, payload);
+    nsvc_pool_init(&ut_pool);
+
+    // Sema count tracks free count
+    CU_ASSERT_TRUE(UT_POOL_SIZE == ut_pool.free_count);
+    CU_ASSERT_TRUE(UT_POOL_SIZE == ut_pool.sema_block->count);
+
+    CU_ASSERT_TRUE(5 == nsvc_pool_allocate_bulk(&ut_pool,
+                                                (void **)elements, 5, false));
+    CU_ASSERT_TRUE(3 == ut_pool.free_count);
+    CU_ASSERT_TRUE(3 == ut_pool.sema_block->count);
+    for (i = 0; i < 5; i++)
+    {
+        CU_ASSERT_TRUE(&ut_pool_elements[i] == elements[i]);
+        elements[i]->header = 0xA5A5A5A5;
+        memset(elements[i]->payload, 0xA5, sizeof(elements[i]->payload));
+    }
+
+    // Spliced after the 3 still free
+    nsvc_pool_free_bulk(&ut_pool, (void **)elements, 5);
+    CU_ASSERT_TRUE(UT_POOL_SIZE == ut_pool.free_count);
+    CU_ASSERT_TRUE(UT_POOL_SIZE == ut_pool.sema_block->count);
+    CU_ASSERT_TRUE(&ut_pool_elements[5] == ut_pool.head_ptr);
+    CU_ASSERT_TRUE(&ut_pool_elements[4] == ut_pool.tail_ptr);
+
+    // Pool runs short. Only header prefix and flink are cleared.
+    CU_ASSERT_TRUE(UT_POOL_SIZE ==
+                   nsvc_pool_allocate_bulk(&ut_pool, (void **)elements,
+                                           UT_POOL_SIZE + 2, false));
+    CU_ASSERT_TRUE((NULL == ut_pool.head_ptr) && (NULL == ut_pool.tail_ptr));
+    CU_ASSERT_TRUE(0 == ut_pool.sema_block->count);
+    dirty = 0;
+    for (i = 0; i < UT_POOL_SIZE; i++)
+    {
+        CU_ASSERT_TRUE((NULL == elements[i]->flink) &&
+                       (0 == elements[i]->header));
+        dirty += (0xA5A5A5A5 == elements[i]->payload[3])? 1 : 0;
+    }
+    CU_ASSERT_TRUE(5 == dirty);
+    CU_ASSERT_TRUE(0 == nsvc_pool_allocate_bulk(&ut_pool,
+                                                (void **)elements, 1, false));
+    for (i = 0; i < UT_POOL_SIZE; i++)
+    {
+        elements[i]->header = 0xA5A5A5A5;
+    }
+    nsvc_pool_free_bulk(&ut_pool, (void **)elements, UT_POOL_SIZE);
+
+    // ISR: only flinks cleared, sema still kept in step
+    CU_ASSERT_TRUE(3 == nsvc_pool_allocate_bulk(&ut_pool,
+                                                (void **)elements, 3, true));
+    CU_ASSERT_TRUE(UT_POOL_SIZE - 3 == ut_pool.sema_block->count);
+    for (i = 0; i < 3; i++)
+    {
+        CU_ASSERT_TRUE((NULL == elements[i]->flink) &&
+                       (0xA5A5A5A5 == elements[i]->header));
+    }
+    nsvc_pool_free_bulk(&ut_pool, (void **)elements, 3);
+
+    // Task holding a sema count has an element reserved
+    CU_ASSERT_TRUE(NUFR_SEMA_GET_OK_NO_BLOCK ==
+                   nufr_sema_getW(ut_pool.sema, NUFR_MSG_PRI_MID));
+    CU_ASSERT_TRUE(UT_POOL_SIZE - 1 ==
+                   nsvc_pool_allocate_bulk(&ut_pool, (void **)elements,
+                                           UT_POOL_SIZE, false));
+    CU_ASSERT_TRUE(1 == ut_pool.free_count);
+    elements[UT_POOL_SIZE - 1] = nsvc_pool_allocate(&ut_pool, false);
+    CU_ASSERT_TRUE_FATAL(NULL != elements[UT_POOL_SIZE - 1]);
+    CU_ASSERT_TRUE(0 == elements[UT_POOL_SIZE - 1]->header);
+
+    nsvc_pool_free_bulk(&ut_pool, (void **)elements, UT_POOL_SIZE);
+    CU_ASSERT_TRUE(UT_POOL_SIZE == ut_pool.free_count);
+    CU_ASSERT_TRUE(UT_POOL_SIZE == ut_pool.sema_block->count);
+    CU_ASSERT_TRUE(NULL == task_1->sema_block);
+
+    CU_ASSERT_TRUE(ut_interrupt_count == 0);
+}
+#endif  // NUFR_CS_POOL_BULK
+
+CU_ErrorCode ut_setup_nsvc_tests(void)
+{
+    CU_pSuite ptrNsvcSuite = NULL;
+    CU_ErrorCode result = CUE_SUCCESS;
+
+    ptrNsvcSuite = CU_add_suite(NSVC_TEST_SUITE, NULL, NULL);
+    if (NULL != ptrNsvcSuite)
+    {
+        CU_pTest outcome = NULL;
+
+    #if NUFR_CS_MUTEX_FAST_PATH == 1
+        outcome = CU_ADD_TEST(ptrNsvcSuite, ut_mutex_fast_path);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_MUTEX_FAST_PATH
+
+        outcome = CU_ADD_TEST(ptrNsvcSuite, ut_rwlock);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+    #if NUFR_CS_DEFERRED_WORK == 1
+        outcome = CU_ADD_TEST(ptrNsvcSuite, ut_deferred_work);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_DEFERRED_WORK
+
+        outcome = CU_ADD_TEST(ptrNsvcSuite, ut_nsvc_timer_heap);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+
+    #if NUFR_CS_TIMER_SLACK == 1
+        outcome = CU_ADD_TEST(ptrNsvcSuite, ut_nsvc_timer_slack);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_TIMER_SLACK
+
+    #if NUFR_CS_TIMER_CALLBACK == 1
+        outcome = CU_ADD_TEST(ptrNsvcSuite, ut_nsvc_timer_callback);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_TIMER_CALLBACK
+
+    #if NUFR_CS_POOL_BULK == 1
+        outcome = CU_ADD_TEST(ptrNsvcSuite, ut_nsvc_pool_bulk);
+        if (NULL == outcome)
+        {
+            CU_cleanup_registry();
+            return CU_get_error();
+        }
+    #endif  // NUFR_CS_POOL_BULK
+    }
+    else
+    {
+        CU_cleanup_registry();
+        result = CU_get_error();
+    }
+    return result;
+}
@@ -0,0 +1,476 @@
+/*
+Copyright (c) 2018, Bernie Woodland
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! @file     nufr-trace-decode.cpp
+//! @authors  agent
+//! @date     16Oct26
+//!
+//! @brief    Decodes a NUFR kernel trace ring into a Chrome trace
+//!
+//! @details  ./nufr-trace-decode -f ring.bin [-o trace.json] [-c 168]
+//! @details  ./nufr-trace-decode -i /dev/ttyUSB0 -b 115200 -d 5 [-o trace.json]
+//! @details  Turns a dump of 'nufr_trace_ring' (see nufr-kernel-trace.h)
+//! @details  into Chrome trace event JSON. Load it in chrome://tracing
+//! @details  or ui.perfetto.dev. Each task is a thread; tid 0 is BG/ISR.
+//! @details  Every record is an instant event, and the time from a task's
+//! @details  BLOCK to its next READY_INSERT is drawn as a "blocked" span.
+//! @details    -f = raw memory image of the ring, from a debugger or
+//! @details         other dump
+//! @details    -i = tty device to collect the ring from, over SSP. Sends
+//! @details         an SSP_DAPP_CLEAR_TRACE_DUMP_REQUEST packet. Target
+//! @details         replies with ssp_trace_dump_next() packets, dapp
+//! @details         SSP_DAPP_CLEAR_TRACE_DUMP_RESPONSE, which are
+//! @details         concatenated, minus the dapp and circuit bytes, into
+//! @details         the ring image.
+//! @details    -b = baud rate, in bits/sec
+//! @details    -d = seconds to listen on the tty. Default is 5.
+//! @details    -o = (optional) output file. Default is stdout.
+//! @details    -c = (optional) timestamp units per microsecond: the
+//! @details         target's NUFR_TASK_STATS_TIMESTAMP() rate. Default 1.
+//! @details
+//! @details   to make:
+//! @details      g++ -g -I../../includes nufr-trace-decode.cpp ssp-framer.cpp ssp-packet.cpp ../../sources/raging-utils.c ../../sources/raging-utils-mem.c ../../sources/raging-utils-crc.c ../../sources/raging-utils-scan-print.c ./linux-utils.cpp -lpthread -o nufr-trace-decode
+//! @details
+//! @details   to debug:
+//! @details      gdb nufr-trace-decode
+//! @details        break main
+//! @details        run -f ring.bin
+//! @details
+//!
+
+#include "raging-global.h"
+
+#include "ssp-packet.h"
+#include "ssp-framer.h"
+#include "ssp-assignments.h"
+
+#include "raging-utils.h"
+#include "raging-utils-scan-print.h"
+
+#include <vector>
+#include <string>
+#include <algorithm>  // std::sort()
+#include <cstdio>
+#include <cstdlib>    // 'std::exit()'
+
+#include <unistd.h>   // getopt(), sleep()
+
+// Must match nufr-kernel-trace.h
+#define TRACE_MAGIC              0x4E545243
+#define TRACE_HEADER_SIZE        12
+#define TRACE_RECORD_SIZE        16
+
+// Indexed by 'nufr_trace_event_t'
+static const char *event_names[] =
+{
+    "NONE",
+    "READY_INSERT",
+    "READY_REMOVE",
+    "BLOCK",
+    "TIMER_EXPIRE",
+    "MSG_SEND",
+    "MSG_RECEIVE",
+    "SEMA_GET",
+    "SEMA_RELEASE",
+    "BOP_SEND",
+    "BOP_WAIT",
+    "EVENT_SET",
+    "EVENT_WAIT",
+};
+
+#define EVENT_READY_INSERT       1
+#define EVENT_BLOCK              3
+#define NUM_EVENT_NAMES          (sizeof(event_names) / sizeof(event_names[0]))
+
+struct trace_record_t
+{
+    uint32_t timestamp;
+    uint32_t sequence;
+    uint8_t  event;
+    uint8_t  tid;
+    uint16_t object_id;
+    uint32_t param;
+};
+
+// Requests ring image from target, collects it from SSP packets
+void collect_from_ssp(const char           *tty_device_name,
+                      unsigned              baud_rate,
+                      unsigned              delay_in_seconds,
+                      std::vector<uint8_t> &image)
+{
+    ssp_packet_cl *rx_packet_ptr;
+    ssp_packet_cl *request_ptr;
+
+    ssp_framer_cl framer(tty_device_name,
+                         baud_rate,
+                         NULL);
+
+    framer_error_t rv;
+
+    rv = framer.start();
+
+    if (rv != FRAMER_ERROR_NONE)
+    {
+        printf("Failed to start framer, rv=%u\n", (unsigned)rv);
+        std::exit(1);
+    }
+
+    // Framer deletes packet once sent
+    request_ptr = new ssp_packet_cl();
+    request_ptr->append_bytes((uint8_t)SSP_DAPP_CLEAR_TRACE_DUMP_REQUEST);
+    request_ptr->append_bytes((uint8_t)SSP_CIR_PRIMARY_PEER);
+    framer.tx_packet(request_ptr);
+
+    sleep(delay_in_seconds);
+
+    while (NULL != (rx_packet_ptr = framer.get_rx_packet()))
+    {
+        if ((rx_packet_ptr->size() > 2) &&
+            (SSP_DAPP_CLEAR_TRACE_DUMP_RESPONSE ==
+                                          rx_packet_ptr->buffer.at(0)))
+        {
+            image.insert(image.end(),
+                         rx_packet_ptr->buffer.begin() + 2,
+                         rx_packet_ptr->buffer.end());
+        }
+
+        delete rx_packet_ptr;
+    }
+
+    framer.stop();
+}
+
+// Reads ring image from file
+void collect_from_file(const char *file_name, std::vector<uint8_t> &image)
+{
+    FILE    *fp;
+    uint8_t  chunk[1024];
+    size_t   length;
+
+    fp = fopen(file_name, "rb");
+    if (NULL == fp)
+    {
+        printf("Can't open <%s>\n", file_name);
+        std::exit(1);
+    }
+
+    while ((length = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    {
+        image.insert(image.end(), chunk, chunk + length);
+    }
+
+    fclose(fp);
+}
+
+// Validates ring image, pulls out complete records, oldest first.
+// Returns false on a bad image.
+bool extract_records(std::vector<uint8_t>        &image,
+                     std::vector<trace_record_t> &records)
+{
+    uint32_t magic;
+    unsigned capacity;
+    unsigned record_size;
+    uint32_t write_index;
+
+    if (image.size() < TRACE_HEADER_SIZE)
+    {
+        printf("Image too short (%u bytes)\n", (unsigned)image.size());
+        return false;
+    }
+
+    magic = rutils_stream_to_word32_little_endian(&image[0]);
+    capacity = rutils_stream_to_word16_little_endian(&image[4]);
+    record_size = rutils_stream_to_word16_little_endian(&image[6]);
+    write_index = rutils_stream_to_word32_little_endian(&image[8]);
+
+    if (TRACE_MAGIC != magic)
+    {
+        printf("Bad magic 0x%08X\n", magic);
+        return false;
+    }
+    if ((TRACE_RECORD_SIZE != record_size) ||
+        (0 == capacity) || (0 != (capacity & (capacity - 1))))
+    {
+        printf("Bad header: capacity %u, record size %u\n",
+               capacity, record_size);
+        return false;
+    }
+    if (image.size() < TRACE_HEADER_SIZE + capacity * record_size)
+    {
+        printf("Image truncated: %u bytes, %u records expected\n",
+               (unsigned)image.size(), capacity);
+        return false;
+    }
+
+    for (unsigned slot = 0; slot < capacity; slot++)
+    {
+        uint8_t        *ptr = &image[TRACE_HEADER_SIZE + slot * record_size];
+        trace_record_t  record;
+
+        record.timestamp = rutils_stream_to_word32_little_endian(&ptr[0]);
+        record.sequence = rutils_stream_to_word32_little_endian(&ptr[4]);
+        record.event = ptr[8];
+        record.tid = ptr[9];
+        record.object_id = rutils_stream_to_word16_little_endian(&ptr[10]);
+        record.param = rutils_stream_to_word32_little_endian(&ptr[12]);
+
+        // Empty, or torn by a write in progress
+        if (0 == record.sequence)
+        {
+            continue;
+        }
+        // Stale: sequence must belong to this slot...
+        if (((record.sequence - 1) & (capacity - 1)) != slot)
+        {
+            continue;
+        }
+        // ...and be in the last 'capacity' writes
+        if ((uint32_t)(write_index - record.sequence) >= capacity)
+        {
+            continue;
+        }
+
+        records.push_back(record);
+    }
+
+    // Oldest first. Wrap-safe: order by distance back from 'write_index'.
+    std::sort(records.begin(), records.end(),
+              [write_index](const trace_record_t &a, const trace_record_t &b)
+              {
+                  return (uint32_t)(write_index - a.sequence) >
+                         (uint32_t)(write_index - b.sequence);
+              });
+
+    return true;
+}
+
+// Writes Chrome trace event JSON
+void write_chrome_trace(FILE                        *out,
+                        std::vector<trace_record_t> &records,
+                        double                       units_per_usec)
+{
+    std::vector<bool> seen_tid(256, false);
+    std::vector<bool> blocked(256, false);
+    uint32_t          prev_timestamp = 0;
+    int64_t           unwrapped = 0;
+    bool              first = true;
+    double            ts;
+
+    fprintf(out, "{\"traceEvents\":[\n");
+
+    for (unsigned i = 0; i < records.size(); i++)
+    {
+        trace_record_t &record = records[i];
+        const char     *name;
+
+        // Timestamps wrap. Records can be slightly out of time order
+        // (ISR preempting a writer), so use signed deltas.
+        if (i > 0)
+        {
+            unwrapped += (int32_t)(record.timestamp - prev_timestamp);
+        }
+        prev_timestamp = record.timestamp;
+        ts = (double)unwrapped / units_per_usec;
+
+        if (!seen_tid[record.tid])
+        {
+            seen_tid[record.tid] = true;
+
+            fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\","
+                    "\"pid\":0,\"tid\":%u,\"args\":{\"name\":",
+                    first? "" : ",\n", record.tid);
+            if (0 == record.tid)
+            {
+                fprintf(out, "\"BG/ISR\"}}");
+            }
+            else
+            {
+                fprintf(out, "\"task %u\"}}", record.tid);
+            }
+            first = false;
+        }
+
+        if (record.event < NUM_EVENT_NAMES)
+        {
+            name = event_names[record.event];
+        }
+        else
+        {
+            name = "UNKNOWN";
+        }
+
+        // Close a blocked span
+        if ((EVENT_READY_INSERT == record.event) && blocked[record.tid])
+        {
+            blocked[record.tid] = false;
+            fprintf(out, ",\n{\"name\":\"blocked\",\"ph\":\"E\","
+                    "\"pid\":0,\"tid\":%u,\"ts\":%.3f}", record.tid, ts);
+        }
+
+        fprintf(out, "%s{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\","
+                "\"pid\":0,\"tid\":%u,\"ts\":%.3f,"
+                "\"args\":{\"seq\":%u,\"obj\":%u,\"param\":\"0x%08X\"}}",
+                first? "" : ",\n", name, record.tid, ts,
+                record.sequence, record.object_id, record.param);
+        first = false;
+
+        // Open a blocked span
+        if ((EVENT_BLOCK == record.event) && !blocked[record.tid])
+        {
+            blocked[record.tid] = true;
+            fprintf(out, ",\n{\"name\":\"blocked\",\"ph\":\"B\","
+                    "\"pid\":0,\"tid\":%u,\"ts\":%.3f,"
+                    "\"args\":{\"block_flag\":%u}}",
+                    record.tid, ts, record.param);
+        }
+    }
+
+    fprintf(out, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+// Parse CLI arguments, error check
+int main(int argc, char **argv)
+{
+    int         option;
+    std::string file_name;
+    std::string tty_device_name;
+    std::string baud_rate_string;
+    std::string delay_string;
+    std::string output_name;
+    std::string rate_string;
+    unsigned    baud_rate = 0;
+    unsigned    delay = 5;
+    unsigned    units_per_usec = 1;
+    bool        failure = false;
+    FILE       *out = stdout;
+
+    std::vector<uint8_t>        image;
+    std::vector<trace_record_t> records;
+
+    // Semicolon means preceding opt takes parm
+
+    while ((option = getopt(argc, argv, "f:i:b:d:o:c:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'f':
+            file_name = optarg;
+            break;
+        case 'i':
+            tty_device_name = optarg;
+            break;
+        case 'b':
+            baud_rate_string = optarg;
+            break;
+        case 'd':
+            delay_string = optarg;
+            break;
+        case 'o':
+            output_name = optarg;
+            break;
+        case 'c':
+            rate_string = optarg;
+            break;
+        case 'h':
+            printf("./nufr-trace-decode -f ring.bin | -i /dev/tty0 -b 115200 [-d 5]  [-o trace.json] [-c 1]\n");
+            std::exit(0);
+            break;
+        default:
+            printf("Unknown option %c\n", option);
+            std::exit(0);
+            break;
+        }
+    }
+
+    // Sanity checks
+    if ((file_name.size() == 0) == (tty_device_name.size() == 0))
+    {
+        printf("Need one of -f or -i\n");
+        std::exit(1);
+    }
+
+    if (rate_string.size() > 0)
+    {
+        (void)rutils_decimal_ascii_to_unsigned32(rate_string.c_str(),
+                                                 &units_per_usec,
+                                                 &failure);
+        if (failure || (0 == units_per_usec))
+        {
+            printf("Bad -c value\n");
+            std::exit(1);
+        }
+    }
+
+    if (file_name.size() > 0)
+    {
+        collect_from_file(file_name.c_str(), image);
+    }
+    else
+    {
+        (void)rutils_decimal_ascii_to_unsigned32(baud_rate_string.c_str(),
+                                                 &baud_rate,
+                                                 &failure);
+
+        if (BAD_BAUD == ssp_framer_cl::baud_rate_lookup(baud_rate))
+        {
+            printf("Unsupported baud rate %u\n", baud_rate);
+            std::exit(1);
+        }
+
+        if (delay_string.size() > 0)
+        {
+            (void)rutils_decimal_ascii_to_unsigned32(delay_string.c_str(),
+                                                     &delay,
+                                                     &failure);
+        }
+
+        collect_from_ssp(tty_device_name.c_str(), baud_rate, delay, image);
+    }
+
+    if (!extract_records(image, records))
+    {
+        std::exit(1);
+    }
+
+    if (output_name.size() > 0)
+    {
+        out = fopen(output_name.c_str(), "w");
+        if (NULL == out)
+        {
+            printf("Can't open <%s> for writing\n", output_name.c_str());
+            std::exit(1);
+        }
+    }
+
+    write_chrome_trace(out, records, (double)units_per_usec);
+
+    if (stdout != out)
+    {
+        fclose(out);
+        printf("%u records decoded\n", (unsigned)records.size());
+    }
+
+    return 0;
+}